@@ -1,6 +1,7 @@
 #include <QMetaType>
 
 #include "ServiceLocator.h"
+#include "EventLog.h"
 #include "LoggingServiceImpl.h"
 #include "GlobalFactoryImpl.h"
 #include "BaseServices.h"
@@ -9,7 +10,9 @@ BaseServices::BaseServices()
 {
     static LoggingServiceImpl loggingServiceImpl;
     static GlobalFactoryImpl globalFactoryImpl;
+    static EventLog eventLog;
 
     ServiceLocator::getInstance().registerService<LoggingService>(&loggingServiceImpl);
 	ServiceLocator::getInstance().registerService<GlobalFactory>(&globalFactoryImpl);
+    ServiceLocator::getInstance().registerService<EventLog>(&eventLog);
 }
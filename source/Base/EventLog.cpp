@@ -0,0 +1,386 @@
+#include "EventLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+char const EventLog::Magic[8] = {'A', 'L', 'I', 'E', 'N', 'E', 'V', 'L'};
+
+namespace
+{
+    auto const SegmentExtension = ".evl";
+    int const IndexDigits = 6;
+    int const PreallocationChunkSize = 1 << 16;
+
+    uint32_t hash(void const* data, size_t size, uint32_t value = 2166136261u)
+    {
+        auto bytes = static_cast<unsigned char const*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            value = (value ^ bytes[i]) * 16777619u;
+        }
+        return value;
+    }
+
+    uint64_t getTime()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+}
+
+EventLog::EventLog()
+    : _records(BufferSize)
+{}
+
+EventLog::~EventLog()
+{
+    close();
+}
+
+bool EventLog::open(Config const& config)
+{
+    close();
+    _config = config;
+    if (config.segmentSize < static_cast<int>(sizeof(SegmentHeader) + sizeof(Record))) {
+        return false;
+    }
+
+    //continue after existing segments such that the log of a crashed run is preserved
+    int64_t index = 0;
+    auto const filenames = getSegmentFilenames(config.baseFilename);
+    if (!filenames.empty()) {
+        auto const& lastFilename = filenames.back();
+        auto const indexPos = lastFilename.size() - strlen(SegmentExtension) - IndexDigits;
+        index = std::stoll(lastFilename.substr(indexPos, IndexDigits)) + 1;
+    }
+    if (!startSegment(index)) {
+        return false;
+    }
+
+    _stopWriter = false;
+    _writer = std::thread([this] {
+        auto lastSync = std::chrono::steady_clock::now();
+        while (true) {
+            uint64_t numFlushRequests;
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(_writerMutex);
+                _writerCondition.wait_for(lock, std::chrono::milliseconds(WriteInterval), [this] {
+                    return _stopWriter || _numFlushRequests > _numFlushes;
+                });
+                numFlushRequests = _numFlushRequests;
+                stop = _stopWriter;
+            }
+
+            writeRecords();
+
+            auto const now = std::chrono::steady_clock::now();
+            if (stop || numFlushRequests > _numFlushes
+                || now - lastSync >= std::chrono::milliseconds(_config.syncInterval)) {
+                syncSegment();
+                lastSync = now;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_writerMutex);
+                _numFlushes = numFlushRequests;
+            }
+            _flushedCondition.notify_all();
+
+            if (stop) {
+                break;
+            }
+        }
+    });
+    _open = true;
+    return true;
+}
+
+void EventLog::close()
+{
+    if (!_writer.joinable()) {
+        return;
+    }
+    _open = false;
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        _stopWriter = true;
+    }
+    _writerCondition.notify_all();
+    _writer.join();
+    closeSegment();
+}
+
+bool EventLog::isOpen() const
+{
+    return _open.load(std::memory_order_relaxed);
+}
+
+void EventLog::logTimestep(int64_t timestep, double calcTime)
+{
+    _timestep.store(timestep, std::memory_order_relaxed);
+    if (!isOpen()) {
+        return;
+    }
+    Record record;
+    record.type = Type::Timestep;
+    record.timestep = timestep;
+    record.value = calcTime;
+    push(std::move(record));
+}
+
+void EventLog::logCounter(string const& name, double value)
+{
+    if (!isOpen()) {
+        return;
+    }
+    Record record;
+    record.type = Type::Counter;
+    record.key = getNameId(name);
+    record.value = value;
+    push(std::move(record));
+}
+
+void EventLog::logParameter(string const& name, double value)
+{
+    if (!isOpen()) {
+        return;
+    }
+    Record record;
+    record.type = Type::Parameter;
+    record.key = getNameId(name);
+    record.value = value;
+    push(std::move(record));
+}
+
+void EventLog::logJobEvent(JobEvent event, string const& jobId)
+{
+    if (!isOpen()) {
+        return;
+    }
+    Record record;
+    record.type = Type::Job;
+    record.key = static_cast<uint16_t>(event);
+    record.value = hash(jobId.data(), jobId.size());
+    push(std::move(record));
+}
+
+void EventLog::flush()
+{
+    if (!_writer.joinable()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_writerMutex);
+    auto const flushRequest = ++_numFlushRequests;
+    _writerCondition.notify_all();
+    _flushedCondition.wait(lock, [&] { return _numFlushes >= flushRequest; });
+}
+
+uint64_t EventLog::getNumDroppedRecords() const
+{
+    return _numDroppedRecords.load(std::memory_order_relaxed);
+}
+
+uint32_t EventLog::calcChecksum(Record const& record)
+{
+    auto result = hash(&record.time, sizeof(record.time));
+    result = hash(&record.timestep, sizeof(record.timestep), result);
+    result = hash(&record.type, sizeof(record.type), result);
+    result = hash(&record.key, sizeof(record.key), result);
+    result = hash(&record.value, sizeof(record.value), result);
+
+    //0 marks preallocated space
+    return result != 0 ? result : 1;
+}
+
+string EventLog::getSegmentFilename(string const& baseFilename, int64_t index)
+{
+    std::stringstream stream;
+    stream << baseFilename << "." << std::setw(IndexDigits) << std::setfill('0') << index << SegmentExtension;
+    return stream.str();
+}
+
+vector<string> EventLog::getSegmentFilenames(string const& baseFilename)
+{
+    namespace fs = std::filesystem;
+
+    vector<string> result;
+    auto const basePath = fs::path(baseFilename);
+    auto const directory = basePath.has_parent_path() ? basePath.parent_path() : fs::path(".");
+    auto const prefix = basePath.filename().string() + ".";
+
+    std::error_code error;
+    for (auto const& entry : fs::directory_iterator(directory, error)) {
+        auto const filename = entry.path().filename().string();
+        if (filename.size() != prefix.size() + IndexDigits + strlen(SegmentExtension)
+            || filename.compare(0, prefix.size(), prefix) != 0
+            || filename.compare(prefix.size() + IndexDigits, string::npos, SegmentExtension) != 0) {
+            continue;
+        }
+        auto const index = filename.substr(prefix.size(), IndexDigits);
+        if (std::all_of(index.begin(), index.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            result.emplace_back(getSegmentFilename(baseFilename, std::stoll(index)));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+uint16_t EventLog::getNameId(string const& name)
+{
+    std::lock_guard<std::mutex> lock(_namesMutex);
+    auto findResult = _nameIds.find(name);
+    if (findResult != _nameIds.end()) {
+        return findResult->second;
+    }
+    if (_nameIds.size() >= std::numeric_limits<uint16_t>::max()) {
+        return 0;
+    }
+    auto const id = static_cast<uint16_t>(_nameIds.size() + 1);
+    _nameIds.emplace(name, id);
+
+    //name records are pushed under the lock, hence they precede all records using the id
+    auto const numParts = (name.size() + sizeof(double) - 1) / sizeof(double);
+    for (size_t part = 0; part < numParts; ++part) {
+        Record record;
+        record.type = Type::Name;
+        record.key = id;
+        record.timestep = static_cast<int64_t>(part);
+        auto const partBegin = part * sizeof(double);
+        std::memcpy(&record.value, name.data() + partBegin, std::min(sizeof(double), name.size() - partBegin));
+        push(std::move(record));
+    }
+    return id;
+}
+
+void EventLog::push(Record&& record)
+{
+    record.time = getTime();
+    if (record.type != Type::Name && record.type != Type::Timestep) {
+        record.timestep = _timestep.load(std::memory_order_relaxed);
+    }
+    if (!_records.tryPush(std::move(record))) {
+        _numDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void EventLog::writeRecords()
+{
+    Record record;
+    while (_records.tryPop(record)) {
+        if (record.type == Type::Name) {
+            auto& nameRecords = _nameRecordsById[record.key];
+            if (record.timestep == 0) {
+                nameRecords.clear();
+            }
+            nameRecords.emplace_back(record);
+        }
+        writeRecord(record);
+    }
+}
+
+void EventLog::writeRecord(Record record)
+{
+    if (!_file) {
+        return;
+    }
+    if (_numSegmentRecords == _segmentCapacity) {
+        if (!startSegment(_segmentIndex + 1)) {
+            return;
+        }
+    }
+
+    //segment is too small for the names
+    if (_numSegmentRecords == _segmentCapacity) {
+        return;
+    }
+    record.checksum = calcChecksum(record);
+    if (std::fwrite(&record, sizeof(Record), 1, _file) == 1) {
+        ++_numSegmentRecords;
+    }
+}
+
+bool EventLog::startSegment(int64_t index)
+{
+    closeSegment();
+
+    auto const filename = getSegmentFilename(_config.baseFilename, index);
+    _file = std::fopen(filename.c_str(), "wb");
+    if (!_file) {
+        return false;
+    }
+    _segmentIndex = index;
+    _segmentCapacity = std::max<int64_t>(_config.segmentSize - static_cast<int64_t>(sizeof(SegmentHeader)), 0)
+        / sizeof(Record);
+    _numSegmentRecords = 0;
+
+    //space is allocated in advance such that writing records does not change the file size
+    SegmentHeader header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.recordSize = sizeof(Record);
+    header.index = index;
+    header.capacity = _segmentCapacity;
+    std::memset(header.reserved, 0, sizeof(header.reserved));
+    std::fwrite(&header, sizeof(SegmentHeader), 1, _file);
+
+    vector<char> zeros(PreallocationChunkSize, 0);
+    auto remainingSize = _segmentCapacity * sizeof(Record);
+    while (remainingSize > 0) {
+        auto const chunkSize = std::min<uint64_t>(remainingSize, zeros.size());
+        std::fwrite(zeros.data(), 1, chunkSize, _file);
+        remainingSize -= chunkSize;
+    }
+    syncSegment();
+    std::fseek(_file, sizeof(SegmentHeader), SEEK_SET);
+
+    if (_config.numSegments > 0 && index >= _config.numSegments) {
+        std::remove(getSegmentFilename(_config.baseFilename, index - _config.numSegments).c_str());
+    }
+
+    //names are repeated in each segment, the remaining space is used for records
+    for (auto const& [id, nameRecords] : _nameRecordsById) {
+        for (auto nameRecord : nameRecords) {
+            if (_numSegmentRecords == _segmentCapacity) {
+                return true;
+            }
+            nameRecord.checksum = calcChecksum(nameRecord);
+            std::fwrite(&nameRecord, sizeof(Record), 1, _file);
+            ++_numSegmentRecords;
+        }
+    }
+    return true;
+}
+
+void EventLog::syncSegment()
+{
+    if (!_file) {
+        return;
+    }
+    std::fflush(_file);
+#if defined(_WIN32)
+    _commit(_fileno(_file));
+#else
+    fsync(fileno(_file));
+#endif
+}
+
+void EventLog::closeSegment()
+{
+    if (!_file) {
+        return;
+    }
+    syncSegment();
+    std::fclose(_file);
+    _file = nullptr;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "Definitions.h"
+#include "DllExport.h"
+#include "MpscRingBuffer.h"
+
+/**
+ * Binary log of fixed-size records for long unattended runs, written alongside the text log. Records are collected
+ * in a lock-free buffer and written in batches by a background thread into preallocated segment files
+ * "<baseFilename>.<index>.evl". The current segment is synced periodically, a full segment is synced before the next
+ * one is started and only the most recent segments are kept. Hence a crash loses at most the unsynced tail of the
+ * current segment. Each segment starts with the names in use and can be read on its own, see EventLogReader.
+ */
+class BASE_EXPORT EventLog
+{
+public:
+    enum class Type : uint16_t
+    {
+        Name = 1,   //8 characters of a name in the value, the key is the name id and the timestep the part index
+        Timestep,   //value is the calculation time in milliseconds
+        Counter,    //key is the name id
+        Job,        //key is the job event, value is a 32 bit hash of the job id
+        Parameter,  //key is the name id
+    };
+
+    enum class JobEvent : uint16_t
+    {
+        Added,
+        Finished
+    };
+
+    struct Record
+    {
+        uint64_t time = 0;  //microseconds since epoch
+        int64_t timestep = 0;
+        Type type = Type::Name;
+        uint16_t key = 0;
+        uint32_t checksum = 0;  //invalid or unwritten records are detected by the reader
+        double value = 0;
+    };
+
+    struct SegmentHeader
+    {
+        char magic[8];
+        uint32_t version = 0;
+        uint32_t recordSize = 0;
+        int64_t index = 0;
+        uint64_t capacity = 0;     //number of records
+        char reserved[32];
+    };
+
+    struct Config
+    {
+        string baseFilename = "eventlog";
+        int segmentSize = 4 << 20;   //in bytes, including the header
+        int numSegments = 16;       //older segments are deleted
+        int syncInterval = 1000;    //in milliseconds
+    };
+
+    EventLog();
+    ~EventLog();
+
+    //starts a new segment after the existing ones, returns false if it cannot be written
+    bool open(Config const& config);
+    void close();
+    bool isOpen() const;
+
+    //may be called from any thread, records are dropped if the buffer is full
+    void logTimestep(int64_t timestep, double calcTime);
+    void logCounter(string const& name, double value);
+    void logParameter(string const& name, double value);
+    void logJobEvent(JobEvent event, string const& jobId);
+
+    //blocks until all records logged so far are written and synced
+    void flush();
+
+    uint64_t getNumDroppedRecords() const;
+
+    static uint32_t calcChecksum(Record const& record);
+    static string getSegmentFilename(string const& baseFilename, int64_t index);
+
+    //existing segment files ordered by index
+    static vector<string> getSegmentFilenames(string const& baseFilename);
+
+    static char const Magic[8];
+    static uint32_t constexpr Version = 1;
+
+private:
+    uint16_t getNameId(string const& name);
+    void push(Record&& record);
+
+    void writeRecords();
+    void writeRecord(Record record);
+    bool startSegment(int64_t index);
+    void syncSegment();
+    void closeSegment();
+
+    static int constexpr BufferSize = 1 << 16;
+    static int constexpr WriteInterval = 50;    //in milliseconds
+
+    Config _config;
+    std::atomic<bool> _open{false};
+    std::atomic<int64_t> _timestep{0};
+    std::atomic<uint64_t> _numDroppedRecords{0};
+    MpscRingBuffer<Record> _records;
+
+    std::mutex _namesMutex;
+    unordered_map<string, uint16_t> _nameIds;
+
+    //state of the writer thread
+    std::thread _writer;
+    std::mutex _writerMutex;
+    std::condition_variable _writerCondition;
+    std::condition_variable _flushedCondition;
+    bool _stopWriter = false;
+    uint64_t _numFlushRequests = 0;
+    uint64_t _numFlushes = 0;
+
+    std::FILE* _file = nullptr;
+    int64_t _segmentIndex = 0;
+    uint64_t _segmentCapacity = 0;
+    uint64_t _numSegmentRecords = 0;
+    map<uint16_t, vector<Record>> _nameRecordsById;     //repeated at the beginning of each segment
+};
+
+static_assert(sizeof(EventLog::Record) == 32, "records have a fixed size in the segment files");
+static_assert(sizeof(EventLog::SegmentHeader) == 64, "segment header has a fixed size");
@@ -0,0 +1,121 @@
+#include "EventLogReader.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+bool EventLogReader::read(string const& baseFilename, vector<Entry>& entries)
+{
+    auto result = true;
+    for (auto const& filename : EventLog::getSegmentFilenames(baseFilename)) {
+        result &= readSegment(filename, entries);
+    }
+    return result;
+}
+
+bool EventLogReader::readSegment(string const& filename, vector<Entry>& entries)
+{
+    std::ifstream stream(filename, std::ios_base::binary);
+    EventLog::SegmentHeader header;
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, EventLog::Magic, sizeof(EventLog::Magic)) != 0
+        || header.version != EventLog::Version || header.recordSize != sizeof(EventLog::Record)) {
+        return false;
+    }
+
+    //names are defined at the beginning of each segment
+    map<uint16_t, map<int64_t, string>> namePartsById;
+    auto getName = [&](uint16_t id) {
+        auto findResult = namePartsById.find(id);
+        if (findResult == namePartsById.end()) {
+            return "#" + std::to_string(id);
+        }
+        string result;
+        for (auto const& [index, part] : findResult->second) {
+            result += part;
+        }
+        return result;
+    };
+
+    EventLog::Record record;
+    for (uint64_t i = 0; i < header.capacity; ++i) {
+        if (!stream.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+            break;
+        }
+        if (record.checksum == 0 || record.checksum != EventLog::calcChecksum(record)) {
+            break;
+        }
+
+        if (record.type == EventLog::Type::Name) {
+            char text[sizeof(double) + 1] = {};
+            std::memcpy(text, &record.value, sizeof(double));
+            namePartsById[record.key][record.timestep] = text;
+            continue;
+        }
+
+        Entry entry;
+        entry.time = record.time;
+        entry.timestep = record.timestep;
+        entry.type = record.type;
+        entry.value = record.value;
+        switch (record.type) {
+        case EventLog::Type::Timestep:
+            entry.name = "timestep";
+            break;
+        case EventLog::Type::Counter:
+        case EventLog::Type::Parameter:
+            entry.name = getName(record.key);
+            break;
+        case EventLog::Type::Job:
+            entry.name = static_cast<EventLog::JobEvent>(record.key) == EventLog::JobEvent::Added ? "added" : "finished";
+            break;
+        default:
+            continue;
+        }
+        entries.emplace_back(entry);
+    }
+    return true;
+}
+
+void EventLogReader::writeCsv(std::ostream& stream, vector<Entry> const& entries)
+{
+    auto writeText = [&](string const& text) {
+        if (text.find_first_of(",\"\n") == string::npos) {
+            stream << text;
+            return;
+        }
+        stream << '"';
+        for (auto c : text) {
+            if (c == '"') {
+                stream << '"';
+            }
+            stream << c;
+        }
+        stream << '"';
+    };
+
+    stream << "time,timestep,type,name,value\n";
+    stream << std::setprecision(15);
+    for (auto const& entry : entries) {
+        stream << entry.time << "," << entry.timestep << "," << getTypeName(entry.type) << ",";
+        writeText(entry.name);
+        stream << "," << entry.value << "\n";
+    }
+}
+
+string EventLogReader::getTypeName(EventLog::Type type)
+{
+    switch (type) {
+    case EventLog::Type::Name:
+        return "name";
+    case EventLog::Type::Timestep:
+        return "timestep";
+    case EventLog::Type::Counter:
+        return "counter";
+    case EventLog::Type::Job:
+        return "job";
+    case EventLog::Type::Parameter:
+        return "parameter";
+    }
+    return "unknown";
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <ostream>
+
+#include "Definitions.h"
+#include "DllExport.h"
+#include "EventLog.h"
+
+/**
+ * Reads the segment files written by EventLog. Reading a segment stops at its first invalid record, which is where
+ * the segment ends or a crash cut it off.
+ */
+class BASE_EXPORT EventLogReader
+{
+public:
+    struct Entry
+    {
+        uint64_t time = 0;  //microseconds since epoch
+        int64_t timestep = 0;
+        EventLog::Type type = EventLog::Type::Timestep;
+        string name;
+        double value = 0;
+    };
+
+    //reads all segments in index order, returns false if a segment cannot be read
+    static bool read(string const& baseFilename, vector<Entry>& entries);
+    static bool readSegment(string const& filename, vector<Entry>& entries);
+
+    static void writeCsv(std::ostream& stream, vector<Entry> const& entries);
+
+    static string getTypeName(EventLog::Type type);
+};
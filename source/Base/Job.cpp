@@ -1,13 +1,62 @@
-#pragma once
-
 #include "Job.h"
 
+#include "Worker.h"
+
 Job::Job(string id, QObject* parent)
-    : QObject(parent), _id(id) 
+    : QObject(parent), _id(id)
 {
 }
 
+Job::~Job()
+{
+    for (auto const& continuation : _continuations) {
+        delete continuation;
+    }
+}
+
 string const& Job::getId() const
 {
     return _id;
-}
\ No newline at end of file
+}
+
+void Job::addDependency(string const& id)
+{
+    _dependencies.emplace_back(id);
+}
+
+vector<string> const& Job::getDependencies() const
+{
+    return _dependencies;
+}
+
+void Job::addContinuation(Job* job)
+{
+    _continuations.emplace_back(job);
+}
+
+string Job::getConflictKey() const
+{
+    return string();
+}
+
+bool Job::isRunningConcurrently() const
+{
+    return _runningConcurrently;
+}
+
+void Job::wakeUp()
+{
+    if (_worker) {
+        _worker->scheduleProcessing();
+    }
+}
+
+void Job::runConcurrently(std::function<void()> const& stage)
+{
+    if (!_worker) {
+        stage();
+        return;
+    }
+    _runningConcurrently = true;
+    _worker->runConcurrently(this, stage);
+}
@@ -1,20 +1,53 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+
 #include "Definitions.h"
 
+/**
+ * Unit of work which is driven by a _Worker. The worker calls process() whenever the job can make progress:
+ * after it has been added, after wakeUp() has been called (e.g. when a requested result has arrived) and after a
+ * stage started with runConcurrently() has completed.
+ */
 class BASE_EXPORT Job : public QObject
 {
     Q_OBJECT
 public:
     Job(string id, QObject* parent);
-    virtual ~Job() = default;
+    virtual ~Job();
 
     string const& getId() const;
 
+    //job is not processed before all jobs with the given id in the same worker have finished
+    void addDependency(string const& id);
+    vector<string> const& getDependencies() const;
+
+    //job is added to the worker when this job has finished, ownership is transferred
+    void addContinuation(Job* job);
+
     virtual void process() = 0;
     virtual bool isFinished() const = 0;
-    virtual bool isBlocking() const = 0;
+
+    //jobs with the same non-empty conflict key are processed one after another in the order of their addition,
+    //all other jobs concurrently
+    virtual string getConflictKey() const;
+
+    bool isRunningConcurrently() const;
+
+protected:
+    void wakeUp();
+
+    //executes a CPU-bound stage on the thread pool of the worker, process() is called again after completion
+    void runConcurrently(std::function<void()> const& stage);
 
 private:
+    friend class _Worker;
+
     string _id;
+    vector<string> _dependencies;
+    vector<Job*> _continuations;
+
+    _Worker* _worker = nullptr;
+    std::atomic<bool> _runningConcurrently{false};
 };
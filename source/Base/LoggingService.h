@@ -12,8 +12,17 @@ class LoggingCallBack
 {
 public:
     virtual void newLogMessage(Priority priority, std::string const& message) = 0;
+
+    //messages with lower priority are not delivered to this callback
+    virtual Priority getMinPriority() const { return Priority::Unimportant; }
+
+    //called after each batch of delivered messages
+    virtual void flush() {}
 };
 
+/**
+ * Messages are delivered to the callbacks asynchronously on a background thread.
+ */
 class LoggingService
 {
 public:
@@ -21,6 +30,9 @@ public:
 
     virtual void logMessage(Priority priority, std::string const& message) = 0;
 
+    //blocks until all messages logged so far are delivered to the callbacks
+    virtual void flush() = 0;
+
     virtual void registerCallBack(LoggingCallBack* callback) = 0;
     virtual void unregisterCallBack(LoggingCallBack* callback) = 0;
 };
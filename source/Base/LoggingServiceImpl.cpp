@@ -2,36 +2,193 @@
 
 #include <iostream>
 #include <iomanip>
-#include <ctime>
 #include <sstream>
 #include <algorithm>
 
+namespace
+{
+    //upper bound for the latency if a wake-up is missed
+    auto const MaxWaitTime = std::chrono::milliseconds(100);
+}
+
+LoggingServiceImpl::LoggingServiceImpl()
+    : _records(BufferSize)
+    , _steadyStart(std::chrono::steady_clock::now())
+    , _systemStart(std::chrono::system_clock::now())
+{}
+
+LoggingServiceImpl::~LoggingServiceImpl()
+{
+    if (_consumer.joinable()) {
+        stopConsumer();
+    }
+    deliverRecords();
+}
+
 void LoggingServiceImpl::logMessage(Priority priority, std::string const& message)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    //filter before anything is copied or formatted
+    if (static_cast<int>(priority) < _minPriority.load(std::memory_order_relaxed)) {
+        return;
+    }
 
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
+    Record record{priority, std::chrono::steady_clock::now(), message};
+    while (!_records.tryPush(std::move(record))) {
 
-    std::stringstream stream;
-    stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << message;
+        //buffer is full: wait for the consumer unless it is the consumer itself or there is none
+        if (std::this_thread::get_id() == _consumerId.load() || _minPriority.load() == NoCallBacks) {
+            return;
+        }
+        wakeUpConsumer();
+        std::this_thread::yield();
+    }
 
-    auto enrichedMessage = stream.str();
-    for (auto const& callback : _callbacks) {
-        callback->newLogMessage(priority, enrichedMessage);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_consumerWaiting.exchange(false)) {
+        wakeUpConsumer();
+    }
+}
+
+void LoggingServiceImpl::flush()
+{
+    if (_minPriority.load() == NoCallBacks || std::this_thread::get_id() == _consumerId.load()) {
+        return;
     }
+    auto const numRecords = _records.getPushPosition();
+    std::unique_lock<std::mutex> lock(_wakeUpMutex);
+    _wakeUpCondition.notify_one();
+    _deliveredCondition.wait(lock, [&] { return _numDeliveredRecords.load() >= numRecords || _stopConsumer; });
 }
 
+//registering and unregistering is expected to happen on the same thread
 void LoggingServiceImpl::registerCallBack(LoggingCallBack* callback)
 {
-    _callbacks.emplace_back(callback);
+    {
+        std::lock_guard<std::mutex> lock(_callbacksMutex);
+        _callbacks.emplace_back(callback);
+        updateMinPriority();
+    }
+    if (!_consumer.joinable()) {
+        startConsumer();
+    }
 }
 
 void LoggingServiceImpl::unregisterCallBack(LoggingCallBack* callback)
 {
-    auto end = std::remove_if(_callbacks.begin(), _callbacks.end(), [&](auto const& callback_) {
-        return callback_ == callback;
-    });
+    flush();
+
+    bool noCallBacks;
+    {
+        std::lock_guard<std::mutex> lock(_callbacksMutex);
+        auto end = std::remove_if(_callbacks.begin(), _callbacks.end(), [&](auto const& callback_) {
+            return callback_ == callback;
+        });
+
+        _callbacks.erase(end, _callbacks.end());
+        updateMinPriority();
+        noCallBacks = _callbacks.empty();
+    }
+    if (noCallBacks && _consumer.joinable()) {
+        stopConsumer();
+    }
+}
+
+void LoggingServiceImpl::updateMinPriority()
+{
+    auto result = NoCallBacks;
+    for (auto const& callback : _callbacks) {
+        result = std::min(result, static_cast<int>(callback->getMinPriority()));
+    }
+    _minPriority.store(result);
+}
 
-    _callbacks.erase(end, _callbacks.end());
+void LoggingServiceImpl::startConsumer()
+{
+    _consumer = std::thread([this] { processRecords(); });
+}
+
+void LoggingServiceImpl::stopConsumer()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeUpMutex);
+        _stopConsumer = true;
+    }
+    _wakeUpCondition.notify_one();
+    _deliveredCondition.notify_all();
+    _consumer.join();
+
+    std::lock_guard<std::mutex> lock(_wakeUpMutex);
+    _stopConsumer = false;
+    _consumerId.store(std::thread::id());
+}
+
+void LoggingServiceImpl::wakeUpConsumer()
+{
+    std::lock_guard<std::mutex> lock(_wakeUpMutex);
+    _wakeUpCondition.notify_one();
+}
+
+void LoggingServiceImpl::processRecords()
+{
+    _consumerId.store(std::this_thread::get_id());
+    auto stop = false;
+    while (!stop) {
+        {
+            std::unique_lock<std::mutex> lock(_wakeUpMutex);
+            _consumerWaiting.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            _wakeUpCondition.wait_for(lock, MaxWaitTime, [this] { return _stopConsumer || !_records.isEmpty(); });
+            _consumerWaiting.store(false);
+            stop = _stopConsumer;
+        }
+        deliverRecords();
+    }
+}
+
+void LoggingServiceImpl::deliverRecords()
+{
+    std::lock_guard<std::mutex> lock(_callbacksMutex);
+
+    size_t numRecords = 0;
+    Record record;
+    std::string enrichedMessage;
+    while (_records.tryPop(record)) {
+        enrichedMessage = getTimeText(record.time);
+        enrichedMessage += ": ";
+        enrichedMessage += record.message;
+        for (auto const& callback : _callbacks) {
+            if (record.priority >= callback->getMinPriority()) {
+                callback->newLogMessage(record.priority, enrichedMessage);
+            }
+        }
+        ++numRecords;
+    }
+    if (0 == numRecords) {
+        return;
+    }
+    for (auto const& callback : _callbacks) {
+        callback->flush();
+    }
+
+    _numDeliveredRecords.fetch_add(numRecords);
+    {
+        std::lock_guard<std::mutex> wakeUpLock(_wakeUpMutex);
+    }
+    _deliveredCondition.notify_all();
+}
+
+std::string const& LoggingServiceImpl::getTimeText(std::chrono::steady_clock::time_point time)
+{
+    auto const systemTime =
+        _systemStart + std::chrono::duration_cast<std::chrono::system_clock::duration>(time - _steadyStart);
+    auto const seconds = std::chrono::system_clock::to_time_t(systemTime);
+    if (seconds != _lastFormattedSeconds || _lastTimeText.empty()) {
+        auto tm = *std::localtime(&seconds);
+
+        std::stringstream stream;
+        stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S");
+        _lastTimeText = stream.str();
+        _lastFormattedSeconds = seconds;
+    }
+    return _lastTimeText;
 }
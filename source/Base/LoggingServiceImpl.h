@@ -1,20 +1,65 @@
 #pragma once
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <condition_variable>
+#include <thread>
 
 #include "LoggingService.h"
+#include "MpscRingBuffer.h"
 
 class LoggingServiceImpl : public LoggingService
 {
 public:
-    virtual ~LoggingServiceImpl() = default;
+    LoggingServiceImpl();
+    virtual ~LoggingServiceImpl();
 
     void logMessage(Priority priority, std::string const& message) override;
+    void flush() override;
 
     void registerCallBack(LoggingCallBack* callback) override;
     void unregisterCallBack(LoggingCallBack* callback) override;
 
 private:
+    struct Record
+    {
+        Priority priority = Priority::Unimportant;
+        std::chrono::steady_clock::time_point time;
+        std::string message;
+    };
+
+    void updateMinPriority();
+    void startConsumer();
+    void stopConsumer();
+    void wakeUpConsumer();
+    void processRecords();
+    void deliverRecords();
+    std::string const& getTimeText(std::chrono::steady_clock::time_point time);
+
+    static int const BufferSize = 4096;
+    static int const NoCallBacks = static_cast<int>(Priority::Important) + 1;
+
+    MpscRingBuffer<Record> _records;
+    std::atomic<int> _minPriority{NoCallBacks};
+
+    std::mutex _callbacksMutex;
     std::vector<LoggingCallBack*> _callbacks;
-    std::mutex _mutex;
+
+    //consumer thread, sleeps on _wakeUpCondition if there are no records
+    std::thread _consumer;
+    std::atomic<std::thread::id> _consumerId;
+    std::mutex _wakeUpMutex;
+    std::condition_variable _wakeUpCondition;
+    std::condition_variable _deliveredCondition;
+    std::atomic<bool> _consumerWaiting{false};
+    bool _stopConsumer = false;
+    std::atomic<size_t> _numDeliveredRecords{0};
+
+    //steady timestamps of the records are converted to local time by the consumer
+    std::chrono::steady_clock::time_point _steadyStart;
+    std::chrono::system_clock::time_point _systemStart;
+    std::time_t _lastFormattedSeconds = 0;
+    std::string _lastTimeText;
 };
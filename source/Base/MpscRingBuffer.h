@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Bounded lock-free queue for many producer threads and a single consumer thread. Each slot carries a sequence
+ * number which tells producers and the consumer whether the slot is free or filled, so that neither side needs a
+ * lock. Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class MpscRingBuffer
+{
+public:
+    explicit MpscRingBuffer(size_t capacity)
+    {
+        size_t roundedCapacity = 2;
+        while (roundedCapacity < capacity) {
+            roundedCapacity *= 2;
+        }
+        _mask = roundedCapacity - 1;
+        _slots = std::make_unique<Slot[]>(roundedCapacity);
+        for (size_t index = 0; index < roundedCapacity; ++index) {
+            _slots[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    //returns false if the buffer is full, may be called from any thread
+    bool tryPush(T&& value)
+    {
+        auto position = _pushPosition.load(std::memory_order_relaxed);
+        while (true) {
+            auto& slot = _slots[position & _mask];
+            auto const sequence = slot.sequence.load(std::memory_order_acquire);
+            auto const difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = _pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //returns false if the next element is not available yet, must only be called from the consumer thread
+    bool tryPop(T& value)
+    {
+        auto& slot = _slots[_popPosition & _mask];
+        if (slot.sequence.load(std::memory_order_acquire) != _popPosition + 1) {
+            return false;
+        }
+        value = std::move(slot.value);
+        slot.sequence.store(_popPosition + _mask + 1, std::memory_order_release);
+        ++_popPosition;
+        return true;
+    }
+
+    //must only be called from the consumer thread
+    bool isEmpty() const
+    {
+        return _slots[_popPosition & _mask].sequence.load(std::memory_order_acquire) != _popPosition + 1;
+    }
+
+    //number of started pushes, elements with a smaller position have been or will be pushed
+    size_t getPushPosition() const { return _pushPosition.load(std::memory_order_acquire); }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    size_t _mask = 0;
+    alignas(64) std::atomic<size_t> _pushPosition{0};
+    alignas(64) size_t _popPosition = 0;
+};
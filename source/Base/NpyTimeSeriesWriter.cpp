@@ -0,0 +1,117 @@
+#include "NpyTimeSeriesWriter.h"
+
+#include <sstream>
+
+namespace
+{
+    char const Magic[] = "\x93NUMPY";
+    int const MagicLength = 6;
+
+    //the header has a fixed length such that the frame count can be rewritten in place, it is a multiple of 64 as
+    //recommended by the format specification
+    int const TotalHeaderLength = 256;
+    int const PreambleLength = MagicLength + 2 + 2;
+}
+
+NpyTimeSeriesWriter::~NpyTimeSeriesWriter()
+{
+    close();
+}
+
+bool NpyTimeSeriesWriter::open(string const& filename, Type type, vector<int> const& frameShape)
+{
+    close();
+    _type = type;
+    _frameShape = frameShape;
+    _numFrames = 0;
+
+    _stream.open(filename, std::ios_base::in | std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!_stream.is_open()) {
+        return false;
+    }
+    if (!writeHeader()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void NpyTimeSeriesWriter::close()
+{
+    if (_stream.is_open()) {
+        _stream.close();
+    }
+}
+
+bool NpyTimeSeriesWriter::isOpen() const
+{
+    return _stream.is_open();
+}
+
+bool NpyTimeSeriesWriter::appendFrame(void const* data)
+{
+    if (!_stream.is_open()) {
+        return false;
+    }
+    auto const frameBytes = static_cast<std::streamsize>(getFrameSize()) * getElementSize(_type);
+    _stream.seekp(0, std::ios_base::end);
+    _stream.write(static_cast<char const*>(data), frameBytes);
+    if (_stream.fail()) {
+        return false;
+    }
+    ++_numFrames;
+    return writeHeader();
+}
+
+int NpyTimeSeriesWriter::getNumFrames() const
+{
+    return _numFrames;
+}
+
+int NpyTimeSeriesWriter::getFrameSize() const
+{
+    auto result = 1;
+    for (auto const& size : _frameShape) {
+        result *= size;
+    }
+    return result;
+}
+
+int NpyTimeSeriesWriter::getElementSize(Type type)
+{
+    switch (type) {
+    case Type::Float32:
+        return 4;
+    case Type::Int32:
+        return 4;
+    }
+    return 0;
+}
+
+bool NpyTimeSeriesWriter::writeHeader()
+{
+    std::stringstream dict;
+    dict << "{'descr': '" << (_type == Type::Float32 ? "<f4" : "<i4") << "', 'fortran_order': False, 'shape': ("
+         << _numFrames << ",";
+    for (auto const& size : _frameShape) {
+        dict << " " << size << ",";
+    }
+    dict << "), }";
+
+    auto header = dict.str();
+    auto const headerLength = TotalHeaderLength - PreambleLength;
+    if (static_cast<int>(header.size()) + 1 > headerLength) {
+        return false;
+    }
+    header.append(headerLength - header.size() - 1, ' ');
+    header.push_back('\n');
+
+    char const preamble[PreambleLength - MagicLength] = {
+        1, 0, static_cast<char>(headerLength & 0xff), static_cast<char>((headerLength >> 8) & 0xff)};
+    _stream.seekp(0, std::ios_base::beg);
+    _stream.write(Magic, MagicLength);
+    _stream.write(preamble, sizeof(preamble));
+    _stream.write(header.data(), header.size());
+    _stream.flush();
+    return !_stream.fail();
+}
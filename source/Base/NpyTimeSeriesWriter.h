@@ -0,0 +1,45 @@
+#pragma once
+
+#include <fstream>
+
+#include "Definitions.h"
+#include "DllExport.h"
+
+/**
+ * Appends frames of equal shape to a file in NumPy's .npy format (version 1.0). The leading dimension counts the
+ * frames and is rewritten in the header after each append, so the file is a valid array at any time and can be
+ * memory-mapped by downstream tools, e.g. with numpy.load(filename, mmap_mode='r'). Data is written in host byte
+ * order, which is expected to be little-endian.
+ */
+class BASE_EXPORT NpyTimeSeriesWriter
+{
+public:
+    enum class Type
+    {
+        Float32,
+        Int32
+    };
+
+    ~NpyTimeSeriesWriter();
+
+    //creates or truncates filename, returns false if the file cannot be written
+    bool open(string const& filename, Type type, vector<int> const& frameShape);
+    void close();
+    bool isOpen() const;
+
+    //data must contain as many elements as a frame, returns false on write errors
+    bool appendFrame(void const* data);
+
+    int getNumFrames() const;
+    int getFrameSize() const;   //in elements
+
+    static int getElementSize(Type type);
+
+private:
+    bool writeHeader();
+
+    std::fstream _stream;
+    Type _type = Type::Float32;
+    vector<int> _frameShape;
+    int _numFrames = 0;
+};
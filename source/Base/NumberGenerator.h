@@ -2,6 +2,10 @@
 
 #include "Definitions.h"
 
+/**
+ * Random numbers are taken from a stream of a counter-based generator (see Philox.h) which is determined by seed
+ * and thread id. Equal seeds and thread ids give equal sequences, different thread ids give independent streams.
+ */
 class NumberGenerator
 	: public QObject
 {
@@ -10,7 +14,10 @@ public:
 	NumberGenerator(QObject* parent = nullptr) : QObject(parent) {}
 	virtual ~NumberGenerator() = default;
 
-	virtual void init(uint32_t arraySize = 1323781, uint16_t threadId = 0) = 0;
+	//a random seed is chosen if none is given
+	virtual void init(uint16_t threadId = 0, optional<uint64_t> seed = boost::none) = 0;
+	virtual uint64_t getSeed() const = 0;
+	virtual void discard(uint64_t count) = 0;	//skips count numbers of the stream
 
 	virtual uint32_t getRandomInt() = 0;
 	virtual uint32_t getRandomInt(uint32_t range) = 0;
@@ -19,5 +26,10 @@ public:
     virtual double getRandomReal(double min, double max) = 0;
 	virtual QByteArray getRandomArray(int length) = 0;
 
+	//bulk versions fill the whole vector with consecutive numbers of the stream
+	virtual void fillRandomInts(vector<uint32_t>& values, uint32_t min, uint32_t max) = 0;
+	virtual void fillRandomReals(vector<double>& values, double min, double max) = 0;
+
 	virtual uint64_t getId() = 0;
+	virtual uint64_t getIds(uint32_t count) = 0;	//reserves a block of ids and returns the first one
 };
@@ -1,69 +1,96 @@
-#include <sstream>
-#include <thread>
-
 #include <QRandomGenerator>
 
+#include "Parallel.h"
 #include "NumberGeneratorImpl.h"
 
 namespace
 {
-    double const RandMax = 4294967296.0;
+    //number of values in [min, max], wrapping around as unsigned arithmetic
+    uint64_t getRange(uint32_t min, uint32_t max)
+    {
+        return static_cast<uint64_t>(max - min) + 1;
+    }
 }
 
 NumberGeneratorImpl::NumberGeneratorImpl(QObject * parent)
 	: NumberGenerator(parent)
+	, _block(Philox::generate(_seed, _stream, 0))
 {
 }
 
-void NumberGeneratorImpl::init(uint32_t arraySize, uint16_t threadId)
+void NumberGeneratorImpl::init(uint16_t threadId, optional<uint64_t> seed)
 {
 	_threadId = static_cast<uint64_t>(threadId) << 48;
-	_arrayOfRandomNumbers.clear();
 	_runningNumber = 0;
-	for (uint32_t i = 0; i < arraySize; ++i) {
-        _arrayOfRandomNumbers.push_back(QRandomGenerator::global()->generate());
-	}
+
+	_seed = seed ? *seed : QRandomGenerator::global()->generate64();
+	_stream = threadId;
+	_position = 0;
+	_blockIndex = 0;
+	_block = Philox::generate(_seed, _stream, 0);
 }
 
-uint32_t NumberGeneratorImpl::getRandomInt()
+uint64_t NumberGeneratorImpl::getSeed() const
 {
-	return getNumberFromArray();
+	return _seed;
 }
 
-uint32_t NumberGeneratorImpl::getRandomInt(uint32_t range)
+void NumberGeneratorImpl::discard(uint64_t count)
 {
-	return getNumberFromArray() % range;
+	_position += count;
 }
 
-uint32_t NumberGeneratorImpl::getRandomInt(uint32_t min, uint32_t max)
+uint32_t NumberGeneratorImpl::getRandomInt()
 {
-    auto delta = max - min + 1;
-    return min + (getNumberFromArray() % delta);
+	return getNextNumber();
 }
 
-uint32_t NumberGeneratorImpl::getLargeRandomInt(uint32_t range)
+uint32_t NumberGeneratorImpl::getRandomInt(uint32_t range)
+{
+	return Philox::toRange(getNextNumber(), range);
+}
+
+uint32_t NumberGeneratorImpl::getRandomInt(uint32_t min, uint32_t max)
 {
-	return getNumberFromArray() % (range + 1);
+    return min + Philox::toRange(getNextNumber(), getRange(min, max));
 }
 
 double NumberGeneratorImpl::getRandomReal(double min, double max)
 {
-	return static_cast<double>(getLargeRandomInt((max - min) * 1000) / 1000.0 + min);
+	return min + (max - min) * getRandomReal();
 }
 
 double NumberGeneratorImpl::getRandomReal()
 {
-    return static_cast<double>(getNumberFromArray()) / RandMax;
+    return Philox::toUnitInterval(getNextNumber());
 }
 
 QByteArray NumberGeneratorImpl::getRandomArray(int length)
 {
-	QByteArray bytes;
-	for (int i = 0; i < length; ++i) {
-		bytes[i] =getRandomInt(256);
-	}
+	QByteArray result(length, 0);
+	auto data = result.data();
+	forEachNextNumber((length + 3) / 4, [&](int index, uint32_t number) {
+		for (int byteIndex = index * 4; byteIndex < std::min(length, index * 4 + 4); ++byteIndex) {
+			data[byteIndex] = static_cast<char>(number);
+			number >>= 8;
+		}
+	});
+	return result;
+}
+
+void NumberGeneratorImpl::fillRandomInts(vector<uint32_t>& values, uint32_t min, uint32_t max)
+{
+	auto const range = getRange(min, max);
+	forEachNextNumber(static_cast<int>(values.size()), [&](int index, uint32_t number) {
+		values[index] = min + Philox::toRange(number, range);
+	});
+}
 
-	return std::move(bytes);
+void NumberGeneratorImpl::fillRandomReals(vector<double>& values, double min, double max)
+{
+	forEachNextNumber(static_cast<int>(values.size()), [&](int index, uint32_t number) {
+		values[index] = min + (max - min) * Philox::toUnitInterval(number);
+	});
 }
 
 uint64_t NumberGeneratorImpl::getId()
@@ -71,8 +98,36 @@ uint64_t NumberGeneratorImpl::getId()
 	return _threadId | ++_runningNumber;
 }
 
-uint32_t NumberGeneratorImpl::getNumberFromArray()
+uint64_t NumberGeneratorImpl::getIds(uint32_t count)
+{
+	auto result = _threadId | (_runningNumber + 1);
+	_runningNumber += count;
+	return result;
+}
+
+uint32_t NumberGeneratorImpl::getNextNumber()
+{
+	auto const blockIndex = _position / 4;
+	if (blockIndex != _blockIndex) {
+		_block = Philox::generate(_seed, _stream, blockIndex);
+		_blockIndex = blockIndex;
+	}
+	return _block.values[_position++ % 4];
+}
+
+template <typename Func>
+void NumberGeneratorImpl::forEachNextNumber(int count, Func const& func)
 {
-	_index = (_index + 1) % _arrayOfRandomNumbers.size();
-	return _arrayOfRandomNumbers[_index];
+	auto const startPosition = _position;
+	Parallel::forEachChunk(0, count, [&](int, int chunkBegin, int chunkEnd) {
+		auto position = startPosition + chunkBegin;
+		auto block = Philox::generate(_seed, _stream, position / 4);
+		for (int index = chunkBegin; index < chunkEnd; ++index, ++position) {
+			if (index > chunkBegin && position % 4 == 0) {
+				block = Philox::generate(_seed, _stream, position / 4);
+			}
+			func(index, block.values[position % 4]);
+		}
+	});
+	discard(count);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "NumberGenerator.h"
+#include "Philox.h"
 
 class NumberGeneratorImpl
 	: public NumberGenerator
@@ -9,7 +10,9 @@ public:
 	NumberGeneratorImpl(QObject* parent = nullptr);
 	virtual ~NumberGeneratorImpl() = default;
 
-	virtual void init(uint32_t arraySize, uint16_t threadId) override;
+	virtual void init(uint16_t threadId, optional<uint64_t> seed) override;
+	virtual uint64_t getSeed() const override;
+	virtual void discard(uint64_t count) override;
 
 	virtual uint32_t getRandomInt() override;
 	virtual uint32_t getRandomInt(uint32_t range) override;
@@ -18,15 +21,25 @@ public:
     virtual double getRandomReal(double min, double max) override;
 	virtual QByteArray getRandomArray(int length) override;
 
+	virtual void fillRandomInts(vector<uint32_t>& values, uint32_t min, uint32_t max) override;
+	virtual void fillRandomReals(vector<double>& values, double min, double max) override;
+
 	virtual uint64_t getId() override;
+	virtual uint64_t getIds(uint32_t count) override;
 
 private:
-    uint32_t getLargeRandomInt(uint32_t range);
-    quint32 getNumberFromArray();
+    uint32_t getNextNumber();
+
+    //calls func(index, number) in parallel for the next count numbers of the stream
+    template <typename Func>
+    void forEachNextNumber(int count, Func const& func);
+
+	uint64_t _seed = 0;
+	uint32_t _stream = 0;
+	uint64_t _position = 0;
+	uint64_t _blockIndex = 0;
+	Philox::Block _block;
 
-	int _index = 0;
-	vector<uint32_t> _arrayOfRandomNumbers;
 	uint64_t _runningNumber = 0;
 	uint64_t _threadId = 0;
 };
-
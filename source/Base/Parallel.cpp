@@ -0,0 +1,19 @@
+#include "Parallel.h"
+
+#include <atomic>
+
+namespace
+{
+    std::atomic<int> numThreadsLimit(0);
+}
+
+int Parallel::getNumThreads()
+{
+    auto const limit = numThreadsLimit.load(std::memory_order_relaxed);
+    return limit > 0 ? limit : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void Parallel::setNumThreads(int value)
+{
+    numThreadsLimit.store(std::max(value, 0), std::memory_order_relaxed);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "DllExport.h"
+
+/**
+ * Helper for data-parallel loops on the host. The index range is split into at most one contiguous chunk per
+ * hardware thread. Ranges below the grain size are processed on the calling thread. Exceptions thrown inside the
+ * loop body are rethrown on the calling thread.
+ */
+class BASE_EXPORT Parallel
+{
+public:
+    static int const DefaultGrainSize = 1024;
+
+    static int getNumThreads();
+
+    //limits the number of threads for all loops, 0 restores one thread per hardware thread
+    static void setNumThreads(int value);
+
+    static int getNumChunks(int size, int grainSize = DefaultGrainSize)
+    {
+        if (size <= 0) {
+            return 0;
+        }
+        grainSize = std::max(1, grainSize);
+        return std::max(1, std::min(getNumThreads(), (size + grainSize - 1) / grainSize));
+    }
+
+    //func(int chunkIndex, int chunkBegin, int chunkEnd) is called for getNumChunks(end - begin, grainSize) chunks
+    template <typename Func>
+    static void forEachChunk(int begin, int end, Func const& func, int grainSize = DefaultGrainSize)
+    {
+        auto const size = end - begin;
+        auto const numChunks = getNumChunks(size, grainSize);
+        if (numChunks == 0) {
+            return;
+        }
+        if (numChunks == 1) {
+            func(0, begin, end);
+            return;
+        }
+
+        auto const chunkSize = (size + numChunks - 1) / numChunks;
+        std::vector<std::exception_ptr> exceptions(numChunks);
+        auto processChunk = [&](int chunkIndex) {
+            try {
+                auto const chunkBegin = begin + chunkIndex * chunkSize;
+                auto const chunkEnd = std::min(end, chunkBegin + chunkSize);
+                if (chunkBegin < chunkEnd) {
+                    func(chunkIndex, chunkBegin, chunkEnd);
+                }
+            } catch (...) {
+                exceptions[chunkIndex] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(numChunks - 1);
+        for (int chunkIndex = 1; chunkIndex < numChunks; ++chunkIndex) {
+            threads.emplace_back(processChunk, chunkIndex);
+        }
+        processChunk(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto const& exception : exceptions) {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+
+    //func(int index) is called for each index in [begin, end)
+    template <typename Func>
+    static void forEach(int begin, int end, Func const& func, int grainSize = DefaultGrainSize)
+    {
+        forEachChunk(
+            begin,
+            end,
+            [&func](int, int chunkBegin, int chunkEnd) {
+                for (int index = chunkBegin; index < chunkEnd; ++index) {
+                    func(index);
+                }
+            },
+            grainSize);
+    }
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__CUDACC__)
+#define PHILOX_FUNCTION __host__ __device__ __inline__
+#else
+#define PHILOX_FUNCTION inline
+#endif
+
+/**
+ * Counter-based random number generator Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+ * A block index is mapped to four 32 bit values without any state, so every position of a stream can be computed
+ * directly and in parallel. NumberGeneratorImpl and CudaNumberGenerator use it for the same sequence of values:
+ * the value at position i of a stream is generate(seed, stream, i / 4).values[i % 4]. Both map the values to ranges
+ * by toRange and toUnitInterval such that they also agree on integers and reals.
+ */
+struct Philox
+{
+    struct Block
+    {
+        uint32_t values[4];
+    };
+
+    PHILOX_FUNCTION static Block generate(uint64_t seed, uint32_t stream, uint64_t blockIndex)
+    {
+        return generate(
+            {static_cast<uint32_t>(blockIndex), static_cast<uint32_t>(blockIndex >> 32), stream, 0},
+            static_cast<uint32_t>(seed),
+            static_cast<uint32_t>(seed >> 32));
+    }
+
+    PHILOX_FUNCTION static Block generate(Block counter, uint32_t key0, uint32_t key1)
+    {
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                key0 += 0x9E3779B9;
+                key1 += 0xBB67AE85;
+            }
+            auto const product0 = static_cast<uint64_t>(0xD2511F53) * counter.values[0];
+            auto const product1 = static_cast<uint64_t>(0xCD9E8D57) * counter.values[2];
+            counter = {
+                static_cast<uint32_t>(product1 >> 32) ^ counter.values[1] ^ key0,
+                static_cast<uint32_t>(product1),
+                static_cast<uint32_t>(product0 >> 32) ^ counter.values[3] ^ key1,
+                static_cast<uint32_t>(product0)};
+        }
+        return counter;
+    }
+
+    //maps a value to [0, range) by multiplication, range must not exceed 2^32
+    PHILOX_FUNCTION static uint32_t toRange(uint32_t value, uint64_t range)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(value) * range) >> 32);
+    }
+
+    //maps a value to [0, 1) in steps of 2^-24, which are exact in float precision
+    PHILOX_FUNCTION static float toUnitInterval(uint32_t value)
+    {
+        return static_cast<float>(value >> 8) / 16777216.0f;
+    }
+};
@@ -1,5 +1,28 @@
 #include "Worker.h"
 
+#include <algorithm>
+#include <unordered_set>
+
+#include <QThreadPool>
+
+#include "EventLog.h"
+#include "ServiceLocator.h"
+
+_Worker::_Worker(QObject* parent)
+    : QObject(parent)
+    , _threadPool(new QThreadPool(this))
+    , _eventLog(ServiceLocator::getInstance().getService<EventLog>())
+{
+}
+
+_Worker::~_Worker()
+{
+    _threadPool->waitForDone();
+    for (auto const& job : _jobs) {
+        delete job;
+    }
+}
+
 bool _Worker::contains(string const& id)
 {
     return _jobById.find(id) != _jobById.end();
@@ -11,35 +34,98 @@ bool _Worker::add(Job* job)
         return false;
     }
 
+    job->_worker = this;
     _jobs.emplace_back(job);
     _jobById.emplace(job->getId(), job);
+    if (_eventLog) {
+        _eventLog->logJobEvent(EventLog::JobEvent::Added, job->getId());
+    }
+    scheduleProcessing();
 
     return true;
 }
 
 void _Worker::process()
 {
-    vector<Job*> newJobQueue;
-    newJobQueue.reserve(_jobs.size());
+    _processingScheduled = false;
 
-    bool blockingJobs = false;
-    for (auto const& job : _jobs) {
-        if (blockingJobs) {
-            newJobQueue.emplace_back(job);
-            continue;
-        }
-        job->process();
-        if (!job->isFinished()) {
-            newJobQueue.emplace_back(job);
-        }
-        if (job->isBlocking()) {
-            blockingJobs = true;
+    //finished jobs release their conflict key and dependencies, hence another pass is needed
+    bool jobsFinished = true;
+    while (jobsFinished) {
+        jobsFinished = false;
+
+        std::unordered_set<string> usedConflictKeys;
+        auto const jobs = _jobs;
+        for (auto const& job : jobs) {
+            //key is also claimed by jobs waiting for their dependencies in order to keep the order of addition
+            auto const conflictKey = job->getConflictKey();
+            if (!conflictKey.empty() && !usedConflictKeys.insert(conflictKey).second) {
+                continue;
+            }
+            if (!areDependenciesFinished(job)) {
+                continue;
+            }
+            if (job->isRunningConcurrently()) {
+                continue;
+            }
+            job->process();
+            if (job->isFinished() && !job->isRunningConcurrently()) {
+                remove(job);
+                jobsFinished = true;
+            }
         }
-        if (job->isFinished()) {
-            _jobById.erase(job->getId());
-            delete job;
+    }
+}
+
+void _Worker::scheduleProcessing()
+{
+    if (_processingScheduled) {
+        return;
+    }
+    _processingScheduled = true;
+    QMetaObject::invokeMethod(this, [this] { process(); }, Qt::QueuedConnection);
+}
+
+void _Worker::runConcurrently(Job* job, std::function<void()> const& stage)
+{
+    _threadPool->start([this, job, stage] {
+        stage();
+
+        //job must not be touched outside the thread of the worker after the stage, it may be deleted there
+        QMetaObject::invokeMethod(
+            this,
+            [this, job] {
+                job->_runningConcurrently = false;
+                scheduleProcessing();
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+bool _Worker::areDependenciesFinished(Job* job) const
+{
+    for (auto const& id : job->getDependencies()) {
+        if (_jobById.find(id) != _jobById.end()) {
+            return false;
         }
     }
-    _jobs = newJobQueue;
+    return true;
 }
 
+void _Worker::remove(Job* job)
+{
+    _jobs.erase(std::find(_jobs.begin(), _jobs.end(), job));
+    _jobById.erase(job->getId());
+    if (_eventLog) {
+        _eventLog->logJobEvent(EventLog::JobEvent::Finished, job->getId());
+    }
+
+    auto const continuations = std::move(job->_continuations);
+    job->_continuations.clear();
+    delete job;
+    for (auto const& continuation : continuations) {
+        if (!add(continuation)) {
+            delete continuation;
+        }
+    }
+}
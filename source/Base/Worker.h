@@ -1,37 +1,49 @@
-#pragma 
+#pragma once
+
+#include <functional>
+
+#include <QObject>
 
 #include "Job.h"
 #include "Definitions.h"
 
-class BASE_EXPORT _Worker
+class QThreadPool;
+class EventLog;
+
+/**
+ * Event-driven scheduler for jobs. Processing is triggered by the addition of jobs, by Job::wakeUp() and by the
+ * completion of concurrent stages instead of polling. All methods have to be called from the thread of the worker.
+ */
+class BASE_EXPORT _Worker : public QObject
 {
+    Q_OBJECT
 public:
+    _Worker(QObject* parent = nullptr);
+
+    //waits for running concurrent stages and deletes unfinished jobs
+    virtual ~_Worker();
+
     bool contains(string const& id);
 
     //returns false if job is already in queue
     bool add(Job* job);
 
-    /*
-    Job get(string const& id) const
-    {
-    auto findResult = _jobById.find(id);
-    if (findResult != _jobById.end()) {
-    return findResult->second;
-    }
-    return nullptr;
-    }
-
-    Job getFirst() const
-    {
-    if (_jobs.empty()) {
-    return nullptr;
-    }
-    return _jobs.front();
-    }
-    */
-
+    //processes all jobs which can make progress, finished jobs are deleted and their continuations added
     void process();
+
 private:
+    friend class Job;
+
+    void scheduleProcessing();
+    void runConcurrently(Job* job, std::function<void()> const& stage);
+
+    bool areDependenciesFinished(Job* job) const;
+    void remove(Job* job);
+
+    bool _processingScheduled = false;
+    QThreadPool* _threadPool = nullptr;
+    EventLog* _eventLog = nullptr;
+
     vector<Job*> _jobs;
     unordered_map<string, Job*> _jobById;
 };
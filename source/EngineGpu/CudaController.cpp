@@ -21,7 +21,7 @@ CudaController::CudaController(QObject* parent /*= nullptr*/)
 {
     auto factory = ServiceLocator::getInstance().getService<GlobalFactory>();
     auto numberGenerator = factory->buildRandomNumberGenerator();
-    numberGenerator->init(1323781, 2);
+    numberGenerator->init(2);
     SET_CHILD(_numberGenerator, numberGenerator);
 
 	_worker = new CudaWorker();
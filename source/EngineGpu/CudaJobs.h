@@ -6,6 +6,7 @@
 #include "EngineInterface/Definitions.h"
 
 #include "DefinitionsImpl.h"
+#include "SpatialStatistics.h"
 #include "EngineGpuKernels/AccessTOs.cuh"
 #include "EngineInterface/ChangeDescriptions.h"
 #include "EngineInterface/ExecutionParameters.h"
@@ -56,24 +57,94 @@ private:
     MonitorData _monitorData;
 };
 
+class _GetSpatialStatisticsJob : public _CudaJob
+{
+public:
+    _GetSpatialStatisticsJob(
+        string const& originId,
+        IntVector2D const& universeSize,
+        IntVector2D const& gridSize,
+        boost::shared_ptr<DataAccessTO> const& dataTO)
+        : _CudaJob(originId, true)
+        , _universeSize(universeSize)
+        , _gridSize(gridSize)
+        , _dataTO(dataTO)
+    {}
+
+    virtual ~_GetSpatialStatisticsJob() = default;
+
+    IntVector2D getUniverseSize() const { return _universeSize; }
+    IntVector2D getGridSize() const { return _gridSize; }
+
+    //buffer for the transfer of the whole world, owned together with the requester
+    DataAccessTO getDataTO() const { return *_dataTO; }
+
+    void setStatistics(SpatialStatistics const& value) { _statistics = value; }
+    SpatialStatistics const& getStatistics() const { return _statistics; }
+
+private:
+    IntVector2D _universeSize;
+    IntVector2D _gridSize;
+    boost::shared_ptr<DataAccessTO> _dataTO;
+    SpatialStatistics _statistics;
+};
+
 class _GetDataJob : public _CudaJob
 {
 public:
-    _GetDataJob(string const& originId, IntRect const& rect, DataAccessTO const& dataTO)
+    //coveringRect: whole region the requester is interested in
+    _GetDataJob(string const& originId, IntRect const& coveringRect, DataAccessTO const& dataTO)
         : _CudaJob(originId, true)
-        , _rect(rect)
+        , _coveringRect(coveringRect)
+        , _dataTO(dataTO)
+    {}
+
+    //rectToFetch: missing part of coveringRect if the requester has cached the rest at cachedDataVersion,
+    //boost::none if nothing is missing
+    _GetDataJob(
+        string const& originId,
+        IntRect const& coveringRect,
+        boost::optional<IntRect> const& rectToFetch,
+        uint64_t cachedDataVersion,
+        DataAccessTO const& dataTO)
+        : _CudaJob(originId, true)
+        , _coveringRect(coveringRect)
+        , _rectToFetch(rectToFetch)
+        , _cachedDataVersion(cachedDataVersion)
         , _dataTO(dataTO)
     {}
 
     virtual ~_GetDataJob() = default;
 
-    IntRect getRect() const { return _rect; }
+    IntRect getCoveringRect() const { return _coveringRect; }
+
+    //decides which rect has to be transferred at the current version of the simulation data
+    boost::optional<IntRect> calcRectToFetch(uint64_t dataVersion) const
+    {
+        if (_cachedDataVersion && *_cachedDataVersion == dataVersion) {
+            return _rectToFetch;
+        }
+        return _coveringRect;
+    }
 
     DataAccessTO getDataTO() const { return _dataTO; }
 
+    //transferred rect and version of the simulation data at the time of the transfer
+    void setResult(boost::optional<IntRect> const& fetchedRect, uint64_t dataVersion)
+    {
+        _fetchedRect = fetchedRect;
+        _dataVersion = dataVersion;
+    }
+    boost::optional<IntRect> getFetchedRect() const { return _fetchedRect; }
+    uint64_t getDataVersion() const { return _dataVersion; }
+
 private:
+    IntRect _coveringRect;
+    boost::optional<IntRect> _rectToFetch;
+    boost::optional<uint64_t> _cachedDataVersion;
     DataAccessTO _dataTO;
-    IntRect _rect;
+    boost::optional<IntRect> _fetchedRect;
+    uint64_t _dataVersion = 0;
 };
 
 class _GetPixelImageJob : public _CudaJob
@@ -8,9 +8,11 @@
 #include <QOpenGLFunctions_3_3_Core>
 #include <QOffscreenSurface>
 
+#include "Base/EventLog.h"
 #include "Base/NumberGenerator.h"
 #include "Base/ServiceLocator.h"
 #include "Base/LoggingService.h"
+#include "EngineInterface/SimulationParametersParser.h"
 #include "EngineInterface/SpaceProperties.h"
 #include "EngineInterface/PhysicalActions.h"
 #include "EngineGpuKernels/AccessTOs.cuh"
@@ -19,6 +21,7 @@
 #include "CudaWorker.h"
 #include "EngineGpuData.h"
 #include "DataConverter.h"
+#include "SpatialStatistics.h"
 
 CudaWorker::CudaWorker(QObject* parent /*= nullptr*/)
     : QObject(parent)
@@ -44,7 +47,11 @@ void CudaWorker::init(
 
     auto size = space->getSize();
 	delete _cudaSimulation;
-    _cudaSimulation = new CudaSimulation({ size.x, size.y }, timestep, parameters, cudaConstants);
+    _cudaSimulation = new CudaSimulation(
+        {size.x, size.y}, timestep, parameters, cudaConstants, numberGenerator->getSeed());
+
+    _loggedParameters.clear();
+    logParameters(parameters);
 }
 
 void CudaWorker::terminateWorker()
@@ -89,6 +96,10 @@ void CudaWorker::run()
     _context->setFormat(format);
     _context->create();
 
+    auto eventLog = ServiceLocator::getInstance().getService<EventLog>();
+    QElapsedTimer monitorTimer;
+    monitorTimer.start();
+
     try {
         do {
             QElapsedTimer timer;
@@ -97,7 +108,20 @@ void CudaWorker::run()
             processJobs();
 
             if (isSimulationRunning()) {
+                auto const calcStartTime = timer.nsecsElapsed();
                 _cudaSimulation->calcCudaTimestep();
+                ++_dataVersion;
+
+                if (eventLog->isOpen()) {
+                    eventLog->logTimestep(
+                        _cudaSimulation->getTimestep(), (timer.nsecsElapsed() - calcStartTime) / 1000000.0);
+
+                    //monitor data requires additional kernel calls
+                    if (monitorTimer.elapsed() >= MonitorInterval) {
+                        monitorTimer.restart();
+                        logMonitorData(eventLog);
+                    }
+                }
 
                 if (_tpsRestriction) {
                     int remainingTime = 1000000 / (*_tpsRestriction) - timer.nsecsElapsed() / 1000;
@@ -166,9 +190,13 @@ void CudaWorker::processJobs()
         }
 
         if (auto _job = boost::dynamic_pointer_cast<_GetDataJob>(job)) {
-            auto rect = _job->getRect();
-            auto dataTO = _job->getDataTO();
-            _cudaSimulation->getSimulationData({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO);
+            //the cached part of the requester is only valid if no job or time step changed the data since
+            auto const rect = _job->calcRectToFetch(_dataVersion);
+            if (rect) {
+                auto dataTO = _job->getDataTO();
+                _cudaSimulation->getSimulationData({rect->p1.x, rect->p1.y}, {rect->p2.x, rect->p2.y}, dataTO);
+            }
+            _job->setResult(rect, _dataVersion);
         }
 
         if (auto _job = boost::dynamic_pointer_cast<_UpdateDataJob>(job)) {
@@ -186,6 +214,7 @@ void CudaWorker::processJobs()
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: update data finished 2/3");
 
             _cudaSimulation->setSimulationData({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO);
+            ++_dataVersion;
 
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: update data finished 3/3");
         }
@@ -196,6 +225,7 @@ void CudaWorker::processJobs()
             auto rect = _job->getRect();
             auto dataTO = _job->getDataTO();
             _cudaSimulation->setSimulationData({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO);
+            ++_dataVersion;
 
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: set data finished");
         }
@@ -213,6 +243,7 @@ void CudaWorker::processJobs()
         if (auto _job = boost::dynamic_pointer_cast<_CalcSingleTimestepJob>(job)) {
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: calculate single time step");
             _cudaSimulation->calcCudaTimestep();
+            ++_dataVersion;
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: calculate single time step finished");
 
             Q_EMIT timestepCalculated();
@@ -226,6 +257,7 @@ void CudaWorker::processJobs()
         if (auto _job = boost::dynamic_pointer_cast<_SetSimulationParametersJob>(job)) {
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: set simulation parameters");
             _cudaSimulation->setSimulationParameters(_job->getSimulationParameters());
+            logParameters(_job->getSimulationParameters());
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: set simulation parameters finished");
         }
 
@@ -239,9 +271,20 @@ void CudaWorker::processJobs()
             _job->setMonitorData(_cudaSimulation->getMonitorData());
         }
 
+        if (auto _job = boost::dynamic_pointer_cast<_GetSpatialStatisticsJob>(job)) {
+            auto const universeSize = _job->getUniverseSize();
+            auto dataTO = _job->getDataTO();
+            _cudaSimulation->getSimulationData({0, 0}, {universeSize.x, universeSize.y}, dataTO);
+
+            auto statistics = SpatialStatisticsCalculator::calc(dataTO, universeSize, _job->getGridSize());
+            statistics.timestep = _cudaSimulation->getTimestep();
+            _job->setStatistics(statistics);
+        }
+
         if (auto _job = boost::dynamic_pointer_cast<_ClearDataJob>(job)) {
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: clear data");
             _cudaSimulation->clear();
+            ++_dataVersion;
             loggingService->logMessage(Priority::Unimportant, "CudaWorker: clear data finished");
         }
 
@@ -276,6 +319,7 @@ void CudaWorker::processJobs()
                 float2 displacement = { _action->getDisplacement().x(), _action->getDisplacement().y() };
                 _cudaSimulation->moveSelection(displacement);
             }
+            ++_dataVersion;
         }
 
         if (job->isNotifyFinish()) {
@@ -333,3 +377,44 @@ void* CudaWorker::registerImageResource(GLuint image)
     openGL.glBindTexture(GL_TEXTURE_2D, 0);
     return result;
 }
+
+void CudaWorker::logMonitorData(EventLog* eventLog)
+{
+    auto const monitorData = _cudaSimulation->getMonitorData();
+    eventLog->logCounter("numClusters", monitorData.numClusters);
+    eventLog->logCounter("numClustersWithTokens", monitorData.numClustersWithTokens);
+    eventLog->logCounter("numCells", monitorData.numCells);
+    eventLog->logCounter("numParticles", monitorData.numParticles);
+    eventLog->logCounter("numTokens", monitorData.numTokens);
+    eventLog->logCounter("totalInternalEnergy", monitorData.totalInternalEnergy);
+    eventLog->logCounter("totalLinearKineticEnergy", monitorData.totalLinearKineticEnergy);
+    eventLog->logCounter("totalRotationalKineticEnergy", monitorData.totalRotationalKineticEnergy);
+}
+
+void CudaWorker::logParameters(SimulationParameters const& parameters)
+{
+    auto eventLog = ServiceLocator::getInstance().getService<EventLog>();
+    if (!eventLog->isOpen()) {
+        return;
+    }
+
+    //only changed values are logged, the parameter names are the paths in the encoded tree
+    std::function<void(boost::property_tree::ptree const&, string const&)> logTree =
+        [&](boost::property_tree::ptree const& tree, string const& path) {
+            for (auto const& [key, subtree] : tree) {
+                auto const subPath = path.empty() ? key : path + "." + key;
+                if (!subtree.empty()) {
+                    logTree(subtree, subPath);
+                    continue;
+                }
+                auto const& text = subtree.data();
+                auto const value = text == "true" ? 1.0 : text == "false" ? 0.0 : QString::fromStdString(text).toDouble();
+                auto findResult = _loggedParameters.find(subPath);
+                if (findResult == _loggedParameters.end() || findResult->second != value) {
+                    _loggedParameters.insert_or_assign(subPath, value);
+                    eventLog->logParameter(subPath, value);
+                }
+            }
+        };
+    logTree(SimulationParametersParser::encode(parameters), "");
+}
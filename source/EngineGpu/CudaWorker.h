@@ -13,6 +13,7 @@
 
 class QOpenGLContext;
 class QOffscreenSurface;
+class EventLog;
 
 class CudaWorker : public QObject
 {
@@ -48,6 +49,11 @@ private:
     void processJobs();
     bool isTerminate();
 
+    void logMonitorData(EventLog* eventLog);
+    void logParameters(SimulationParameters const& parameters);
+
+    static int const MonitorInterval = 1000;    //in milliseconds
+
 private:
     CudaSimulation* _cudaSimulation = nullptr;
     NumberGenerator* _numberGenerator = nullptr;
@@ -57,9 +63,11 @@ private:
     list<CudaJob> _jobs;
     vector<CudaJob> _finishedJobs;
 
+    uint64_t _dataVersion = 0;    //increased whenever the simulation data may have been changed
     bool _simulationRunning = false;
     bool _terminate = false;
     boost::optional<int> _tpsRestriction;
+    map<string, double> _loggedParameters;
     QOpenGLContext* _context;
     QOffscreenSurface* _surface;
 };
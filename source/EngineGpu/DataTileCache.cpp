@@ -0,0 +1,225 @@
+#include "DataTileCache.h"
+
+#include <algorithm>
+
+#include "EngineInterface/SpaceProperties.h"
+
+namespace
+{
+    auto const InvalidVersion = std::numeric_limits<uint64_t>::max();
+}
+
+void DataTileCache::init(SpaceProperties* space, int tileSize)
+{
+    _space = space;
+    _tileSize = tileSize;
+    auto const size = _space->getSize();
+    _numTiles = {(size.x + _tileSize - 1) / _tileSize, (size.y + _tileSize - 1) / _tileSize};
+    _tileVersions = vector<uint64_t>(_numTiles.x * _numTiles.y, InvalidVersion);
+    _coveringRect = boost::none;
+    _dataVersion = boost::none;
+    _data = DataDescription();
+}
+
+IntRect DataTileCache::getCoveringRect(IntRect const& rect) const
+{
+    return getRect(getTileRange(rect));
+}
+
+boost::optional<IntRect> DataTileCache::getRectToFetch(IntRect const& coveringRect, uint64_t dataVersion) const
+{
+    auto const range = getTileRange(coveringRect);
+    boost::optional<TileRange> rangeToFetch;
+    for (int y = range.first.y; y <= range.last.y; ++y) {
+        for (int x = range.first.x; x <= range.last.x; ++x) {
+            if (getTileVersion(x, y) == dataVersion) {
+                continue;
+            }
+            if (!rangeToFetch) {
+                rangeToFetch = TileRange{{x, y}, {x, y}};
+            }
+            else {
+                rangeToFetch->first = {std::min(rangeToFetch->first.x, x), std::min(rangeToFetch->first.y, y)};
+                rangeToFetch->last = {std::max(rangeToFetch->last.x, x), std::max(rangeToFetch->last.y, y)};
+            }
+        }
+    }
+    if (!rangeToFetch) {
+        return boost::none;
+    }
+    return getRect(*rangeToFetch);
+}
+
+bool DataTileCache::update(
+    DataDescription&& fetchedData,
+    IntRect const& fetchedRect,
+    IntRect const& coveringRect,
+    uint64_t dataVersion)
+{
+    auto const coveringRange = getTileRange(coveringRect);
+    auto const fetchedRange = getTileRange(fetchedRect);
+    if (isEqual(coveringRange, fetchedRange)) {
+        invalidate();
+    }
+    auto isInRange = [](TileRange const& range, int x, int y) {
+        return range.first.x <= x && x <= range.last.x && range.first.y <= y && y <= range.last.y;
+    };
+
+    restrictToRect(coveringRect);
+
+    //cached tiles must have the version of the fetched data
+    for (int y = coveringRange.first.y; y <= coveringRange.last.y; ++y) {
+        for (int x = coveringRange.first.x; x <= coveringRange.last.x; ++x) {
+            auto& version = getTileVersion(x, y);
+            if (isInRange(fetchedRange, x, y)) {
+                version = dataVersion;
+            }
+            else if (version != dataVersion) {
+                invalidate();
+                return false;
+            }
+        }
+    }
+
+    _dataVersion = dataVersion;
+    removeData(fetchedRect, true);
+    if (!_data.clusters && !_data.particles) {
+        _data = std::move(fetchedData);
+        return true;
+    }
+    if (fetchedData.clusters) {
+        if (!_data.clusters) {
+            _data.clusters = vector<ClusterDescription>();
+        }
+        _data.clusters->reserve(_data.clusters->size() + fetchedData.clusters->size());
+        std::move(fetchedData.clusters->begin(), fetchedData.clusters->end(), std::back_inserter(*_data.clusters));
+    }
+    if (fetchedData.particles) {
+        if (!_data.particles) {
+            _data.particles = vector<ParticleDescription>();
+        }
+        _data.particles->reserve(_data.particles->size() + fetchedData.particles->size());
+        std::move(fetchedData.particles->begin(), fetchedData.particles->end(), std::back_inserter(*_data.particles));
+    }
+    return true;
+}
+
+void DataTileCache::restrictToRect(IntRect const& coveringRect)
+{
+    if (_coveringRect && isEqual(getTileRange(*_coveringRect), getTileRange(coveringRect))) {
+        return;
+    }
+    _coveringRect = coveringRect;
+
+    auto const range = getTileRange(coveringRect);
+    for (int y = 0; y < _numTiles.y; ++y) {
+        for (int x = 0; x < _numTiles.x; ++x) {
+            if (x < range.first.x || x > range.last.x || y < range.first.y || y > range.last.y) {
+                getTileVersion(x, y) = InvalidVersion;
+            }
+        }
+    }
+    removeData(coveringRect, false);
+}
+
+void DataTileCache::invalidate()
+{
+    std::fill(_tileVersions.begin(), _tileVersions.end(), InvalidVersion);
+    _coveringRect = boost::none;
+    _dataVersion = boost::none;
+    _data = DataDescription();
+}
+
+boost::optional<uint64_t> DataTileCache::getDataVersion() const
+{
+    return _dataVersion;
+}
+
+boost::optional<uint64_t> DataTileCache::getReusableDataVersion(bool simulationRunning) const
+{
+    if (simulationRunning) {
+        return boost::none;
+    }
+    return _dataVersion;
+}
+
+DataDescription const& DataTileCache::getData() const
+{
+    return _data;
+}
+
+auto DataTileCache::getTileRange(IntRect const& rect) const -> TileRange
+{
+    auto toTile = [this](int value, int numTiles) {
+        return std::max(0, std::min(numTiles - 1, value / _tileSize));
+    };
+
+    //tiles are half-open such that a tile-aligned rect does not reach into the adjacent tiles
+    return {
+        {toTile(rect.p1.x, _numTiles.x), toTile(rect.p1.y, _numTiles.y)},
+        {toTile(std::max(rect.p1.x, rect.p2.x - 1), _numTiles.x),
+         toTile(std::max(rect.p1.y, rect.p2.y - 1), _numTiles.y)}};
+}
+
+bool DataTileCache::isEqual(TileRange const& range1, TileRange const& range2)
+{
+    return range1.first.x == range2.first.x && range1.first.y == range2.first.y && range1.last.x == range2.last.x
+        && range1.last.y == range2.last.y;
+}
+
+IntRect DataTileCache::getRect(TileRange const& range) const
+{
+    auto const size = _space->getSize();
+    return {
+        {range.first.x * _tileSize, range.first.y * _tileSize},
+        {std::min((range.last.x + 1) * _tileSize, size.x), std::min((range.last.y + 1) * _tileSize, size.y)}};
+}
+
+uint64_t& DataTileCache::getTileVersion(int x, int y)
+{
+    return _tileVersions[x + y * _numTiles.x];
+}
+
+uint64_t DataTileCache::getTileVersion(int x, int y) const
+{
+    return _tileVersions[x + y * _numTiles.x];
+}
+
+bool DataTileCache::isContained(QVector2D pos, IntRect const& rect) const
+{
+    _space->correctPosition(pos);
+    return rect.p1.x <= pos.x() && pos.x() <= rect.p2.x && rect.p1.y <= pos.y() && pos.y() <= rect.p2.y;
+}
+
+bool DataTileCache::isContained(ClusterDescription const& cluster, IntRect const& rect) const
+{
+    if (!cluster.cells) {
+        return false;
+    }
+    return std::any_of(cluster.cells->begin(), cluster.cells->end(), [&](CellDescription const& cell) {
+        return isContained(*cell.pos, rect);
+    });
+}
+
+void DataTileCache::removeData(IntRect const& rect, bool inside)
+{
+    //same criteria as for fetching data from the device: clusters with at least one cell in rect
+    if (_data.clusters) {
+        auto& clusters = *_data.clusters;
+        clusters.erase(
+            std::remove_if(
+                clusters.begin(),
+                clusters.end(),
+                [&](ClusterDescription const& cluster) { return isContained(cluster, rect) == inside; }),
+            clusters.end());
+    }
+    if (_data.particles) {
+        auto& particles = *_data.particles;
+        particles.erase(
+            std::remove_if(
+                particles.begin(),
+                particles.end(),
+                [&](ParticleDescription const& particle) { return isContained(*particle.pos, rect) == inside; }),
+            particles.end());
+    }
+}
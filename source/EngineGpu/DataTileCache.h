@@ -0,0 +1,70 @@
+#pragma once
+
+#include "EngineInterface/Descriptions.h"
+
+#include "Definitions.h"
+#include "DefinitionsImpl.h"
+
+/**
+ * Caches simulation data of a region which is split into square tiles of fixed size. All cached tiles belong to the
+ * same data version of the simulation. Only tiles which are missing have to be transferred from the device when the
+ * region is shifted or requested again at that version.
+ */
+class ENGINEGPU_EXPORT DataTileCache
+{
+public:
+    void init(SpaceProperties* space, int tileSize);
+
+    //smallest tile-aligned rect containing rect
+    IntRect getCoveringRect(IntRect const& rect) const;
+
+    //tile-aligned rect which has to be fetched in order to obtain the data of coveringRect at dataVersion
+    boost::optional<IntRect> getRectToFetch(IntRect const& coveringRect, uint64_t dataVersion) const;
+
+    //integrates data of fetchedRect and drops the data outside coveringRect,
+    //returns false if the cached tiles do not belong to the version of the fetched data
+    bool update(
+        DataDescription&& fetchedData,
+        IntRect const& fetchedRect,
+        IntRect const& coveringRect,
+        uint64_t dataVersion);
+
+    //drops the data outside coveringRect
+    void restrictToRect(IntRect const& coveringRect);
+
+    void invalidate();
+
+    //version of the cached tiles, boost::none if nothing is cached
+    boost::optional<uint64_t> getDataVersion() const;
+
+    //version of the cached tiles if they may be reused, every time step changes the data, hence cached tiles are
+    //only reused while the simulation is paused
+    boost::optional<uint64_t> getReusableDataVersion(bool simulationRunning) const;
+
+    DataDescription const& getData() const;
+
+private:
+    struct TileRange
+    {
+        IntVector2D first;
+        IntVector2D last;
+    };
+    TileRange getTileRange(IntRect const& rect) const;
+    IntRect getRect(TileRange const& range) const;
+    static bool isEqual(TileRange const& range1, TileRange const& range2);
+    uint64_t& getTileVersion(int x, int y);
+    uint64_t getTileVersion(int x, int y) const;
+
+    bool isContained(QVector2D pos, IntRect const& rect) const;
+    bool isContained(ClusterDescription const& cluster, IntRect const& rect) const;
+    void removeData(IntRect const& rect, bool inside);
+
+    SpaceProperties* _space = nullptr;
+    int _tileSize = 1;
+    IntVector2D _numTiles;
+    vector<uint64_t> _tileVersions;
+    boost::optional<IntRect> _coveringRect;
+    boost::optional<uint64_t> _dataVersion;
+
+    DataDescription _data;
+};
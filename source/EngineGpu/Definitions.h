@@ -9,3 +9,5 @@ class SimulationAccessGpu;
 class EngineGpuData;
 class SimulationMonitorGpu;
 struct DataAccessTO;
+struct SpatialStatistics;
+class SpatialStatisticsRecorderGpu;
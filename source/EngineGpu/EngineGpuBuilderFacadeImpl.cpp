@@ -6,6 +6,7 @@
 #include "SimulationContextGpuImpl.h"
 #include "SimulationAccessGpuImpl.h"
 #include "SimulationMonitorGpuImpl.h"
+#include "SpatialStatisticsRecorderGpuImpl.h"
 #include "EngineGpuBuilderFacadeImpl.h"
 #include "EngineGpuSettings.h"
 
@@ -33,6 +34,11 @@ SimulationMonitorGpu * EngineGpuBuilderFacadeImpl::buildSimulationMonitor() cons
 	return new SimulationMonitorGpuImpl();
 }
 
+SpatialStatisticsRecorderGpu* EngineGpuBuilderFacadeImpl::buildSpatialStatisticsRecorder() const
+{
+    return new SpatialStatisticsRecorderGpuImpl();
+}
+
 CudaConstants EngineGpuBuilderFacadeImpl::getDefaultCudaConstants() const
 {
     return EngineGpuSettings::getDefaultCudaConstants();
@@ -14,6 +14,7 @@ public:
         uint timestepAtBeginning) const override;
     SimulationAccessGpu* buildSimulationAccess() const override;
 	SimulationMonitorGpu* buildSimulationMonitor() const override;
+    SpatialStatisticsRecorderGpu* buildSpatialStatisticsRecorder() const override;
 
     CudaConstants getDefaultCudaConstants() const override;
 
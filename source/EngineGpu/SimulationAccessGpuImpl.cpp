@@ -16,6 +16,7 @@
 namespace
 {
     const string SimulationAccessGpuId = "SimulationAccessGpuId";
+    int const DataTileSize = 32;
 }
 
 SimulationAccessGpuImpl::SimulationAccessGpuImpl(QObject* parent /*= nullptr*/)
@@ -34,6 +35,7 @@ void SimulationAccessGpuImpl::init(SimulationControllerGpu* controller)
     auto worker = _context->getCudaController()->getCudaWorker();
     auto size = _context->getSpaceProperties()->getSize();
     _lastDataRect = {{0, 0}, size};
+    _dataTileCache.init(_context->getSpaceProperties(), DataTileSize);
     for (auto const& connection : _connections) {
         QObject::disconnect(connection);
     }
@@ -73,7 +75,19 @@ void SimulationAccessGpuImpl::requireData(ResolveDescription const& resolveDesc)
 
 void SimulationAccessGpuImpl::requireData(IntRect rect, ResolveDescription const& resolveDesc)
 {
-    scheduleJob(boost::make_shared<_GetDataJob>(getObjectId(), rect, _dataTOCache->getDataTO()));
+    auto worker = _context->getCudaController()->getCudaWorker();
+    auto const coveringRect = _dataTileCache.getCoveringRect(rect);
+
+    auto const cachedDataVersion = _dataTileCache.getReusableDataVersion(worker->isSimulationRunning());
+    if (!cachedDataVersion) {
+        scheduleJob(boost::make_shared<_GetDataJob>(getObjectId(), coveringRect, _dataTOCache->getDataTO()));
+        return;
+    }
+
+    //the worker checks the cached version when processing the job since preceding jobs may change the data
+    auto const rectToFetch = _dataTileCache.getRectToFetch(coveringRect, *cachedDataVersion);
+    scheduleJob(boost::make_shared<_GetDataJob>(
+        getObjectId(), coveringRect, rectToFetch, *cachedDataVersion, _dataTOCache->getDataTO()));
 }
 
 void SimulationAccessGpuImpl::requirePixelImage(IntRect rect, QImagePtr const& target, std::mutex& mutex)
@@ -108,7 +122,7 @@ void SimulationAccessGpuImpl::applyAction(PhysicalAction const& action)
 
 DataDescription const& SimulationAccessGpuImpl::retrieveData()
 {
-    return _dataCollected;
+    return _dataTileCache.getData();
 }
 
 ImageResource SimulationAccessGpuImpl::registerImageResource(GLuint imageId)
@@ -145,9 +159,24 @@ void SimulationAccessGpuImpl::jobsFinished()
 
         if (auto const& getDataJob = boost::dynamic_pointer_cast<_GetDataJob>(job)) {
             auto dataTO = getDataJob->getDataTO();
-            createDataFromGpuModel(dataTO, getDataJob->getRect());
+            auto const coveringRect = getDataJob->getCoveringRect();
+            auto consistent = true;
+            if (auto const fetchedRect = getDataJob->getFetchedRect()) {
+                consistent = createDataFromGpuModel(dataTO, *fetchedRect, coveringRect, getDataJob->getDataVersion());
+            }
+            else {
+                _lastDataRect = coveringRect;
+                _dataTileCache.restrictToRect(coveringRect);
+            }
             _dataTOCache->releaseDataTO(dataTO);
-            Q_EMIT dataReadyToRetrieve();
+            if (consistent) {
+                Q_EMIT dataReadyToRetrieve();
+            }
+            else {
+
+                //data has been changed in the meantime => transfer the whole region
+                scheduleJob(boost::make_shared<_GetDataJob>(getObjectId(), coveringRect, _dataTOCache->getDataTO()));
+            }
         }
 
         if (auto const& setDataJob = boost::dynamic_pointer_cast<_SetDataJob>(job)) {
@@ -156,35 +185,49 @@ void SimulationAccessGpuImpl::jobsFinished()
     }
 }
 
-void SimulationAccessGpuImpl::createDataFromGpuModel(DataAccessTO dataTO, IntRect const& rect)
+bool SimulationAccessGpuImpl::createDataFromGpuModel(
+    DataAccessTO dataTO,
+    IntRect const& rect,
+    IntRect const& coveringRect,
+    uint64_t dataVersion)
 {
-    _lastDataRect = rect;
+    _lastDataRect = coveringRect;
 
     DataConverter converter(dataTO, _numberGen, _context->getSimulationParameters(), _cudaConstants);
-    _dataCollected = converter.getDataDescription();
+    return _dataTileCache.update(converter.getDataDescription(), rect, coveringRect, dataVersion);
 }
 
 void SimulationAccessGpuImpl::metricCorrection(DataChangeDescription& data) const
 {
     SpaceProperties* space = _context->getSpaceProperties();
-    for (auto& cluster : data.clusters) {
-        QVector2D origPos = cluster->pos.getValue();
-        auto pos = origPos;
-        space->correctPosition(pos);
-        auto correctionDelta = pos - origPos;
+
+    vector<QVector2D> clusterPositions;
+    clusterPositions.reserve(data.clusters.size());
+    for (auto const& cluster : data.clusters) {
+        clusterPositions.emplace_back(cluster->pos.getValue());
+    }
+    space->correctPositions(clusterPositions.data(), static_cast<int>(clusterPositions.size()));
+    for (int i = 0; i < clusterPositions.size(); ++i) {
+        auto& cluster = data.clusters[i];
+        auto correctionDelta = clusterPositions[i] - cluster->pos.getValue();
         if (!correctionDelta.isNull()) {
-            cluster->pos.setValue(pos);
+            cluster->pos.setValue(clusterPositions[i]);
         }
         for (auto& cell : cluster->cells) {
             cell->pos.setValue(cell->pos.getValue() + correctionDelta);
         }
     }
-    for (auto& particle : data.particles) {
-        QVector2D origPos = particle->pos.getValue();
-        auto pos = origPos;
-        space->correctPosition(pos);
-        if (pos != origPos) {
-            particle->pos.setValue(pos);
+
+    vector<QVector2D> particlePositions;
+    particlePositions.reserve(data.particles.size());
+    for (auto const& particle : data.particles) {
+        particlePositions.emplace_back(particle->pos.getValue());
+    }
+    space->correctPositions(particlePositions.data(), static_cast<int>(particlePositions.size()));
+    for (int i = 0; i < particlePositions.size(); ++i) {
+        auto& particle = data.particles[i];
+        if (particlePositions[i] != particle->pos.getValue()) {
+            particle->pos.setValue(particlePositions[i]);
         }
     }
 }
@@ -4,6 +4,7 @@
 #include "EngineInterface/ChangeDescriptions.h"
 #include "EngineInterface/SimulationAccess.h"
 #include "SimulationAccessGpu.h"
+#include "DataTileCache.h"
 #include "DefinitionsImpl.h"
 
 class SimulationAccessGpuImpl : public SimulationAccessGpu
@@ -35,7 +36,11 @@ private:
     void scheduleJob(CudaJob const& job);
     Q_SLOT void jobsFinished();
 
-    void createDataFromGpuModel(DataAccessTO dataTO, IntRect const& rect);
+    bool createDataFromGpuModel(
+        DataAccessTO dataTO,
+        IntRect const& rect,
+        IntRect const& coveringRect,
+        uint64_t dataVersion);
 
     void metricCorrection(DataChangeDescription& data) const;
 
@@ -67,7 +72,7 @@ private:
     NumberGenerator* _numberGen = nullptr;
     CudaConstants _cudaConstants;
 
-    DataDescription _dataCollected;
+    DataTileCache _dataTileCache;
     DataTOCache _dataTOCache;
     IntRect _lastDataRect;
 };
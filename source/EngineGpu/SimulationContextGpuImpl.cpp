@@ -26,7 +26,7 @@ void SimulationContextGpuImpl::init(
 {
 	auto factory = ServiceLocator::getInstance().getService<GlobalFactory>();
 	auto numberGen = factory->buildRandomNumberGenerator();
-	numberGen->init(1323781, 1);
+	numberGen->init(1);
 
 	SET_CHILD(_metric, space);
 	SET_CHILD(_symbolTable, symbolTable);
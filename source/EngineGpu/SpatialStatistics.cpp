@@ -0,0 +1,166 @@
+#include "SpatialStatistics.h"
+
+#include <cmath>
+
+#include "Base/Parallel.h"
+#include "EngineInterface/Physics.h"
+#include "EngineGpuKernels/AccessTOs.cuh"
+
+namespace
+{
+    int const ClustersPerChunk = 64;
+    int const ParticlesPerChunk = 4096;
+
+    float correctCoordinate(float value, float size)
+    {
+        auto result = value - std::floor(value / size) * size;
+        return result < size ? result : 0.0f;
+    }
+
+    class BinMapping
+    {
+    public:
+        BinMapping(IntVector2D const& universeSize, IntVector2D const& gridSize)
+            : _universeSize{static_cast<float>(universeSize.x), static_cast<float>(universeSize.y)}
+            , _gridSize(gridSize)
+        {}
+
+        int getBinIndex(float2 const& pos) const
+        {
+            auto const x = static_cast<int>(correctCoordinate(pos.x, _universeSize.x) / _universeSize.x * _gridSize.x);
+            auto const y = static_cast<int>(correctCoordinate(pos.y, _universeSize.y) / _universeSize.y * _gridSize.y);
+            return std::min(x, _gridSize.x - 1) + std::min(y, _gridSize.y - 1) * _gridSize.x;
+        }
+
+        //shortest displacement on the torus
+        QVector2D getDisplacement(float2 const& from, float2 const& to) const
+        {
+            auto const dx = to.x - from.x;
+            auto const dy = to.y - from.y;
+            return {
+                dx - std::round(dx / _universeSize.x) * _universeSize.x,
+                dy - std::round(dy / _universeSize.y) * _universeSize.y};
+        }
+
+    private:
+        RealVector2D _universeSize;
+        IntVector2D _gridSize;
+    };
+}
+
+void SpatialStatistics::init(IntVector2D const& gridSize_)
+{
+    gridSize = gridSize_;
+    values = vector<float>(static_cast<size_t>(NumChannels) * getNumBins(), 0.0f);
+}
+
+int SpatialStatistics::getNumBins() const
+{
+    return gridSize.x * gridSize.y;
+}
+
+float SpatialStatistics::get(int channel, IntVector2D const& bin) const
+{
+    return values[channel * getNumBins() + bin.x + bin.y * gridSize.x];
+}
+
+float& SpatialStatistics::getRef(int channel, IntVector2D const& bin)
+{
+    return values[channel * getNumBins() + bin.x + bin.y * gridSize.x];
+}
+
+SpatialStatistics SpatialStatisticsCalculator::calc(
+    DataAccessTO const& dataTO,
+    IntVector2D const& universeSize,
+    IntVector2D const& gridSize)
+{
+    SpatialStatistics result;
+    result.init({std::max(gridSize.x, 1), std::max(gridSize.y, 1)});
+    if (universeSize.x <= 0 || universeSize.y <= 0) {
+        return result;
+    }
+
+    auto const numBins = result.getNumBins();
+    auto channelOffset = [numBins](int channel, int binIndex) { return channel * numBins + binIndex; };
+    BinMapping const mapping(universeSize, result.gridSize);
+
+    //each chunk accumulates into its own grid, the grids are summed up afterwards
+    vector<vector<float>> chunkValues(Parallel::getNumThreads());
+    auto getChunkValues = [&](int chunkIndex) -> vector<float>& {
+        auto& values = chunkValues[chunkIndex];
+        if (values.empty()) {
+            values.resize(result.values.size(), 0.0f);
+        }
+        return values;
+    };
+
+    auto const numClusters = *dataTO.numClusters;
+    Parallel::forEachChunk(
+        0,
+        numClusters,
+        [&](int chunkIndex, int begin, int end) {
+            auto& values = getChunkValues(chunkIndex);
+            for (int clusterIndex = begin; clusterIndex < end; ++clusterIndex) {
+                auto const& cluster = dataTO.clusters[clusterIndex];
+                Physics::Velocities const clusterVel{{cluster.vel.x, cluster.vel.y}, cluster.angularVel};
+                for (int i = 0; i < cluster.numCells; ++i) {
+                    auto const& cell = dataTO.cells[cluster.cellStartIndex + i];
+                    auto const binIndex = mapping.getBinIndex(cell.pos);
+                    auto const vel = Physics::tangentialVelocity(mapping.getDisplacement(cluster.pos, cell.pos), clusterVel);
+                    values[channelOffset(SpatialStatistics::EnergyDensity, binIndex)] += cell.energy;
+                    values[channelOffset(SpatialStatistics::NumCells, binIndex)] += 1.0f;
+                    values[channelOffset(SpatialStatistics::MeanVelocityX, binIndex)] += vel.x();
+                    values[channelOffset(SpatialStatistics::MeanVelocityY, binIndex)] += vel.y();
+                    auto const cellFunction = ((cell.cellFunctionType % Enums::CellFunction::_COUNTER)
+                                               + Enums::CellFunction::_COUNTER)
+                        % Enums::CellFunction::_COUNTER;
+                    values[channelOffset(SpatialStatistics::NumCellsWithFunction + cellFunction, binIndex)] += 1.0f;
+                }
+                for (int i = 0; i < cluster.numTokens; ++i) {
+                    auto const& token = dataTO.tokens[cluster.tokenStartIndex + i];
+                    auto const binIndex = mapping.getBinIndex(dataTO.cells[token.cellIndex].pos);
+                    values[channelOffset(SpatialStatistics::EnergyDensity, binIndex)] += token.energy;
+                    values[channelOffset(SpatialStatistics::NumTokens, binIndex)] += 1.0f;
+                }
+            }
+        },
+        ClustersPerChunk);
+
+    auto const numParticles = *dataTO.numParticles;
+    Parallel::forEachChunk(
+        0,
+        numParticles,
+        [&](int chunkIndex, int begin, int end) {
+            auto& values = getChunkValues(chunkIndex);
+            for (int particleIndex = begin; particleIndex < end; ++particleIndex) {
+                auto const& particle = dataTO.particles[particleIndex];
+                auto const binIndex = mapping.getBinIndex(particle.pos);
+                values[channelOffset(SpatialStatistics::EnergyDensity, binIndex)] += particle.energy;
+                values[channelOffset(SpatialStatistics::NumParticles, binIndex)] += 1.0f;
+                values[channelOffset(SpatialStatistics::MeanVelocityX, binIndex)] += particle.vel.x;
+                values[channelOffset(SpatialStatistics::MeanVelocityY, binIndex)] += particle.vel.y;
+            }
+        },
+        ParticlesPerChunk);
+
+    auto const binArea = static_cast<float>(universeSize.x) / static_cast<float>(result.gridSize.x)
+        * static_cast<float>(universeSize.y) / static_cast<float>(result.gridSize.y);
+    Parallel::forEach(0, numBins, [&](int binIndex) {
+        for (int channel = 0; channel < SpatialStatistics::NumChannels; ++channel) {
+            auto& value = result.values[channelOffset(channel, binIndex)];
+            for (auto const& values : chunkValues) {
+                if (!values.empty()) {
+                    value += values[channelOffset(channel, binIndex)];
+                }
+            }
+        }
+        result.values[channelOffset(SpatialStatistics::EnergyDensity, binIndex)] /= binArea;
+        auto const numEntities = result.values[channelOffset(SpatialStatistics::NumCells, binIndex)]
+            + result.values[channelOffset(SpatialStatistics::NumParticles, binIndex)];
+        if (numEntities > 0) {
+            result.values[channelOffset(SpatialStatistics::MeanVelocityX, binIndex)] /= numEntities;
+            result.values[channelOffset(SpatialStatistics::MeanVelocityY, binIndex)] /= numEntities;
+        }
+    });
+    return result;
+}
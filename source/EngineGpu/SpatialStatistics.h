@@ -0,0 +1,42 @@
+#pragma once
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/ElementaryTypes.h"
+
+#include "Definitions.h"
+
+/**
+ * Spatially resolved metrics of the simulation on a regular grid over the world. The values are stored channel by
+ * channel, each channel as a row-major array of gridSize.y rows.
+ */
+struct ENGINEGPU_EXPORT SpatialStatistics
+{
+    enum Channel
+    {
+        EnergyDensity,  //energy of cells, tokens and particles per unit area
+        NumCells,
+        NumTokens,
+        NumParticles,
+        MeanVelocityX,  //averaged over cells and particles
+        MeanVelocityY,
+        NumCellsWithFunction,   //first of Enums::CellFunction::_COUNTER channels, one per cell function type
+        NumChannels = NumCellsWithFunction + Enums::CellFunction::_COUNTER
+    };
+
+    int timestep = 0;
+    IntVector2D gridSize;
+    vector<float> values;
+
+    void init(IntVector2D const& gridSize_);
+    int getNumBins() const;
+    float get(int channel, IntVector2D const& bin) const;
+    float& getRef(int channel, IntVector2D const& bin);
+};
+
+class ENGINEGPU_EXPORT SpatialStatisticsCalculator
+{
+public:
+    //all entities of dataTO are taken into account, positions outside the universe are mapped into it
+    static SpatialStatistics
+    calc(DataAccessTO const& dataTO, IntVector2D const& universeSize, IntVector2D const& gridSize);
+};
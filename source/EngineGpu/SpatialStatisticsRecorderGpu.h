@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QObject>
+
+#include "EngineInterface/Definitions.h"
+
+#include "Definitions.h"
+
+/**
+ * Computes spatial statistics of the simulation in a fixed timestep interval on the worker thread and appends them to
+ * a time series in .npy format. The statistics file has the shape (frames, SpatialStatistics::NumChannels, grid rows,
+ * grid columns), a companion file with suffix ".timesteps.npy" holds the timestep of each frame.
+ */
+class SpatialStatisticsRecorderGpu : public QObject
+{
+    Q_OBJECT
+public:
+    SpatialStatisticsRecorderGpu(QObject* parent = nullptr) : QObject(parent) {}
+    virtual ~SpatialStatisticsRecorderGpu() = default;
+
+    struct Config
+    {
+        IntVector2D gridSize;
+        int interval = 1;   //in timesteps
+        string filename;
+    };
+    //returns false if the files cannot be created
+    virtual bool init(SimulationControllerGpu* controller, Config const& config) = 0;
+
+    virtual SpatialStatistics const& retrieveLastStatistics() const = 0;
+    Q_SIGNAL void statisticsRecorded();
+};
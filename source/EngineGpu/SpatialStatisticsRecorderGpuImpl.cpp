@@ -0,0 +1,167 @@
+#include "SpatialStatisticsRecorderGpuImpl.h"
+
+#include <sstream>
+
+#include "Base/Exceptions.h"
+#include "Base/LoggingService.h"
+#include "Base/ServiceLocator.h"
+#include "EngineInterface/SpaceProperties.h"
+
+#include "CudaController.h"
+#include "CudaJobs.h"
+#include "CudaWorker.h"
+#include "EngineGpuData.h"
+#include "SimulationContextGpuImpl.h"
+#include "SimulationControllerGpu.h"
+
+namespace
+{
+    const string SpatialStatisticsRecorderGpuId = "SpatialStatisticsRecorderGpuId";
+    const string TimestepFileSuffix = ".timesteps.npy";
+}
+
+SpatialStatisticsRecorderGpuImpl::SpatialStatisticsRecorderGpuImpl(QObject* parent /*= nullptr*/)
+    : SpatialStatisticsRecorderGpu(parent)
+{}
+
+bool SpatialStatisticsRecorderGpuImpl::init(SimulationControllerGpu* controller, Config const& config)
+{
+    for (auto const& connection : _connections) {
+        QObject::disconnect(connection);
+    }
+    _connections.clear();
+
+    auto engineGpuData = EngineGpuData(controller->getContext()->getSpecificData());
+    _cudaConstants = engineGpuData.getCudaConstants();
+    _context = static_cast<SimulationContextGpuImpl*>(controller->getContext());
+    _config = config;
+    _config.gridSize = {std::max(config.gridSize.x, 1), std::max(config.gridSize.y, 1)};
+    _config.interval = std::max(config.interval, 1);
+    _jobPending = false;
+    _lastStatistics = SpatialStatistics();
+
+    if (!_statisticsWriter.open(
+            _config.filename,
+            NpyTimeSeriesWriter::Type::Float32,
+            {SpatialStatistics::NumChannels, _config.gridSize.y, _config.gridSize.x})
+        || !_timestepWriter.open(_config.filename + TimestepFileSuffix, NpyTimeSeriesWriter::Type::Int32, {})) {
+        stopRecording("could not create " + _config.filename);
+        return false;
+    }
+
+    auto worker = _context->getCudaController()->getCudaWorker();
+    _nextTimestep = worker->getTimestep();
+    _connections.push_back(connect(
+        worker,
+        &CudaWorker::timestepCalculated,
+        this,
+        &SpatialStatisticsRecorderGpuImpl::timestepCalculated,
+        Qt::QueuedConnection));
+    _connections.push_back(connect(
+        worker, &CudaWorker::jobsFinished, this, &SpatialStatisticsRecorderGpuImpl::jobsFinished, Qt::QueuedConnection));
+    return true;
+}
+
+SpatialStatistics const& SpatialStatisticsRecorderGpuImpl::retrieveLastStatistics() const
+{
+    return _lastStatistics;
+}
+
+void SpatialStatisticsRecorderGpuImpl::timestepCalculated()
+{
+    auto worker = _context->getCudaController()->getCudaWorker();
+    if (_jobPending || worker->getTimestep() < _nextTimestep) {
+        return;
+    }
+    allocateDataTO();
+    _jobPending = true;
+
+    auto const universeSize = _context->getSpaceProperties()->getSize();
+    worker->addJob(
+        boost::make_shared<_GetSpatialStatisticsJob>(getObjectId(), universeSize, _config.gridSize, _dataTO));
+}
+
+void SpatialStatisticsRecorderGpuImpl::jobsFinished()
+{
+    auto worker = _context->getCudaController()->getCudaWorker();
+    for (auto const& job : worker->getFinishedJobs(getObjectId())) {
+        if (auto const statisticsJob = boost::dynamic_pointer_cast<_GetSpatialStatisticsJob>(job)) {
+            _jobPending = false;
+            _lastStatistics = statisticsJob->getStatistics();
+            _nextTimestep = _lastStatistics.timestep + _config.interval;
+
+            auto const timestep = _lastStatistics.timestep;
+            if (!_statisticsWriter.appendFrame(_lastStatistics.values.data())
+                || !_timestepWriter.appendFrame(&timestep)) {
+                stopRecording("could not write to " + _config.filename);
+                return;
+            }
+            Q_EMIT statisticsRecorded();
+        }
+    }
+}
+
+void SpatialStatisticsRecorderGpuImpl::allocateDataTO()
+{
+    if (_dataTO) {
+        return;
+    }
+    auto dataTO = new DataAccessTO();
+    try {
+        dataTO->numClusters = new int;
+        dataTO->numCells = new int;
+        dataTO->numParticles = new int;
+        dataTO->numTokens = new int;
+        dataTO->numStringBytes = new int;
+        dataTO->clusters = new ClusterAccessTO[_cudaConstants.MAX_CLUSTERS];
+        dataTO->cells = new CellAccessTO[_cudaConstants.MAX_CELLS];
+        dataTO->particles = new ParticleAccessTO[_cudaConstants.MAX_PARTICLES];
+        dataTO->tokens = new TokenAccessTO[_cudaConstants.MAX_TOKENS];
+        dataTO->stringBytes = new char[_cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE];
+    } catch (std::bad_alloc const&) {
+        deleteDataTO(*dataTO);
+        delete dataTO;
+        throw BugReportException("There is not sufficient CPU memory available.");
+    }
+
+    //released by the last owner, i.e. the recorder or the job in case the recorder has been destroyed meanwhile
+    _dataTO = boost::shared_ptr<DataAccessTO>(dataTO, [](DataAccessTO* dataTO) {
+        deleteDataTO(*dataTO);
+        delete dataTO;
+    });
+}
+
+void SpatialStatisticsRecorderGpuImpl::deleteDataTO(DataAccessTO const& dataTO)
+{
+    delete dataTO.numClusters;
+    delete dataTO.numCells;
+    delete dataTO.numParticles;
+    delete dataTO.numTokens;
+    delete dataTO.numStringBytes;
+    delete[] dataTO.clusters;
+    delete[] dataTO.cells;
+    delete[] dataTO.particles;
+    delete[] dataTO.tokens;
+    delete[] dataTO.stringBytes;
+}
+
+void SpatialStatisticsRecorderGpuImpl::stopRecording(string const& reason)
+{
+    for (auto const& connection : _connections) {
+        QObject::disconnect(connection);
+    }
+    _connections.clear();
+    _statisticsWriter.close();
+    _timestepWriter.close();
+
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+    loggingService->logMessage(Priority::Important, "spatial statistics recording stopped: " + reason);
+}
+
+string SpatialStatisticsRecorderGpuImpl::getObjectId() const
+{
+    auto id = reinterpret_cast<long long>(this);
+    std::stringstream stream;
+    stream << SpatialStatisticsRecorderGpuId << id;
+    return stream.str();
+}
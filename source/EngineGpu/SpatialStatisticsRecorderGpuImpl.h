@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Base/NpyTimeSeriesWriter.h"
+#include "EngineGpuKernels/AccessTOs.cuh"
+#include "EngineGpuKernels/CudaConstants.h"
+
+#include "SpatialStatistics.h"
+#include "SpatialStatisticsRecorderGpu.h"
+#include "DefinitionsImpl.h"
+
+class SpatialStatisticsRecorderGpuImpl : public SpatialStatisticsRecorderGpu
+{
+    Q_OBJECT
+public:
+    SpatialStatisticsRecorderGpuImpl(QObject* parent = nullptr);
+    virtual ~SpatialStatisticsRecorderGpuImpl() = default;
+
+    virtual bool init(SimulationControllerGpu* controller, Config const& config) override;
+
+    virtual SpatialStatistics const& retrieveLastStatistics() const override;
+
+private:
+    Q_SLOT void timestepCalculated();
+    Q_SLOT void jobsFinished();
+
+    void allocateDataTO();
+    static void deleteDataTO(DataAccessTO const& dataTO);
+    void stopRecording(string const& reason);
+    string getObjectId() const;
+
+private:
+    list<QMetaObject::Connection> _connections;
+
+    SimulationContextGpuImpl* _context = nullptr;
+    Config _config;
+    CudaConstants _cudaConstants;
+    boost::shared_ptr<DataAccessTO> _dataTO;    //shared with a pending job, which may outlive the recorder
+    bool _jobPending = false;
+    int _nextTimestep = 0;
+
+    NpyTimeSeriesWriter _statisticsWriter;
+    NpyTimeSeriesWriter _timestepWriter;
+    SpatialStatistics _lastStatistics;
+};
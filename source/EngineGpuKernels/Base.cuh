@@ -6,6 +6,8 @@
 #include <device_launch_parameters.h>
 #include <helper_cuda.h>
 
+#include "Base/Philox.h"
+
 #include "Array.cuh"
 #include "CudaConstants.h"
 #include "CudaMemoryManager.cuh"
@@ -31,52 +33,47 @@ struct PartitionData
     __inline__ __device__ int numElements() const { return endIndex - startIndex + 1; }
 };
 
+//device counterpart of NumberGeneratorImpl, the value at position i equals the host value at position i for the
+//same seed and stream
 class CudaNumberGenerator
 {
 private:
-    unsigned int* _currentIndex;
-    int* _array;
-    int _size;
+    unsigned long long int* _currentIndex;
+    unsigned long long int _seed;
+    unsigned int _stream;
 
     unsigned long long int* _currentId;
 
 public:
-    void init(int size)
+    void init(unsigned long long int seed, unsigned int stream = 0)
     {
-        _size = size;
+        _seed = seed;
+        _stream = stream;
 
-        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(1, _currentIndex);
-        CudaMemoryManager::getInstance().acquireMemory<int>(size, _array);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned long long int>(1, _currentIndex);
         CudaMemoryManager::getInstance().acquireMemory<unsigned long long int>(1, _currentId);
 
-        checkCudaErrors(cudaMemset(_currentIndex, 0, sizeof(unsigned int)));
+        checkCudaErrors(cudaMemset(_currentIndex, 0, sizeof(unsigned long long int)));
         unsigned long long int hostCurrentId = 1;
         checkCudaErrors(cudaMemcpy(_currentId, &hostCurrentId, sizeof(_currentId), cudaMemcpyHostToDevice));
-
-        std::vector<int> randomNumbers(size);
-        for (int i = 0; i < size; ++i) {
-            randomNumbers[i] = rand();
-        }
-        checkCudaErrors(cudaMemcpy(_array, randomNumbers.data(), sizeof(int) * size, cudaMemcpyHostToDevice));
     }
 
 
     __device__ __inline__ int random(int maxVal)
     {
-        int number = getRandomNumber();
-        return number % (maxVal + 1);
+        auto number = getRandomNumber();
+        return static_cast<int>(Philox::toRange(number, static_cast<unsigned int>(maxVal) + 1ull));
     }
 
     __device__ __inline__ float random(float maxVal)
     {
-        int number = getRandomNumber();
-        return maxVal * static_cast<float>(number) / RAND_MAX;
+        return maxVal * random();
     }
 
     __device__ __inline__ float random()
     {
-        int number = getRandomNumber();
-        return static_cast<float>(number) / RAND_MAX;
+        auto number = getRandomNumber();
+        return Philox::toUnitInterval(number);
     }
 
     __device__ __inline__ unsigned long long int createNewId_kernel() { return atomicAdd(_currentId, 1); }
@@ -84,19 +81,17 @@ public:
     void free()
     {
         CudaMemoryManager::getInstance().freeMemory(_currentIndex);
-        CudaMemoryManager::getInstance().freeMemory(_array);
         CudaMemoryManager::getInstance().freeMemory(_currentId);
 
         cudaFree(_currentId);
         cudaFree(_currentIndex);
-        cudaFree(_array);
     }
 
 private:
-    __device__ __inline__ int getRandomNumber()
+    __device__ __inline__ unsigned int getRandomNumber()
     {
-        int index = atomicInc(_currentIndex, _size - 1);
-        return _array[index];
+        auto index = atomicAdd(_currentIndex, 1ull);
+        return Philox::generate(_seed, _stream, index / 4).values[index % 4];
     }
 };
 
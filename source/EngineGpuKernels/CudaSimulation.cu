@@ -26,6 +26,7 @@
 #include "CudaMemoryManager.cuh"
 #include "CudaMonitorData.cuh"
 #include "CudaSimulation.cuh"
+#include "DebugKernels.cuh"
 #include "Entities.cuh"
 #include "Map.cuh"
 #include "MonitorKernels.cuh"
@@ -115,7 +116,8 @@ CudaSimulation::CudaSimulation(
     int2 const& worldSize,
     int timestep,
     SimulationParameters const& parameters,
-    CudaConstants const& cudaConstants)
+    CudaConstants const& cudaConstants,
+    uint64_t seed)
 {
     CudaInitializer::init();
     CudaMemoryManager::getInstance().reset();
@@ -132,7 +134,7 @@ CudaSimulation::CudaSimulation(
 
     auto const memorySizeBefore = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
 
-    _cudaSimulationData->init(worldSize, cudaConstants, timestep);
+    _cudaSimulationData->init(worldSize, cudaConstants, timestep, seed);
     _cudaMonitorData->init();
 
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numCells);
@@ -395,6 +397,21 @@ void CudaSimulation::clear()
     GPU_FUNCTION(cudaClearData, *_cudaSimulationData);
 }
 
+void CudaSimulation::getRandomNumbers(int count, int maxValue, int* intValues, float* realValues)
+{
+    int* cudaIntValues;
+    float* cudaRealValues;
+    CudaMemoryManager::getInstance().acquireMemory<int>(count, cudaIntValues);
+    CudaMemoryManager::getInstance().acquireMemory<float>(count, cudaRealValues);
+
+    GPU_FUNCTION(DEBUG_getRandomNumbers, *_cudaSimulationData, count, maxValue, cudaIntValues, cudaRealValues);
+
+    checkCudaErrors(cudaMemcpy(intValues, cudaIntValues, sizeof(int) * count, cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(realValues, cudaRealValues, sizeof(float) * count, cudaMemcpyDeviceToHost));
+    CudaMemoryManager::getInstance().freeMemory(cudaIntValues);
+    CudaMemoryManager::getInstance().freeMemory(cudaRealValues);
+}
+
 namespace
 {
     void calcImageBlurFactors(int* imageBlurFactors)
@@ -4,6 +4,7 @@
 #include <windows.h>
 #endif
 #include <GL/gl.h>
+#include <cstdint>
 
 #include "CudaConstants.h"
 #include "Definitions.cuh"
@@ -14,11 +15,13 @@
 class ENGINEGPUKERNELS_EXPORT CudaSimulation
 {
 public:
+    //random numbers on the device are taken from stream 0 of seed, see Philox.h
     CudaSimulation(
         int2 const& worldSize,
         int timestep,
         SimulationParameters const& parameters,
-        CudaConstants const& cudaConstants);
+        CudaConstants const& cudaConstants,
+        uint64_t seed);
     ~CudaSimulation();
 
     void* registerImageResource(GLuint image);
@@ -62,6 +65,9 @@ public:
 
     void clear();
 
+    //draws count pairs of random(maxValue) and random() one after another from the device generator
+    void getRandomNumbers(int count, int maxValue, int* intValues, float* realValues);
+
 private:
     void setCudaConstants(CudaConstants const& cudaConstants);
     void DEBUG_printNumEntries();
@@ -14,3 +14,12 @@ __global__ void DEBUG_checkCluster(SimulationData data, int numClusters, int par
         DEBUG_cluster::check_block(&data, *clusterPointer, parameter);
     }
 }
+
+//single thread such that the values are drawn in a defined order
+__global__ void DEBUG_getRandomNumbers(SimulationData data, int count, int maxValue, int* intValues, float* realValues)
+{
+    for (int i = 0; i < count; ++i) {
+        intValues[i] = data.numberGen.random(maxValue);
+        realValues[i] = data.numberGen.random();
+    }
+}
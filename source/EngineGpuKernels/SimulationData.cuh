@@ -23,7 +23,7 @@ struct SimulationData
     int numImageBytes;
     unsigned int* imageData;
 
-    void init(int2 const& universeSize, CudaConstants const& cudaConstants, int timestep_)
+    void init(int2 const& universeSize, CudaConstants const& cudaConstants, int timestep_, uint64_t seed)
     {
         size = universeSize;
         timestep = timestep_;
@@ -34,7 +34,7 @@ struct SimulationData
         cellMap.init(size, cudaConstants.MAX_CELLPOINTERS, entities.cellPointers.getArrayForHost());
         particleMap.init(size, cudaConstants.MAX_PARTICLEPOINTERS);
         dynamicMemory.init(cudaConstants.DYNAMIC_MEMORY_SIZE);
-        numberGen.init(40312357);
+        numberGen.init(seed);
 
         numImageBytes = size.x * size.y;
         CudaMemoryManager::getInstance().acquireMemory<unsigned int>(numImageBytes, imageData);
@@ -19,6 +19,13 @@ public:
 	virtual ~CellComputerCompiler() = default;
 
 	virtual CompilationResult compileSourceCode(std::string const& code) const = 0;
+
+	//compiles and shortens the program by CellComputerOptimizer, the result decompiles to different source code
+	virtual CompilationResult compileOptimized(std::string const& code) const = 0;
+
+	//compiles the programs in parallel, results are in the same order as the source codes
+	virtual std::vector<CompilationResult> compileMany(std::vector<std::string> const& codes) const = 0;
+
 	virtual std::string decompileSourceCode(QByteArray const& data) const = 0;
 };
 
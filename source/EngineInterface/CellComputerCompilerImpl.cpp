@@ -1,5 +1,13 @@
-﻿#include "SymbolTable.h"
+﻿#include <array>
+#include <charconv>
+
+#include <boost/functional/hash.hpp>
+
+#include "Base/Parallel.h"
+
+#include "SymbolTable.h"
 #include "SimulationParameters.h"
+#include "CellComputerOptimizer.h"
 #include "CompilerHelper.h"
 #include "CellComputerCompilerImpl.h"
 
@@ -16,99 +24,237 @@ namespace
 		LOOKING_FOR_OP2_END
 	};
 
+	//tokens are views into the source code since each of them consists of consecutive characters
 	struct InstructionUncoded {
 		bool readingFinished = false;
-		QString name;
-		QString operand1;
-		QString operand2;
-		QString comp;
+		std::string_view name;
+		std::string_view operand1;
+		std::string_view operand2;
+		std::string_view comp;
+	};
+
+	//classification of all byte values, computed once with the same QChar tests the tokenizer used per character
+	class CharacterTable
+	{
+	public:
+		enum Class : uint8_t {
+			Letter = 1 << 0,
+			NameChar = 1 << 1,
+			OperandStart = 1 << 2,
+			OperandChar = 1 << 3,
+			Comparator = 1 << 4
+		};
+
+		CharacterTable()
+		{
+			for (int byte = 0; byte < 256; ++byte) {
+				auto const symbol = QChar::fromLatin1(static_cast<char>(byte));
+				auto const isNameChar = symbol.isLetterOrNumber() || symbol == ':';
+				auto const isOperandStart = isNameChar || symbol == '-' || symbol == '_' || symbol == '[' || symbol == '(';
+				uint8_t classes = 0;
+				if (symbol.isLetter()) {
+					classes |= Letter;
+				}
+				if (isNameChar) {
+					classes |= NameChar;
+				}
+				if (isOperandStart) {
+					classes |= OperandStart;
+				}
+				if (isOperandStart || symbol == ']' || symbol == ')') {
+					classes |= OperandChar;
+				}
+				if (symbol == '<' || symbol == '>' || symbol == '=' || symbol == '!') {
+					classes |= Comparator;
+				}
+				_classes[byte] = classes;
+			}
+		}
+
+		bool is(char symbol, Class characterClass) const
+		{
+			return (_classes[static_cast<uint8_t>(symbol)] & characterClass) != 0;
+		}
+
+	private:
+		std::array<uint8_t, 256> _classes;
 	};
 
-	bool isNameChar(const QChar& c)
+	CharacterTable const& getCharacterTable()
 	{
-		return c.isLetterOrNumber() || (c == ':');
+		static CharacterTable const result;
+		return result;
 	}
 
-	bool gotoNextStateAndReturnSuccess(CompilerState &state, QChar &currentSymbol, InstructionUncoded& instruction, int bytePos, int codeSize)
+	struct Keyword {
+		std::string_view name;
+		Enums::ComputerOperation::Type operation;
+	};
+
+	std::array<Keyword, 10> const Keywords = {{
+		{"mov", Enums::ComputerOperation::MOV},
+		{"add", Enums::ComputerOperation::ADD},
+		{"sub", Enums::ComputerOperation::SUB},
+		{"mul", Enums::ComputerOperation::MUL},
+		{"div", Enums::ComputerOperation::DIV},
+		{"xor", Enums::ComputerOperation::XOR},
+		{"or", Enums::ComputerOperation::OR},
+		{"and", Enums::ComputerOperation::AND},
+		{"else", Enums::ComputerOperation::ELSE},
+		{"endif", Enums::ComputerOperation::ENDIF}
+	}};
+
+	std::array<Keyword, 9> const Comparators = {{
+		{">", Enums::ComputerOperation::IFG},
+		{">=", Enums::ComputerOperation::IFGE},
+		{"=>", Enums::ComputerOperation::IFGE},
+		{"=", Enums::ComputerOperation::IFE},
+		{"==", Enums::ComputerOperation::IFE},
+		{"!=", Enums::ComputerOperation::IFNE},
+		{"<=", Enums::ComputerOperation::IFLE},
+		{"=<", Enums::ComputerOperation::IFLE},
+		{"<", Enums::ComputerOperation::IFL}
+	}};
+
+	//keyword has to be in lower case
+	bool equalsIgnoringCase(std::string_view text, std::string_view keyword)
+	{
+		if (text.size() != keyword.size()) {
+			return false;
+		}
+		for (size_t index = 0; index < text.size(); ++index) {
+			auto symbol = text[index];
+			if (symbol >= 'A' && symbol <= 'Z') {
+				symbol += 'a' - 'A';
+			}
+			if (symbol != keyword[index]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool isBlockEnd(std::string_view name)
 	{
+		return equalsIgnoringCase(name, "else") || equalsIgnoringCase(name, "endif");
+	}
+
+	boost::optional<Enums::ComputerOperation::Type> findOperation(InstructionUncoded const& instruction)
+	{
+		if (equalsIgnoringCase(instruction.name, "if")) {
+			for (auto const& comparator : Comparators) {
+				if (instruction.comp == comparator.name) {
+					return comparator.operation;
+				}
+			}
+			return boost::none;
+		}
+		for (auto const& keyword : Keywords) {
+			if (equalsIgnoringCase(instruction.name, keyword.name)) {
+				return keyword.operation;
+			}
+		}
+		return boost::none;
+	}
+
+	void startToken(std::string_view& token, std::string_view code, int bytePos)
+	{
+		token = code.substr(bytePos, 1);
+	}
+
+	void extendToken(std::string_view& token, std::string_view code, int bytePos)
+	{
+		if (token.empty()) {
+			startToken(token, code, bytePos);
+		}
+		else {
+			token = std::string_view(token.data(), token.size() + 1);
+		}
+	}
+
+	bool gotoNextStateAndReturnSuccess(CompilerState &state, std::string_view code, int bytePos, InstructionUncoded& instruction)
+	{
+		auto const& table = getCharacterTable();
+		auto const currentSymbol = code[bytePos];
+		auto const codeSize = static_cast<int>(code.size());
 		switch (state) {
 		case CompilerState::LOOKING_FOR_INSTR_START: {
-			if (currentSymbol.isLetter()) {
+			if (table.is(currentSymbol, CharacterTable::Letter)) {
 				state = CompilerState::LOOKING_FOR_INSTR_END;
-				instruction.name = currentSymbol;
+				startToken(instruction.name, code, bytePos);
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_INSTR_END: {
-			if (!currentSymbol.isLetter()) {
-				if ((instruction.name.toLower() == "else") || (instruction.name.toLower() == "endif"))
+			if (!table.is(currentSymbol, CharacterTable::Letter)) {
+				if (isBlockEnd(instruction.name))
 					instruction.readingFinished = true;
 				else
 					state = CompilerState::LOOKING_FOR_OP1_START;
 			}
 			else {
-				instruction.name += currentSymbol;
-				if ((bytePos + 1) == codeSize && ((instruction.name.toLower() == "else") || (instruction.name.toLower() == "endif")))
+				extendToken(instruction.name, code, bytePos);
+				if ((bytePos + 1) == codeSize && isBlockEnd(instruction.name))
 					instruction.readingFinished = true;
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_OP1_START: {
-			if (isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[') || (currentSymbol == '(')) {
+			if (table.is(currentSymbol, CharacterTable::OperandStart)) {
 				state = CompilerState::LOOKING_FOR_OP1_END;
-				instruction.operand1 = currentSymbol;
+				startToken(instruction.operand1, code, bytePos);
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_OP1_END: {
-			if ((currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!')) {
+			if (table.is(currentSymbol, CharacterTable::Comparator)) {
 				state = CompilerState::LOOKING_FOR_COMPARATOR;
-				instruction.comp = currentSymbol;
+				startToken(instruction.comp, code, bytePos);
 			}
 			else if (currentSymbol == ',')
 				state = CompilerState::LOOKING_FOR_OP2_START;
-			else if (!isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[') && (currentSymbol != ']') && (currentSymbol != '(') && (currentSymbol != ')'))
+			else if (!table.is(currentSymbol, CharacterTable::OperandChar))
 				state = CompilerState::LOOKING_FOR_SEPARATOR;
 			else
-				instruction.operand1 += currentSymbol;
+				extendToken(instruction.operand1, code, bytePos);
 		}
 		break;
 		case CompilerState::LOOKING_FOR_SEPARATOR: {
 			if (currentSymbol == ',')
 				state = CompilerState::LOOKING_FOR_OP2_START;
-			else if ((currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!')) {
+			else if (table.is(currentSymbol, CharacterTable::Comparator)) {
 				state = CompilerState::LOOKING_FOR_COMPARATOR;
-				instruction.comp = currentSymbol;
+				startToken(instruction.comp, code, bytePos);
 			}
-			else if (isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[') || (currentSymbol == ']') || (currentSymbol == '(') || (currentSymbol == ')'))
+			else if (table.is(currentSymbol, CharacterTable::OperandChar))
 				return false;
 		}
 		break;
 		case CompilerState::LOOKING_FOR_COMPARATOR: {
-			if ((currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!'))
-				instruction.comp += currentSymbol;
-			else if (!isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[') && (currentSymbol != '('))
+			if (table.is(currentSymbol, CharacterTable::Comparator))
+				extendToken(instruction.comp, code, bytePos);
+			else if (!table.is(currentSymbol, CharacterTable::OperandStart))
 				state = CompilerState::LOOKING_FOR_OP2_START;
 			else {
 				state = CompilerState::LOOKING_FOR_OP2_END;
-				instruction.operand2 = currentSymbol;
+				startToken(instruction.operand2, code, bytePos);
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_OP2_START: {
-			if (isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[') || (currentSymbol == '(')) {
+			if (table.is(currentSymbol, CharacterTable::OperandStart)) {
 				state = CompilerState::LOOKING_FOR_OP2_END;
-				instruction.operand2 = currentSymbol;
+				startToken(instruction.operand2, code, bytePos);
 				if (bytePos == (codeSize - 1))
 					instruction.readingFinished = true;
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_OP2_END: {
-			if (!isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[') && (currentSymbol != ']') && (currentSymbol != '(') && (currentSymbol != ')'))
+			if (!table.is(currentSymbol, CharacterTable::OperandChar))
 				instruction.readingFinished = true;
 			else {
-				instruction.operand2 += currentSymbol;
+				extendToken(instruction.operand2, code, bytePos);
 				if ((bytePos + 1) == codeSize)
 					instruction.readingFinished = true;
 			}
@@ -116,152 +262,121 @@ namespace
 		break;
 		}
 		if ((currentSymbol == '\n') || ((bytePos + 1) == codeSize)) {
-			if (!instruction.name.isEmpty()) {
+			if (!instruction.name.empty()) {
 				instruction.readingFinished = true;
 			}
 		}
 		return true;
 	}
 
-	QString applyTableToCode(SymbolTable const* symbols, QString s)
+	bool startsWith(std::string_view text, std::string_view prefix)
 	{
-		QString prefix;
-		QString postfix;
-		for (int i = 0; i < 2; ++i) {
-			if (s.left(1) == "[" || s.left(1) == "(") {
-				prefix = prefix + s.left(1);
-				s = s.mid(1);
-			}
+		return text.substr(0, prefix.size()) == prefix;
+	}
+
+	bool endsWith(std::string_view text, std::string_view suffix)
+	{
+		return text.size() >= suffix.size() && text.substr(text.size() - suffix.size()) == suffix;
+	}
+
+	//returns the operand with the symbol inside the brackets resolved, buffer is only used if the symbol is found
+	std::string_view applyTableToCode(SymbolTableIndex const& symbols, std::string_view operand, string& buffer)
+	{
+		size_t prefixSize = 0;
+		while (prefixSize < 2 && prefixSize < operand.size() && (operand[prefixSize] == '[' || operand[prefixSize] == '(')) {
+			++prefixSize;
 		}
-		for (int i = 0; i < 2; ++i) {
-			if (s.right(1) == "]" || s.right(1) == ")") {
-				postfix = s.right(1) + postfix;
-				s.chop(1);
-			}
+		auto symbol = operand.substr(prefixSize);
+		size_t postfixSize = 0;
+		while (postfixSize < 2 && postfixSize < symbol.size()
+			&& (symbol[symbol.size() - 1 - postfixSize] == ']' || symbol[symbol.size() - 1 - postfixSize] == ')')) {
+			++postfixSize;
+		}
+		symbol.remove_suffix(postfixSize);
+
+		auto const value = symbols.getValue(symbol);
+		if (value == symbol) {
+			return operand;
 		}
-		s = QString::fromStdString(symbols->getValue(s.toStdString()));
-		return prefix + s + postfix;
+		buffer.assign(operand.substr(0, prefixSize));
+		buffer += value;
+		buffer.append(operand.substr(operand.size() - postfixSize));
+		return buffer;
 	}
 
-	bool resolveInstructionAndReturnSuccess(SymbolTable const* symbols, InstructionCoded& instructionCoded, InstructionUncoded instructionUncoded)
+	//removes the brackets of a memory operand
+	Enums::ComputerOptype::Type extractOperandType(std::string_view& operand)
 	{
-		instructionUncoded.operand1 = applyTableToCode(symbols, instructionUncoded.operand1);
-		instructionUncoded.operand2 = applyTableToCode(symbols, instructionUncoded.operand2);
-
-		//prepare data for instruction coding
-		if (instructionUncoded.name.toLower() == "mov")
-			instructionCoded.operation = Enums::ComputerOperation::MOV;
-		else if (instructionUncoded.name.toLower() == "add")
-			instructionCoded.operation = Enums::ComputerOperation::ADD;
-		else if (instructionUncoded.name.toLower() == "sub")
-			instructionCoded.operation = Enums::ComputerOperation::SUB;
-		else if (instructionUncoded.name.toLower() == "mul")
-			instructionCoded.operation = Enums::ComputerOperation::MUL;
-		else if (instructionUncoded.name.toLower() == "div")
-			instructionCoded.operation = Enums::ComputerOperation::DIV;
-		else if (instructionUncoded.name.toLower() == "xor")
-			instructionCoded.operation = Enums::ComputerOperation::XOR;
-		else if (instructionUncoded.name.toLower() == "or")
-			instructionCoded.operation = Enums::ComputerOperation::OR;
-		else if (instructionUncoded.name.toLower() == "and")
-			instructionCoded.operation = Enums::ComputerOperation::AND;
-		else if (instructionUncoded.name.toLower() == "if") {
-			if (instructionUncoded.comp.toLower() == ">")
-				instructionCoded.operation = Enums::ComputerOperation::IFG;
-			else if ((instructionUncoded.comp.toLower() == ">=") || (instructionUncoded.comp.toLower() == "=>"))
-				instructionCoded.operation = Enums::ComputerOperation::IFGE;
-			else if ((instructionUncoded.comp.toLower() == "=") || (instructionUncoded.comp.toLower() == "=="))
-				instructionCoded.operation = Enums::ComputerOperation::IFE;
-			else if (instructionUncoded.comp.toLower() == "!=")
-				instructionCoded.operation = Enums::ComputerOperation::IFNE;
-			else if ((instructionUncoded.comp.toLower() == "<=") || (instructionUncoded.comp.toLower() == "=<"))
-				instructionCoded.operation = Enums::ComputerOperation::IFLE;
-			else if (instructionUncoded.comp.toLower() == "<")
-				instructionCoded.operation = Enums::ComputerOperation::IFL;
-			else {
-				return false;
-			}
+		if (startsWith(operand, "[[") && endsWith(operand, "]]")) {
+			operand = operand.substr(2, operand.size() - 4);
+			return Enums::ComputerOptype::MEMMEM;
 		}
-		else if (instructionUncoded.name.toLower() == "else")
-			instructionCoded.operation = Enums::ComputerOperation::ELSE;
-		else if (instructionUncoded.name.toLower() == "endif")
-			instructionCoded.operation = Enums::ComputerOperation::ENDIF;
-		else {
-			return false;
+		if (startsWith(operand, "[") && endsWith(operand, "]")) {
+			operand = operand.substr(1, operand.size() - 2);
+			return Enums::ComputerOptype::MEM;
+		}
+		if (startsWith(operand, "(") && endsWith(operand, ")")) {
+			operand = operand.substr(1, operand.size() - 2);
+			return Enums::ComputerOptype::CMEM;
 		}
+		return Enums::ComputerOptype::CONSTANT;
+	}
 
-		if (instructionCoded.operation != Enums::ComputerOperation::ELSE && instructionCoded.operation != Enums::ComputerOperation::ENDIF) {
-			if ((instructionUncoded.operand1.left(2) == "[[") && (instructionUncoded.operand1.right(2) == "]]")) {
-				instructionCoded.opType1 = Enums::ComputerOptype::MEMMEM;
-				instructionUncoded.operand1 = instructionUncoded.operand1.remove(0, 2);
-				instructionUncoded.operand1.chop(2);
-			}
-			else if ((instructionUncoded.operand1.left(1) == "[") && (instructionUncoded.operand1.right(1) == "]")) {
-				instructionCoded.opType1 = Enums::ComputerOptype::MEM;
-				instructionUncoded.operand1 = instructionUncoded.operand1.remove(0, 1);
-				instructionUncoded.operand1.chop(1);
-			}
-			else if ((instructionUncoded.operand1.left(1) == "(") && (instructionUncoded.operand1.right(1) == ")")) {
-				instructionCoded.opType1 = Enums::ComputerOptype::CMEM;
-				instructionUncoded.operand1 = instructionUncoded.operand1.remove(0, 1);
-				instructionUncoded.operand1.chop(1);
-			}
-			else {
-				return false;
-			}
+	//accepts the same formats as QString::toInt with base 16 for a leading "0x" and base 10 otherwise
+	bool parseNumberAndReturnSuccess(std::string_view text, uint8_t& result)
+	{
+		auto base = 10;
+		if (startsWith(text, "0x")) {
+			text.remove_prefix(2);
+			base = 16;
+		}
+		auto isSpace = [](char symbol) { return symbol == ' ' || (symbol >= '\t' && symbol <= '\r'); };
+		while (!text.empty() && isSpace(text.front())) {
+			text.remove_prefix(1);
+		}
+		while (!text.empty() && isSpace(text.back())) {
+			text.remove_suffix(1);
+		}
+		if (text.size() > 1 && text.front() == '+' && text[1] != '-') {
+			text.remove_prefix(1);
+		}
 
-			if ((instructionUncoded.operand2.left(2) == "[[") && (instructionUncoded.operand2.right(2) == "]]")) {
-				instructionCoded.opType2 = Enums::ComputerOptype::MEMMEM;
-				instructionUncoded.operand2 = instructionUncoded.operand2.remove(0, 2);
-				instructionUncoded.operand2.chop(2);
-			}
-			else if ((instructionUncoded.operand2.left(1) == "[") && (instructionUncoded.operand2.right(1) == "]")) {
-				instructionCoded.opType2 = Enums::ComputerOptype::MEM;
-				instructionUncoded.operand2 = instructionUncoded.operand2.remove(0, 1);
-				instructionUncoded.operand2.chop(1);
-			}
-			else if ((instructionUncoded.operand2.left(1) == "(") && (instructionUncoded.operand2.right(1) == ")")) {
-				instructionCoded.opType2 = Enums::ComputerOptype::CMEM;
-				instructionUncoded.operand2 = instructionUncoded.operand2.remove(0, 1);
-				instructionUncoded.operand2.chop(1);
-			}
-			else
-				instructionCoded.opType2 = Enums::ComputerOptype::CONSTANT;
+		int value = 0;
+		auto const end = text.data() + text.size();
+		auto const conversion = std::from_chars(text.data(), end, value, base);
+		if (conversion.ec != std::errc() || conversion.ptr != end) {
+			return false;
+		}
+		result = static_cast<uint8_t>(value);
+		return true;
+	}
 
+	bool resolveInstructionAndReturnSuccess(SymbolTableIndex const& symbols, InstructionCoded& instructionCoded, InstructionUncoded const& instructionUncoded)
+	{
+		string buffer1;
+		string buffer2;
+		auto operand1 = applyTableToCode(symbols, instructionUncoded.operand1, buffer1);
+		auto operand2 = applyTableToCode(symbols, instructionUncoded.operand2, buffer2);
 
-			if (instructionUncoded.operand1.left(2) == "0x") {
-				bool ok(true);
-				instructionCoded.operand1 = instructionUncoded.operand1.remove(0, 2).toInt(&ok, 16);
-				if (!ok) {
-					return false;
-				}
-			}
-			else {
-				bool ok(true);
-				instructionCoded.operand1 = instructionUncoded.operand1.toInt(&ok, 10);
-				if (!ok)
-					return false;
-			}
-			if (instructionUncoded.operand2.left(2) == "0x") {
-				bool ok(true);
-				instructionCoded.operand2 = instructionUncoded.operand2.remove(0, 2).toInt(&ok, 16);
-				if (!ok) {
-					return false;
-				}
-			}
-			else {
-				bool ok(true);
-				instructionCoded.operand2 = instructionUncoded.operand2.toInt(&ok, 10);
-				if (!ok) {
-					return false;
-				}
-			}
+		auto const operation = findOperation(instructionUncoded);
+		if (!operation) {
+			return false;
 		}
-		else {
+		instructionCoded.operation = *operation;
+
+		if (instructionCoded.operation == Enums::ComputerOperation::ELSE || instructionCoded.operation == Enums::ComputerOperation::ENDIF) {
 			instructionCoded.operand1 = 0;
 			instructionCoded.operand2 = 0;
+			return true;
 		}
-		return true;
+
+		instructionCoded.opType1 = extractOperandType(operand1);
+		if (instructionCoded.opType1 == Enums::ComputerOptype::CONSTANT) {
+			return false;
+		}
+		instructionCoded.opType2 = extractOperandType(operand2);
+		return parseNumberAndReturnSuccess(operand1, instructionCoded.operand1)
+			&& parseNumberAndReturnSuccess(operand2, instructionCoded.operand2);
 	}
 }
 
@@ -275,9 +390,61 @@ void CellComputerCompilerImpl::init(SymbolTable const* symbols, SimulationParame
 {
 	_symbols = symbols;
 	_parameters = parameters;
+
+	std::lock_guard<std::mutex> lock(_cacheMutex);
+	_cache.clear();
 }
 
 CompilationResult CellComputerCompilerImpl::compileSourceCode(std::string const & code) const
+{
+	return compileSourceCodeCached(code, *_symbols->getIndex());
+}
+
+CompilationResult CellComputerCompilerImpl::compileOptimized(std::string const& code) const
+{
+	auto result = compileSourceCode(code);
+	if (result.compilationOk) {
+		result.compilation = CellComputerOptimizer::optimize(result.compilation, _parameters);
+	}
+	return result;
+}
+
+std::vector<CompilationResult> CellComputerCompilerImpl::compileMany(std::vector<std::string> const& codes) const
+{
+	auto const symbols = _symbols->getIndex();
+	std::vector<CompilationResult> result(codes.size());
+	Parallel::forEach(
+		0,
+		static_cast<int>(codes.size()),
+		[&](int index) { result[index] = compileSourceCodeCached(codes[index], *symbols); },
+		CompilationGrainSize);
+	return result;
+}
+
+CompilationResult CellComputerCompilerImpl::compileSourceCodeCached(std::string const& code, SymbolTableIndex const& symbols) const
+{
+	auto const symbolsHash = symbols.getHash();
+	auto cacheKey = std::hash<std::string>()(code);
+	boost::hash_combine(cacheKey, symbolsHash);
+	{
+		std::lock_guard<std::mutex> lock(_cacheMutex);
+		auto const findResult = _cache.find(cacheKey);
+		if (findResult != _cache.end() && findResult->second.symbolsHash == symbolsHash && findResult->second.code == code) {
+			return findResult->second.result;
+		}
+	}
+
+	auto const result = compileSourceCodeUncached(code, symbols);
+
+	std::lock_guard<std::mutex> lock(_cacheMutex);
+	if (_cache.size() >= MaxCacheSize) {
+		_cache.clear();
+	}
+	_cache[cacheKey] = {code, symbolsHash, result};
+	return result;
+}
+
+CompilationResult CellComputerCompilerImpl::compileSourceCodeUncached(std::string_view code, SymbolTableIndex const& symbols) const
 {
 	CompilerState state = CompilerState::LOOKING_FOR_INSTR_START;
 
@@ -285,17 +452,15 @@ CompilationResult CellComputerCompilerImpl::compileSourceCode(std::string const
 	int linePos = 0;
 	InstructionUncoded instructionUncoded;
 	InstructionCoded instructionCoded;
-	for (int bytePos = 0; bytePos < code.length(); ++bytePos) {
-		QChar currentSymbol = code[bytePos];
-
-		if (!gotoNextStateAndReturnSuccess(state, currentSymbol, instructionUncoded, bytePos, code.length())) {
+	for (int bytePos = 0; bytePos < static_cast<int>(code.size()); ++bytePos) {
+		if (!gotoNextStateAndReturnSuccess(state, code, bytePos, instructionUncoded)) {
 			result.compilationOk = false;
 			result.lineOfFirstError = linePos;
 			return result;
 		}
 		if (instructionUncoded.readingFinished) {
 			linePos++;
-			if (!resolveInstructionAndReturnSuccess(_symbols, instructionCoded, instructionUncoded)) {
+			if (!resolveInstructionAndReturnSuccess(symbols, instructionCoded, instructionUncoded)) {
 				result.compilationOk = false;
 				result.lineOfFirstError = linePos;
 				return result;
@@ -305,8 +470,9 @@ CompilationResult CellComputerCompilerImpl::compileSourceCode(std::string const
 			instructionUncoded = InstructionUncoded();
 		}
 	}
-	if (state == CompilerState::LOOKING_FOR_INSTR_START)
+	if (state == CompilerState::LOOKING_FOR_INSTR_START) {
 		result.compilationOk = true;
+	}
 	else {
 		result.compilationOk = false;
 		result.lineOfFirstError = linePos;
@@ -1,7 +1,11 @@
 ﻿#pragma once
 
+#include <mutex>
+#include <string_view>
+
 #include "Definitions.h"
 #include "CellComputerCompiler.h"
+#include "SymbolTableIndex.h"
 
 class CellComputerCompilerImpl
 	: public CellComputerCompiler
@@ -14,9 +18,27 @@ public:
 	void init(SymbolTable const* symbols, SimulationParameters const& parameters);
 
 	virtual CompilationResult compileSourceCode(std::string const& code) const override;
+	virtual CompilationResult compileOptimized(std::string const& code) const override;
+	virtual std::vector<CompilationResult> compileMany(std::vector<std::string> const& codes) const override;
 	virtual std::string decompileSourceCode(QByteArray const& data) const override;
 
 private:
+	CompilationResult compileSourceCodeCached(std::string const& code, SymbolTableIndex const& symbols) const;
+	CompilationResult compileSourceCodeUncached(std::string_view code, SymbolTableIndex const& symbols) const;
+
+	static int const CompilationGrainSize = 64;
+	static size_t const MaxCacheSize = 4096;
+
 	SymbolTable const* _symbols = nullptr;
 	SimulationParameters _parameters;
+
+	//compilations by hash of source code and symbol table, cleared when it becomes too large
+	struct CacheEntry
+	{
+		std::string code;
+		size_t symbolsHash = 0;
+		CompilationResult result;
+	};
+	mutable std::mutex _cacheMutex;
+	mutable unordered_map<size_t, CacheEntry> _cache;
 };
@@ -0,0 +1,303 @@
+#include "CellComputerMachine.h"
+
+#include <algorithm>
+
+#include "Base/Parallel.h"
+
+#include "CompilerHelper.h"
+
+namespace
+{
+    //number of tokens processed together, the per-token state of a block is kept on the stack
+    int const BlockSize = 256;
+
+    uint64_t getConditionMask(int condPointer)
+    {
+        return condPointer >= 64 ? ~uint64_t(0) : (uint64_t(1) << condPointer) - 1;
+    }
+
+    //target is either a pointer to consecutive bytes (constant address) or the memory with per-token offsets
+    struct Target
+    {
+        int8_t* bytes = nullptr;
+        int8_t* memory = nullptr;
+        int const* offsets = nullptr;
+
+        int8_t& get(int lane) const { return bytes ? bytes[lane] : memory[offsets[lane]]; }
+    };
+
+    template <typename Func>
+    void apply(Target const& target, uint8_t const* operands, uint8_t const* execute, int width, Func const& func)
+    {
+        if (target.bytes) {
+            auto bytes = target.bytes;
+            for (int lane = 0; lane < width; ++lane) {
+                auto const value = static_cast<int8_t>(func(bytes[lane], operands[lane]));
+                bytes[lane] = execute[lane] ? value : bytes[lane];
+            }
+        } else {
+            for (int lane = 0; lane < width; ++lane) {
+                auto& byte = target.memory[target.offsets[lane]];
+                if (execute[lane]) {
+                    byte = static_cast<int8_t>(func(byte, operands[lane]));
+                }
+            }
+        }
+    }
+
+    template <typename Func>
+    void pushCondition(
+        Target const& target,
+        uint8_t const* operands,
+        uint64_t* condBits,
+        int condPointer,
+        int width,
+        Func const& func)
+    {
+        auto const bit = uint64_t(1) << condPointer;
+        for (int lane = 0; lane < width; ++lane) {
+            auto const value = static_cast<uint8_t>(target.get(lane));
+            condBits[lane] = func(value, operands[lane]) ? (condBits[lane] | bit) : (condBits[lane] & ~bit);
+        }
+    }
+}
+
+CellComputerMachine::CellComputerMachine(SimulationParameters const& parameters)
+    : _tokenMemorySize(std::max(1, parameters.tokenMemorySize))
+    , _cellMemorySize(std::max(1, parameters.cellFunctionComputerCellMemorySize))
+    , _maxInstructions(std::min(parameters.cellFunctionComputerMaxInstructions, MaxInstructions))
+{}
+
+int CellComputerMachine::Program::getNumInstructions() const
+{
+    return static_cast<int>(_instructions.size());
+}
+
+auto CellComputerMachine::decode(QByteArray const& code) const -> Program
+{
+    auto const numBytes = std::min(static_cast<int>(code.size()), std::max(0, _maxInstructions) * 3);
+    auto paddedCode = code.left(numBytes);
+    paddedCode.append(QByteArray(2, 0));
+
+    Program result;
+    for (int instructionPointer = 0; instructionPointer < numBytes;) {
+        Program::Instruction instruction;
+        CompilerHelper::readInstruction(paddedCode, instructionPointer, instruction.coded);
+        auto const& coded = instruction.coded;
+        instruction.address1 = CompilerHelper::convertToAddress(
+            coded.operand1, coded.opType1 == Enums::ComputerOptype::CMEM ? _cellMemorySize : _tokenMemorySize);
+        instruction.address2 = CompilerHelper::convertToAddress(
+            coded.operand2, coded.opType2 == Enums::ComputerOptype::CMEM ? _cellMemorySize : _tokenMemorySize);
+        result._instructions.emplace_back(instruction);
+    }
+    return result;
+}
+
+CellComputerMachine::Batch::Batch(int numTokens, int tokenMemorySize, int cellMemorySize)
+    : _numTokens(numTokens)
+    , _tokenMemorySize(tokenMemorySize)
+    , _cellMemorySize(cellMemorySize)
+    , _tokenMemory(static_cast<size_t>(numTokens) * tokenMemorySize, 0)
+    , _cellMemory(static_cast<size_t>(numTokens) * cellMemorySize, 0)
+{}
+
+int CellComputerMachine::Batch::getNumTokens() const
+{
+    return _numTokens;
+}
+
+void CellComputerMachine::Batch::setTokenMemory(int tokenIndex, QByteArray const& memory)
+{
+    for (int address = 0; address < _tokenMemorySize; ++address) {
+        _tokenMemory[static_cast<size_t>(address) * _numTokens + tokenIndex] = address < memory.size() ? memory[address] : 0;
+    }
+}
+
+QByteArray CellComputerMachine::Batch::getTokenMemory(int tokenIndex) const
+{
+    QByteArray result(_tokenMemorySize, 0);
+    for (int address = 0; address < _tokenMemorySize; ++address) {
+        result[address] = _tokenMemory[static_cast<size_t>(address) * _numTokens + tokenIndex];
+    }
+    return result;
+}
+
+void CellComputerMachine::Batch::setCellMemory(int tokenIndex, QByteArray const& memory)
+{
+    for (int address = 0; address < _cellMemorySize; ++address) {
+        _cellMemory[static_cast<size_t>(address) * _numTokens + tokenIndex] = address < memory.size() ? memory[address] : 0;
+    }
+}
+
+QByteArray CellComputerMachine::Batch::getCellMemory(int tokenIndex) const
+{
+    QByteArray result(_cellMemorySize, 0);
+    for (int address = 0; address < _cellMemorySize; ++address) {
+        result[address] = _cellMemory[static_cast<size_t>(address) * _numTokens + tokenIndex];
+    }
+    return result;
+}
+
+vector<int8_t>& CellComputerMachine::Batch::getTokenMemoryRef()
+{
+    return _tokenMemory;
+}
+
+vector<int8_t>& CellComputerMachine::Batch::getCellMemoryRef()
+{
+    return _cellMemory;
+}
+
+auto CellComputerMachine::createBatch(int numTokens) const -> Batch
+{
+    return Batch(numTokens, _tokenMemorySize, _cellMemorySize);
+}
+
+void CellComputerMachine::execute(Program const& program, Batch& batch) const
+{
+    auto const numBlocks = (batch._numTokens + BlockSize - 1) / BlockSize;
+    Parallel::forEach(
+        0,
+        numBlocks,
+        [&](int blockIndex) {
+            auto const begin = blockIndex * BlockSize;
+            executeBlock(program, batch, begin, std::min(begin + BlockSize, batch._numTokens));
+        },
+        1);
+}
+
+void CellComputerMachine::execute(Program const& program, QByteArray& tokenMemory, QByteArray& cellMemory) const
+{
+    auto batch = createBatch(1);
+    batch.setTokenMemory(0, tokenMemory);
+    batch.setCellMemory(0, cellMemory);
+    execute(program, batch);
+    tokenMemory = batch.getTokenMemory(0);
+    cellMemory = batch.getCellMemory(0);
+}
+
+void CellComputerMachine::executeBlock(Program const& program, Batch& batch, int begin, int end) const
+{
+    using Operation = Enums::ComputerOperation;
+    using Optype = Enums::ComputerOptype;
+
+    auto const width = end - begin;
+    auto const stride = batch._numTokens;
+    auto const tokenMemory = batch._tokenMemory.data() + begin;
+    auto const cellMemory = batch._cellMemory.data() + begin;
+
+    uint64_t condBits[BlockSize] = {};
+    uint8_t operands[BlockSize];
+    uint8_t execute[BlockSize];
+    int offsets[BlockSize];
+    int condPointer = 0;
+
+    for (auto const& instruction : program._instructions) {
+        auto const& coded = instruction.coded;
+
+        //operand 1: pointer to memory
+        Target target;
+        if (coded.opType1 == Optype::MEM) {
+            target.bytes = tokenMemory + instruction.address1 * stride;
+        } else if (coded.opType1 == Optype::MEMMEM) {
+            auto const pointers = tokenMemory + instruction.address1 * stride;
+            for (int lane = 0; lane < width; ++lane) {
+                offsets[lane] = CompilerHelper::convertToAddress(pointers[lane], _tokenMemorySize) * stride + lane;
+            }
+            target.memory = tokenMemory;
+            target.offsets = offsets;
+        } else {
+            target.bytes = cellMemory + instruction.address1 * stride;
+        }
+
+        //operand 2: loading value
+        if (coded.opType2 == Optype::MEM) {
+            auto const values = tokenMemory + instruction.address2 * stride;
+            for (int lane = 0; lane < width; ++lane) {
+                operands[lane] = values[lane];
+            }
+        } else if (coded.opType2 == Optype::MEMMEM) {
+            auto const pointers = tokenMemory + instruction.address2 * stride;
+            for (int lane = 0; lane < width; ++lane) {
+                auto const address = CompilerHelper::convertToAddress(pointers[lane], _tokenMemorySize);
+                operands[lane] = tokenMemory[address * stride + lane];
+            }
+        } else if (coded.opType2 == Optype::CMEM) {
+            auto const values = cellMemory + instruction.address2 * stride;
+            for (int lane = 0; lane < width; ++lane) {
+                operands[lane] = values[lane];
+            }
+        } else {
+            std::fill(operands, operands + width, coded.operand2);
+        }
+
+        //execute instruction
+        if (coded.operation <= Operation::AND) {
+            auto const condMask = getConditionMask(condPointer);
+            for (int lane = 0; lane < width; ++lane) {
+                execute[lane] = (condBits[lane] & condMask) == condMask ? 1 : 0;
+            }
+        }
+        switch (coded.operation) {
+        case Operation::MOV:
+            apply(target, operands, execute, width, [](int8_t, uint8_t operand) { return operand; });
+            break;
+        case Operation::ADD:
+            apply(target, operands, execute, width, [](int8_t value, uint8_t operand) { return value + operand; });
+            break;
+        case Operation::SUB:
+            apply(target, operands, execute, width, [](int8_t value, uint8_t operand) { return value - operand; });
+            break;
+        case Operation::MUL:
+            apply(target, operands, execute, width, [](int8_t value, uint8_t operand) { return value * operand; });
+            break;
+        case Operation::DIV:
+            apply(target, operands, execute, width, [](int8_t value, uint8_t operand) {
+                return operand > 0 ? value / operand : 0;
+            });
+            break;
+        case Operation::XOR:
+            apply(target, operands, execute, width, [](int8_t value, uint8_t operand) { return value ^ operand; });
+            break;
+        case Operation::OR:
+            apply(target, operands, execute, width, [](int8_t value, uint8_t operand) { return value | operand; });
+            break;
+        case Operation::AND:
+            apply(target, operands, execute, width, [](int8_t value, uint8_t operand) { return value & operand; });
+            break;
+
+        //if instructions compare the unsigned bytes
+        case Operation::IFG:
+            pushCondition(target, operands, condBits, condPointer++, width, [](uint8_t lhs, uint8_t rhs) { return lhs > rhs; });
+            break;
+        case Operation::IFGE:
+            pushCondition(target, operands, condBits, condPointer++, width, [](uint8_t lhs, uint8_t rhs) { return lhs >= rhs; });
+            break;
+        case Operation::IFE:
+            pushCondition(target, operands, condBits, condPointer++, width, [](uint8_t lhs, uint8_t rhs) { return lhs == rhs; });
+            break;
+        case Operation::IFNE:
+            pushCondition(target, operands, condBits, condPointer++, width, [](uint8_t lhs, uint8_t rhs) { return lhs != rhs; });
+            break;
+        case Operation::IFLE:
+            pushCondition(target, operands, condBits, condPointer++, width, [](uint8_t lhs, uint8_t rhs) { return lhs <= rhs; });
+            break;
+        case Operation::IFL:
+            pushCondition(target, operands, condBits, condPointer++, width, [](uint8_t lhs, uint8_t rhs) { return lhs < rhs; });
+            break;
+        case Operation::ELSE:
+            if (condPointer > 0) {
+                auto const bit = uint64_t(1) << (condPointer - 1);
+                for (int lane = 0; lane < width; ++lane) {
+                    condBits[lane] ^= bit;
+                }
+            }
+            break;
+        case Operation::ENDIF:
+            if (condPointer > 0) {
+                --condPointer;
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Host-side interpreter for compiled cell computer programs with the same semantics as the simulation: a program is
+ * executed once over a token memory and the memory of the computer cell, operands wrap around the memory sizes from
+ * the simulation parameters and conditional blocks are tracked by a condition table.
+ * Programs are decoded once and can be run over many memories at once. A Batch stores the memories byte by byte over
+ * all of its tokens such that each instruction is applied to consecutive bytes of the batch.
+ */
+class ENGINEINTERFACE_EXPORT CellComputerMachine
+{
+public:
+    CellComputerMachine(SimulationParameters const& parameters);
+
+    class Program
+    {
+    public:
+        int getNumInstructions() const;
+
+    private:
+        friend class CellComputerMachine;
+
+        struct Instruction
+        {
+            InstructionCoded coded;
+            int address1 = 0;   //for constant addresses in MEM, MEMMEM and CMEM operands
+            int address2 = 0;
+        };
+        vector<Instruction> _instructions;
+    };
+
+    //decodes the machine code as stored in CellFeatureDescription::constData, missing bytes of the last instruction are
+    //read as zero and at most MaxInstructions instructions are decoded
+    Program decode(QByteArray const& code) const;
+
+    class Batch
+    {
+    public:
+        Batch(int numTokens, int tokenMemorySize, int cellMemorySize);
+
+        int getNumTokens() const;
+
+        //memories shorter than the memory size are padded with zeros
+        void setTokenMemory(int tokenIndex, QByteArray const& memory);
+        QByteArray getTokenMemory(int tokenIndex) const;
+        void setCellMemory(int tokenIndex, QByteArray const& memory);
+        QByteArray getCellMemory(int tokenIndex) const;
+
+        //byte address of token tokenIndex is stored at address * getNumTokens() + tokenIndex
+        vector<int8_t>& getTokenMemoryRef();
+        vector<int8_t>& getCellMemoryRef();
+
+    private:
+        friend class CellComputerMachine;
+
+        int _numTokens = 0;
+        int _tokenMemorySize = 0;
+        int _cellMemorySize = 0;
+        vector<int8_t> _tokenMemory;
+        vector<int8_t> _cellMemory;
+    };
+
+    Batch createBatch(int numTokens) const;
+
+    //runs the program once for each token of the batch in parallel, every token has its own copy of the cell memory
+    void execute(Program const& program, Batch& batch) const;
+
+    //runs the program once, both memories are resized to the memory sizes of the simulation parameters
+    void execute(Program const& program, QByteArray& tokenMemory, QByteArray& cellMemory) const;
+
+    static int const MaxInstructions = 64;
+
+private:
+    void executeBlock(Program const& program, Batch& batch, int begin, int end) const;
+
+    int _tokenMemorySize = 0;
+    int _cellMemorySize = 0;
+    int _maxInstructions = 0;
+};
@@ -0,0 +1,322 @@
+#include "CellComputerOptimizer.h"
+
+#include <algorithm>
+
+#include "CompilerHelper.h"
+
+namespace
+{
+    using Operation = Enums::ComputerOperation;
+    using Optype = Enums::ComputerOptype;
+
+    bool isCondition(InstructionCoded const& instruction)
+    {
+        return instruction.operation >= Operation::IFG;
+    }
+
+    bool isIf(InstructionCoded const& instruction)
+    {
+        return instruction.operation >= Operation::IFG && instruction.operation <= Operation::IFL;
+    }
+
+    //same as in the simulation: memory bytes are signed, operands unsigned
+    uint8_t evaluate(Operation::Type operation, int8_t value, uint8_t operand)
+    {
+        switch (operation) {
+        case Operation::MOV:
+            return operand;
+        case Operation::ADD:
+            return static_cast<uint8_t>(value + operand);
+        case Operation::SUB:
+            return static_cast<uint8_t>(value - operand);
+        case Operation::MUL:
+            return static_cast<uint8_t>(value * operand);
+        case Operation::DIV:
+            return static_cast<uint8_t>(operand > 0 ? value / operand : 0);
+        case Operation::XOR:
+            return static_cast<uint8_t>(value ^ operand);
+        case Operation::OR:
+            return static_cast<uint8_t>(value | operand);
+        case Operation::AND:
+            return static_cast<uint8_t>(value & operand);
+        default:
+            return static_cast<uint8_t>(value);
+        }
+    }
+
+    class Optimizer
+    {
+    public:
+        Optimizer(vector<InstructionCoded> const& instructions, SimulationParameters const& parameters)
+            : _instructions(instructions)
+            , _tokenMemorySize(std::max(1, parameters.tokenMemorySize))
+            , _cellMemorySize(std::max(1, parameters.cellFunctionComputerCellMemorySize))
+        {}
+
+        vector<InstructionCoded> const& getInstructions() const { return _instructions; }
+
+        void run()
+        {
+            bool changed = true;
+            while (changed) {
+                changed = removeInstructionsWithoutEffect();
+                changed |= foldConstants();
+                changed |= removeDeadStores();
+                changed |= removeEmptyBlocks();
+            }
+        }
+
+    private:
+        //memory byte with an address known at compile time
+        struct Location
+        {
+            bool cell = false;
+            int address = 0;
+
+            bool operator==(Location const& other) const { return cell == other.cell && address == other.address; }
+        };
+
+        boost::optional<Location> getTarget(InstructionCoded const& instruction) const
+        {
+            if (instruction.opType1 == Optype::MEM) {
+                return Location{false, CompilerHelper::convertToAddress(instruction.operand1, _tokenMemorySize)};
+            }
+            if (instruction.opType1 == Optype::CMEM) {
+                return Location{true, CompilerHelper::convertToAddress(instruction.operand1, _cellMemorySize)};
+            }
+            return boost::none;
+        }
+
+        boost::optional<Location> getSource(InstructionCoded const& instruction) const
+        {
+            if (instruction.opType2 == Optype::MEM) {
+                return Location{false, CompilerHelper::convertToAddress(instruction.operand2, _tokenMemorySize)};
+            }
+            if (instruction.opType2 == Optype::CMEM) {
+                return Location{true, CompilerHelper::convertToAddress(instruction.operand2, _cellMemorySize)};
+            }
+            return boost::none;
+        }
+
+        bool reads(InstructionCoded const& instruction, Location const& location) const
+        {
+            auto const readsTarget = instruction.operation != Operation::MOV;
+            if (instruction.opType1 == Optype::MEMMEM) {
+                if (!location.cell
+                    && (readsTarget
+                        || CompilerHelper::convertToAddress(instruction.operand1, _tokenMemorySize) == location.address)) {
+                    return true;
+                }
+            } else if (readsTarget && getTarget(instruction) == location) {
+                return true;
+            }
+            if (instruction.opType2 == Optype::MEMMEM) {
+                return !location.cell;
+            }
+            return getSource(instruction) == location;
+        }
+
+        bool hasNoEffect(InstructionCoded const& instruction) const
+        {
+            if (isCondition(instruction)) {
+                return false;
+            }
+            if (instruction.opType2 == Optype::CONSTANT) {
+                auto const operand = instruction.operand2;
+                switch (instruction.operation) {
+                case Operation::ADD:
+                case Operation::SUB:
+                case Operation::XOR:
+                case Operation::OR:
+                    return operand == 0;
+                case Operation::MUL:
+                case Operation::DIV:
+                    return operand == 1;
+                case Operation::AND:
+                    return operand == 0xff;
+                default:
+                    return false;
+                }
+            }
+            if (instruction.operation != Operation::MOV) {
+                return false;
+            }
+            if (instruction.opType1 == Optype::MEMMEM && instruction.opType2 == Optype::MEMMEM) {
+                return CompilerHelper::convertToAddress(instruction.operand1, _tokenMemorySize)
+                    == CompilerHelper::convertToAddress(instruction.operand2, _tokenMemorySize);
+            }
+            auto const target = getTarget(instruction);
+            return target && getSource(instruction) == target;
+        }
+
+        bool removeInstructionsWithoutEffect()
+        {
+            auto const numInstructions = _instructions.size();
+            _instructions.erase(
+                std::remove_if(
+                    _instructions.begin(),
+                    _instructions.end(),
+                    [this](InstructionCoded const& instruction) { return hasNoEffect(instruction); }),
+                _instructions.end());
+            return numInstructions != _instructions.size();
+        }
+
+        //combines two constant operations on the same location into the second instruction
+        boost::optional<InstructionCoded> fold(InstructionCoded const& first, InstructionCoded const& second) const
+        {
+            if (isCondition(first) || isCondition(second) || first.opType2 != Optype::CONSTANT
+                || second.opType2 != Optype::CONSTANT) {
+                return boost::none;
+            }
+            auto const target = getTarget(first);
+            if (!target || getTarget(second) != target) {
+                return boost::none;
+            }
+
+            auto result = second;
+            auto const operand1 = first.operand2;
+            auto const operand2 = second.operand2;
+            auto isAdditive = [](Operation::Type operation) {
+                return operation == Operation::ADD || operation == Operation::SUB;
+            };
+            if (first.operation == Operation::MOV) {
+                result.operation = Operation::MOV;
+                result.operand2 = evaluate(second.operation, static_cast<int8_t>(operand1), operand2);
+            } else if (second.operation == Operation::MOV) {
+                //first is overwritten
+            } else if (isAdditive(first.operation) && isAdditive(second.operation)) {
+                auto const delta = (first.operation == Operation::ADD ? operand1 : -operand1)
+                    + (second.operation == Operation::ADD ? operand2 : -operand2);
+                result.operation = Operation::ADD;
+                result.operand2 = static_cast<uint8_t>(delta);
+            } else if (first.operation == second.operation && first.operation == Operation::MUL) {
+                result.operand2 = static_cast<uint8_t>(operand1 * operand2);
+            } else if (first.operation == second.operation && first.operation == Operation::XOR) {
+                result.operand2 = operand1 ^ operand2;
+            } else if (first.operation == second.operation && first.operation == Operation::OR) {
+                result.operand2 = operand1 | operand2;
+            } else if (first.operation == second.operation && first.operation == Operation::AND) {
+                result.operand2 = operand1 & operand2;
+            } else {
+                return boost::none;
+            }
+            return result;
+        }
+
+        bool foldConstants()
+        {
+            auto changed = false;
+            for (int index = 0; index + 1 < static_cast<int>(_instructions.size());) {
+                if (auto const folded = fold(_instructions[index], _instructions[index + 1])) {
+                    _instructions[index + 1] = *folded;
+                    _instructions.erase(_instructions.begin() + index);
+                    changed = true;
+                } else {
+                    ++index;
+                }
+            }
+            return changed;
+        }
+
+        //a store is dead if the same location is overwritten unconditionally before it is read
+        bool isDeadStore(int index) const
+        {
+            auto const& store = _instructions[index];
+            auto const location = getTarget(store);
+            if (isCondition(store) || !location) {
+                return false;
+            }
+            for (int laterIndex = index + 1; laterIndex < static_cast<int>(_instructions.size()); ++laterIndex) {
+                auto const& instruction = _instructions[laterIndex];
+                if (isCondition(instruction) || reads(instruction, *location)) {
+                    return false;
+                }
+                if (instruction.operation == Operation::MOV && getTarget(instruction) == location) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool removeDeadStores()
+        {
+            auto changed = false;
+            for (int index = 0; index < static_cast<int>(_instructions.size());) {
+                if (isDeadStore(index)) {
+                    _instructions.erase(_instructions.begin() + index);
+                    changed = true;
+                } else {
+                    ++index;
+                }
+            }
+            return changed;
+        }
+
+        bool removeEmptyBlocks()
+        {
+            auto isOperation = [this](int index, Operation::Type operation) {
+                return index < static_cast<int>(_instructions.size()) && _instructions[index].operation == operation;
+            };
+            int depth = 0;
+            for (int index = 0; index < static_cast<int>(_instructions.size()); ++index) {
+                auto const& instruction = _instructions[index];
+                if (isIf(instruction)) {
+                    if (isOperation(index + 1, Operation::ENDIF)) {
+                        _instructions.erase(_instructions.begin() + index, _instructions.begin() + index + 2);
+                        return true;
+                    }
+                    if (isOperation(index + 1, Operation::ELSE) && isOperation(index + 2, Operation::ENDIF)) {
+                        _instructions.erase(_instructions.begin() + index, _instructions.begin() + index + 3);
+                        return true;
+                    }
+                    ++depth;
+                } else if (instruction.operation == Operation::ELSE) {
+                    if (0 == depth || isOperation(index + 1, Operation::ENDIF)) {
+                        _instructions.erase(_instructions.begin() + index);
+                        return true;
+                    }
+                } else if (instruction.operation == Operation::ENDIF) {
+                    if (0 == depth) {
+                        _instructions.erase(_instructions.begin() + index);
+                        return true;
+                    }
+                    --depth;
+                }
+            }
+
+            //conditions only influence subsequent instructions, a closing endif is kept for readable decompilation
+            if (!_instructions.empty() && isCondition(_instructions.back())
+                && _instructions.back().operation != Operation::ENDIF) {
+                _instructions.pop_back();
+                return true;
+            }
+            return false;
+        }
+
+        vector<InstructionCoded> _instructions;
+        int _tokenMemorySize = 0;
+        int _cellMemorySize = 0;
+    };
+}
+
+QByteArray CellComputerOptimizer::optimize(QByteArray const& code, SimulationParameters const& parameters)
+{
+    if (code.size() % 3 != 0 || code.size() > parameters.cellFunctionComputerMaxInstructions * 3) {
+        return code;
+    }
+    vector<InstructionCoded> instructions;
+    for (int instructionPointer = 0; instructionPointer < code.size();) {
+        InstructionCoded instruction;
+        CompilerHelper::readInstruction(code, instructionPointer, instruction);
+        instructions.emplace_back(instruction);
+    }
+
+    Optimizer optimizer(instructions, parameters);
+    optimizer.run();
+
+    QByteArray result;
+    for (auto const& instruction : optimizer.getInstructions()) {
+        CompilerHelper::writeInstruction(result, instruction);
+    }
+    return result;
+}
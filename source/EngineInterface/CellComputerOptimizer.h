@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Shortens compiled cell computer programs without changing their effect on token and cell memory:
+ * - constant operations on the same memory byte in a row are folded into one instruction
+ * - instructions without effect (e.g. adding 0 or moving a byte onto itself) are removed
+ * - stores which are overwritten before being read are removed
+ * - empty if/else/endif blocks and conditions without subsequent instructions are removed
+ */
+class ENGINEINTERFACE_EXPORT CellComputerOptimizer
+{
+public:
+    //programs which are longer than cellFunctionComputerMaxInstructions are returned unchanged because removing
+    //instructions would move ignored instructions into the executed part
+    static QByteArray optimize(QByteArray const& code, SimulationParameters const& parameters);
+};
@@ -0,0 +1,148 @@
+#include "ClusterFingerprint.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "Base/Parallel.h"
+
+#include "Descriptions.h"
+
+namespace
+{
+    int const ClustersPerChunk = 64;
+    int const MaxRefinementRounds = 16;
+
+    uint64_t mix(uint64_t value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ull;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebull;
+        value ^= value >> 31;
+        return value;
+    }
+
+    uint64_t combine(uint64_t seed, uint64_t value)
+    {
+        return mix(seed + 0x9e3779b97f4a7c15ull + value);
+    }
+
+    uint64_t calcHash(QByteArray const& data)
+    {
+        uint64_t result = 0xcbf29ce484222325ull;
+        for (int i = 0; i < data.size(); ++i) {
+            result ^= static_cast<unsigned char>(data[i]);
+            result *= 0x100000001b3ull;
+        }
+        return mix(result);
+    }
+
+    uint64_t calcInitialLabel(CellDescription const& cell)
+    {
+        auto result = mix(static_cast<uint64_t>(cell.maxConnections.get_value_or(0)));
+        result = combine(result, cell.connectingCells ? cell.connectingCells->size() : 0);
+        result = combine(result, cell.tokenBlocked.get_value_or(false) ? 1 : 0);
+        result = combine(result, static_cast<uint64_t>(cell.tokenBranchNumber.get_value_or(0)));
+        if (auto const& feature = cell.cellFeature) {
+            result = combine(result, static_cast<uint64_t>(feature->getType()));
+            result = combine(result, calcHash(feature->constData));
+        }
+        return result;
+    }
+
+    int getNumDistinct(vector<uint64_t> labels)
+    {
+        std::sort(labels.begin(), labels.end());
+        return static_cast<int>(std::unique(labels.begin(), labels.end()) - labels.begin());
+    }
+}
+
+uint64_t ClusterFingerprint::calc(ClusterDescription const& cluster)
+{
+    auto result = mix(hasToken(cluster) ? 1 : 2);
+    if (!cluster.cells || cluster.cells->empty()) {
+        return result;
+    }
+    auto const& cells = *cluster.cells;
+    auto const numCells = static_cast<int>(cells.size());
+
+    std::unordered_map<uint64_t, int> cellIndexById;
+    cellIndexById.reserve(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        cellIndexById.emplace(cells[i].id, i);
+    }
+    vector<vector<int>> neighbors(numCells);
+    vector<uint64_t> labels(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        labels[i] = calcInitialLabel(cells[i]);
+        if (auto const& connectingCells = cells[i].connectingCells) {
+            for (auto const& connectingCellId : *connectingCells) {
+                auto const findResult = cellIndexById.find(connectingCellId);
+                if (findResult != cellIndexById.end()) {
+                    neighbors[i].emplace_back(findResult->second);
+                }
+            }
+        }
+    }
+
+    //labels are refined until the induced partition of the cells is stable, at least one round is needed such that
+    //the labels take the bonds into account
+    auto numDistinct = getNumDistinct(labels);
+    vector<uint64_t> newLabels(numCells);
+    vector<uint64_t> neighborLabels;
+    for (int round = 0; round < MaxRefinementRounds; ++round) {
+        for (int i = 0; i < numCells; ++i) {
+            neighborLabels.clear();
+            for (auto const& neighbor : neighbors[i]) {
+                neighborLabels.emplace_back(labels[neighbor]);
+            }
+            std::sort(neighborLabels.begin(), neighborLabels.end());
+            auto label = combine(labels[i], neighborLabels.size());
+            for (auto const& neighborLabel : neighborLabels) {
+                label = combine(label, neighborLabel);
+            }
+            newLabels[i] = label;
+        }
+        labels.swap(newLabels);
+
+        auto const newNumDistinct = getNumDistinct(labels);
+        if (newNumDistinct == numDistinct) {
+            break;
+        }
+        numDistinct = newNumDistinct;
+    }
+
+    std::sort(labels.begin(), labels.end());
+    result = combine(result, numCells);
+    for (auto const& label : labels) {
+        result = combine(result, label);
+    }
+    return result;
+}
+
+vector<uint64_t> ClusterFingerprint::calc(DataDescription const& data)
+{
+    if (!data.clusters) {
+        return {};
+    }
+    auto const& clusters = *data.clusters;
+    vector<uint64_t> result(clusters.size());
+    Parallel::forEach(
+        0,
+        static_cast<int>(clusters.size()),
+        [&](int index) { result[index] = calc(clusters[index]); },
+        ClustersPerChunk);
+    return result;
+}
+
+bool ClusterFingerprint::hasToken(ClusterDescription const& cluster)
+{
+    if (auto const& cells = cluster.cells) {
+        for (auto const& cell : *cells) {
+            if (cell.tokens && !cell.tokens->empty()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
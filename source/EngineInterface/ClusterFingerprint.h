@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Structural fingerprint of a cluster which does not depend on the order of its cells. It is computed by
+ * Weisfeiler-Lehman refinement over the bond graph: each cell starts with a hash of its features and repeatedly
+ * absorbs the sorted labels of its neighbors until the number of distinct labels stops growing. Equal clusters always
+ * have equal fingerprints, different clusters collide with negligible probability.
+ */
+class ENGINEINTERFACE_EXPORT ClusterFingerprint
+{
+public:
+    static uint64_t calc(ClusterDescription const& cluster);
+
+    //fingerprints of all clusters in data computed in parallel, in the order of data.clusters
+    static vector<uint64_t> calc(DataDescription const& data);
+
+    static bool hasToken(ClusterDescription const& cluster);
+};
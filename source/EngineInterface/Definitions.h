@@ -31,6 +31,7 @@ class EngineInterfaceBuilderFacade;
 class SerializationFacade;
 class DescriptionHelper;
 class CellComputerCompiler;
+struct CompilationResult;
 class Serializer;
 class SimulationMonitor;
 class SymbolTable;
@@ -0,0 +1,346 @@
+#include "DensityPyramid.h"
+
+#include <cmath>
+#include <limits>
+
+#include "Base/Parallel.h"
+
+#include "Colors.h"
+#include "Descriptions.h"
+
+namespace
+{
+    unsigned int const CellColors[DensityPyramid::NumColors] = {
+        Const::IndividualCellColor1,
+        Const::IndividualCellColor2,
+        Const::IndividualCellColor3,
+        Const::IndividualCellColor4,
+        Const::IndividualCellColor5,
+        Const::IndividualCellColor6,
+        Const::IndividualCellColor7};
+
+    int const RowsPerChunk = 16;
+
+    int floorInt(float value)
+    {
+        auto result = static_cast<int>(value);
+        if (result > value) {
+            --result;
+        }
+        return result;
+    }
+
+    int correctCoordinate(int value, int size)
+    {
+        return ((value % size) + size) % size;
+    }
+
+    //color channels are added to the space color with saturation, channel x is stored in the lowest byte as in the
+    //GPU engine
+    unsigned int toPixel(float x, float y, float z)
+    {
+        auto addChannel = [](unsigned int baseColor, int shift, float value) {
+            auto const channel = static_cast<int>((baseColor >> shift) & 0xff) + toInt(std::min(value, 1.0f) * 255.0f);
+            return static_cast<unsigned int>(std::min(channel, 255)) << shift;
+        };
+        return 0xff000000 | addChannel(Const::SpaceColor, 16, z) | addChannel(Const::SpaceColor, 8, y)
+            | addChannel(Const::SpaceColor, 0, x);
+    }
+
+    //brightnessPerEntity approximates the color intensity a single entity contributes to the pixels covered by a bin
+    unsigned int calcPixel(DensityPyramid::Bin const& bin, float brightnessPerEntity)
+    {
+        float x = 0;
+        float y = 0;
+        float z = 0;
+        if (bin.numCells > 0) {
+            auto const averageEnergy = bin.cellEnergy / bin.numCells;
+            auto const energyFactor = std::min(100.0f, std::sqrt(averageEnergy) * 5 + 20.0f) / 100.0f * 0.75f;
+            auto const factor = energyFactor * std::min(bin.numCells * brightnessPerEntity, 1.0f) / bin.numCells;
+            for (int i = 0; i < DensityPyramid::NumColors; ++i) {
+                if (auto const numCells = bin.numCellsByColor[i]) {
+                    auto const weight = numCells * factor;
+                    x += static_cast<float>((CellColors[i] >> 16) & 0xff) / 256.0f * weight;
+                    y += static_cast<float>((CellColors[i] >> 8) & 0xff) / 256.0f * weight;
+                    z += static_cast<float>(CellColors[i] & 0xff) / 256.0f * weight;
+                }
+            }
+        }
+        if (bin.numParticles > 0) {
+            auto const averageEnergy = bin.particleEnergy / bin.numParticles;
+            auto const factor = std::min(bin.numParticles * brightnessPerEntity, 1.0f);
+            x += std::max(std::min((toInt(averageEnergy) + 10) * 5, 150), 20) / 256.0f * 0.75f * factor;
+            z += 0.08f * factor;
+        }
+        return toPixel(x, y, z);
+    }
+}
+
+void DensityPyramid::Bin::add(Bin const& other)
+{
+    numCells += other.numCells;
+    numParticles += other.numParticles;
+    cellEnergy += other.cellEnergy;
+    particleEnergy += other.particleEnergy;
+    for (int i = 0; i < NumColors; ++i) {
+        numCellsByColor[i] += other.numCellsByColor[i];
+    }
+}
+
+void DensityPyramid::init(IntVector2D const& universeSize, int binSize)
+{
+    _universeSize = universeSize;
+    _binSize = std::max(binSize, 1);
+    _levelSizes.clear();
+    _levels.clear();
+
+    IntVector2D levelSize{(universeSize.x + _binSize - 1) / _binSize, (universeSize.y + _binSize - 1) / _binSize};
+    while (true) {
+        _levelSizes.emplace_back(levelSize);
+        _levels.emplace_back(levelSize.x * levelSize.y);
+        if (levelSize.x <= 1 && levelSize.y <= 1) {
+            break;
+        }
+        levelSize = {(levelSize.x + 1) / 2, (levelSize.y + 1) / 2};
+    }
+    _isBinUpdated = vector<bool>(_levels.front().size(), false);
+    _numUpdatedBins = 0;
+}
+
+void DensityPyramid::update(DataDescription const& data, IntRect const& rect)
+{
+    if (_levels.empty()) {
+        return;
+    }
+
+    //bins are replaced only if they are covered completely
+    auto const& levelSize = _levelSizes.front();
+    auto firstBin = [&](int value) { return (std::max(value, 0) + _binSize - 1) / _binSize; };
+    auto endBin = [&](int value, int universeSize, int numBins) {
+        return value >= universeSize ? numBins : std::max(value, 0) / _binSize;
+    };
+    IntRect const binRect{
+        {firstBin(rect.p1.x), firstBin(rect.p1.y)},
+        {endBin(rect.p2.x, _universeSize.x, levelSize.x), endBin(rect.p2.y, _universeSize.y, levelSize.y)}};
+    if (binRect.p1.x >= binRect.p2.x || binRect.p1.y >= binRect.p2.y) {
+        return;
+    }
+
+    auto& bins = _levels.front();
+    for (int y = binRect.p1.y; y < binRect.p2.y; ++y) {
+        for (int x = binRect.p1.x; x < binRect.p2.x; ++x) {
+            auto const index = x + y * levelSize.x;
+            bins[index] = Bin();
+            if (!_isBinUpdated[index]) {
+                _isBinUpdated[index] = true;
+                ++_numUpdatedBins;
+            }
+        }
+    }
+
+    auto getCoveredBin = [&](QVector2D const& pos) -> Bin* {
+        IntVector2D const binPos{
+            correctCoordinate(floorInt(pos.x()), _universeSize.x) / _binSize,
+            correctCoordinate(floorInt(pos.y()), _universeSize.y) / _binSize};
+        if (binPos.x < binRect.p1.x || binPos.x >= binRect.p2.x || binPos.y < binRect.p1.y
+            || binPos.y >= binRect.p2.y) {
+            return nullptr;
+        }
+        return &bins[binPos.x + binPos.y * levelSize.x];
+    };
+
+    if (data.clusters) {
+        for (auto const& cluster : *data.clusters) {
+            if (!cluster.cells) {
+                continue;
+            }
+            for (auto const& cell : *cluster.cells) {
+                if (!cell.pos) {
+                    continue;
+                }
+                if (auto bin = getCoveredBin(*cell.pos)) {
+                    ++bin->numCells;
+                    bin->cellEnergy += static_cast<float>(cell.energy.get_value_or(0.0));
+                    ++bin->numCellsByColor[(cell.metadata ? cell.metadata->color : 0) % NumColors];
+                }
+            }
+        }
+    }
+    if (data.particles) {
+        for (auto const& particle : *data.particles) {
+            if (!particle.pos) {
+                continue;
+            }
+            if (auto bin = getCoveredBin(*particle.pos)) {
+                ++bin->numParticles;
+                bin->particleEnergy += static_cast<float>(particle.energy.get_value_or(0.0));
+            }
+        }
+    }
+
+    updateCoarserLevels(binRect);
+}
+
+bool DensityPyramid::isComplete() const
+{
+    return !_levels.empty() && _numUpdatedBins == static_cast<int>(_isBinUpdated.size());
+}
+
+IntVector2D const& DensityPyramid::getUniverseSize() const
+{
+    return _universeSize;
+}
+
+int DensityPyramid::getNumLevels() const
+{
+    return static_cast<int>(_levels.size());
+}
+
+int DensityPyramid::getBinSize(int level) const
+{
+    return _binSize << level;
+}
+
+IntVector2D const& DensityPyramid::getLevelSize(int level) const
+{
+    return _levelSizes.at(level);
+}
+
+auto DensityPyramid::getBin(int level, IntVector2D const& pos) const -> Bin const&
+{
+    return _levels.at(level).at(pos.x + pos.y * _levelSizes.at(level).x);
+}
+
+int DensityPyramid::getLevelForZoom(float zoom) const
+{
+    auto level = 0;
+    while (level + 1 < getNumLevels() && static_cast<float>(getBinSize(level)) * zoom < 1.0f) {
+        ++level;
+    }
+    return level;
+}
+
+void DensityPyramid::render(RealRect const& worldRect, float zoom, QImage& target) const
+{
+    if (target.depth() != 32) {
+        target = QImage(target.width(), target.height(), QImage::Format_RGBA8888);
+    }
+    IntVector2D const imageSize{target.width(), target.height()};
+    auto const bits = target.bits();
+    auto const bytesPerLine = target.bytesPerLine();
+    if (_levels.empty() || zoom <= 0) {
+        target.fill(Const::NothingnessColor);
+        return;
+    }
+
+    auto const level = getLevelForZoom(zoom);
+    auto const binSize = static_cast<float>(getBinSize(level));
+    auto const& levelSize = _levelSizes[level];
+    auto const& bins = _levels[level];
+
+    //a cell adds its color scaled by 2 * zoom / 3 to the dot pixel and 30% of it to four neighbor pixels in the
+    //vector image of the GPU engine, the sum is spread over the pixels of the bin
+    auto const pixelsPerBin = binSize * zoom * binSize * zoom;
+    auto const brightnessPerEntity = zoom * 2.0f / 3.0f * 2.2f / pixelsPerBin;
+
+    //maps image columns and rows to bins, -1 for positions outside the universe
+    auto calcBinIndices = [&](int imageSize, float worldStart, int universeSize, int numBins) {
+        vector<int> result(imageSize, -1);
+        for (int i = 0; i < imageSize; ++i) {
+            auto const worldPos = worldStart + (toFloat(i) + 0.5f) / zoom;
+            if (worldPos >= 0 && worldPos < toFloat(universeSize)) {
+                result[i] = std::min(toInt(worldPos / binSize), numBins - 1);
+            }
+        }
+        return result;
+    };
+    auto const binXByColumn = calcBinIndices(imageSize.x, worldRect.p1.x, _universeSize.x, levelSize.x);
+    auto const binYByRow = calcBinIndices(imageSize.y, worldRect.p1.y, _universeSize.y, levelSize.y);
+
+    //each bin covers at least one pixel, hence its color is calculated once for the visible bins
+    auto getVisibleRange = [](vector<int> const& binIndices) {
+        IntVector2D result{std::numeric_limits<int>::max(), -1};
+        for (auto const binIndex : binIndices) {
+            if (binIndex >= 0) {
+                result.x = std::min(result.x, binIndex);
+                result.y = std::max(result.y, binIndex);
+            }
+        }
+        return result;
+    };
+    auto const visibleBinsX = getVisibleRange(binXByColumn);
+    auto const visibleBinsY = getVisibleRange(binYByRow);
+    auto const numVisibleBinsX = std::max(visibleBinsX.y - visibleBinsX.x + 1, 0);
+    auto const numVisibleBinsY = std::max(visibleBinsY.y - visibleBinsY.x + 1, 0);
+    vector<unsigned int> binPixels(numVisibleBinsX * numVisibleBinsY);
+    Parallel::forEach(0, numVisibleBinsY, [&](int y) {
+        auto const binY = visibleBinsY.x + y;
+        for (int x = 0; x < numVisibleBinsX; ++x) {
+            binPixels[x + y * numVisibleBinsX] =
+                calcPixel(bins[visibleBinsX.x + x + binY * levelSize.x], brightnessPerEntity);
+        }
+    }, RowsPerChunk);
+
+    Parallel::forEachChunk(
+        0,
+        imageSize.y,
+        [&](int, int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y) {
+                auto row = reinterpret_cast<unsigned int*>(bits + y * bytesPerLine);
+                auto const binY = binYByRow[y];
+                if (binY < 0) {
+                    std::fill(row, row + imageSize.x, Const::NothingnessColor);
+                    continue;
+                }
+                auto const binPixelRow = binPixels.data() + (binY - visibleBinsY.x) * numVisibleBinsX;
+                for (int x = 0; x < imageSize.x; ++x) {
+                    auto const binX = binXByColumn[x];
+                    row[x] = binX >= 0 ? binPixelRow[binX - visibleBinsX.x] : Const::NothingnessColor;
+                }
+            }
+        },
+        RowsPerChunk);
+}
+
+QImage DensityPyramid::renderOverview(IntVector2D const& imageSize) const
+{
+    QImage result(std::max(imageSize.x, 1), std::max(imageSize.y, 1), QImage::Format_RGBA8888);
+    if (_universeSize.x <= 0 || _universeSize.y <= 0) {
+        result.fill(Const::NothingnessColor);
+        return result;
+    }
+    auto const zoom = std::min(
+        toFloat(result.width()) / toFloat(_universeSize.x), toFloat(result.height()) / toFloat(_universeSize.y));
+    RealRect const worldRect{
+        RealVector2D{0.0f, 0.0f}, RealVector2D{toFloat(result.width()) / zoom, toFloat(result.height()) / zoom}};
+    render(worldRect, zoom, result);
+    return result;
+}
+
+auto DensityPyramid::getBinRef(int level, IntVector2D const& pos) -> Bin&
+{
+    return _levels[level][pos.x + pos.y * _levelSizes[level].x];
+}
+
+void DensityPyramid::updateCoarserLevels(IntRect const& binRect)
+{
+    auto rect = binRect;
+    for (int level = 1; level < getNumLevels(); ++level) {
+        rect = {{rect.p1.x / 2, rect.p1.y / 2}, {(rect.p2.x + 1) / 2, (rect.p2.y + 1) / 2}};
+        auto const& finerLevelSize = _levelSizes[level - 1];
+        for (int y = rect.p1.y; y < rect.p2.y; ++y) {
+            for (int x = rect.p1.x; x < rect.p2.x; ++x) {
+                Bin bin;
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        IntVector2D const finerPos{x * 2 + dx, y * 2 + dy};
+                        if (finerPos.x < finerLevelSize.x && finerPos.y < finerLevelSize.y) {
+                            bin.add(getBinRef(level - 1, finerPos));
+                        }
+                    }
+                }
+                getBinRef(level, {x, y}) = bin;
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+
+#include <QImage>
+
+#include "Definitions.h"
+
+/**
+ * Multi-resolution grid of aggregated cell and particle statistics over the whole world. Level 0 consists of square
+ * bins of the given size, each further level halves the resolution until a single bin remains. The grid is updated
+ * per region such that it can be refreshed incrementally from data of parts of the world.
+ */
+class ENGINEINTERFACE_EXPORT DensityPyramid
+{
+public:
+    static int const NumColors = 7;
+
+    struct Bin
+    {
+        int numCells = 0;
+        int numParticles = 0;
+        float cellEnergy = 0;
+        float particleEnergy = 0;
+        std::array<int, NumColors> numCellsByColor = {};
+
+        void add(Bin const& other);
+    };
+
+    void init(IntVector2D const& universeSize, int binSize);
+
+    //replaces the content of all bins lying completely inside rect by the entities of data, which is expected to
+    //contain all entities in rect (p2 is exclusive)
+    void update(DataDescription const& data, IntRect const& rect);
+
+    bool isComplete() const;  //true if every bin has been updated at least once
+
+    IntVector2D const& getUniverseSize() const;
+    int getNumLevels() const;
+    int getBinSize(int level) const;
+    IntVector2D const& getLevelSize(int level) const;
+    Bin const& getBin(int level, IntVector2D const& pos) const;
+
+    //finest level whose bins cover at least one pixel
+    int getLevelForZoom(float zoom) const;
+
+    //renders worldRect with zoom pixels per unit into target (32-bit format) using the pixel layout of the GPU engine,
+    //i.e. QImage::Format_RGBA8888
+    void render(RealRect const& worldRect, float zoom, QImage& target) const;
+    QImage renderOverview(IntVector2D const& imageSize) const;
+
+private:
+    Bin& getBinRef(int level, IntVector2D const& pos);
+    void updateCoarserLevels(IntRect const& binRect);
+
+    IntVector2D _universeSize;
+    int _binSize = 1;
+    vector<IntVector2D> _levelSizes;
+    vector<vector<Bin>> _levels;
+    vector<bool> _isBinUpdated;
+    int _numUpdatedBins = 0;
+};
@@ -7,6 +7,18 @@ class ENGINEINTERFACE_EXPORT DescriptionFactory
 public:
     virtual ~DescriptionFactory() = default;
 
+    //all create methods assign the cell ids 1, 2, ..., n in one block; use DescriptionHelper::makeValid before adding them
+    struct CreateRectParameters
+    {
+        MEMBER_DECLARATION(CreateRectParameters, IntVector2D, size, IntVector2D({10, 10}));
+        MEMBER_DECLARATION(CreateRectParameters, double, cellDistance, 1.0);
+        MEMBER_DECLARATION(CreateRectParameters, double, cellEnergy, 100.0);
+        MEMBER_DECLARATION(CreateRectParameters, QVector2D, centerPosition, QVector2D());
+        MEMBER_DECLARATION(CreateRectParameters, int, maxConnections, 4);
+        MEMBER_DECLARATION(CreateRectParameters, int, colorCode, 1);
+    };
+    virtual ClusterDescription createRect(CreateRectParameters const& parameters) const = 0;
+
     struct CreateHexagonParameters
     {
         MEMBER_DECLARATION(CreateHexagonParameters, int, layers, 1);
@@ -32,15 +44,42 @@ public:
     virtual ClusterDescription createUnconnectedDisc(CreateDiscParameters const& parameters)
         const = 0;
 
+    //connected annulus on a triangular lattice
+    struct CreateRingParameters
+    {
+        MEMBER_DECLARATION(CreateRingParameters, double, outerRadius, 10.0);
+        MEMBER_DECLARATION(CreateRingParameters, double, innerRadius, 5.0);
+        MEMBER_DECLARATION(CreateRingParameters, double, cellDistance, 1.0);
+        MEMBER_DECLARATION(CreateRingParameters, double, cellEnergy, 100.0);
+        MEMBER_DECLARATION(CreateRingParameters, int, maxConnections, 6);
+        MEMBER_DECLARATION(CreateRingParameters, QVector2D, centerPosition, QVector2D());
+        MEMBER_DECLARATION(CreateRingParameters, int, colorCode, 1);
+    };
+    virtual ClusterDescription createRing(CreateRingParameters const& parameters) const = 0;
+
+    //polygon filled with a connected triangular lattice, vertices are relative to the center position
+    struct CreatePolygonParameters
+    {
+        MEMBER_DECLARATION(CreatePolygonParameters, vector<QVector2D>, vertices, vector<QVector2D>());
+        MEMBER_DECLARATION(CreatePolygonParameters, double, cellDistance, 1.0);
+        MEMBER_DECLARATION(CreatePolygonParameters, double, cellEnergy, 100.0);
+        MEMBER_DECLARATION(CreatePolygonParameters, int, maxConnections, 6);
+        MEMBER_DECLARATION(CreatePolygonParameters, QVector2D, centerPosition, QVector2D());
+        MEMBER_DECLARATION(CreatePolygonParameters, int, colorCode, 1);
+    };
+    virtual ClusterDescription createFilledPolygon(CreatePolygonParameters const& parameters) const = 0;
+
     virtual void generateBranchNumbers(
         SimulationParameters const& parameters,
         DataDescription& data,
         std::unordered_set<uint64_t> const& cellIds) const = 0;
 
+    //equal seeds give equal cell functions for each cell id, independent of the number of threads
     virtual void randomizeCellFunctions(
         SimulationParameters const& parameters,
         DataDescription& data,
-        std::unordered_set<uint64_t> const& cellIds) const = 0;
+        std::unordered_set<uint64_t> const& cellIds,
+        uint64_t seed) const = 0;
 
     virtual void removeFreeCellConnections(
         SimulationParameters const& parameters,
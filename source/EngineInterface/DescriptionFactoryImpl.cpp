@@ -1,128 +1,352 @@
 #include "DescriptionFactoryImpl.h"
 
 #include <math.h>
+#include <atomic>
 
-#include <QRandomGenerator>
+#include "Base/Parallel.h"
+#include "Base/Philox.h"
 
 #include "Physics.h"
 
 
-ClusterDescription DescriptionFactoryImpl::createHexagon(CreateHexagonParameters const& parameters) const
+namespace
 {
-    auto addConnection = [](CellDescription& cell1, CellDescription& cell2) {
-        cell1.addConnection(cell2.id);
-        cell2.addConnection(cell1.id);
+    enum class LatticeType
+    {
+        Square,
+        Triangular
     };
 
-    auto const layers = parameters._layers;
-    std::vector<std::vector<CellDescription>> cellMatrix(2 * layers - 1, std::vector<CellDescription>(2 * layers - 1));
-    list<CellDescription> cells;
-
-    uint64_t id = 0;
-    double incY = std::sqrt(3.0) * parameters._cellDistance / 2.0;
-    for (int j = 0; j < layers; ++j) {
-        for (int i = -(layers - 1); i < layers - j; ++i) {
-
-            //create cell: upper layer
-            cellMatrix[layers - 1 + i][layers - 1 - j] =
-                CellDescription()
-                    .setId(++id)
-                    .setEnergy(parameters._cellEnergy)
-                    .setPos(
-                        parameters._centerPosition
-                        + QVector2D{static_cast<float>(i * parameters._cellDistance + j * parameters._cellDistance / 2.0), 
-                                    static_cast<float>(-j * incY)})
-                    .setMaxConnections(parameters._maxConnections)
-                    .setFlagTokenBlocked(false)
-                    .setTokenBranchNumber(0)
-                    .setMetadata(CellMetadata().setColor(parameters._colorCode))
-                    .setCellFeature(CellFeatureDescription());
-
-            if (layers - 1 + i > 0) {
-                addConnection(
-                    cellMatrix[layers - 1 + i][layers - 1 - j], cellMatrix[layers - 1 + i - 1][layers - 1 - j]);
+    //triangular lattice uses axial coordinates: (x, y) is located at ((x + y / 2) * d, y * sqrt(3) / 2 * d)
+    vector<IntVector2D> const& getNeighborStencil(LatticeType type)
+    {
+        static vector<IntVector2D> const squareStencil = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        static vector<IntVector2D> const triangularStencil = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, -1}, {-1, 1}};
+        return LatticeType::Square == type ? squareStencil : triangularStencil;
+    }
+
+    //Centroid: centroid of the cells is moved to the center position, Origin: lattice origin is moved there
+    enum class LatticeAnchor
+    {
+        Centroid,
+        Origin
+    };
+
+    QVector2D getLatticePosition(LatticeType type, IntVector2D const& site, double cellDistance)
+    {
+        if (LatticeType::Square == type) {
+            return QVector2D(site.x * cellDistance, site.y * cellDistance);
+        }
+        return QVector2D((site.x + site.y / 2.0) * cellDistance, site.y * std::sqrt(3.0) / 2.0 * cellDistance);
+    }
+
+    CellDescription createCellTemplate(double energy, int maxConnections, int colorCode)
+    {
+        return CellDescription()
+            .setEnergy(energy)
+            .setMaxConnections(maxConnections)
+            .setFlagTokenBlocked(false)
+            .setTokenBranchNumber(0)
+            .setMetadata(CellMetadata().setColor(colorCode))
+            .setCellFeature(CellFeatureDescription());
+    }
+
+    ClusterDescription createEmptyCluster()
+    {
+        return ClusterDescription().setVel({0, 0}).setAngle(0).setAngularVel(0).setMetadata(ClusterMetadata());
+    }
+
+    //collects the sites of all rows in [rowBegin, rowEnd] whose position satisfies the predicate,
+    //columnRange(row) returns the inclusive column range to be checked
+    template <typename ColumnRange, typename Predicate>
+    vector<IntVector2D> collectSites(
+        LatticeType type,
+        double cellDistance,
+        int rowBegin,
+        int rowEnd,
+        ColumnRange const& columnRange,
+        Predicate const& isInside)
+    {
+        int numRows = rowEnd - rowBegin + 1;
+        vector<vector<IntVector2D>> sitesByChunk(Parallel::getNumChunks(numRows, 16));
+        Parallel::forEachChunk(
+            0,
+            numRows,
+            [&](int chunkIndex, int chunkBegin, int chunkEnd) {
+                auto& sites = sitesByChunk[chunkIndex];
+                for (int row = rowBegin + chunkBegin; row < rowBegin + chunkEnd; ++row) {
+                    auto columns = columnRange(row);
+                    for (int column = columns.x; column <= columns.y; ++column) {
+                        IntVector2D site{column, row};
+                        if (isInside(getLatticePosition(type, site, cellDistance))) {
+                            sites.push_back(site);
+                        }
+                    }
+                }
+            },
+            16);
+
+        vector<IntVector2D> result;
+        for (auto const& sites : sitesByChunk) {
+            result.insert(result.end(), sites.begin(), sites.end());
+        }
+        return result;
+    }
+
+    //creates one cell per site (in the given order) and connects neighboring sites according to the lattice stencil,
+    //the cells are rotated around the anchor
+    ClusterDescription createLatticeCluster(
+        LatticeType type,
+        vector<IntVector2D> const& sites,
+        double cellDistance,
+        QVector2D const& centerPosition,
+        double angle,
+        CellDescription const& cellTemplate,
+        LatticeAnchor anchor = LatticeAnchor::Centroid)
+    {
+        auto result = createEmptyCluster();
+        int numCells = static_cast<int>(sites.size());
+        if (numCells == 0) {
+            result.setPos(centerPosition);
+            return result;
+        }
+
+        //dense lookup grid from site to cell index
+        IntVector2D minSite = sites.front();
+        IntVector2D maxSite = sites.front();
+        for (auto const& site : sites) {
+            minSite = {std::min(minSite.x, site.x), std::min(minSite.y, site.y)};
+            maxSite = {std::max(maxSite.x, site.x), std::max(maxSite.y, site.y)};
+        }
+        int gridWidth = maxSite.x - minSite.x + 1;
+        int gridHeight = maxSite.y - minSite.y + 1;
+        vector<int> cellIndexBySite(static_cast<size_t>(gridWidth) * gridHeight, -1);
+        Parallel::forEach(0, numCells, [&](int index) {
+            auto const& site = sites[index];
+            cellIndexBySite[static_cast<size_t>(site.y - minSite.y) * gridWidth + site.x - minSite.x] = index;
+        });
+
+        Physics::VectorArray positions;
+        positions.resize(numCells);
+        Parallel::forEach(0, numCells, [&](int index) {
+            positions.set(index, getLatticePosition(type, sites[index], cellDistance));
+        });
+        auto center = LatticeAnchor::Centroid == anchor ? Physics::mean(positions) : QVector2D();
+        auto sinAngle = std::sin(angle * degToRad);
+        auto cosAngle = std::cos(angle * degToRad);
+
+        auto const& stencil = getNeighborStencil(type);
+        auto& cells = *(result.cells = vector<CellDescription>(numCells, cellTemplate));
+        Parallel::forEach(0, numCells, [&](int index) {
+            auto& cell = cells[index];
+            cell.id = index + 1;
+
+            auto relX = positions.x[index] - center.x();
+            auto relY = positions.y[index] - center.y();
+            cell.pos = centerPosition
+                + QVector2D(relX * cosAngle - relY * sinAngle, relX * sinAngle + relY * cosAngle);
+
+            auto const& site = sites[index];
+            list<uint64_t> connectingCells;
+            for (auto const& offset : stencil) {
+                int x = site.x + offset.x - minSite.x;
+                int y = site.y + offset.y - minSite.y;
+                if (x < 0 || y < 0 || x >= gridWidth || y >= gridHeight) {
+                    continue;
+                }
+                auto neighborIndex = cellIndexBySite[static_cast<size_t>(y) * gridWidth + x];
+                if (neighborIndex != -1) {
+                    connectingCells.push_back(neighborIndex + 1);
+                }
             }
-            if (j > 0) {
-                addConnection(
-                    cellMatrix[layers - 1 + i][layers - 1 - j], cellMatrix[layers - 1 + i][layers - 1 - j + 1]);
-                addConnection(
-                    cellMatrix[layers - 1 + i][layers - 1 - j], cellMatrix[layers - 1 + i + 1][layers - 1 - j + 1]);
+            cell.connectingCells = std::move(connectingCells);
+        });
+
+        result.setPos(LatticeAnchor::Centroid == anchor ? centerPosition : result.getClusterPosFromCells());
+        return result;
+    }
+
+    //Philox stream of a cell, counter consists of the block index and the cell id
+    class CellRandomStream
+    {
+    public:
+        CellRandomStream(uint64_t seed, uint64_t cellId)
+            : _seed(seed)
+            , _cellId(cellId)
+        {}
+
+        uint32_t getRandomInt(uint32_t range)
+        {
+            if (_position % 4 == 0) {
+                auto const blockIndex = _position / 4;
+                _block = Philox::generate(
+                    {blockIndex, 0, static_cast<uint32_t>(_cellId), static_cast<uint32_t>(_cellId >> 32)},
+                    static_cast<uint32_t>(_seed),
+                    static_cast<uint32_t>(_seed >> 32));
             }
+            return Philox::toRange(_block.values[_position++ % 4], range);
+        }
 
-            //create cell: under layer (except for 0-layer)
-            if (j > 0) {
-                cellMatrix[layers - 1 + i][layers - 1 + j] =
-                    CellDescription()
-                        .setId(++id)
-                        .setEnergy(parameters._cellEnergy)
-                        .setPos(
-                            parameters._centerPosition
-                            + QVector2D{static_cast<float>(i * parameters._cellDistance + j * parameters._cellDistance / 2.0), static_cast<float>(+j * incY)})
-                        .setMaxConnections(parameters._maxConnections)
-                        .setFlagTokenBlocked(false)
-                        .setTokenBranchNumber(0)
-                        .setMetadata(CellMetadata().setColor(parameters._colorCode))
-                        .setCellFeature(CellFeatureDescription());
-
-                if (layers - 1 + i > 0) {
-                    addConnection(
-                        cellMatrix[layers - 1 + i][layers - 1 + j], cellMatrix[layers - 1 + i - 1][layers - 1 + j]);
-                }
-                addConnection(
-                    cellMatrix[layers - 1 + i][layers - 1 + j], cellMatrix[layers - 1 + i][layers - 1 + j - 1]);
-                addConnection(
-                    cellMatrix[layers - 1 + i][layers - 1 + j], cellMatrix[layers - 1 + i + 1][layers - 1 + j - 1]);
+        QByteArray getRandomArray(int size)
+        {
+            QByteArray result(size, 0);
+            for (int i = 0; i < size; ++i) {
+                result[i] = static_cast<char>(getRandomInt(256));
             }
+            return result;
         }
-    }
 
-    for (auto const& cellRow : cellMatrix) {
-        for (auto const& cell : cellRow) {
-            if (cell.id > 0) {
-                cells.push_back(cell);
+    private:
+        uint64_t _seed = 0;
+        uint64_t _cellId = 0;
+        uint32_t _position = 0;
+        Philox::Block _block;
+    };
+
+    //adjacency of all cells in compressed sparse row format: neighbors of cell i are
+    //neighborIndices[neighborOffsets[i]], ..., neighborIndices[neighborOffsets[i + 1] - 1]
+    struct CellGraph
+    {
+        vector<CellDescription*> cells;
+        vector<int> neighborOffsets;
+        vector<int> neighborIndices;
+        unordered_map<uint64_t, int> cellIndicesByIds;
+
+        void init(DataDescription& data, bool withConnections)
+        {
+            if (data.clusters) {
+                for (auto& cluster : *data.clusters) {
+                    if (cluster.cells) {
+                        for (auto& cell : *cluster.cells) {
+                            cells.emplace_back(&cell);
+                        }
+                    }
+                }
+            }
+            int numCells = static_cast<int>(cells.size());
+            cellIndicesByIds.reserve(numCells);
+            for (int index = 0; index < numCells; ++index) {
+                cellIndicesByIds.emplace(cells[index]->id, index);
+            }
+            if (!withConnections) {
+                return;
+            }
+
+            neighborOffsets.resize(numCells + 1);
+            neighborOffsets[0] = 0;
+            Parallel::forEach(0, numCells, [&](int index) {
+                auto const& connectingCells = cells[index]->connectingCells;
+                neighborOffsets[index + 1] = connectingCells ? static_cast<int>(connectingCells->size()) : 0;
+            });
+            for (int index = 0; index < numCells; ++index) {
+                neighborOffsets[index + 1] += neighborOffsets[index];
             }
+
+            neighborIndices.resize(neighborOffsets[numCells]);
+            Parallel::forEach(0, numCells, [&](int index) {
+                auto const& connectingCells = cells[index]->connectingCells;
+                if (!connectingCells) {
+                    return;
+                }
+                auto neighborIndex = neighborOffsets[index];
+                for (auto const& connectingCellId : *connectingCells) {
+                    auto findResult = cellIndicesByIds.find(connectingCellId);
+                    neighborIndices[neighborIndex++] = findResult != cellIndicesByIds.end() ? findResult->second : -1;
+                }
+            });
         }
-    }
 
-    auto hexagon =
-        ClusterDescription().setVel({0, 0}).setAngle(0).setAngularVel(0).setMetadata(ClusterMetadata()).addCells(cells);
-    hexagon.setPos(hexagon.getClusterPosFromCells());
+        vector<int> getCellIndices(std::unordered_set<uint64_t> const& cellIds) const
+        {
+            vector<int> result;
+            result.reserve(cellIds.size());
+            for (auto const& cellId : cellIds) {
+                auto findResult = cellIndicesByIds.find(cellId);
+                if (findResult != cellIndicesByIds.end()) {
+                    result.emplace_back(findResult->second);
+                }
+            }
+            return result;
+        }
+    };
+}
 
-    if (parameters._angle != 0) {
-        for (auto& cell : *hexagon.cells) {
-            cell.pos = Physics::rotateClockwise(*cell.pos - *hexagon.pos, parameters._angle) + *hexagon.pos;
+ClusterDescription DescriptionFactoryImpl::createRect(CreateRectParameters const& parameters) const
+{
+    auto const& size = parameters._size;
+    vector<IntVector2D> sites;
+    sites.reserve(static_cast<size_t>(std::max(0, size.x)) * std::max(0, size.y));
+    for (int x = 0; x < size.x; ++x) {
+        for (int y = 0; y < size.y; ++y) {
+            sites.push_back({x, y});
         }
     }
+    return createLatticeCluster(
+        LatticeType::Square,
+        sites,
+        parameters._cellDistance,
+        parameters._centerPosition,
+        0,
+        createCellTemplate(parameters._cellEnergy, parameters._maxConnections, parameters._colorCode));
+}
 
-    return hexagon;
+ClusterDescription DescriptionFactoryImpl::createHexagon(CreateHexagonParameters const& parameters) const
+{
+    //sites are enumerated column by column of the original hexagon matrix in order to keep the cell order stable
+    auto const layers = parameters._layers;
+    vector<IntVector2D> sites;
+    for (int i = -(layers - 1); i < layers; ++i) {
+        for (int row = -(layers - 1); row < layers; ++row) {
+            if (i < layers - std::abs(row)) {
+                sites.push_back({row < 0 ? i - row : i, row});
+            }
+        }
+    }
+    return createLatticeCluster(
+        LatticeType::Triangular,
+        sites,
+        parameters._cellDistance,
+        parameters._centerPosition,
+        parameters._angle,
+        createCellTemplate(parameters._cellEnergy, parameters._maxConnections, parameters._colorCode));
 }
 
 ClusterDescription DescriptionFactoryImpl::createUnconnectedDisc(
     CreateDiscParameters const& parameters) const
 {
-    auto circle =
-        ClusterDescription().setVel({0, 0}).setAngle(0).setAngularVel(0).setMetadata(ClusterMetadata());
+    auto circle = createEmptyCluster();
 
-    uint64_t id = 0;
+    //number of cells per circle
+    vector<double> radii;
+    vector<int> firstCellIndices;
+    vector<int> numCellsPerCircle;
+    int numCells = 0;
     for (double radius = parameters._innerRadius; radius - FLOATINGPOINT_HIGH_PRECISION <= parameters._outerRadius;
          radius += parameters._cellDistance) {
-        auto angleInc = radius > 0 ? asin(parameters._cellDistance / (2.0 * radius)) * 2.0 * radToDeg : 361.0;
-        angleInc = 360.0 / floor(360.0 / angleInc);
-        std::unordered_set<uint64_t> cellIds;
-        for (auto angle = 0.0; angle < 360.0 - angleInc/2; angle += angleInc) {
-            auto relPos = Physics::unitVectorOfAngle(angle) * radius;
-
-            auto cell = CellDescription()
-                            .setId(++id)
-                            .setEnergy(parameters._cellEnergy)
-                            .setPos(parameters._centerPosition + relPos)
-                            .setMaxConnections(parameters._maxConnections)
-                            .setFlagTokenBlocked(false)
-                            .setTokenBranchNumber(0)
-                            .setMetadata(CellMetadata().setColor(parameters._colorCode))
-                            .setCellFeature(CellFeatureDescription());
-            circle.addCell(cell);
+        int numCellsOnCircle = 0;
+        if (radius > 0 && parameters._cellDistance <= 2.0 * radius) {
+            auto angleInc = asin(parameters._cellDistance / (2.0 * radius)) * 2.0 * radToDeg;
+            numCellsOnCircle = static_cast<int>(floor(360.0 / angleInc));
         }
+        radii.push_back(radius);
+        firstCellIndices.push_back(numCells);
+        numCellsPerCircle.push_back(numCellsOnCircle);
+        numCells += numCellsOnCircle;
+    }
+
+    auto const cellTemplate =
+        createCellTemplate(parameters._cellEnergy, parameters._maxConnections, parameters._colorCode);
+    auto& cells = *(circle.cells = vector<CellDescription>(numCells, cellTemplate));
+    for (int circleIndex = 0; circleIndex < radii.size(); ++circleIndex) {
+        auto radius = radii[circleIndex];
+        auto numCellsOnCircle = numCellsPerCircle[circleIndex];
+        auto firstCellIndex = firstCellIndices[circleIndex];
+        Parallel::forEach(0, numCellsOnCircle, [&](int index) {
+            auto angle = 360.0 * index / numCellsOnCircle;
+            auto& cell = cells[firstCellIndex + index];
+            cell.id = firstCellIndex + index + 1;
+            cell.pos = parameters._centerPosition + Physics::unitVectorOfAngle(angle) * radius;
+        });
     }
 
     circle.setPos(circle.getClusterPosFromCells());
@@ -130,91 +354,152 @@ ClusterDescription DescriptionFactoryImpl::createUnconnectedDisc(
     return circle;
 }
 
-void DescriptionFactoryImpl::generateBranchNumbers(
-    SimulationParameters const& parameters,
-    DataDescription& data,
-    std::unordered_set<uint64_t> const& cellIds) const
+ClusterDescription DescriptionFactoryImpl::createRing(CreateRingParameters const& parameters) const
 {
-    DescriptionNavigator navigator;
-    navigator.update(data);
+    auto const outerRadius = parameters._outerRadius;
+    auto const innerRadius = parameters._innerRadius;
+    auto const rowDistance = std::sqrt(3.0) / 2.0 * parameters._cellDistance;
+    int maxRow = static_cast<int>(ceil(outerRadius / rowDistance));
+    int maxColumn = static_cast<int>(ceil(outerRadius / parameters._cellDistance)) + maxRow;
+    auto sites = collectSites(
+        LatticeType::Triangular,
+        parameters._cellDistance,
+        -maxRow,
+        maxRow,
+        [&](int row) { return IntVector2D{-maxColumn, maxColumn}; },
+        [&](QVector2D const& pos) {
+            auto radius = pos.length();
+            return radius + FLOATINGPOINT_HIGH_PRECISION >= innerRadius
+                && radius - FLOATINGPOINT_HIGH_PRECISION <= outerRadius;
+        });
+    return createLatticeCluster(
+        LatticeType::Triangular,
+        sites,
+        parameters._cellDistance,
+        parameters._centerPosition,
+        0,
+        createCellTemplate(parameters._cellEnergy, parameters._maxConnections, parameters._colorCode));
+}
 
-    std::set<uint64_t> visitedCellIds(cellIds.begin(), cellIds.end());
-    std::vector<std::vector<uint64_t>> cellIdPaths;
-    for (auto const& cellId : cellIds) {
-        cellIdPaths.emplace_back(std::vector<uint64_t>{cellId});
+ClusterDescription DescriptionFactoryImpl::createFilledPolygon(CreatePolygonParameters const& parameters) const
+{
+    auto const& vertices = parameters._vertices;
+    if (vertices.size() < 3) {
+        return createEmptyCluster().setPos(parameters._centerPosition);
     }
 
-    int origNumVisitedCells = 0;
-    do {
+    QVector2D minPos = vertices.front();
+    QVector2D maxPos = vertices.front();
+    for (auto const& vertex : vertices) {
+        minPos = QVector2D(std::min(minPos.x(), vertex.x()), std::min(minPos.y(), vertex.y()));
+        maxPos = QVector2D(std::max(maxPos.x(), vertex.x()), std::max(maxPos.y(), vertex.y()));
+    }
 
-        //set branch numbers an last cell on path
-        for (auto const& cellIdPath : cellIdPaths) {
-            if (cellIdPath.empty()) {
-                continue;
+    //even-odd rule
+    auto isInside = [&vertices](QVector2D const& pos) {
+        bool result = false;
+        for (int i = 0, j = static_cast<int>(vertices.size()) - 1; i < vertices.size(); j = i++) {
+            auto const& v1 = vertices[i];
+            auto const& v2 = vertices[j];
+            if ((v1.y() > pos.y()) != (v2.y() > pos.y())
+                && pos.x() < (v2.x() - v1.x()) * (pos.y() - v1.y()) / (v2.y() - v1.y()) + v1.x()) {
+                result = !result;
             }
-            auto const& lastCellId = cellIdPath.back();
-
-            auto clusterIndex = navigator.clusterIndicesByCellIds.at(lastCellId);
-            auto cellIndex = navigator.cellIndicesByCellIds.at(lastCellId);
-            auto& cell = data.clusters->at(clusterIndex).cells->at(cellIndex);
-            cell.setTokenBranchNumber((cellIdPath.size() - 1) % parameters.cellMaxTokenBranchNumber);
         }
+        return result;
+    };
+
+    auto const cellDistance = parameters._cellDistance;
+    auto const rowDistance = std::sqrt(3.0) / 2.0 * cellDistance;
+    auto sites = collectSites(
+        LatticeType::Triangular,
+        cellDistance,
+        static_cast<int>(floor(minPos.y() / rowDistance)),
+        static_cast<int>(ceil(maxPos.y() / rowDistance)),
+        [&](int row) {
+            return IntVector2D{
+                static_cast<int>(floor(minPos.x() / cellDistance - row / 2.0)),
+                static_cast<int>(ceil(maxPos.x() / cellDistance - row / 2.0))};
+        },
+        isInside);
+    return createLatticeCluster(
+        LatticeType::Triangular,
+        sites,
+        cellDistance,
+        parameters._centerPosition,
+        0,
+        createCellTemplate(parameters._cellEnergy, parameters._maxConnections, parameters._colorCode),
+        LatticeAnchor::Origin);
+}
+
+void DescriptionFactoryImpl::generateBranchNumbers(
+    SimulationParameters const& parameters,
+    DataDescription& data,
+    std::unordered_set<uint64_t> const& cellIds) const
+{
+    CellGraph graph;
+    graph.init(data, true);
+
+    //level-synchronous breadth-first search starting from all given cells:
+    //the branch number of a cell is its distance to the nearest start cell
+    int numCells = static_cast<int>(graph.cells.size());
+    vector<std::atomic<bool>> visitedFlags(numCells);
+    Parallel::forEach(0, numCells, [&](int index) { visitedFlags[index].store(false, std::memory_order_relaxed); });
+
+    vector<int> frontier;
+    for (auto const& cellIndex : graph.getCellIndices(cellIds)) {
+        visitedFlags[cellIndex].store(true, std::memory_order_relaxed);
+        frontier.emplace_back(cellIndex);
+    }
 
-        //modify paths
-        origNumVisitedCells = visitedCellIds.size();
-        for (auto& cellIdPath : cellIdPaths) {
-            auto found = false;
-            while (!found && !cellIdPath.empty()) {
-                auto const& lastCellId = cellIdPath.back();
-                auto clusterIndex = navigator.clusterIndicesByCellIds.at(lastCellId);
-                auto cellIndex = navigator.cellIndicesByCellIds.at(lastCellId);
-                auto& cell = data.clusters->at(clusterIndex).cells->at(cellIndex);
-                for (auto const& connectingCellId : *cell.connectingCells) {
-                    if (visitedCellIds.find(connectingCellId) == visitedCellIds.end()) {
-                        cellIdPath.emplace_back(connectingCellId);
-                        visitedCellIds.insert(connectingCellId);
-                        found = true;
-                        break;
+    int distance = 0;
+    while (!frontier.empty()) {
+        auto const branchNumber = distance % parameters.cellMaxTokenBranchNumber;
+        vector<vector<int>> nextFrontiersByChunk(Parallel::getNumChunks(static_cast<int>(frontier.size())));
+        Parallel::forEachChunk(0, static_cast<int>(frontier.size()), [&](int chunkIndex, int chunkBegin, int chunkEnd) {
+            auto& nextFrontier = nextFrontiersByChunk[chunkIndex];
+            for (int frontierIndex = chunkBegin; frontierIndex < chunkEnd; ++frontierIndex) {
+                auto const cellIndex = frontier[frontierIndex];
+                graph.cells[cellIndex]->setTokenBranchNumber(branchNumber);
+                for (int i = graph.neighborOffsets[cellIndex]; i < graph.neighborOffsets[cellIndex + 1]; ++i) {
+                    auto const neighborIndex = graph.neighborIndices[i];
+                    if (neighborIndex != -1 && !visitedFlags[neighborIndex].exchange(true, std::memory_order_relaxed)) {
+                        nextFrontier.emplace_back(neighborIndex);
                     }
                 }
-                if (!found) {
-                    cellIdPath.pop_back();
-                }
             }
+        });
+
+        frontier.clear();
+        for (auto const& nextFrontier : nextFrontiersByChunk) {
+            frontier.insert(frontier.end(), nextFrontier.begin(), nextFrontier.end());
         }
-    } while (origNumVisitedCells != visitedCellIds.size());
+        ++distance;
+    }
 }
 
 void DescriptionFactoryImpl::randomizeCellFunctions(
     SimulationParameters const& parameters,
     DataDescription& data,
-    std::unordered_set<uint64_t> const& cellIds) const
+    std::unordered_set<uint64_t> const& cellIds,
+    uint64_t seed) const
 {
+    CellGraph graph;
+    graph.init(data, false);
+    auto const cellIndices = graph.getCellIndices(cellIds);
 
-    DescriptionNavigator navigator;
-    navigator.update(data);
-    for (auto const& cellId : cellIds) {
-        auto clusterIndex = navigator.clusterIndicesByCellIds.at(cellId);
-        auto cellIndex = navigator.cellIndicesByCellIds.at(cellId);
-        auto& cell = data.clusters->at(clusterIndex).cells->at(cellIndex);
+    //each cell draws from its own stream, hence neither contention nor the chunking affects the result
+    Parallel::forEach(0, static_cast<int>(cellIndices.size()), [&](int index) {
+        auto& cell = *graph.cells[cellIndices[index]];
+        CellRandomStream random(seed, cell.id);
 
         CellFeatureDescription cellFunction;
-        cellFunction.setType(static_cast<Enums::CellFunction::Type>(
-            QRandomGenerator::global()->generate() % Enums::CellFunction::_COUNTER));
-
-        QByteArray volatileData;
-        for (int i = 0; i < parameters.cellFunctionComputerMaxInstructions * 3; ++i) {
-            volatileData.append(QRandomGenerator::global()->generate() % 256);
-        }
-        cellFunction.setVolatileData(volatileData);
-
-        QByteArray staticData;
-        for (int i = 0; i < parameters.cellFunctionComputerCellMemorySize; ++i) {
-            staticData.append(QRandomGenerator::global()->generate() % 256);
-        }
-        cellFunction.setConstData(staticData);
+        cellFunction.setType(
+            static_cast<Enums::CellFunction::Type>(random.getRandomInt(Enums::CellFunction::_COUNTER)));
+        cellFunction.setVolatileData(random.getRandomArray(parameters.cellFunctionComputerMaxInstructions * 3));
+        cellFunction.setConstData(random.getRandomArray(parameters.cellFunctionComputerCellMemorySize));
         cell.cellFeature = cellFunction;
-    }
+    });
 }
 
 void DescriptionFactoryImpl::removeFreeCellConnections(
@@ -222,12 +507,11 @@ void DescriptionFactoryImpl::removeFreeCellConnections(
     DataDescription& data,
     std::unordered_set<uint64_t> const& cellIds) const
 {
-    DescriptionNavigator navigator;
-    navigator.update(data);
-    for (auto const& cellId : cellIds) {
-        auto clusterIndex = navigator.clusterIndicesByCellIds.at(cellId);
-        auto cellIndex = navigator.cellIndicesByCellIds.at(cellId);
-        auto& cell = data.clusters->at(clusterIndex).cells->at(cellIndex);
-        cell.maxConnections = cell.connectingCells ? cell.connectingCells->size() : 0;
-    }
+    CellGraph graph;
+    graph.init(data, false);
+    auto const cellIndices = graph.getCellIndices(cellIds);
+    Parallel::forEach(0, static_cast<int>(cellIndices.size()), [&](int index) {
+        auto& cell = *graph.cells[cellIndices[index]];
+        cell.maxConnections = cell.connectingCells ? static_cast<int>(cell.connectingCells->size()) : 0;
+    });
 }
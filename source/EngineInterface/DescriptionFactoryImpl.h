@@ -7,10 +7,16 @@ class DescriptionFactoryImpl : public DescriptionFactory
 public:
     virtual ~DescriptionFactoryImpl() = default;
 
+    ClusterDescription createRect(CreateRectParameters const& parameters) const override;
+
     ClusterDescription createHexagon(CreateHexagonParameters const& parameters) const override;
 
     ClusterDescription createUnconnectedDisc(CreateDiscParameters const& parameters) const override;
 
+    ClusterDescription createRing(CreateRingParameters const& parameters) const override;
+
+    ClusterDescription createFilledPolygon(CreatePolygonParameters const& parameters) const override;
+
     void generateBranchNumbers(
         SimulationParameters const& parameters,
         DataDescription& data,
@@ -19,7 +25,8 @@ public:
     void randomizeCellFunctions(
         SimulationParameters const& parameters,
         DataDescription& data,
-        std::unordered_set<uint64_t> const& cellIds) const override;
+        std::unordered_set<uint64_t> const& cellIds,
+        uint64_t seed) const override;
 
     void removeFreeCellConnections(
         SimulationParameters const& parameters,
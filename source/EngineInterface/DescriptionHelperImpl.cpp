@@ -1,7 +1,9 @@
 #include <algorithm>
+#include <atomic>
 
 #include <Base/DebugMacros.h>
 #include "Base/NumberGenerator.h"
+#include "Base/Parallel.h"
 
 #include "DescriptionHelperImpl.h"
 
@@ -74,20 +76,24 @@ void DescriptionHelperImpl::makeValid(ClusterDescription & cluster)
     TRY;
     cluster.id = _numberGen->getId();
 	if (cluster.cells) {
+		auto& cells = *cluster.cells;
+		uint64_t firstNewId = _numberGen->getIds(static_cast<uint32_t>(cells.size()));
 		unordered_map<uint64_t, uint64_t> newByOldIds;
-		for (auto & cell : *cluster.cells) {
-			uint64_t newId = _numberGen->getId();
-			newByOldIds.insert_or_assign(cell.id, newId);
-			cell.id = newId;
+		newByOldIds.reserve(cells.size());
+		for (int i = 0; i < cells.size(); ++i) {
+			uint64_t newId = firstNewId + i;
+			newByOldIds.insert_or_assign(cells[i].id, newId);
+			cells[i].id = newId;
 		}
 
-		for (auto & cell : *cluster.cells) {
+		Parallel::forEach(0, static_cast<int>(cells.size()), [&](int index) {
+			auto& cell = cells[index];
 			if (cell.connectingCells) {
 				for (uint64_t& connectingCellId : *cell.connectingCells) {
 					connectingCellId = newByOldIds.at(connectingCellId);
 				}
 			}
-		}
+		});
 	}
     CATCH;
 }
@@ -153,14 +159,22 @@ void DescriptionHelperImpl::updateInternals()
     _navi.update(*_data);
 	_origNavi.update(*_origData);
 
-	_cellMap.clear();
+	vector<QVector2D> cellPositions;
+	vector<uint64_t> cellIds;
 	for (auto const &cluster : *_data->clusters) {
 		for (auto const &cell : *cluster.cells) {
-			auto const &pos = *cell.pos;
-			auto intPos = _metric->convertToIntVector(pos);
-			_cellMap[intPos.x][intPos.y].push_back(cell.id);
+			cellPositions.emplace_back(*cell.pos);
+			cellIds.emplace_back(cell.id);
 		}
 	}
+	vector<IntVector2D> intPositions(cellPositions.size());
+	_metric->convertToIntVectors(cellPositions.data(), intPositions.data(), static_cast<int>(cellPositions.size()));
+
+	_cellMap.clear();
+	for (int i = 0; i < intPositions.size(); ++i) {
+		auto const& intPos = intPositions[i];
+		_cellMap[intPos.x][intPos.y].push_back(cellIds[i]);
+	}
     CATCH;
 }
 
@@ -179,68 +193,143 @@ void DescriptionHelperImpl::updateConnectingCells(list<uint64_t> const &changedC
     CATCH;
 }
 
-void DescriptionHelperImpl::reclustering(unordered_set<uint64_t> const& clusterIds)
+namespace
 {
-    TRY;
-    unordered_set<uint64_t> affectedClusterIndices;
-	for (uint64_t clusterId : clusterIds) {
-		affectedClusterIndices.insert(_navi.clusterIndicesByClusterIds.at(clusterId));
-	}
-
-	vector<ClusterDescription> newClusters;
-	unordered_set<uint64_t> remainingCellIds;
-	for (int affectedClusterIndex : affectedClusterIndices) {
-		for (auto &cell : *_data->clusters->at(affectedClusterIndex).cells) {
-			remainingCellIds.insert(cell.id);
-		}
-	}
-
-	unordered_set<uint64_t> lookedUpCellIds;
-
-	while (!remainingCellIds.empty()) {
-		ClusterDescription newCluster;
-		lookUpCell(*remainingCellIds.begin(), newCluster, lookedUpCellIds, remainingCellIds);
-		if (newCluster.cells && !newCluster.cells->empty()) {
-			newCluster.id = _numberGen->getId();
-			setClusterAttributes(newCluster);
-			newClusters.push_back(newCluster);
-		}
-	}
-
-	unordered_set<int> discardedClusterIndices;
-	for (uint64_t lookedUpCellId : lookedUpCellIds) {
-		discardedClusterIndices.insert(_navi.clusterIndicesByCellIds.at(lookedUpCellId));
-	}
+    int findRoot(vector<std::atomic<int>>& parents, int index)
+    {
+        while (true) {
+            int parent = parents[index].load();
+            if (parent == index) {
+                return index;
+            }
 
-	for (int clusterIndex = 0; clusterIndex < _data->clusters->size(); ++clusterIndex) {
-		if (discardedClusterIndices.find(clusterIndex) == discardedClusterIndices.end()) {
-			newClusters.emplace_back(_data->clusters->at(clusterIndex));
-		}
-	}
+            //path halving
+            int grandParent = parents[parent].load();
+            if (grandParent != parent) {
+                int expected = parent;
+                parents[index].compare_exchange_weak(expected, grandParent);
+            }
+            index = grandParent;
+        }
+    }
 
-	_data->clusters = newClusters;
-    CATCH;
+    //root with larger index is always linked to root with smaller index => no cycles under concurrent unions
+    void unite(vector<std::atomic<int>>& parents, int index1, int index2)
+    {
+        while (true) {
+            index1 = findRoot(parents, index1);
+            index2 = findRoot(parents, index2);
+            if (index1 == index2) {
+                return;
+            }
+            if (index1 < index2) {
+                std::swap(index1, index2);
+            }
+            int expected = index1;
+            if (parents[index1].compare_exchange_strong(expected, index2)) {
+                return;
+            }
+        }
+    }
 }
 
-void DescriptionHelperImpl::lookUpCell(uint64_t cellId, ClusterDescription &newCluster, unordered_set<uint64_t> &lookedUpCellIds
-	, unordered_set<uint64_t> &remainingCellIds)
+void DescriptionHelperImpl::reclustering(unordered_set<uint64_t> const& clusterIds)
 {
     TRY;
-    if (lookedUpCellIds.find(cellId) != lookedUpCellIds.end()) {
-		return;
-	}
-	
-	lookedUpCellIds.insert(cellId);
-	remainingCellIds.erase(cellId);
+    //affected clusters are the given ones and all clusters connected to them
+    vector<bool> affectedClusterFlags(_data->clusters->size(), false);
+    vector<int> affectedClusterIndices;
+    for (uint64_t clusterId : clusterIds) {
+        int clusterIndex = _navi.clusterIndicesByClusterIds.at(clusterId);
+        if (!affectedClusterFlags[clusterIndex]) {
+            affectedClusterFlags[clusterIndex] = true;
+            affectedClusterIndices.push_back(clusterIndex);
+        }
+    }
+    for (int i = 0; i < affectedClusterIndices.size(); ++i) {
+        auto const& cluster = _data->clusters->at(affectedClusterIndices[i]);
+        if (!cluster.cells) {
+            continue;
+        }
+        for (auto const& cell : *cluster.cells) {
+            if (!cell.connectingCells) {
+                continue;
+            }
+            for (uint64_t connectingCellId : *cell.connectingCells) {
+                int clusterIndex = _navi.clusterIndicesByCellIds.at(connectingCellId);
+                if (!affectedClusterFlags[clusterIndex]) {
+                    affectedClusterFlags[clusterIndex] = true;
+                    affectedClusterIndices.push_back(clusterIndex);
+                }
+            }
+        }
+    }
 
-	auto &cell = getCellDescRef(cellId);
-	newCluster.addCell(cell);
+    //dense cell indices
+    vector<CellDescription const*> cells;
+    unordered_map<uint64_t, int> cellIndicesByCellIds;
+    for (int clusterIndex : affectedClusterIndices) {
+        auto const& cluster = _data->clusters->at(clusterIndex);
+        if (cluster.cells) {
+            for (auto const& cell : *cluster.cells) {
+                cellIndicesByCellIds.emplace(cell.id, static_cast<int>(cells.size()));
+                cells.push_back(&cell);
+            }
+        }
+    }
+    int numCells = static_cast<int>(cells.size());
+
+    //connected component labelling
+    vector<std::atomic<int>> parents(numCells);
+    Parallel::forEach(0, numCells, [&](int index) { parents[index].store(index); });
+    Parallel::forEach(0, numCells, [&](int index) {
+        auto const& cell = *cells[index];
+        if (cell.connectingCells) {
+            for (uint64_t connectingCellId : *cell.connectingCells) {
+                auto connectingCellIndex = cellIndicesByCellIds.at(connectingCellId);
+                if (connectingCellIndex > index) {
+                    unite(parents, index, connectingCellIndex);
+                }
+            }
+        }
+    });
+
+    vector<int> roots(numCells);
+    Parallel::forEach(0, numCells, [&](int index) { roots[index] = findRoot(parents, index); });
+
+    vector<int> newClusterIndicesByRoot(numCells, -1);
+    vector<int> newClusterIndices(numCells);
+    vector<int> newCellIndices(numCells);
+    vector<int> newClusterSizes;
+    for (int index = 0; index < numCells; ++index) {
+        auto& newClusterIndex = newClusterIndicesByRoot[roots[index]];
+        if (newClusterIndex == -1) {
+            newClusterIndex = static_cast<int>(newClusterSizes.size());
+            newClusterSizes.push_back(0);
+        }
+        newClusterIndices[index] = newClusterIndex;
+        newCellIndices[index] = newClusterSizes[newClusterIndex]++;
+    }
 
-	if (cell.connectingCells) {
-		for (uint64_t connectingCellId : *cell.connectingCells) {
-			lookUpCell(connectingCellId, newCluster, lookedUpCellIds, remainingCellIds);
-		}
-	}
+    //scatter cells into new clusters
+    int numNewClusters = static_cast<int>(newClusterSizes.size());
+    vector<ClusterDescription> newClusters(numNewClusters);
+    for (int i = 0; i < numNewClusters; ++i) {
+        newClusters[i].id = _numberGen->getId();
+        newClusters[i].cells = vector<CellDescription>(newClusterSizes[i]);
+    }
+    Parallel::forEach(0, numCells, [&](int index) {
+        (*newClusters[newClusterIndices[index]].cells)[newCellIndices[index]] = *cells[index];
+    });
+    Parallel::forEach(0, numNewClusters, [&](int index) { setClusterAttributes(newClusters[index]); }, 1);
+
+    for (int clusterIndex = 0; clusterIndex < _data->clusters->size(); ++clusterIndex) {
+        if (!affectedClusterFlags[clusterIndex]) {
+            newClusters.emplace_back(_data->clusters->at(clusterIndex));
+        }
+    }
+
+	_data->clusters = newClusters;
     CATCH;
 }
 
@@ -341,13 +430,13 @@ list<uint64_t> DescriptionHelperImpl::getCellIdsAtPos(IntVector2D const &pos)
 
 namespace
 {
-	QVector2D calcCenter(vector<CellDescription> const & cells)
+	Physics::VectorArray getPositions(vector<CellDescription> const & cells)
 	{
-		QVector2D result;
-		for (auto const& cell : cells) {
-			result += *cell.pos;
+		Physics::VectorArray result;
+		result.resize(static_cast<int>(cells.size()));
+		for (int i = 0; i < cells.size(); ++i) {
+			result.set(i, *cells[i].pos);
 		}
-		result = result / cells.size();
 		return result;
 	}
 }
@@ -355,10 +444,10 @@ namespace
 void DescriptionHelperImpl::setClusterAttributes(ClusterDescription& cluster)
 {
     TRY;
-    cluster.pos = calcCenter(*cluster.cells);
+    auto positions = getPositions(*cluster.cells);
+    cluster.pos = Physics::mean(positions);
 	cluster.angle = calcAngleBasedOnOrigClusters(*cluster.cells);
-	auto velocities = calcVelocitiesBasedOnOrigClusters(*cluster.cells);
-	double v = velocities.linear.length();
+	auto velocities = calcVelocitiesBasedOnOrigClusters(*cluster.cells, positions);
 	cluster.vel = velocities.linear;
 	cluster.angularVel = velocities.angular;
 	if (auto clusterMetadata = calcMetadataBasedOnOrigClusters(*cluster.cells)) {
@@ -380,62 +469,36 @@ double DescriptionHelperImpl::calcAngleBasedOnOrigClusters(vector<CellDescriptio
     CATCH;
 }
 
-namespace
-{
-	double calcAngularMass(vector<CellDescription> const & cells)
-	{
-		QVector2D center = calcCenter(cells);
-		double result = 0.0;
-		for (auto const& cell : cells) {
-			result += (*cell.pos - center).lengthSquared();
-		}
-		return result;
-	}
-}
-
-Physics::Velocities DescriptionHelperImpl::calcVelocitiesBasedOnOrigClusters(vector<CellDescription> const & cells) const
+Physics::Velocities DescriptionHelperImpl::calcVelocitiesBasedOnOrigClusters(
+    vector<CellDescription> const & cells,
+    Physics::VectorArray const & positions) const
 {
     TRY;
     CHECK(!cells.empty());
 	
 	Physics::Velocities result{ QVector2D(), 0.0 };
-	if (cells.size() == 1) {
-		auto cell = cells.front();
-		if (_origNavi.clusterIndicesByCellIds.find(cell.id) == _origNavi.clusterIndicesByCellIds.end()
-			|| _origNavi.cellIndicesByCellIds.find(cell.id) == _origNavi.cellIndicesByCellIds.end()) {
+	Physics::VectorArray cellVelocities;
+	cellVelocities.resize(static_cast<int>(cells.size()));
+	for (int i = 0; i < cells.size(); ++i) {
+		auto const& cell = cells[i];
+		auto clusterIndexIter = _origNavi.clusterIndicesByCellIds.find(cell.id);
+		auto cellIndexIter = _origNavi.cellIndicesByCellIds.find(cell.id);
+		if (clusterIndexIter == _origNavi.clusterIndicesByCellIds.end()
+			|| cellIndexIter == _origNavi.cellIndicesByCellIds.end()) {
 			return result;
 		}
-		int clusterIndex = _origNavi.clusterIndicesByCellIds.at(cell.id);
-		int cellIndex = _origNavi.cellIndicesByCellIds.at(cell.id);
-		auto const& origCluster = _origData->clusters->at(clusterIndex);
-		auto const& origCell = origCluster.cells->at(cellIndex);
-		result.linear= Physics::tangentialVelocity(*origCell.pos - *origCluster.pos, { *origCluster.vel, *origCluster.angularVel });
-		return result;
+		auto const& origCluster = _origData->clusters->at(clusterIndexIter->second);
+		auto const& origCell = origCluster.cells->at(cellIndexIter->second);
+		cellVelocities.set(i, Physics::tangentialVelocity(*origCell.pos - *origCluster.pos, { *origCluster.vel, *origCluster.angularVel }));
 	}
-
-	unordered_map<uint64_t, QVector2D> cellVel;
-	for (auto const& cell : cells) {
-		if (_origNavi.clusterIndicesByCellIds.find(cell.id) == _origNavi.clusterIndicesByCellIds.end()
-			|| _origNavi.cellIndicesByCellIds.find(cell.id) == _origNavi.cellIndicesByCellIds.end()) {
-			return result;
-		}
-		int clusterIndex = _origNavi.clusterIndicesByCellIds.at(cell.id);
-		int cellIndex = _origNavi.cellIndicesByCellIds.at(cell.id);
-		auto const& origCluster = _origData->clusters->at(clusterIndex);
-		auto const& origCell = origCluster.cells->at(cellIndex);
-		cellVel.insert_or_assign(cell.id, Physics::tangentialVelocity(*origCell.pos - *origCluster.pos, { *origCluster.vel, *origCluster.angularVel }));
-		result.linear += cellVel.at(cell.id);
+	result.linear = Physics::mean(cellVelocities);
+	if (cells.size() == 1) {
+		return result;
 	}
-	result.linear /= cells.size();
 
-	QVector2D center = calcCenter(cells);
-	double angularMomentum = 0.0;
-	for (auto const& cell : cells) {
-		QVector2D r = *cell.pos - center;
-		QVector2D v = cellVel.at(cell.id) - result.linear;
-		angularMomentum += Physics::angularMomentum(r, v);
-	}
-	result.angular = Physics::angularVelocity(angularMomentum, calcAngularMass(cells));
+	auto center = Physics::mean(positions);
+	auto angularMomentum = Physics::angularMomentum(positions, center, cellVelocities, result.linear);
+	result.angular = Physics::angularVelocity(angularMomentum, Physics::angularMass(positions, center));
 
 	return result;
     CATCH;
@@ -0,0 +1,161 @@
+#include "DescriptionInstancer.h"
+
+#include <cmath>
+#include <unordered_map>
+
+#include "Base/Parallel.h"
+
+#include "Descriptions.h"
+#include "Physics.h"
+
+namespace
+{
+    int const InstancesPerChunk = 16;
+
+    class Transformation
+    {
+    public:
+        Transformation(DescriptionInstancer::Transform const& transform, QVector2D const& center)
+            : _transform(transform)
+            , _center(center)
+        {
+            auto const angle = transform.angle.get_value_or(0.0) * degToRad;
+            _cos = static_cast<float>(std::cos(angle));
+            _sin = static_cast<float>(std::sin(angle));
+        }
+
+        QVector2D mapPos(QVector2D const& pos) const
+        {
+            if (!_transform.angle) {
+                return pos + _transform.posDelta;
+            }
+            auto const relPos = pos - _center;
+            return _center + _transform.posDelta
+                + QVector2D(_cos * relPos.x() - _sin * relPos.y(), _sin * relPos.x() + _cos * relPos.y());
+        }
+
+        void mapVel(QVector2D& vel) const
+        {
+            if (_transform.velocityXDelta) {
+                vel.setX(vel.x() + static_cast<float>(*_transform.velocityXDelta));
+            }
+            if (_transform.velocityYDelta) {
+                vel.setY(vel.y() + static_cast<float>(*_transform.velocityYDelta));
+            }
+        }
+
+        DescriptionInstancer::Transform const& getTransform() const { return _transform; }
+
+    private:
+        DescriptionInstancer::Transform _transform;
+        QVector2D _center;
+        float _cos = 1.0f;
+        float _sin = 0.0f;
+    };
+}
+
+uint32_t DescriptionInstancer::getNumIdsPerInstance(DataDescription const& prototype)
+{
+    uint32_t result = 0;
+    if (prototype.clusters) {
+        for (auto const& cluster : *prototype.clusters) {
+            result += 1 + (cluster.cells ? static_cast<uint32_t>(cluster.cells->size()) : 0);
+        }
+    }
+    if (prototype.particles) {
+        result += static_cast<uint32_t>(prototype.particles->size());
+    }
+    return result;
+}
+
+DataDescription DescriptionInstancer::createInstances(
+    DataDescription const& prototype,
+    vector<Transform> const& transforms,
+    uint64_t firstId)
+{
+    DataDescription result;
+    result.clusters = vector<ClusterDescription>();
+    result.particles = vector<ParticleDescription>();
+    auto const numInstances = static_cast<int>(transforms.size());
+    auto const numClusters = prototype.clusters ? static_cast<int>(prototype.clusters->size()) : 0;
+    auto const numParticles = prototype.particles ? static_cast<int>(prototype.particles->size()) : 0;
+    if (numInstances == 0 || numClusters + numParticles == 0) {
+        return result;
+    }
+
+    //ids of an instance: clusters first, then cells in prototype order, then particles
+    std::unordered_map<uint64_t, uint64_t> idOffsetByCellId;
+    for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex) {
+        auto const& cluster = prototype.clusters->at(clusterIndex);
+        if (cluster.cells) {
+            for (auto const& cell : *cluster.cells) {
+                idOffsetByCellId.emplace(cell.id, numClusters + idOffsetByCellId.size());
+            }
+        }
+    }
+    auto const numIdsPerInstance = getNumIdsPerInstance(prototype);
+    auto const center = prototype.calcCenter();
+
+    result.clusters->resize(static_cast<size_t>(numInstances) * numClusters);
+    result.particles->resize(static_cast<size_t>(numInstances) * numParticles);
+    Parallel::forEach(
+        0,
+        numInstances,
+        [&](int instance) {
+            Transformation const transformation(transforms[instance], center);
+            auto const& transform = transformation.getTransform();
+            auto const instanceFirstId = firstId + static_cast<uint64_t>(instance) * numIdsPerInstance;
+
+            for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex) {
+                auto& cluster = result.clusters->at(static_cast<size_t>(instance) * numClusters + clusterIndex);
+                cluster = prototype.clusters->at(clusterIndex);
+                cluster.id = instanceFirstId + clusterIndex;
+                if (cluster.pos) {
+                    *cluster.pos = transformation.mapPos(*cluster.pos);
+                }
+                if (cluster.vel) {
+                    transformation.mapVel(*cluster.vel);
+                }
+                if (transform.angle && cluster.angle) {
+                    *cluster.angle += *transform.angle;
+                }
+                if (transform.angularVelocityDelta && cluster.angularVel) {
+                    *cluster.angularVel += *transform.angularVelocityDelta;
+                }
+                if (!cluster.cells) {
+                    continue;
+                }
+                for (auto& cell : *cluster.cells) {
+                    cell.id = instanceFirstId + idOffsetByCellId.at(cell.id);
+                    if (cell.pos) {
+                        *cell.pos = transformation.mapPos(*cell.pos);
+                    }
+                    if (cell.connectingCells) {
+                        list<uint64_t> connectingCells;
+                        for (auto const& connectingCellId : *cell.connectingCells) {
+                            auto const findResult = idOffsetByCellId.find(connectingCellId);
+                            if (findResult != idOffsetByCellId.end()) {
+                                connectingCells.emplace_back(instanceFirstId + findResult->second);
+                            }
+                        }
+                        cell.connectingCells = connectingCells;
+                    }
+                }
+            }
+
+            auto const firstParticleId = instanceFirstId + numIdsPerInstance - numParticles;
+            for (int particleIndex = 0; particleIndex < numParticles; ++particleIndex) {
+                auto& particle = result.particles->at(static_cast<size_t>(instance) * numParticles + particleIndex);
+                particle = prototype.particles->at(particleIndex);
+                particle.id = firstParticleId + particleIndex;
+                if (particle.pos) {
+                    *particle.pos = transformation.mapPos(*particle.pos);
+                }
+                if (particle.vel) {
+                    transformation.mapVel(*particle.vel);
+                }
+            }
+        },
+        InstancesPerChunk);
+    return result;
+}
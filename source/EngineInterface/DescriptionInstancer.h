@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Creates many transformed copies of a prototype at once. The copies are independent of each other and are therefore
+ * built in parallel. Ids are taken from a consecutive range which has to be reserved in advance, e.g. by
+ * NumberGenerator::getIds(getNumIdsPerInstance(prototype) * numInstances).
+ */
+class ENGINEINTERFACE_EXPORT DescriptionInstancer
+{
+public:
+    struct Transform
+    {
+        QVector2D posDelta;
+        boost::optional<double> angle;  //rotation in degrees around the center of the prototype
+        boost::optional<double> velocityXDelta;
+        boost::optional<double> velocityYDelta;
+        boost::optional<double> angularVelocityDelta;
+    };
+
+    static uint32_t getNumIdsPerInstance(DataDescription const& prototype);
+
+    //the clusters and particles of instance i are stored at positions i * (number in prototype) + j, both are always
+    //initialized in the result, connections to cells outside of the prototype are removed
+    static DataDescription
+    createInstances(DataDescription const& prototype, vector<Transform> const& transforms, uint64_t firstId);
+};
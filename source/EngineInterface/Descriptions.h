@@ -105,7 +105,10 @@ struct ENGINEINTERFACE_EXPORT ClusterDescription
 	}
 	ClusterDescription& addCell(CellDescription const& value)
 	{
-		addCells({ value });
+		if (!cells) {
+			cells = vector<CellDescription>();
+		}
+		cells->emplace_back(value);
 		return *this;
 	}
 
@@ -148,7 +151,18 @@ struct ENGINEINTERFACE_EXPORT DataDescription
 	}
 	DataDescription& addCluster(ClusterDescription const& value)
 	{
-		addClusters({ value });
+		if (!clusters) {
+			clusters = vector<ClusterDescription>();
+		}
+		clusters->emplace_back(value);
+		return *this;
+	}
+	DataDescription& addCluster(ClusterDescription&& value)
+	{
+		if (!clusters) {
+			clusters = vector<ClusterDescription>();
+		}
+		clusters->emplace_back(std::move(value));
 		return *this;
 	}
 	DataDescription& addParticle(ParticleDescription const& value)
@@ -204,9 +218,15 @@ struct DescriptionNavigator
 		cellIndicesByCellIds.clear();
 		particleIndicesByParticleIds.clear();
 
-		int clusterIndex = 0;
+		updateAppended(data, 0, 0);
+	}
+
+	//only the clusters and particles from the given indices on are added
+	void updateAppended(DataDescription const& data, int firstClusterIndex, int firstParticleIndex)
+	{
 		if (data.clusters) {
-			for (auto const &cluster : *data.clusters) {
+			for (int clusterIndex = firstClusterIndex; clusterIndex < data.clusters->size(); ++clusterIndex) {
+				auto const &cluster = data.clusters->at(clusterIndex);
 				clusterIndicesByClusterIds.insert_or_assign(cluster.id, clusterIndex);
 				int cellIndex = 0;
 				if (cluster.cells) {
@@ -218,16 +238,14 @@ struct DescriptionNavigator
 						++cellIndex;
 					}
 				}
-				++clusterIndex;
 			}
 		}
 
-		int particleIndex = 0;
 		if (data.particles) {
-			for (auto const &particle : *data.particles) {
+			for (int particleIndex = firstParticleIndex; particleIndex < data.particles->size(); ++particleIndex) {
+				auto const &particle = data.particles->at(particleIndex);
 				particleIndicesByParticleIds.insert_or_assign(particle.id, particleIndex);
 				particleIds.insert(particle.id);
-				++particleIndex;
 			}
 		}
 	}
@@ -2,6 +2,11 @@
 #include <qmath.h>
 #include <QMatrix4x4>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHYSICS_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 #include "Physics.h"
 
 //calculate collision of two moving and rotating rigid bodies
@@ -89,28 +94,151 @@ double Physics::rotationalKineticEnergy(double angularMass, double angularVel)
 
 double Physics::angularMass(vector<QVector2D> const & relPositionOfMasses)
 {
-	auto result = 0.0;
-	for (auto const& relPositionOfMass : relPositionOfMasses) {
-		result += relPositionOfMass.lengthSquared();
-	}
-	return result;
+	return angularMass(VectorArray(relPositionOfMasses), QVector2D());
 }
 
 double Physics::angularMomentum(Velocities const & velocities, vector<QVector2D> const & relPositionOfMasses)
 {
-	vector<QVector2D> relVel;
-	std::transform(
-		relPositionOfMasses.begin(), relPositionOfMasses.end(), std::inserter(relVel, relVel.begin()),
-		[&velocities](QVector2D const& relPos) { return tangentialVelocity(relPos, velocities); });
+	VectorArray relPositions(relPositionOfMasses);
+	VectorArray relVelocities;
+	tangentialVelocities(relPositions, { QVector2D(), velocities.angular }, relVelocities);
+	return angularMomentum(relPositions, QVector2D(), relVelocities, QVector2D());
+}
 
-	auto result = 0.0;
-	for (auto const& relPos : relPositionOfMasses) {
-		auto relVel = tangentialVelocity(relPos, velocities) - velocities.linear;
-		result += angularMomentum(relPos, relVel);
+namespace
+{
+#ifdef PHYSICS_USE_SSE2
+	double horizontalSum(__m128d value)
+	{
+		return _mm_cvtsd_f64(_mm_add_sd(value, _mm_unpackhi_pd(value, value)));
+	}
+#endif
+}
+
+QVector2D Physics::mean(VectorArray const & vectors)
+{
+	int const size = vectors.size();
+	if (size == 0) {
+		return QVector2D();
+	}
+	double const* x = vectors.x.data();
+	double const* y = vectors.y.data();
+	double sumX = 0.0;
+	double sumY = 0.0;
+	int i = 0;
+#ifdef PHYSICS_USE_SSE2
+	__m128d accX = _mm_setzero_pd();
+	__m128d accY = _mm_setzero_pd();
+	for (; i + 2 <= size; i += 2) {
+		accX = _mm_add_pd(accX, _mm_loadu_pd(x + i));
+		accY = _mm_add_pd(accY, _mm_loadu_pd(y + i));
+	}
+	sumX = horizontalSum(accX);
+	sumY = horizontalSum(accY);
+#endif
+	for (; i < size; ++i) {
+		sumX += x[i];
+		sumY += y[i];
+	}
+	return QVector2D(sumX / size, sumY / size);
+}
+
+double Physics::angularMass(VectorArray const & positions, QVector2D const & center)
+{
+	int const size = positions.size();
+	double const* x = positions.x.data();
+	double const* y = positions.y.data();
+	double const centerX = center.x();
+	double const centerY = center.y();
+	double result = 0.0;
+	int i = 0;
+#ifdef PHYSICS_USE_SSE2
+	__m128d const cx = _mm_set1_pd(centerX);
+	__m128d const cy = _mm_set1_pd(centerY);
+	__m128d acc = _mm_setzero_pd();
+	for (; i + 2 <= size; i += 2) {
+		__m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), cx);
+		__m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), cy);
+		acc = _mm_add_pd(acc, _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+	}
+	result = horizontalSum(acc);
+#endif
+	for (; i < size; ++i) {
+		double dx = x[i] - centerX;
+		double dy = y[i] - centerY;
+		result += dx * dx + dy * dy;
 	}
 	return result;
 }
 
+double Physics::angularMomentum(
+	VectorArray const & positions, QVector2D const & center, VectorArray const & velocities, QVector2D const & velocityOfCenter)
+{
+	CHECK(positions.size() == velocities.size());
+	int const size = positions.size();
+	double const* x = positions.x.data();
+	double const* y = positions.y.data();
+	double const* vx = velocities.x.data();
+	double const* vy = velocities.y.data();
+	double const centerX = center.x();
+	double const centerY = center.y();
+	double const centerVelX = velocityOfCenter.x();
+	double const centerVelY = velocityOfCenter.y();
+	double result = 0.0;
+	int i = 0;
+#ifdef PHYSICS_USE_SSE2
+	__m128d const cx = _mm_set1_pd(centerX);
+	__m128d const cy = _mm_set1_pd(centerY);
+	__m128d const cvx = _mm_set1_pd(centerVelX);
+	__m128d const cvy = _mm_set1_pd(centerVelY);
+	__m128d acc = _mm_setzero_pd();
+	for (; i + 2 <= size; i += 2) {
+		__m128d rx = _mm_sub_pd(_mm_loadu_pd(x + i), cx);
+		__m128d ry = _mm_sub_pd(_mm_loadu_pd(y + i), cy);
+		__m128d relVx = _mm_sub_pd(_mm_loadu_pd(vx + i), cvx);
+		__m128d relVy = _mm_sub_pd(_mm_loadu_pd(vy + i), cvy);
+		acc = _mm_add_pd(acc, _mm_sub_pd(_mm_mul_pd(rx, relVy), _mm_mul_pd(ry, relVx)));
+	}
+	result = horizontalSum(acc);
+#endif
+	for (; i < size; ++i) {
+		double rx = x[i] - centerX;
+		double ry = y[i] - centerY;
+		result += rx * (vy[i] - centerVelY) - ry * (vx[i] - centerVelX);
+	}
+	return result;
+}
+
+void Physics::tangentialVelocities(
+	VectorArray const & positionsFromCenter, Velocities const & velocityOfCenter, VectorArray & result)
+{
+	int const size = positionsFromCenter.size();
+	result.resize(size);
+	double const* x = positionsFromCenter.x.data();
+	double const* y = positionsFromCenter.y.data();
+	double* resultX = result.x.data();
+	double* resultY = result.y.data();
+	double const linearX = velocityOfCenter.linear.x();
+	double const linearY = velocityOfCenter.linear.y();
+	double const angular = velocityOfCenter.angular * degToRad;
+	int i = 0;
+#ifdef PHYSICS_USE_SSE2
+	__m128d const lx = _mm_set1_pd(linearX);
+	__m128d const ly = _mm_set1_pd(linearY);
+	__m128d const w = _mm_set1_pd(angular);
+	for (; i + 2 <= size; i += 2) {
+		__m128d rx = _mm_loadu_pd(x + i);
+		__m128d ry = _mm_loadu_pd(y + i);
+		_mm_storeu_pd(resultX + i, _mm_sub_pd(lx, _mm_mul_pd(w, ry)));
+		_mm_storeu_pd(resultY + i, _mm_add_pd(ly, _mm_mul_pd(w, rx)));
+	}
+#endif
+	for (; i < size; ++i) {
+		resultX[i] = linearX - angular * y[i];
+		resultY[i] = linearY + angular * x[i];
+	}
+}
+
 double Physics::angularVelocity (double angularMassOld, double angularMassNew, double angularVelOld)
 {
     angularVelOld = angularVelOld*degToRad;
@@ -132,41 +260,22 @@ double Physics::angularVelocity (double angularMomentum, double angularMass)
         return angularMomentum/angularMass*radToDeg;
 }
 
-namespace
-{
-	vector<QVector2D> getPositionsInBarycentricCoordinates(vector<QVector2D> const& positions)
-	{
-		QVector2D center = std::accumulate(positions.begin(), positions.end(), QVector2D());
-		center /= positions.size();
-		vector<QVector2D> result;
-		std::transform(positions.begin(), positions.end(), std::inserter(result, result.begin()), [&center](QVector2D const& pos) {
-			return pos - center;
-		});
-		return result;
-	}
-}
-
 auto Physics::velocitiesOfCenter(Velocities const& velocities, vector<QVector2D> const& relPositionOfMasses) -> Velocities
 {
 	CHECK(!relPositionOfMasses.empty());
+	VectorArray relPositions(relPositionOfMasses);
+	VectorArray velocitiesOfMasses;
+	tangentialVelocities(relPositions, velocities, velocitiesOfMasses);
+
 	Velocities result;
+	result.linear = mean(velocitiesOfMasses);
 	result.angular = 0.0;
-	for (QVector2D const& relPositionOfMass : relPositionOfMasses) {
-		result.linear += Physics::tangentialVelocity(relPositionOfMass, velocities);
-	}
-	result.linear /= relPositionOfMasses.size();
-	if (relPositionOfMasses.size() == 1) {
+	if (relPositions.size() == 1) {
 		return result;
 	}
 
-	double angularMomentum = 0.0;
-	double angularMass = Physics::angularMass(getPositionsInBarycentricCoordinates(relPositionOfMasses));
-	for (QVector2D const& relPositionOfMass : relPositionOfMasses) {
-		QVector2D tangentialVel = Physics::tangentialVelocity(relPositionOfMass, velocities);
-		QVector2D relVel = tangentialVel - result.linear;
-		angularMomentum += Physics::angularMomentum(relPositionOfMass, relVel);
-	}
-
+	double angularMass = Physics::angularMass(relPositions, mean(relPositions));
+	double angularMomentum = Physics::angularMomentum(relPositions, QVector2D(), velocitiesOfMasses, result.linear);
 	result.angular = Physics::angularVelocity(angularMomentum, angularMass);
 	return result;
 }
@@ -17,6 +17,26 @@ public:
 		double angular;
 	};
 
+	//structure-of-arrays storage of 2d vectors for batch calculations
+	struct VectorArray
+	{
+		vector<double> x;
+		vector<double> y;
+
+		VectorArray() = default;
+		VectorArray(vector<QVector2D> const& vectors)
+		{
+			resize(static_cast<int>(vectors.size()));
+			for (int i = 0; i < vectors.size(); ++i) {
+				set(i, vectors[i]);
+			}
+		}
+		int size() const { return static_cast<int>(x.size()); }
+		void resize(int size) { x.resize(size); y.resize(size); }
+		void set(int index, QVector2D const& value) { x[index] = value.x(); y[index] = value.y(); }
+		QVector2D get(int index) const { return QVector2D(x[index], y[index]); }
+	};
+
     //Notice: all angles below are in DEG
     static void collision (QVector2D vA1, QVector2D vB1, QVector2D rAPp, QVector2D rBPp, double angularVelA1, 
 		double angularVelB1, QVector2D n, double angularMassA, double angularMassB, double massA, double massB,
@@ -28,6 +48,13 @@ public:
 	static double angularMass(vector<QVector2D> const& relPositionOfMasses);
 	static double angularMomentum(Velocities const& velocities, vector<QVector2D> const& relPositionOfMasses);
 
+	//batch versions operating on structure-of-arrays, vectorized if SSE2 is available
+	static QVector2D mean(VectorArray const& vectors);
+	static double angularMass(VectorArray const& positions, QVector2D const& center);
+	static double angularMomentum(
+		VectorArray const& positions, QVector2D const& center, VectorArray const& velocities, QVector2D const& velocityOfCenter);
+	static void tangentialVelocities(VectorArray const& positionsFromCenter, Velocities const& velocityOfCenter, VectorArray& result);
+
 	static QVector2D tangentialVelocity(QVector2D positionFromCenter, Velocities const& velocityOfCenter);
 	static double angularMomentum(QVector2D positionFromCenter, QVector2D velocity);
 	static double angularVelocity(double angularMassOld, double angularMassNew, double angularVelOld);
@@ -0,0 +1,566 @@
+#include "SoftwareRenderer.h"
+
+#include <cmath>
+#include <unordered_map>
+
+#include "Base/Parallel.h"
+
+#include "Colors.h"
+#include "Descriptions.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARERENDERER_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    int const TileSize = 64;
+    float const FpPrecision = 0.00001f;
+
+    //the rendering code below mirrors RenderingKernels.cuh operation by operation in order to produce the same
+    //pixels, therefore float2/float3 arithmetic is spelled out instead of using QVector2D/QVector3D
+    struct Float2
+    {
+        float x;
+        float y;
+    };
+
+    struct Color
+    {
+        float x;
+        float y;
+        float z;
+    };
+
+    Color operator*(Color const& color, float factor)
+    {
+        return {color.x * factor, color.y * factor, color.z * factor};
+    }
+
+    int floorInt(float value)
+    {
+        int result = static_cast<int>(value);
+        if (result > value) {
+            --result;
+        }
+        return result;
+    }
+
+    struct Primitive
+    {
+        enum class Type
+        {
+            Circle,
+            Line
+        };
+        Type type;
+        Float2 pos;
+        Float2 endPos;  //only used for lines
+        Color color;
+        float radius;   //only used for circles
+        bool inverted;  //only used for circles
+    };
+
+    struct PixelBounds
+    {
+        int x1;
+        int y1;
+        int x2;  //inclusive
+        int y2;  //inclusive
+    };
+
+    Color calcCellColor(uint8_t colorCode, float energy)
+    {
+        unsigned int cellColor = 0;
+        switch (colorCode % 7) {
+        case 0:
+            cellColor = Const::IndividualCellColor1;
+            break;
+        case 1:
+            cellColor = Const::IndividualCellColor2;
+            break;
+        case 2:
+            cellColor = Const::IndividualCellColor3;
+            break;
+        case 3:
+            cellColor = Const::IndividualCellColor4;
+            break;
+        case 4:
+            cellColor = Const::IndividualCellColor5;
+            break;
+        case 5:
+            cellColor = Const::IndividualCellColor6;
+            break;
+        case 6:
+            cellColor = Const::IndividualCellColor7;
+            break;
+        }
+
+        //descriptions do not carry a selection state, entities are rendered as unselected
+        float factor = std::min(100.0f, std::sqrt(energy) * 5 + 20.0f) / 100.0f;
+        factor *= 0.75f;
+
+        return {
+            static_cast<float>((cellColor >> 16) & 0xff) / 256.0f * factor,
+            static_cast<float>((cellColor >> 8) & 0xff) / 256.0f * factor,
+            static_cast<float>(cellColor & 0xff) / 256.0f * factor};
+    }
+
+    Color calcParticleColor(float energy)
+    {
+        auto intensity = std::max(std::min((toInt(energy) + 10) * 5, 150), 20) / 256.0f;
+        intensity *= 0.75f;
+        return {intensity, 0, 0.08f};
+    }
+
+    Color const TokenColor = {0.75f, 0.75f, 0.75f};
+
+    unsigned int toFlatColor(Color const& color)
+    {
+        return toInt(color.z * 255.0f) << 16 | toInt(color.y * 255.0f) << 8 | toInt(color.x * 255.0f);
+    }
+
+    void addingColor(unsigned int& pixel, Color const& colorToAdd)
+    {
+        auto colorFlat = toFlatColor(colorToAdd);
+        auto newColor = (pixel & 0xfefefe) + (colorFlat & 0xfefefe);
+        if ((newColor & 0x1000000) != 0) {
+            newColor |= 0xff0000;
+        }
+        if ((newColor & 0x10000) != 0) {
+            newColor |= 0xff00;
+        }
+        if ((newColor & 0x100) != 0) {
+            newColor |= 0xff;
+        }
+        pixel = newColor | 0xff000000;
+    }
+
+#ifdef SOFTWARERENDERER_USE_SSE2
+    //lane-wise version of addingColor
+    __m128i addingColors(__m128i pixels, __m128i colorsFlat)
+    {
+        auto const mask = _mm_set1_epi32(0xfefefe);
+        auto newColors = _mm_add_epi32(_mm_and_si128(pixels, mask), _mm_and_si128(colorsFlat, mask));
+
+        auto saturate = [&](int overflowBit, int channelMask) {
+            auto const overflow = _mm_set1_epi32(overflowBit);
+            auto const isOverflow = _mm_cmpeq_epi32(_mm_and_si128(newColors, overflow), overflow);
+            newColors = _mm_or_si128(newColors, _mm_and_si128(isOverflow, _mm_set1_epi32(channelMask)));
+        };
+        saturate(0x1000000, 0xff0000);
+        saturate(0x10000, 0xff00);
+        saturate(0x100, 0xff);
+        return _mm_or_si128(newColors, _mm_set1_epi32(static_cast<int>(0xff000000)));
+    }
+
+    //lane-wise version of toFlatColor for colorToAdd * weightsX * weightsY
+    __m128i toFlatColors(Color const& colorToAdd, __m128 weightsX, __m128 weightsY)
+    {
+        auto const factor = _mm_set1_ps(255.0f);
+        auto channel = [&](float value) {
+            auto const weightedValue = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(value), weightsX), weightsY);
+            return _mm_cvttps_epi32(_mm_mul_ps(weightedValue, factor));
+        };
+        return _mm_or_si128(
+            _mm_or_si128(_mm_slli_epi32(channel(colorToAdd.z), 16), _mm_slli_epi32(channel(colorToAdd.y), 8)),
+            channel(colorToAdd.x));
+    }
+#endif
+
+    //renders primitives into a tile of the image, pixels outside of the tile are discarded
+    class TileCanvas
+    {
+    public:
+        TileCanvas(IntVector2D const& imageSize, PixelBounds const& tile)
+            : _imageSize(imageSize)
+            , _tile(tile)
+            , _width(tile.x2 - tile.x1 + 1)
+            , _pixels(_width * (tile.y2 - tile.y1 + 1))
+        {}
+
+        void clear(PixelBounds const& insideUniverse)
+        {
+            for (int y = _tile.y1; y <= _tile.y2; ++y) {
+                for (int x = _tile.x1; x <= _tile.x2; ++x) {
+                    auto const outside = x < insideUniverse.x1 || y < insideUniverse.y1 || x > insideUniverse.x2
+                        || y > insideUniverse.y2;
+                    pixel(x, y) = outside ? Const::NothingnessColor : Const::SpaceColor;
+                }
+            }
+        }
+
+        void draw(Primitive const& primitive)
+        {
+            if (Primitive::Type::Circle == primitive.type) {
+                drawCircle(primitive.pos, primitive.color, primitive.radius, primitive.inverted);
+            } else {
+                drawLine(primitive.pos, primitive.endPos, primitive.color);
+            }
+        }
+
+        //copies the tile to a QImage scan line buffer, the ABGR layout of the GPU image is converted to ARGB
+        void writeTo(uchar* bits, int bytesPerLine, bool swapRedBlue) const
+        {
+            for (int y = _tile.y1; y <= _tile.y2; ++y) {
+                auto target = reinterpret_cast<unsigned int*>(bits + y * bytesPerLine) + _tile.x1;
+                auto source = &_pixels[(y - _tile.y1) * _width];
+                if (!swapRedBlue) {
+                    std::copy(source, source + _width, target);
+                    continue;
+                }
+                for (int x = 0; x < _width; ++x) {
+                    auto const color = source[x];
+                    target[x] = (color & 0xff00ff00) | ((color & 0xff) << 16) | ((color >> 16) & 0xff);
+                }
+            }
+        }
+
+    private:
+        unsigned int& pixel(int x, int y) { return _pixels[(x - _tile.x1) + (y - _tile.y1) * _width]; }
+
+        bool isInsideTile(int x, int y) const
+        {
+            return x >= _tile.x1 && x <= _tile.x2 && y >= _tile.y1 && y <= _tile.y2;
+        }
+
+        void drawDot(Float2 const& pos, Color const& colorToAdd)
+        {
+            int const x = toInt(pos.x);
+            int const y = toInt(pos.y);
+            if (x < 1 || x >= _imageSize.x - 1 || y < 1 || y >= _imageSize.y - 1) {
+                return;
+            }
+            if (x + 1 < _tile.x1 || x > _tile.x2 || y + 1 < _tile.y1 || y > _tile.y2) {
+                return;
+            }
+
+            Float2 posFrac{pos.x - x, pos.y - y};
+
+#ifdef SOFTWARERENDERER_USE_SSE2
+            if (x >= _tile.x1 && x + 1 <= _tile.x2 && y >= _tile.y1 && y + 1 <= _tile.y2) {
+                //weights in lane order: (x, y), (x + 1, y), (x, y + 1), (x + 1, y + 1)
+                auto const weightsX = _mm_set_ps(posFrac.x, 1.0f - posFrac.x, posFrac.x, 1.0f - posFrac.x);
+                auto const weightsY = _mm_set_ps(posFrac.y, posFrac.y, 1.0f - posFrac.y, 1.0f - posFrac.y);
+                auto const colorsFlat = toFlatColors(colorToAdd, weightsX, weightsY);
+
+                auto upperRow = &pixel(x, y);
+                auto lowerRow = &pixel(x, y + 1);
+                auto const pixels = _mm_unpacklo_epi64(
+                    _mm_loadl_epi64(reinterpret_cast<__m128i const*>(upperRow)),
+                    _mm_loadl_epi64(reinterpret_cast<__m128i const*>(lowerRow)));
+                auto const result = addingColors(pixels, colorsFlat);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(upperRow), result);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(lowerRow), _mm_unpackhi_epi64(result, result));
+                return;
+            }
+#endif
+            if (isInsideTile(x, y)) {
+                addingColor(pixel(x, y), colorToAdd * (1.0f - posFrac.x) * (1.0f - posFrac.y));
+            }
+            if (isInsideTile(x + 1, y)) {
+                addingColor(pixel(x + 1, y), colorToAdd * posFrac.x * (1.0f - posFrac.y));
+            }
+            if (isInsideTile(x, y + 1)) {
+                addingColor(pixel(x, y + 1), colorToAdd * (1.0f - posFrac.x) * posFrac.y);
+            }
+            if (isInsideTile(x + 1, y + 1)) {
+                addingColor(pixel(x + 1, y + 1), colorToAdd * posFrac.x * posFrac.y);
+            }
+        }
+
+        void drawCircle(Float2 const& pos, Color color, float radius, bool inverted)
+        {
+            if (radius > 1.0 - FpPrecision) {
+                auto radiusSquared = radius * radius;
+                for (float x = -radius; x <= radius; x += 1.0f) {
+
+                    //columns not touching the tile can be skipped as a whole
+                    auto const intX = toInt(pos.x + x);
+                    if (intX + 1 < _tile.x1 || intX > _tile.x2) {
+                        continue;
+                    }
+                    for (float y = -radius; y <= radius; y += 1.0f) {
+                        auto rSquared = x * x + y * y;
+                        if (rSquared <= radiusSquared) {
+                            auto factor =
+                                inverted ? (rSquared / radiusSquared) * 2 : (1.0f - rSquared / radiusSquared) * 2;
+                            drawDot({pos.x + x, pos.y + y}, color * std::min(factor, 1.0f));
+                        }
+                    }
+                }
+            } else {
+                color = color * radius * 2;
+                drawDot(pos, color);
+                color = color * 0.3f;
+                drawDot({pos.x + 1, pos.y}, color);
+                drawDot({pos.x - 1, pos.y}, color);
+                drawDot({pos.x, pos.y + 1}, color);
+                drawDot({pos.x, pos.y - 1}, color);
+            }
+        }
+
+        void drawLine(Float2 const& startPos, Float2 const& endPos, Color const& color)
+        {
+            Float2 const delta{endPos.x - startPos.x, endPos.y - startPos.y};
+            float dist = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            Float2 const v{delta.x / dist * 1.8f, delta.y / dist * 1.8f};
+            auto pos = startPos;
+            for (float d = 0; d <= dist; d += 1.8f) {
+                drawDot(pos, color);
+                pos = {pos.x + v.x, pos.y + v.y};
+            }
+        }
+
+        IntVector2D _imageSize;
+        PixelBounds _tile;
+        int _width;
+        vector<unsigned int> _pixels;
+    };
+
+    Float2 toFloat2(QVector2D const& value)
+    {
+        return {value.x(), value.y()};
+    }
+
+    Float2 mapUniversePosToImagePos(RealRect const& worldRect, Float2 const& pos, float zoom)
+    {
+        return {(pos.x - worldRect.p1.x) * zoom, (pos.y - worldRect.p1.y) * zoom};
+    }
+
+    Float2 mapPosCorrection(Float2 const& pos, IntVector2D const& universeSize)
+    {
+        auto const intX = floorInt(pos.x);
+        auto const intY = floorInt(pos.y);
+        auto const correctedX = ((intX % universeSize.x) + universeSize.x) % universeSize.x;
+        auto const correctedY = ((intY % universeSize.y) + universeSize.y) % universeSize.y;
+        return {toFloat(correctedX) + (pos.x - intX), toFloat(correctedY) + (pos.y - intY)};
+    }
+
+    bool isContainedInRect(Float2 const& upperLeft, Float2 const& lowerRight, Float2 const& pos)
+    {
+        return pos.x >= upperLeft.x && pos.x <= lowerRight.x && pos.y >= upperLeft.y && pos.y <= lowerRight.y;
+    }
+
+    PixelBounds calcBounds(Primitive const& primitive)
+    {
+        //margins cover the bilinear spreading of dots and the neighbor dots of small circles
+        if (Primitive::Type::Circle == primitive.type) {
+            auto const extent = std::max(primitive.radius, 1.0f) + 2.0f;
+            return {
+                floorInt(primitive.pos.x - extent),
+                floorInt(primitive.pos.y - extent),
+                floorInt(primitive.pos.x + extent),
+                floorInt(primitive.pos.y + extent)};
+        }
+        return {
+            floorInt(std::min(primitive.pos.x, primitive.endPos.x) - 2.0f),
+            floorInt(std::min(primitive.pos.y, primitive.endPos.y) - 2.0f),
+            floorInt(std::max(primitive.pos.x, primitive.endPos.x) + 2.0f),
+            floorInt(std::max(primitive.pos.y, primitive.endPos.y) + 2.0f)};
+    }
+
+    //primitives in the drawing order of the GPU engine: cells with their connections, tokens, particles
+    vector<Primitive> createPrimitives(
+        SoftwareRenderer::Input const& input,
+        IntVector2D const& universeSize,
+        RealRect const& worldRect,
+        IntVector2D const& imageSize,
+        float zoom)
+    {
+        vector<Primitive> result;
+        result.reserve(input.cellPositions.size() * 2 + input.connections.size() + input.particlePositions.size());
+
+        Float2 const rectUpperLeft{worldRect.p1.x, worldRect.p1.y};
+        Float2 const rectLowerRight{worldRect.p2.x, worldRect.p2.y};
+        Float2 const imageLowerRight{toFloat(imageSize.x), toFloat(imageSize.y)};
+
+        auto connectionIndex = 0;
+        auto const numConnections = static_cast<int>(input.connections.size());
+        auto const numCells = static_cast<int>(input.cellPositions.size());
+        for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+            auto const absPos = toFloat2(input.cellPositions[cellIndex]);
+            auto const cellPos = mapPosCorrection(absPos, universeSize);
+
+            auto const connectionBegin = connectionIndex;
+            while (connectionIndex < numConnections && input.connections[connectionIndex].first == cellIndex) {
+                ++connectionIndex;
+            }
+            if (!isContainedInRect(rectUpperLeft, rectLowerRight, cellPos)) {
+                continue;
+            }
+            auto const cellImagePos = mapUniversePosToImagePos(worldRect, cellPos, zoom);
+            auto color = calcCellColor(input.cellColorCodes[cellIndex], input.cellEnergies[cellIndex]);
+            result.push_back({Primitive::Type::Circle, cellImagePos, {}, color, zoom / 3, true});
+
+            if (zoom > 1 - FpPrecision) {
+                color = color * std::min((zoom - 1.0f) / 3, 1.0f);
+                Float2 const posCorrection{cellPos.x - absPos.x, cellPos.y - absPos.y};
+                for (int index = connectionBegin; index < connectionIndex; ++index) {
+                    auto const otherAbsPos = toFloat2(input.cellPositions[input.connections[index].second]);
+                    Float2 const otherCellPos{otherAbsPos.x + posCorrection.x, otherAbsPos.y + posCorrection.y};
+                    auto const otherCellImagePos = mapUniversePosToImagePos(worldRect, otherCellPos, zoom);
+                    result.push_back({Primitive::Type::Line, cellImagePos, otherCellImagePos, color, 0, false});
+                }
+            }
+        }
+
+        for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+            auto const numTokens = input.cellNumTokens[cellIndex];
+            if (0 == numTokens) {
+                continue;
+            }
+            auto const cellPos = mapPosCorrection(toFloat2(input.cellPositions[cellIndex]), universeSize);
+            auto const cellImagePos = mapUniversePosToImagePos(worldRect, cellPos, zoom);
+            if (isContainedInRect({0, 0}, imageLowerRight, cellImagePos)) {
+                for (int i = 0; i < numTokens; ++i) {
+                    result.push_back({Primitive::Type::Circle, cellImagePos, {}, TokenColor, zoom / 2, false});
+                }
+            }
+        }
+
+        auto const numParticles = static_cast<int>(input.particlePositions.size());
+        for (int index = 0; index < numParticles; ++index) {
+            auto const particleImagePos =
+                mapUniversePosToImagePos(worldRect, toFloat2(input.particlePositions[index]), zoom);
+            if (isContainedInRect({0, 0}, imageLowerRight, particleImagePos)) {
+                auto const color = calcParticleColor(input.particleEnergies[index]);
+                result.push_back({Primitive::Type::Circle, particleImagePos, {}, color, zoom / 3, false});
+            }
+        }
+        return result;
+    }
+}
+
+auto SoftwareRenderer::createInput(DataDescription const& data) -> Input
+{
+    Input result;
+    if (data.clusters) {
+        std::unordered_map<uint64_t, int> cellIndexById;
+        for (auto const& cluster : *data.clusters) {
+            if (!cluster.cells) {
+                continue;
+            }
+            for (auto const& cell : *cluster.cells) {
+                cellIndexById.emplace(cell.id, static_cast<int>(result.cellPositions.size()));
+                result.cellPositions.emplace_back(cell.pos.get_value_or(QVector2D()));
+                result.cellEnergies.emplace_back(static_cast<float>(cell.energy.get_value_or(0.0)));
+                result.cellColorCodes.emplace_back(cell.metadata ? cell.metadata->color : 0);
+                result.cellNumTokens.emplace_back(cell.tokens ? static_cast<int>(cell.tokens->size()) : 0);
+            }
+        }
+
+        auto cellIndex = 0;
+        for (auto const& cluster : *data.clusters) {
+            if (!cluster.cells) {
+                continue;
+            }
+            for (auto const& cell : *cluster.cells) {
+                if (cell.connectingCells) {
+                    for (auto const& connectingCellId : *cell.connectingCells) {
+                        auto findResult = cellIndexById.find(connectingCellId);
+                        if (findResult != cellIndexById.end()) {
+                            result.connections.emplace_back(cellIndex, findResult->second);
+                        }
+                    }
+                }
+                ++cellIndex;
+            }
+        }
+    }
+    if (data.particles) {
+        for (auto const& particle : *data.particles) {
+            result.particlePositions.emplace_back(particle.pos.get_value_or(QVector2D()));
+            result.particleEnergies.emplace_back(static_cast<float>(particle.energy.get_value_or(0.0)));
+        }
+    }
+    return result;
+}
+
+void SoftwareRenderer::render(
+    Input const& input,
+    IntVector2D const& universeSize,
+    RealRect const& worldRect,
+    float zoom,
+    QImage& target)
+{
+    IntVector2D const imageSize{target.width(), target.height()};
+    if (imageSize.x <= 0 || imageSize.y <= 0 || universeSize.x <= 0 || universeSize.y <= 0) {
+        return;
+    }
+    if (target.depth() != 32) {
+        target = target.convertToFormat(QImage::Format_RGB32);
+    }
+
+    //same region as clearImageMap in the GPU engine, stored with inclusive lower right corner
+    PixelBounds const insideUniverse{
+        -std::min(toInt(worldRect.p1.x * zoom), 0),
+        -std::min(toInt(worldRect.p1.y * zoom), 0),
+        imageSize.x - std::max(toInt((worldRect.p2.x - universeSize.x) * zoom), 0) - 1,
+        imageSize.y - std::max(toInt((worldRect.p2.y - universeSize.y) * zoom), 0) - 1};
+
+    auto const primitives = createPrimitives(input, universeSize, worldRect, imageSize, zoom);
+
+    //bin primitives into tiles preserving the drawing order such that tiles can be rendered independently
+    IntVector2D const numTiles{(imageSize.x + TileSize - 1) / TileSize, (imageSize.y + TileSize - 1) / TileSize};
+    vector<vector<int>> primitiveIndicesByTile(numTiles.x * numTiles.y);
+    for (int index = 0; index < static_cast<int>(primitives.size()); ++index) {
+        auto const bounds = calcBounds(primitives[index]);
+        if (bounds.x2 < 0 || bounds.y2 < 0 || bounds.x1 >= imageSize.x || bounds.y1 >= imageSize.y) {
+            continue;
+        }
+        auto const tileX1 = std::max(bounds.x1, 0) / TileSize;
+        auto const tileY1 = std::max(bounds.y1, 0) / TileSize;
+        auto const tileX2 = std::min(bounds.x2, imageSize.x - 1) / TileSize;
+        auto const tileY2 = std::min(bounds.y2, imageSize.y - 1) / TileSize;
+        for (int tileY = tileY1; tileY <= tileY2; ++tileY) {
+            for (int tileX = tileX1; tileX <= tileX2; ++tileX) {
+                primitiveIndicesByTile[tileX + tileY * numTiles.x].emplace_back(index);
+            }
+        }
+    }
+
+    auto const swapRedBlue =
+        target.format() != QImage::Format_RGBA8888 && target.format() != QImage::Format_RGBA8888_Premultiplied
+        && target.format() != QImage::Format_RGBX8888;
+    auto const bits = target.bits();  //detaches before the image is written concurrently
+    auto const bytesPerLine = target.bytesPerLine();
+
+    Parallel::forEachChunk(
+        0,
+        numTiles.x * numTiles.y,
+        [&](int, int tileBegin, int tileEnd) {
+            for (int tileIndex = tileBegin; tileIndex < tileEnd; ++tileIndex) {
+                auto const tileX = tileIndex % numTiles.x;
+                auto const tileY = tileIndex / numTiles.x;
+                PixelBounds const tile{
+                    tileX * TileSize,
+                    tileY * TileSize,
+                    std::min((tileX + 1) * TileSize, imageSize.x) - 1,
+                    std::min((tileY + 1) * TileSize, imageSize.y) - 1};
+
+                TileCanvas canvas(imageSize, tile);
+                canvas.clear(insideUniverse);
+                for (auto const& primitiveIndex : primitiveIndicesByTile[tileIndex]) {
+                    canvas.draw(primitives[primitiveIndex]);
+                }
+                canvas.writeTo(bits, bytesPerLine, swapRedBlue);
+            }
+        },
+        1);
+}
+
+QImage SoftwareRenderer::render(
+    DataDescription const& data,
+    IntVector2D const& universeSize,
+    RealRect const& worldRect,
+    float zoom)
+{
+    QImage result(
+        std::max(toInt((worldRect.p2.x - worldRect.p1.x) * zoom), 1),
+        std::max(toInt((worldRect.p2.y - worldRect.p1.y) * zoom), 1),
+        QImage::Format_RGB32);
+    render(createInput(data), universeSize, worldRect, zoom, result);
+    return result;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QImage>
+#include <QVector2D>
+
+#include "Definitions.h"
+
+/**
+ * Rasterizes simulation data on the CPU. Colors, shapes and the additive blending follow the vector image rendering
+ * of the GPU engine such that images can be produced without a CUDA device or an OpenGL context. The image is split
+ * into tiles which are rendered in parallel.
+ */
+class ENGINEINTERFACE_EXPORT SoftwareRenderer
+{
+public:
+    //flat representation of the entities to be rendered
+    struct Input
+    {
+        vector<QVector2D> cellPositions;
+        vector<float> cellEnergies;
+        vector<uint8_t> cellColorCodes;
+        vector<int> cellNumTokens;
+        vector<std::pair<int, int>> connections;  //cell indices, drawn from the first cell as in the GPU engine
+        vector<QVector2D> particlePositions;
+        vector<float> particleEnergies;
+    };
+    static Input createInput(DataDescription const& data);
+
+    //renders the world region worldRect with zoom pixels per unit into target (32-bit format), target is not resized
+    static void render(
+        Input const& input,
+        IntVector2D const& universeSize,
+        RealRect const& worldRect,
+        float zoom,
+        QImage& target);
+
+    static QImage render(
+        DataDescription const& data,
+        IntVector2D const& universeSize,
+        RealRect const& worldRect,
+        float zoom);
+};
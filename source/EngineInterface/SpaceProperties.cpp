@@ -1,5 +1,36 @@
 #include "SpaceProperties.h"
 
+namespace
+{
+	int floorToInt(float value)
+	{
+		auto result = static_cast<int>(value);
+		return result - static_cast<int>(value < static_cast<float>(result));
+	}
+
+	template<typename CorrectPosition>
+	void correctPositionsImpl(QVector2D* positions, int count, CorrectPosition const& correctPosition)
+	{
+		for (int i = 0; i < count; ++i) {
+			auto& pos = positions[i];
+			IntVector2D intPart{ floorToInt(pos.x()), floorToInt(pos.y()) };
+			qreal fracPartX = pos.x() - intPart.x;
+			qreal fracPartY = pos.y() - intPart.y;
+			correctPosition(intPart);
+			pos.setX(static_cast<qreal>(intPart.x) + fracPartX);
+			pos.setY(static_cast<qreal>(intPart.y) + fracPartY);
+		}
+	}
+
+	template<typename CorrectPosition>
+	void correctIntPositionsImpl(IntVector2D* positions, int count, CorrectPosition const& correctPosition)
+	{
+		for (int i = 0; i < count; ++i) {
+			correctPosition(positions[i]);
+		}
+	}
+}
+
 SpaceProperties::SpaceProperties(QObject * parent)
 	: QObject(parent)
 {
@@ -8,12 +39,18 @@ SpaceProperties::SpaceProperties(QObject * parent)
 void SpaceProperties::init(IntVector2D size)
 {
 	_size = size;
+
+	auto isPowerOfTwo = [](int value) { return value > 0 && (value & (value - 1)) == 0; };
+	_isPowerOfTwoSize = isPowerOfTwo(size.x) && isPowerOfTwo(size.y);
+	_sizeMask = { size.x - 1, size.y - 1 };
+	_invSizeX = size.x > 0 ? 1.0 / size.x : 0.0;
+	_invSizeY = size.y > 0 ? 1.0 / size.y : 0.0;
 }
 
 SpaceProperties * SpaceProperties::clone(QObject * parent) const
 {
 	auto metric = new SpaceProperties(parent);
-	metric->_size = _size;
+	metric->init(_size);
 	return metric;
 }
 
@@ -24,12 +61,7 @@ IntVector2D SpaceProperties::getSize() const
 
 void SpaceProperties::correctPosition(QVector2D & pos) const
 {
-	IntVector2D intPart{ qFloor(pos.x()), qFloor(pos.y()) };
-	qreal fracPartX = pos.x() - intPart.x;
-	qreal fracPartY = pos.y() - intPart.y;
-	correctPositionInline(intPart);
-	pos.setX(static_cast<qreal>(intPart.x) + fracPartX);
-	pos.setY(static_cast<qreal>(intPart.y) + fracPartY);
+	correctPositions(&pos, 1);
 }
 
 void SpaceProperties::correctPosition(IntVector2D & pos) const
@@ -40,14 +72,7 @@ void SpaceProperties::correctPosition(IntVector2D & pos) const
 IntVector2D SpaceProperties::convertToIntVector(QVector2D const & pos) const
 {
 	IntVector2D intPos;
-	intPos.x = static_cast<int>(pos.x());
-	if (intPos.x < 0) {
-		--intPos.x;
-	}
-	intPos.y = static_cast<int>(pos.y());
-	if (intPos.y < 0) {
-		--intPos.y;
-	}
+	convertToIntVectors(&pos, &intPos, 1);
 	return intPos;
 }
 
@@ -58,6 +83,40 @@ IntVector2D SpaceProperties::correctPositionAndConvertToIntVector(QVector2D cons
 	return intPos;
 }
 
+void SpaceProperties::correctPositions(QVector2D* positions, int count) const
+{
+	//the wraparound method is chosen once such that the loop body is free of branches
+	if (_isPowerOfTwoSize) {
+		correctPositionsImpl(positions, count, [this](IntVector2D& pos) { correctPositionByMask(pos); });
+	}
+	else {
+		correctPositionsImpl(positions, count, [this](IntVector2D& pos) { correctPositionByReciprocal(pos); });
+	}
+}
+
+void SpaceProperties::convertToIntVectors(QVector2D const* positions, IntVector2D* result, int count) const
+{
+	for (int i = 0; i < count; ++i) {
+		auto x = static_cast<int>(positions[i].x());
+		auto y = static_cast<int>(positions[i].y());
+		result[i] = { x - static_cast<int>(x < 0), y - static_cast<int>(y < 0) };
+	}
+}
+
+void SpaceProperties::correctPositionsAndConvertToIntVectors(
+	QVector2D const* positions,
+	IntVector2D* result,
+	int count) const
+{
+	convertToIntVectors(positions, result, count);
+	if (_isPowerOfTwoSize) {
+		correctIntPositionsImpl(result, count, [this](IntVector2D& pos) { correctPositionByMask(pos); });
+	}
+	else {
+		correctIntPositionsImpl(result, count, [this](IntVector2D& pos) { correctPositionByReciprocal(pos); });
+	}
+}
+
 IntVector2D SpaceProperties::shiftPosition(IntVector2D const & pos, IntVector2D const && shift) const
 {
 	IntVector2D temp{ pos.x + shift.x, pos.y + shift.y };
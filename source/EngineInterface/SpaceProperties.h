@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+
 #include "Definitions.h"
 
 class ENGINEINTERFACE_EXPORT SpaceProperties
@@ -28,15 +30,50 @@ public:
 	virtual qreal distance(QVector2D fromPoint, QVector2D toPoint) const;
 	virtual IntVector2D shiftPosition(IntVector2D const& pos, IntVector2D const && shift) const;
 
+	//batch variants of the methods above for contiguous arrays
+	void correctPositions(QVector2D* positions, int count) const;
+	void convertToIntVectors(QVector2D const* positions, IntVector2D* result, int count) const;
+	void correctPositionsAndConvertToIntVectors(QVector2D const* positions, IntVector2D* result, int count) const;
+
 private:
 	inline void correctPositionInline(IntVector2D & pos) const;
+	inline void correctPositionByMask(IntVector2D & pos) const;	//for power-of-two sizes only
+	inline void correctPositionByReciprocal(IntVector2D & pos) const;
 
 	IntVector2D _size{ 0, 0 };
+
+	//precomputed in init() to avoid integer divisions
+	bool _isPowerOfTwoSize = false;
+	IntVector2D _sizeMask{ 0, 0 };
+	double _invSizeX = 0;
+	double _invSizeY = 0;
 };
 
 void SpaceProperties::correctPositionInline(IntVector2D & pos) const
 {
-	pos.x = ((pos.x % _size.x) + _size.x) % _size.x;
-	pos.y = ((pos.y % _size.y) + _size.y) % _size.y;
+	if (_isPowerOfTwoSize) {
+		correctPositionByMask(pos);
+	}
+	else {
+		correctPositionByReciprocal(pos);
+	}
+}
+
+void SpaceProperties::correctPositionByMask(IntVector2D & pos) const
+{
+	pos.x &= _sizeMask.x;
+	pos.y &= _sizeMask.y;
+}
+
+void SpaceProperties::correctPositionByReciprocal(IntVector2D & pos) const
+{
+	auto correctCoordinate = [](int value, int size, double invSize) {
+		auto result = value - static_cast<int>(std::floor(value * invSize)) * size;
+		result += static_cast<int>(result < 0) * size;
+		result -= static_cast<int>(result >= size) * size;
+		return result;
+	};
+	pos.x = correctCoordinate(pos.x, _size.x, _invSizeX);
+	pos.y = correctCoordinate(pos.y, _size.y, _invSizeY);
 }
 
@@ -0,0 +1,191 @@
+#include "SpeciesCensus.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+
+#include "ClusterFingerprint.h"
+#include "Descriptions.h"
+
+bool SpeciesCensus::init(Config const& config)
+{
+    _config = config;
+    _species.clear();
+    _speciesIndexByFingerprint.clear();
+    _presentSpeciesIndices.clear();
+    _speciesIndexByCellId.clear();
+    _writeError = false;
+
+    if (_countsStream.is_open()) {
+        _countsStream.close();
+    }
+    if (!_config.countsFilename.empty()) {
+        _countsStream.open(_config.countsFilename, std::ios_base::out | std::ios_base::trunc);
+        _countsStream << "timestep,species,count" << std::endl;
+        if (_countsStream.fail()) {
+            return false;
+        }
+    }
+    return _config.speciesTableFilename.empty() || writeSpeciesTable();
+}
+
+auto SpeciesCensus::addSample(int timestep, DataDescription const& data) -> SampleResult
+{
+    SampleResult result;
+    result.timestep = timestep;
+
+    struct SampleCount
+    {
+        int count = 0;
+        int numCells = 0;
+        int firstClusterIndex = 0;
+    };
+    std::unordered_map<uint64_t, SampleCount> countByFingerprint;
+    vector<int> countedClusterIndices;
+    vector<uint64_t> fingerprints;
+    if (data.clusters) {
+        auto const& clusters = *data.clusters;
+        fingerprints = ClusterFingerprint::calc(data);
+        for (int i = 0; i < static_cast<int>(clusters.size()); ++i) {
+            auto const numCells = clusters[i].cells ? static_cast<int>(clusters[i].cells->size()) : 0;
+            if (numCells < _config.minNumCells) {
+                continue;
+            }
+            countedClusterIndices.emplace_back(i);
+            auto& sampleCount = countByFingerprint[fingerprints[i]];
+            if (1 == ++sampleCount.count) {
+                sampleCount.numCells = numCells;
+                sampleCount.firstClusterIndex = i;
+            }
+            ++result.numClusters;
+        }
+    }
+
+    //species are processed in the order of their first cluster in data such that new ids are deterministic
+    vector<std::pair<uint64_t, SampleCount>> sampleCounts(countByFingerprint.begin(), countByFingerprint.end());
+    std::sort(sampleCounts.begin(), sampleCounts.end(), [](auto const& count1, auto const& count2) {
+        return count1.second.firstClusterIndex < count2.second.firstClusterIndex;
+    });
+
+    vector<int> presentSpeciesIndices;
+    presentSpeciesIndices.reserve(sampleCounts.size());
+    auto const numSpeciesBefore = static_cast<int>(_species.size());
+    for (auto const& fingerprintAndCount : sampleCounts) {
+        auto const& fingerprint = fingerprintAndCount.first;
+        auto const& sampleCount = fingerprintAndCount.second;
+
+        auto findResult = _speciesIndexByFingerprint.find(fingerprint);
+        if (findResult == _speciesIndexByFingerprint.end()) {
+            Species species;
+            species.id = static_cast<int>(_species.size());
+            species.fingerprint = fingerprint;
+            species.numCells = sampleCount.numCells;
+            species.firstTimestep = timestep;
+            findResult = _speciesIndexByFingerprint.emplace(fingerprint, species.id).first;
+            _species.emplace_back(species);
+            result.appearedSpecies.emplace_back(species.id);
+        } else if (_species[findResult->second].extinctionTimestep) {
+            _species[findResult->second].extinctionTimestep = boost::none;
+            result.appearedSpecies.emplace_back(findResult->second);
+        }
+
+        auto& species = _species[findResult->second];
+        species.count = sampleCount.count;
+        species.maxCount = std::max(species.maxCount, sampleCount.count);
+        species.lastTimestep = timestep;
+        presentSpeciesIndices.emplace_back(findResult->second);
+    }
+    std::sort(result.appearedSpecies.begin(), result.appearedSpecies.end());
+    std::sort(presentSpeciesIndices.begin(), presentSpeciesIndices.end());
+
+    //the parent of a new species is the species which contained most of its cells in the preceding sample, ties are
+    //resolved in favor of the older species
+    std::unordered_map<int, std::map<int, int>> numCellsByParentIndexByIndex;
+    std::unordered_map<uint64_t, int> speciesIndexByCellId;
+    for (auto const& clusterIndex : countedClusterIndices) {
+        auto const index = _speciesIndexByFingerprint.at(fingerprints[clusterIndex]);
+        for (auto const& cell : *data.clusters->at(clusterIndex).cells) {
+            speciesIndexByCellId.emplace(cell.id, index);
+            if (index < numSpeciesBefore) {
+                continue;
+            }
+            auto const findResult = _speciesIndexByCellId.find(cell.id);
+            if (findResult != _speciesIndexByCellId.end()) {
+                ++numCellsByParentIndexByIndex[index][findResult->second];
+            }
+        }
+    }
+    for (auto const& [index, numCellsByParentIndex] : numCellsByParentIndexByIndex) {
+        auto const parent = std::max_element(
+            numCellsByParentIndex.begin(), numCellsByParentIndex.end(), [](auto const& parent1, auto const& parent2) {
+                return parent1.second < parent2.second;
+            });
+        _species[index].parentId = parent->first;
+    }
+    _speciesIndexByCellId = std::move(speciesIndexByCellId);
+
+    for (auto const& index : _presentSpeciesIndices) {
+        auto& species = _species[index];
+        if (species.lastTimestep != timestep) {
+            species.count = 0;
+            species.extinctionTimestep = timestep;
+            result.extinctSpecies.emplace_back(species.id);
+        }
+    }
+    _presentSpeciesIndices = presentSpeciesIndices;
+    result.numSpecies = static_cast<int>(_presentSpeciesIndices.size());
+
+    _writeError = false;
+    if (_countsStream.is_open()) {
+        for (auto const& index : _presentSpeciesIndices) {
+            _countsStream << timestep << "," << index << "," << _species[index].count << "\n";
+        }
+        _countsStream.flush();
+        _writeError = _countsStream.fail();
+    }
+    if (!_config.speciesTableFilename.empty() && !writeSpeciesTable()) {
+        _writeError = true;
+    }
+    return result;
+}
+
+auto SpeciesCensus::getSpecies() const -> vector<Species> const&
+{
+    return _species;
+}
+
+auto SpeciesCensus::getSpecies(uint64_t fingerprint) const -> Species const*
+{
+    auto const findResult = _speciesIndexByFingerprint.find(fingerprint);
+    return findResult != _speciesIndexByFingerprint.end() ? &_species[findResult->second] : nullptr;
+}
+
+bool SpeciesCensus::hasWriteError() const
+{
+    return _writeError;
+}
+
+bool SpeciesCensus::writeSpeciesTable() const
+{
+    //the table is written to a temporary file first such that readers never see a partially written table
+    auto const tempFilename = _config.speciesTableFilename + ".tmp";
+    {
+        std::ofstream stream(tempFilename, std::ios_base::out | std::ios_base::trunc);
+        stream << "species,fingerprint,numCells,firstTimestep,lastTimestep,extinctionTimestep,count,maxCount,parent\n";
+        for (auto const& species : _species) {
+            stream << species.id << "," << std::hex << std::setw(16) << std::setfill('0') << species.fingerprint
+                   << std::dec << std::setfill(' ') << "," << species.numCells << "," << species.firstTimestep << ","
+                   << species.lastTimestep << "," << species.extinctionTimestep.get_value_or(-1) << ","
+                   << species.count << "," << species.maxCount << "," << species.parentId.get_value_or(-1) << "\n";
+        }
+        stream.close();
+        if (stream.fail()) {
+            return false;
+        }
+    }
+
+    //replaces the former table in one step, std::filesystem::rename overwrites existing files on all platforms
+    std::error_code error;
+    std::filesystem::rename(tempFilename, _config.speciesTableFilename, error);
+    return !error;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <fstream>
+#include <unordered_map>
+
+#include "Definitions.h"
+
+/**
+ * Follows the population of structural species over a series of samples of the world. A species is the set of
+ * clusters sharing a ClusterFingerprint. The census records when species appear and die out and optionally persists a
+ * species table (rewritten after each sample) and a sparse count time series (appended per sample) as CSV files.
+ * The parent of a new species is derived from the cell ids: offspring and mutants are built from cells which already
+ * belonged to a cluster of the parent species in the preceding sample.
+ */
+class ENGINEINTERFACE_EXPORT SpeciesCensus
+{
+public:
+    struct Config
+    {
+        int minNumCells = 1;    //smaller clusters are not counted
+        string speciesTableFilename;    //no species table is written if empty
+        string countsFilename;  //no count time series is written if empty
+    };
+
+    struct Species
+    {
+        int id = 0;     //in order of appearance
+        uint64_t fingerprint = 0;
+        int numCells = 0;
+        int firstTimestep = 0;
+        int lastTimestep = 0;   //last sample the species was present in
+        boost::optional<int> extinctionTimestep;
+        int count = 0;  //in the last sample
+        int maxCount = 0;
+        boost::optional<int> parentId;  //species which contained most of the cells of this species before it appeared
+    };
+
+    struct SampleResult
+    {
+        int timestep = 0;
+        int numSpecies = 0;     //present in the sample
+        int numClusters = 0;    //counted in the sample
+        vector<int> appearedSpecies;    //new or reappeared species ids
+        vector<int> extinctSpecies;
+    };
+
+    //returns false if the output files cannot be created
+    bool init(Config const& config);
+
+    SampleResult addSample(int timestep, DataDescription const& data);
+
+    vector<Species> const& getSpecies() const;
+    Species const* getSpecies(uint64_t fingerprint) const;
+
+    //true if the output of the last sample could not be written
+    bool hasWriteError() const;
+
+private:
+    bool writeSpeciesTable() const;
+
+    Config _config;
+    vector<Species> _species;
+    std::unordered_map<uint64_t, int> _speciesIndexByFingerprint;
+    vector<int> _presentSpeciesIndices;
+    std::unordered_map<uint64_t, int> _speciesIndexByCellId;   //of the counted clusters in the last sample
+
+    std::ofstream _countsStream;
+    bool _writeError = false;
+};
@@ -16,16 +16,19 @@ SymbolTable * SymbolTable::clone(QObject * parent) const
 void SymbolTable::getSymbolsFrom(SymbolTable const* other)
 {
 	_symbolsByKey = other->_symbolsByKey;
+	invalidateIndex();
 }
 
 void SymbolTable::addEntry(string const& key, string const& value)
 {
 	_symbolsByKey[key] = value;
+	invalidateIndex();
 }
 
 void SymbolTable::delEntry(string const& key)
 {
 	_symbolsByKey.erase(key);
+	invalidateIndex();
 }
 
 string SymbolTable::getValue(string const& input) const
@@ -39,6 +42,7 @@ string SymbolTable::getValue(string const& input) const
 void SymbolTable::clear()
 {
 	_symbolsByKey.clear();
+	invalidateIndex();
 }
 
 map<string, string> const& SymbolTable::getEntries() const
@@ -49,10 +53,26 @@ map<string, string> const& SymbolTable::getEntries() const
 void SymbolTable::setEntries(map<string, string> const & table)
 {
 	_symbolsByKey = table;
+	invalidateIndex();
 }
 
 void SymbolTable::mergeEntries(SymbolTable const& table)
 {
 	_symbolsByKey.insert(table._symbolsByKey.begin(), table._symbolsByKey.end());
+	invalidateIndex();
 }
 
+SymbolTableIndexPtr SymbolTable::getIndex() const
+{
+	std::lock_guard<std::mutex> lock(_indexMutex);
+	if (!_index) {
+		_index = boost::make_shared<SymbolTableIndex>(_symbolsByKey);
+	}
+	return _index;
+}
+
+void SymbolTable::invalidateIndex()
+{
+	std::lock_guard<std::mutex> lock(_indexMutex);
+	_index.reset();
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <mutex>
+
 #include "Definitions.h"
+#include "SymbolTableIndex.h"
 
 class ENGINEINTERFACE_EXPORT SymbolTable
 	: public QObject
@@ -22,6 +25,14 @@ public:
 	virtual void setEntries(map<string, string> const& table);
 	virtual void mergeEntries(SymbolTable const& table);
 
+	//index of the current entries, built on first use after each change
+	virtual SymbolTableIndexPtr getIndex() const;
+
 private:
+	void invalidateIndex();
+
     map<string, string> _symbolsByKey;
+
+	mutable std::mutex _indexMutex;
+	mutable SymbolTableIndexPtr _index;
 };
@@ -0,0 +1,29 @@
+#include "SymbolTableIndex.h"
+
+#include <boost/functional/hash.hpp>
+
+SymbolTableIndex::SymbolTableIndex(map<string, string> const& symbolsByKey)
+    : _entries(symbolsByKey.begin(), symbolsByKey.end())
+{
+    //views refer to the strings in _entries which are not modified afterwards
+    _valuesByKey.reserve(_entries.size());
+    for (auto const& [key, value] : _entries) {
+        _valuesByKey.emplace(key, value);
+        boost::hash_combine(_hash, key);
+        boost::hash_combine(_hash, value);
+    }
+}
+
+std::string_view SymbolTableIndex::getValue(std::string_view input) const
+{
+    auto const findResult = _valuesByKey.find(input);
+    if (findResult != _valuesByKey.end()) {
+        return findResult->second;
+    }
+    return input;
+}
+
+size_t SymbolTableIndex::getHash() const
+{
+    return _hash;
+}
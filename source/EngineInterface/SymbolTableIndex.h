@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string_view>
+
+#include "Definitions.h"
+
+/**
+ * Immutable hash index over the entries of a symbol table. It owns copies of all keys and values and can therefore be
+ * shared read-only between threads, e.g. by compilers running in parallel, while the symbol table itself changes.
+ */
+class ENGINEINTERFACE_EXPORT SymbolTableIndex
+{
+public:
+    SymbolTableIndex(map<string, string> const& symbolsByKey);
+
+    //returns the input if it is not a key
+    std::string_view getValue(std::string_view input) const;
+
+    //hash over all entries, equal for symbol tables with equal entries
+    size_t getHash() const;
+
+private:
+    vector<pair<string, string>> _entries;
+    unordered_map<std::string_view, std::string_view> _valuesByKey;
+    size_t _hash = 0;
+};
+
+using SymbolTableIndexPtr = shared_ptr<SymbolTableIndex const>;
@@ -0,0 +1,39 @@
+#include <fstream>
+#include <iostream>
+
+#include "Base/EventLogReader.h"
+
+/**
+ * Exports the segment files of an event log to CSV, e.g. "EventLogExport eventlog eventlog.csv" reads
+ * eventlog.000000.evl, eventlog.000001.evl, ... The CSV is written to the standard output if no filename is given.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3) {
+        std::cerr << "usage: EventLogExport <base filename> [<csv filename>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    string const baseFilename = argv[1];
+    if (EventLog::getSegmentFilenames(baseFilename).empty()) {
+        std::cerr << "no segment files found for " << baseFilename << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    vector<EventLogReader::Entry> entries;
+    auto result = EventLogReader::read(baseFilename, entries);
+    if (!result) {
+        std::cerr << "some segment files could not be read" << std::endl;
+    }
+
+    if (argc == 3) {
+        std::ofstream stream(argv[2]);
+        if (!stream) {
+            std::cerr << "could not write " << argv[2] << std::endl;
+            return EXIT_FAILURE;
+        }
+        EventLogReader::writeCsv(stream, entries);
+    } else {
+        EventLogReader::writeCsv(std::cout, entries);
+    }
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
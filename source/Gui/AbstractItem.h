@@ -13,4 +13,10 @@ public:
 	virtual ~AbstractItem() = default;
 
 	virtual void moveBy(QVector2D const &delta);
+
+	int getUpdateNumber() const { return _updateNumber; }
+	void setUpdateNumber(int value) { _updateNumber = value; }
+
+private:
+	int _updateNumber = 0;
 };
@@ -135,6 +135,7 @@ void ActionController::init(
     connect(actions->actionDisplayLink, &QAction::triggered, this, &ActionController::onToggleDisplayLink);
     connect(actions->actionGlowEffect, &QAction::toggled, this, &ActionController::onToggleGlowEffect);
     connect(actions->actionMotionEffect, &QAction::toggled, this, &ActionController::onToggleMotionEffect);
+    connect(actions->actionMinimap, &QAction::toggled, this, &ActionController::onToggleMinimap);
 
     connect(actions->actionItemView, &QAction::toggled, this, &ActionController::onToggleEditorMode);
     connect(actions->actionActionMode, &QAction::toggled, this, &ActionController::onToggleActionMode);
@@ -353,6 +354,22 @@ void ActionController::onToggleMotionEffect(bool toggled)
     loggingService->logMessage(Priority::Unimportant, "toggle motion effect finished");
 }
 
+void ActionController::onToggleMinimap(bool toggled)
+{
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+    if (toggled) {
+        loggingService->logMessage(Priority::Important, "show minimap");
+    } else {
+        loggingService->logMessage(Priority::Important, "hide minimap");
+    }
+
+    auto viewSettings = _model->getSimulationViewSettings();
+    viewSettings.minimap = toggled;
+    _simulationViewController->setSettings(viewSettings);
+
+    loggingService->logMessage(Priority::Unimportant, "toggle minimap finished");
+}
+
 void ActionController::onToggleEditorMode(bool toggled)
 {
     auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
@@ -700,44 +717,6 @@ void ActionController::onDeleteExtendedSelection()
     loggingService->logMessage(Priority::Unimportant, "delete extended selection finished");
 }
 
-namespace
-{
-	void modifyDescription(DataDescription& data, QVector2D const& posDelta, boost::optional<double> const& velocityXDelta
-		, boost::optional<double> const& velocityYDelta, boost::optional<double> const& angularVelocityDelta)
-	{
-		if (data.clusters) {
-			for (auto& cluster : data.clusters.get()) {
-				*cluster.pos += posDelta;
-				if (velocityXDelta) {
-					cluster.vel->setX(cluster.vel->x() + *velocityXDelta);
-				}
-				if (velocityYDelta) {
-					cluster.vel->setY(cluster.vel->y() + *velocityYDelta);
-				}
-				if (angularVelocityDelta) {
-					*cluster.angularVel += *angularVelocityDelta;
-				}
-				if (cluster.cells) {
-					for (auto& cell : cluster.cells.get()) {
-						*cell.pos += posDelta;
-					}
-				}
-			}
-		}
-		if (data.particles) {
-			for (auto& particle : data.particles.get()) {
-				*particle.pos += posDelta;
-				if (velocityXDelta) {
-					particle.vel->setX(particle.vel->x() + *velocityXDelta);
-				}
-				if (velocityYDelta) {
-					particle.vel->setY(particle.vel->y() + *velocityYDelta);
-				}
-			}
-		}
-	}
-}
-
 void ActionController::onRandomMultiplier()
 {
 	RandomMultiplierDialog dialog;
@@ -748,30 +727,40 @@ void ActionController::onRandomMultiplier()
 
 		DataDescription data = _repository->getExtendedSelection();
 		IntVector2D universeSize = _mainController->getSimulationConfig()->universeSize;
-		vector<DataRepository::DataAndAngle> addedData;
-		for (int i = 0; i < dialog.getNumberOfCopies(); ++i) {
-			DataDescription dataCopied = data;
-			QVector2D posDelta(_numberGenerator->getRandomReal(0.0, universeSize.x), _numberGenerator->getRandomReal(0.0, universeSize.y));
-			boost::optional<double> velocityX;
-			boost::optional<double> velocityY;
-			boost::optional<double> angle;
-			boost::optional<double> angularVelocity;
-			if (dialog.isChangeVelX()) {
-				velocityX = _numberGenerator->getRandomReal(dialog.getVelXMin(), dialog.getVelXMax());
+		auto const numberOfCopies = dialog.getNumberOfCopies();
+		auto getRandomReals = [&](bool enabled, double min, double max) {
+			vector<double> result;
+			if (enabled) {
+				result.resize(numberOfCopies);
+				_numberGenerator->fillRandomReals(result, min, max);
+			}
+			return result;
+		};
+		auto const posX = getRandomReals(true, 0.0, universeSize.x);
+		auto const posY = getRandomReals(true, 0.0, universeSize.y);
+		auto const velX = getRandomReals(dialog.isChangeVelX(), dialog.getVelXMin(), dialog.getVelXMax());
+		auto const velY = getRandomReals(dialog.isChangeVelY(), dialog.getVelYMin(), dialog.getVelYMax());
+		auto const angles = getRandomReals(dialog.isChangeAngle(), dialog.getAngleMin(), dialog.getAngleMax());
+		auto const angVels = getRandomReals(dialog.isChangeAngVel(), dialog.getAngVelMin(), dialog.getAngVelMax());
+
+		vector<DescriptionInstancer::Transform> transforms(numberOfCopies);
+		for (int i = 0; i < numberOfCopies; ++i) {
+			auto& transform = transforms[i];
+			transform.posDelta = QVector2D(posX[i], posY[i]);
+			if (!velX.empty()) {
+				transform.velocityXDelta = velX[i];
 			}
-			if (dialog.isChangeVelY()) {
-				velocityY = _numberGenerator->getRandomReal(dialog.getVelYMin(), dialog.getVelYMax());
+			if (!velY.empty()) {
+				transform.velocityYDelta = velY[i];
 			}
-			if (dialog.isChangeAngle()) {
-				angle = _numberGenerator->getRandomReal(dialog.getAngleMin(), dialog.getAngleMax());
+			if (!angles.empty()) {
+				transform.angle = angles[i];
 			}
-			if (dialog.isChangeAngVel()) {
-				angularVelocity = _numberGenerator->getRandomReal(dialog.getAngVelMin(), dialog.getAngVelMax());
+			if (!angVels.empty()) {
+				transform.angularVelocityDelta = angVels[i];
 			}
-			modifyDescription(dataCopied, posDelta, velocityX, velocityY, angularVelocity);
-			addedData.emplace_back(DataRepository::DataAndAngle{ dataCopied, angle });
 		}
-		_repository->addDataAtFixedPosition(addedData);
+		_repository->addInstances(data, transforms);
 		Q_EMIT _notifier->notifyDataRepositoryChanged({
 			Receiver::DataEditor,
 			Receiver::Simulation,
@@ -794,38 +783,33 @@ void ActionController::onGridMultiplier()
 
 		QVector2D initialDelta(dialog.getInitialPosX(), dialog.getInitialPosY());
 		initialDelta -= center;
-		vector<DataRepository::DataAndAngle> addedData;
+		vector<DescriptionInstancer::Transform> transforms;
+		transforms.reserve(dialog.getHorizontalNumber() * dialog.getVerticalNumber());
 		for (int i = 0; i < dialog.getHorizontalNumber(); ++i) {
 			for (int j = 0; j < dialog.getVerticalNumber(); ++j) {
 				if (i == 0 && j == 0 && initialDelta.lengthSquared() < FLOATINGPOINT_MEDIUM_PRECISION) {
 					continue;
 				}
-				DataDescription dataCopied = data;
-				boost::optional<double> velocityX;
-				boost::optional<double> velocityY;
-				boost::optional<double> angle;
-				boost::optional<double> angularVelocity;
+				DescriptionInstancer::Transform transform;
 				if (dialog.isChangeAngle()) {
-					angle = dialog.getInitialAngle() + i*dialog.getHorizontalAngleIncrement() + j*dialog.getVerticalAngleIncrement();
+					transform.angle = dialog.getInitialAngle() + i*dialog.getHorizontalAngleIncrement() + j*dialog.getVerticalAngleIncrement();
 				}
 				if (dialog.isChangeVelocityX()) {
-					velocityX = dialog.getInitialVelX() + i*dialog.getHorizontalVelocityXIncrement() + j*dialog.getVerticalVelocityXIncrement();
+					transform.velocityXDelta = dialog.getInitialVelX() + i*dialog.getHorizontalVelocityXIncrement() + j*dialog.getVerticalVelocityXIncrement();
 				}
 				if (dialog.isChangeVelocityY()) {
-					velocityY = dialog.getInitialVelY() + j*dialog.getHorizontalVelocityYIncrement() + j*dialog.getVerticalVelocityYIncrement();
+					transform.velocityYDelta = dialog.getInitialVelY() + j*dialog.getHorizontalVelocityYIncrement() + j*dialog.getVerticalVelocityYIncrement();
 				}
 				if (dialog.isChangeAngularVelocity()) {
-					angularVelocity = dialog.getInitialAngVel() + i*dialog.getHorizontalAngularVelocityIncrement() + j*dialog.getVerticalAngularVelocityIncrement();
+					transform.angularVelocityDelta = dialog.getInitialAngVel() + i*dialog.getHorizontalAngularVelocityIncrement() + j*dialog.getVerticalAngularVelocityIncrement();
 				}
 
-				QVector2D posDelta(i*dialog.getHorizontalInterval(), j*dialog.getVerticalInterval());
-				posDelta += initialDelta;
-
-				modifyDescription(dataCopied, posDelta, velocityX, velocityY, angularVelocity);
-				addedData.emplace_back(DataRepository::DataAndAngle{ dataCopied, angle });
+				transform.posDelta = QVector2D(i*dialog.getHorizontalInterval(), j*dialog.getVerticalInterval());
+				transform.posDelta += initialDelta;
+				transforms.emplace_back(transform);
 			}
 		}
-		_repository->addDataAtFixedPosition(addedData);
+		_repository->addInstances(data, transforms);
 		Q_EMIT _notifier->notifyDataRepositoryChanged({
 			Receiver::DataEditor,
 			Receiver::Simulation,
@@ -987,7 +971,7 @@ void ActionController::onPasteFromClipboard()
     CHECK(cellIds.size() == 1);
     auto const tokenIndex = _repository->getSelectedTokenIndex();
     CHECK(tokenIndex);
-    auto& cell = _repository->getCellDescRef(*cellIds.begin());
+    auto& cell = _repository->getCellDescRefForModification(*cellIds.begin(), DataChangeSet::Tokens);
     auto& token = cell.tokens->at(*tokenIndex);
 
     auto& tokenMemory = *token.data;
@@ -1022,47 +1006,11 @@ void ActionController::onNewRectangle()
 		double energy = dialog.getInternalEnergy();
         int colorCode = dialog.getColorCode();
 
-		uint64_t id = 0;
-
-		vector<vector<CellDescription>> cellMatrix;
-		for (int x = 0; x < size.x; ++x) {
-			vector<CellDescription> cellRow;
-			for (int y = 0; y < size.y; ++y) {
-				cellRow.push_back(CellDescription().setId(++id).setEnergy(energy)
-					.setPos({ static_cast<float>(x), static_cast<float>(y) })
-					.setMaxConnections(4).setFlagTokenBlocked(false)
-					.setTokenBranchNumber(0).setMetadata(CellMetadata().setColor(colorCode))
-					.setCellFeature(CellFeatureDescription()));
-			}
-			cellMatrix.push_back(cellRow);
-		}
-		for (int x = 0; x < size.x; ++x) {
-			for (int y = 0; y < size.y; ++y) {
-				if (x < size.x - 1) {
-					cellMatrix[x][y].addConnection(cellMatrix[x + 1][y].id);
-				}
-				if (x > 0) {
-					cellMatrix[x][y].addConnection(cellMatrix[x - 1][y].id);
-				}
-				if (y < size.y - 1) {
-					cellMatrix[x][y].addConnection(cellMatrix[x][y + 1].id);
-				}
-				if (y > 0) {
-					cellMatrix[x][y].addConnection(cellMatrix[x][y - 1].id);
-				}
-			}
-		}
-
-		auto cluster = ClusterDescription().setPos({ static_cast<float>(size.x) / 2.0f - 0.5f, static_cast<float>(size.y) / 2.0f - 0.5f })
-			.setVel({ 0, 0 })
-			.setAngle(0).setAngularVel(0).setMetadata(ClusterMetadata());
-		for (int x = 0; x < size.x; ++x) {
-			for (int y = 0; y < size.y; ++y) {
-				cluster.addCell(cellMatrix[x][y]);
-			}
-		}
+        auto const factory = ServiceLocator::getInstance().getService<DescriptionFactory>();
+        auto cluster = factory->createRect(
+            DescriptionFactory::CreateRectParameters().size(size).cellDistance(distance).cellEnergy(energy).colorCode(colorCode));
 
-		_repository->addAndSelectData(DataDescription().addCluster(cluster), { 0, 0 });
+		_repository->addAndSelectData(DataDescription().addCluster(std::move(cluster)), { 0, 0 });
 		Q_EMIT _notifier->notifyDataRepositoryChanged({
 			Receiver::DataEditor,
 			Receiver::Simulation,
@@ -1199,7 +1147,9 @@ void ActionController::onRandomizeCellFunctions()
     auto selectedCellIds = _repository->getSelectedCellIds();
 
 	auto factory = ServiceLocator::getInstance().getService<DescriptionFactory>();
-    factory->randomizeCellFunctions(_mainModel->getSimulationParameters(), extendedSelection, selectedCellIds);
+    uint64_t seed = _numberGenerator->getRandomInt();
+    seed = seed << 32 | _numberGenerator->getRandomInt();
+    factory->randomizeCellFunctions(_mainModel->getSimulationParameters(), extendedSelection, selectedCellIds, seed);
 
 	_repository->updateData(extendedSelection);
 
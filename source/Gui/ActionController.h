@@ -56,6 +56,7 @@ private:
     Q_SLOT void onToggleDisplayLink(bool toggled);
     Q_SLOT void onToggleGlowEffect(bool toggled);
     Q_SLOT void onToggleMotionEffect(bool toggled);
+    Q_SLOT void onToggleMinimap(bool toggled);
 
 	Q_SLOT void onNewCell();
 	Q_SLOT void onNewParticle();
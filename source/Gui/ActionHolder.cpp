@@ -180,6 +180,11 @@ ActionHolder::ActionHolder(QObject* parent) : QObject(parent)
     actionMotionEffect->setShortcut(Qt::ALT + Qt::Key_M);
     actionMotionEffect->setChecked(true);
 
+    actionMinimap = new QAction("Minimap", this);
+    actionMinimap->setEnabled(true);
+    actionMinimap->setCheckable(true);
+    actionMinimap->setChecked(true);
+
 	actionShowCellInfo = new QAction("Cell info", this);
 	QIcon iconCellInfo;
 	iconCellInfo.addFile("://Icons/editor/info_off.png", QSize(), QIcon::Normal, QIcon::Off);
@@ -43,6 +43,7 @@ public:
     QAction* actionDisplayLink = nullptr;
     QAction* actionGlowEffect = nullptr;
     QAction* actionMotionEffect = nullptr;
+    QAction* actionMinimap = nullptr;
     QAction* actionShowCellInfo = nullptr;
 	QAction* actionCenterSelection = nullptr;
 
@@ -146,5 +146,6 @@ SimulationViewSettings ActionModel::getSimulationViewSettings() const
 {
     SimulationViewSettings result;
     result.glowEffect = _actions->actionGlowEffect->isChecked();
+    result.minimap = _actions->actionMinimap->isChecked();
     return result;
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 #include <sstream>
 
 #include "Base/LoggingService.h"
@@ -16,5 +17,6 @@ public:
     std::string getFullProtocol() const;
 
 private:
+    mutable std::mutex _mutex;
     std::stringstream _stream;
 };
@@ -21,6 +21,7 @@ CellComputerEditTab::CellComputerEditTab(QWidget *parent) :
 
     //set colors
     ui->compileButton->setStyleSheet(Const::ButtonStyleSheet);
+    ui->optimizeButton->setStyleSheet(Const::ButtonStyleSheet);
 
     QPalette p = ui->memoryLabel->palette();
     p.setColor(QPalette::WindowText, Const::CellEditCaptionColor1);
@@ -28,6 +29,7 @@ CellComputerEditTab::CellComputerEditTab(QWidget *parent) :
     ui->codeLabel->setPalette(p);
 
     connect(ui->compileButton, &QToolButton::clicked, this, &CellComputerEditTab::compileButtonClicked);
+    connect(ui->optimizeButton, &QToolButton::clicked, this, &CellComputerEditTab::optimizeButtonClicked);
 	connect(_timer, &QTimer::timeout, this, &CellComputerEditTab::timerTimeout);
 	connect(ui->memoryEditWidget, &HexEditWidget::dataChanged, this, &CellComputerEditTab::updateFromMemoryEditWidget);
 }
@@ -76,7 +78,21 @@ void CellComputerEditTab::setCompilationState (bool error, int line)
 void CellComputerEditTab::compileButtonClicked ()
 {
 	auto const& code = ui->codeEditWidget->getCode();
-	CompilationResult result = _compiler->compileSourceCode(code);
+	applyCompilation(_compiler->compileSourceCode(code), code);
+}
+
+void CellComputerEditTab::optimizeButtonClicked()
+{
+    //optimized program does not correspond to the entered code anymore, hence its decompilation is shown instead
+    auto const result = _compiler->compileOptimized(ui->codeEditWidget->getCode());
+    applyCompilation(result, result.compilationOk ? _compiler->decompileSourceCode(result.compilation) : string());
+    if (result.compilationOk) {
+        ui->codeEditWidget->updateDisplay();
+    }
+}
+
+void CellComputerEditTab::applyCompilation(CompilationResult const& result, std::string const& code)
+{
 	if (result.compilationOk) {
 		auto cell = _model->getCellToEditRef();
         if (!cell) {
@@ -22,9 +22,11 @@ public:
 
 private:
     Q_SLOT void compileButtonClicked ();
+    Q_SLOT void optimizeButtonClicked();
 	Q_SLOT void timerTimeout ();
 	Q_SLOT void updateFromMemoryEditWidget();
     
+	void applyCompilation(CompilationResult const& result, std::string const& code);
 	void setCompilationState(bool error, int line);
 
     Ui::CellComputerEditTab *ui;
@@ -0,0 +1,113 @@
+#include <QPainter>
+
+#include "EngineInterface/Colors.h"
+
+#include "Gui/Settings.h"
+
+#include "ClusterItem.h"
+#include "CoordinateSystem.h"
+
+namespace
+{
+    QColor getCellColor(uint8_t colorCode)
+    {
+        switch (colorCode % 7) {
+        case 0:
+            return toQColor(Const::IndividualCellColor1);
+        case 1:
+            return toQColor(Const::IndividualCellColor2);
+        case 2:
+            return toQColor(Const::IndividualCellColor3);
+        case 3:
+            return toQColor(Const::IndividualCellColor4);
+        case 4:
+            return toQColor(Const::IndividualCellColor5);
+        case 5:
+            return toQColor(Const::IndividualCellColor6);
+        default:
+            return toQColor(Const::IndividualCellColor7);
+        }
+    }
+}
+
+ClusterItem::ClusterItem(ClusterDescription const& desc, QGraphicsItem* parent /*= nullptr*/)
+    : AbstractItem(parent)
+{
+	update(desc);
+}
+
+void ClusterItem::update(ClusterDescription const& desc)
+{
+    _id = desc.id;
+    _cellIds.clear();
+    _colorCode = 0;
+
+    //bounding box of the cells relative to the first cell
+    QVector2D origin;
+    QVector2D minPos;
+    QVector2D maxPos;
+    if (desc.cells && !desc.cells->empty()) {
+        auto const& firstCell = desc.cells->front();
+        origin = *firstCell.pos;
+        _colorCode = firstCell.metadata.get_value_or(CellMetadata()).color;
+        for (auto const& cell : *desc.cells) {
+            auto const relPos = *cell.pos - origin;
+            minPos = QVector2D(std::min(minPos.x(), relPos.x()), std::min(minPos.y(), relPos.y()));
+            maxPos = QVector2D(std::max(maxPos.x(), relPos.x()), std::max(maxPos.y(), relPos.y()));
+            _cellIds.push_back(cell.id);
+        }
+    }
+    else if (desc.pos) {
+        origin = *desc.pos;
+    }
+
+    prepareGeometryChange();
+    auto const upperLeft = CoordinateSystem::modelToScene(minPos - QVector2D(0.5, 0.5));
+    auto const lowerRight = CoordinateSystem::modelToScene(maxPos + QVector2D(0.5, 0.5));
+    _rect = QRectF(upperLeft.x(), upperLeft.y(), lowerRight.x() - upperLeft.x(), lowerRight.y() - upperLeft.y());
+
+    auto const pos = CoordinateSystem::modelToScene(origin);
+    QGraphicsItem::setPos(QPointF(pos.x(), pos.y()));
+}
+
+QRectF ClusterItem::boundingRect() const
+{
+    return _rect;
+}
+
+void ClusterItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    auto color = getCellColor(_colorCode);
+    int h, s, l;
+    color.getHsl(&h, &s, &l);
+    if (FOCUS == _focusState) {
+        color.setHsl(h, s, 190);
+    }
+    painter->setBrush(QBrush(color));
+    color.setHsl(h, s, FOCUS == _focusState ? 255 : std::max(0, l - 60));
+    painter->setPen(QPen(QBrush(color), CoordinateSystem::modelToScene(0.1)));
+
+    auto const radius = CoordinateSystem::modelToScene(0.5);
+    painter->drawRoundedRect(_rect, radius, radius);
+}
+
+int ClusterItem::type() const
+{
+    // enables the use of qgraphicsitem_cast with this item.
+    return Type;
+}
+
+uint64_t ClusterItem::getId() const
+{
+    return _id;
+}
+
+list<uint64_t> const& ClusterItem::getCellIds() const
+{
+    return _cellIds;
+}
+
+void ClusterItem::setFocusState(FocusState focusState)
+{
+    _focusState = focusState;
+}
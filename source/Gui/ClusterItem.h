@@ -0,0 +1,42 @@
+#pragma once
+
+#include "EngineInterface/Descriptions.h"
+
+#include "AbstractItem.h"
+
+/**
+ * Level-of-detail item which represents a whole cluster when the view is zoomed out too far for drawing single
+ * cells and connections.
+ */
+class ClusterItem
+	: public AbstractItem
+{
+public:
+    enum FocusState {
+        NO_FOCUS,
+        FOCUS
+    };
+    enum {
+        Type = UserType + 3
+    };
+
+	ClusterItem(ClusterDescription const& desc, QGraphicsItem* parent = nullptr);
+	virtual ~ClusterItem() = default;
+
+	virtual void update(ClusterDescription const& desc);
+
+	virtual QRectF boundingRect() const;
+	virtual void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+	virtual int type() const;
+
+	virtual uint64_t getId() const;
+	virtual list<uint64_t> const& getCellIds() const;
+	virtual void setFocusState(FocusState focusState);
+
+private:
+	FocusState _focusState = FocusState::NO_FOCUS;
+	uint64_t _id = 0;
+	list<uint64_t> _cellIds;
+	QRectF _rect;
+	uint8_t _colorCode = 0;
+};
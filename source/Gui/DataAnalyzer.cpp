@@ -1,6 +1,14 @@
+#include <sstream>
+
 #include <boost/range/adaptors.hpp>
 #include <QMessageBox>
 
+#include "Base/LoggingService.h"
+#include "Base/Parallel.h"
+#include "Base/ServiceLocator.h"
+#include "EngineInterface/ClusterFingerprint.h"
+#include "EngineInterface/SimulationContext.h"
+#include "EngineInterface/SimulationController.h"
 #include "EngineInterface/SimulationAccess.h"
 #include "EngineInterface/Descriptions.h"
 
@@ -8,10 +16,22 @@
 #include "DataRepository.h"
 #include "DataAnalyzer.h"
 
+namespace
+{
+    int const ClustersPerChunk = 1024;
+}
+
 DataAnalyzer::DataAnalyzer(QObject* parent /*= nullptr*/)
     : QObject(parent)
 {}
 
+DataAnalyzer::~DataAnalyzer()
+{
+    _censusThread.quit();
+    _censusThread.wait();
+    delete _censusContext;
+}
+
 void DataAnalyzer::init(SimulationAccess* access, DataRepository* repository, Notifier* notifier)
 {
     SET_CHILD(_access, access);
@@ -32,30 +52,82 @@ void DataAnalyzer::addMostFrequenceClusterRepresentantToSimulation() const
     _access->requireData(ResolveDescription());
 }
 
+void DataAnalyzer::startCensus(SimulationController* controller, SimulationAccess* access, CensusConfig const& config)
+{
+    stopCensus();
+
+    SET_CHILD(_censusAccess, access);
+    _censusController = controller;
+    _censusInterval = std::max(config.interval, 1);
+    _nextCensusTimestep = controller->getContext()->getTimestep();
+
+    if (!_censusContext) {
+        _censusContext = new QObject();
+        _censusContext->moveToThread(&_censusThread);
+        _censusThread.start();
+    }
+    auto const censusConfig = config.census;
+    QMetaObject::invokeMethod(
+        _censusContext,
+        [this, censusConfig] {
+            if (!_census.init(censusConfig)) {
+                auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+                loggingService->logMessage(Priority::Important, "species census: output files could not be created");
+            }
+        },
+        Qt::QueuedConnection);
+
+    _censusConnections.push_back(connect(
+        _censusController,
+        &SimulationController::nextTimestepCalculated,
+        this,
+        &DataAnalyzer::timestepCalculated));
+    _censusConnections.push_back(connect(
+        _censusAccess,
+        &SimulationAccess::dataReadyToRetrieve,
+        this,
+        &DataAnalyzer::censusDataAvailable,
+        Qt::QueuedConnection));
+}
+
+void DataAnalyzer::stopCensus()
+{
+    for (auto const& connection : _censusConnections) {
+        disconnect(connection);
+    }
+    _censusConnections.clear();
+    _censusController = nullptr;
+    _censusSamplePending = false;
+}
+
 void DataAnalyzer::dataFromAccessAvailable()
 {
     DataDescription data = _access->retrieveData();
 
-    auto const partitionDataByDescription = calcPartitionData(data);
+    auto const partitionDataByFingerprint = calcPartitionData(data);
 
-    PartitionData mostFrequentClusterData;
-    for (auto const& descAndPartitionData : partitionDataByDescription ) {
-        auto const& desc = descAndPartitionData.first;
-        auto const& partitionData = descAndPartitionData.second;
-        if (partitionData.numberOfElements > mostFrequentClusterData.numberOfElements && desc.hasToken) {
-            mostFrequentClusterData = partitionData;
+    PartitionData const* mostFrequentClusterData = nullptr;
+    for (auto const& fingerprintAndPartitionData : partitionDataByFingerprint) {
+        auto const& partitionData = fingerprintAndPartitionData.second;
+        if (!partitionData.hasToken) {
+            continue;
+        }
+        if (!mostFrequentClusterData || partitionData.numberOfElements > mostFrequentClusterData->numberOfElements
+            || (partitionData.numberOfElements == mostFrequentClusterData->numberOfElements
+                && partitionData.representant.id < mostFrequentClusterData->representant.id)) {
+            mostFrequentClusterData = &partitionData;
         }
     }
     
-    if (mostFrequentClusterData.numberOfElements > 0) {
-        _repository->addAndSelectData(DataDescription().addCluster(mostFrequentClusterData.representant), { 0, 0 });
+    if (mostFrequentClusterData) {
+        _repository->addAndSelectData(DataDescription().addCluster(mostFrequentClusterData->representant), { 0, 0 });
 
         Q_EMIT _notifier->notifyDataRepositoryChanged({
             Receiver::DataEditor, Receiver::Simulation, Receiver::VisualEditor, Receiver::ActionController
         }, UpdateDescription::All);
 
         QMessageBox msgBox;
-        msgBox.setText(QString("%1 exemplars found.").arg(mostFrequentClusterData.numberOfElements));
+        msgBox.setText(QString("%1 exemplars found.").arg(mostFrequentClusterData->numberOfElements));
         msgBox.exec();
     }
     else {
@@ -66,44 +138,94 @@ void DataAnalyzer::dataFromAccessAvailable()
 }
 
 auto DataAnalyzer::calcPartitionData(DataDescription const& data) const
-    -> std::map<ClusterAnalysisDescription, PartitionData>
+    -> std::unordered_map<uint64_t, PartitionData>
 {
-    std::map<ClusterAnalysisDescription, PartitionData> result;
-
-    if (auto const& clusters = data.clusters) {
-        for (auto const& cluster : *clusters) {
-            auto const clusterAnalysisData = getAnalysisDescription(cluster);
-            auto& partitionData = result[clusterAnalysisData];
-            if (1 == ++partitionData.numberOfElements) {
-                partitionData.representant = cluster;
+    std::unordered_map<uint64_t, PartitionData> result;
+    if (!data.clusters) {
+        return result;
+    }
+    auto const& clusters = *data.clusters;
+    auto const fingerprints = ClusterFingerprint::calc(data);
+
+    //each chunk counts into its own map storing the index of the first cluster per partition, the maps are merged in
+    //chunk order such that the representant is the first cluster in data
+    struct ChunkPartitionData
+    {
+        int numberOfElements = 0;
+        int representantIndex = 0;
+    };
+    auto const numClusters = static_cast<int>(clusters.size());
+    vector<std::unordered_map<uint64_t, ChunkPartitionData>> chunkPartitionData(
+        Parallel::getNumChunks(numClusters, ClustersPerChunk));
+    Parallel::forEachChunk(
+        0,
+        numClusters,
+        [&](int chunkIndex, int begin, int end) {
+            auto& partitionDataByFingerprint = chunkPartitionData[chunkIndex];
+            for (int index = begin; index < end; ++index) {
+                auto& partitionData = partitionDataByFingerprint[fingerprints[index]];
+                if (1 == ++partitionData.numberOfElements) {
+                    partitionData.representantIndex = index;
+                }
+            }
+        },
+        ClustersPerChunk);
+
+    for (auto const& partitionDataByFingerprint : chunkPartitionData) {
+        for (auto const& fingerprintAndPartitionData : partitionDataByFingerprint) {
+            auto const& chunkData = fingerprintAndPartitionData.second;
+            auto& partitionData = result[fingerprintAndPartitionData.first];
+            if (0 == partitionData.numberOfElements) {
+                auto const& representant = clusters[chunkData.representantIndex];
+                partitionData.representant = representant;
+                partitionData.hasToken = ClusterFingerprint::hasToken(representant);
             }
+            partitionData.numberOfElements += chunkData.numberOfElements;
         }
     }
     return result;
 }
 
-auto DataAnalyzer::getAnalysisDescription(ClusterDescription const& cluster) const -> ClusterAnalysisDescription
+void DataAnalyzer::timestepCalculated()
 {
-    ClusterAnalysisDescription result;
-    result.hasToken = false;
-    if (auto const& cells = cluster.cells) {
-        for (auto const& cell : *cells) {
-            CellAnalysisDescription cellAnalysisData;
-            cellAnalysisData.maxConnections = *cell.maxConnections;
-            cellAnalysisData.numConnections = cell.connectingCells->size();
-            cellAnalysisData.tokenBlocked = *cell.tokenBlocked;
-            cellAnalysisData.tokenBranchNumber = *cell.tokenBranchNumber;
-
-            CellFeatureAnalysisDescription featureAnalysisData;
-            featureAnalysisData.cellFunction = cell.cellFeature->getType();
-            featureAnalysisData.constData = cell.cellFeature->constData;
-            cellAnalysisData.feature = featureAnalysisData;
-            
-            result.cells.emplace_back(cellAnalysisData);
-            if (cell.tokens && cell.tokens->size() > 0) {
-                result.hasToken = true;
-            }
-        }
+    auto const timestep = _censusController->getContext()->getTimestep();
+    if (_censusSamplePending || timestep < _nextCensusTimestep) {
+        return;
     }
-    return result;
+    _censusSamplePending = true;
+    _requestedCensusTimestep = timestep;
+    _nextCensusTimestep = timestep + _censusInterval;
+    _censusAccess->requireData(ResolveDescription());
+}
+
+void DataAnalyzer::censusDataAvailable()
+{
+    if (!_censusSamplePending) {
+        return;
+    }
+    auto data = _censusAccess->retrieveData();
+    auto const timestep = _requestedCensusTimestep;
+    QMetaObject::invokeMethod(
+        _censusContext,
+        [this, timestep, data = std::move(data)] {
+            auto const result = _census.addSample(timestep, data);
+            auto const writeError = _census.hasWriteError();
+            QMetaObject::invokeMethod(
+                this, [this, result, writeError] { censusSampleProcessed(result, writeError); }, Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
+
+void DataAnalyzer::censusSampleProcessed(SpeciesCensus::SampleResult const& result, bool writeError)
+{
+    _censusSamplePending = false;
+
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+    if (writeError) {
+        loggingService->logMessage(Priority::Important, "species census: output files could not be written");
+    }
+    std::stringstream stream;
+    stream << "species census at timestep " << result.timestep << ": " << result.numSpecies << " species, "
+           << result.appearedSpecies.size() << " appeared, " << result.extinctSpecies.size() << " extinct";
+    loggingService->logMessage(Priority::Unimportant, stream.str());
 }
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <unordered_map>
+
 #include <QObject>
+#include <QThread>
 
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SpeciesCensus.h"
 
 #include "Definitions.h"
 
@@ -11,104 +15,36 @@ class DataAnalyzer : public QObject
     Q_OBJECT
 public:
     DataAnalyzer(QObject* parent = nullptr);
-    virtual ~DataAnalyzer() = default;
+    virtual ~DataAnalyzer();
 
     void init(SimulationAccess* access, DataRepository* repository, Notifier* notifier);
 
     void addMostFrequenceClusterRepresentantToSimulation() const;
 
-private:
-    Q_SLOT void dataFromAccessAvailable();
-
-    struct CellFeatureAnalysisDescription
+    //the census samples the world every interval timesteps, the species are determined on a separate thread
+    struct CensusConfig
     {
-        int cellFunction;
-        QByteArray constData;
-
-        bool operator<(CellFeatureAnalysisDescription const& other) const {
-            if (cellFunction != other.cellFunction) {
-                return cellFunction < other.cellFunction;
-            }
-            if (constData != other.constData) {
-                return constData < other.constData;
-            }
-            return false;
-        }
-        bool operator==(CellFeatureAnalysisDescription const& other) const
-        {
-            return cellFunction == other.cellFunction && constData == other.constData;
-        }
-        bool operator!=(CellFeatureAnalysisDescription const& other) const
-        {
-            return !operator==(other);
-        }
+        int interval = 1000;
+        SpeciesCensus::Config census;
     };
-    struct CellAnalysisDescription
-    {
-        int maxConnections;
-        int numConnections;
-        bool tokenBlocked;
-        int tokenBranchNumber;
-        CellFeatureAnalysisDescription feature;
-
-        bool operator==(CellAnalysisDescription const& other) const
-        {
-            return maxConnections == other.maxConnections
-                && numConnections == other.numConnections
-                && tokenBlocked == other.tokenBlocked
-                && tokenBranchNumber == other.tokenBranchNumber
-                && feature == other.feature;
-        }
-
-        bool operator!=(CellAnalysisDescription const& other) const
-        {
-            return !operator==(other);
-        }
+    void startCensus(SimulationController* controller, SimulationAccess* access, CensusConfig const& config);
+    void stopCensus();
 
-        bool operator<(CellAnalysisDescription const& other) const
-        {
-            if (maxConnections != other.maxConnections) {
-                return maxConnections < other.maxConnections;
-            }
-            if (numConnections != other.numConnections) {
-                return numConnections < other.numConnections;
-            }
-            if (tokenBlocked != other.tokenBlocked) {
-                return tokenBlocked < other.tokenBlocked;
-            }
-            if (tokenBranchNumber != other.tokenBranchNumber) {
-                return tokenBranchNumber < other.tokenBranchNumber;
-            }
-            if (feature != other.feature) {
-                return feature < other.feature;
-            }
-            return false;
-        }
-    };
-    struct ClusterAnalysisDescription
-    {
-        bool hasToken;
-        std::vector<CellAnalysisDescription> cells;
+private:
+    Q_SLOT void dataFromAccessAvailable();
+    Q_SLOT void timestepCalculated();
+    Q_SLOT void censusDataAvailable();
+    void censusSampleProcessed(SpeciesCensus::SampleResult const& result, bool writeError);
 
-        bool operator<(ClusterAnalysisDescription const& other) const {
-            if (hasToken != other.hasToken) {
-                return hasToken < other.hasToken;
-            }
-            if (cells != other.cells) {
-                return cells < other.cells;
-            }
-            return false;
-        }
-    };
     struct PartitionData
     {
         int numberOfElements = 0;
-        ClusterDescription representant;
+        bool hasToken = false;
+        ClusterDescription representant;    //first cluster of the partition in data
     };
 
-    std::map<ClusterAnalysisDescription, PartitionData> calcPartitionData(DataDescription const& data) const;
-
-    ClusterAnalysisDescription getAnalysisDescription(ClusterDescription const& cluster) const;
+    //partitions the clusters by their structural fingerprint, see ClusterFingerprint
+    std::unordered_map<uint64_t, PartitionData> calcPartitionData(DataDescription const& data) const;
 
 private:
     list<QMetaObject::Connection> _connections;
@@ -116,4 +52,16 @@ private:
     SimulationAccess* _access = nullptr;
     DataRepository* _repository = nullptr;
     Notifier* _notifier = nullptr;
+
+    list<QMetaObject::Connection> _censusConnections;
+    SimulationController* _censusController = nullptr;
+    SimulationAccess* _censusAccess = nullptr;
+    int _censusInterval = 0;
+    int _nextCensusTimestep = 0;
+    int _requestedCensusTimestep = 0;
+    bool _censusSamplePending = false;
+
+    QThread _censusThread;
+    QObject* _censusContext = nullptr;  //lives in _censusThread, all accesses to _census are queued to it
+    SpeciesCensus _census;
 };
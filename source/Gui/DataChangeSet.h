@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Ids of the entities which have been changed in the DataRepository since a receiver has been notified the last
+ * time. A change set flagged with 'all' means that the whole data has to be considered as changed.
+ */
+struct DataChangeSet
+{
+    enum Field
+    {
+        Position = 1 << 0,
+        Connections = 1 << 1,
+        Tokens = 1 << 2,
+        CellFeature = 1 << 3,
+        Metadata = 1 << 4,
+        Energy = 1 << 5,
+        Selection = 1 << 6,
+        AllFields = (1 << 7) - 1
+    };
+
+    bool all = false;
+    int fields = 0;
+
+    unordered_set<uint64_t> addedCellIds;
+    unordered_set<uint64_t> removedCellIds;
+    unordered_set<uint64_t> modifiedCellIds;
+    unordered_set<uint64_t> addedParticleIds;
+    unordered_set<uint64_t> removedParticleIds;
+    unordered_set<uint64_t> modifiedParticleIds;
+    unordered_set<uint64_t> addedClusterIds;
+    unordered_set<uint64_t> removedClusterIds;
+    unordered_set<uint64_t> modifiedClusterIds;
+
+    static DataChangeSet createAll()
+    {
+        DataChangeSet result;
+        result.setAll();
+        return result;
+    }
+
+    void setAll()
+    {
+        *this = DataChangeSet();
+        all = true;
+        fields = AllFields;
+    }
+
+    bool isEmpty() const { return !all && getNumChanges() == 0; }
+
+    bool hasField(Field field) const { return all || (fields & field) != 0; }
+
+    int getNumChanges() const
+    {
+        return static_cast<int>(
+            addedCellIds.size() + removedCellIds.size() + modifiedCellIds.size() + addedParticleIds.size()
+            + removedParticleIds.size() + modifiedParticleIds.size() + addedClusterIds.size()
+            + removedClusterIds.size() + modifiedClusterIds.size());
+    }
+
+    //entities which are added and removed afterwards are contained in both sets, receivers have to look up the
+    //current data for added and modified entities
+    bool isCellAffected(uint64_t id) const
+    {
+        return all || addedCellIds.find(id) != addedCellIds.end() || removedCellIds.find(id) != removedCellIds.end()
+            || modifiedCellIds.find(id) != modifiedCellIds.end();
+    }
+
+    bool isParticleAffected(uint64_t id) const
+    {
+        return all || addedParticleIds.find(id) != addedParticleIds.end()
+            || removedParticleIds.find(id) != removedParticleIds.end()
+            || modifiedParticleIds.find(id) != modifiedParticleIds.end();
+    }
+
+    bool isClusterAffected(uint64_t id) const
+    {
+        return all || addedClusterIds.find(id) != addedClusterIds.end()
+            || removedClusterIds.find(id) != removedClusterIds.end()
+            || modifiedClusterIds.find(id) != modifiedClusterIds.end();
+    }
+};
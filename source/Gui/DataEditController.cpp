@@ -8,6 +8,7 @@
 #include "EngineInterface/SimulationContext.h"
 #include "EngineInterface/EngineInterfaceBuilderFacade.h"
 
+#include "Gui/DataChangeSet.h"
 #include "Gui/DataRepository.h"
 #include "Gui/Notifier.h"
 
@@ -210,6 +211,9 @@ void DataEditController::receivedExternalNotifications(set<Receiver> const& targ
 
 	auto const& selectedCellIds = _repository->getSelectedCellIds();
 	auto const& selectedParticleIds = _repository->getSelectedParticleIds();
+	if (!isEditorAffected(_repository->takeChanges(Receiver::DataEditor), selectedCellIds, selectedParticleIds)) {
+		return;
+	}
 	if (selectedCellIds.size() == 1 && selectedParticleIds.empty()) {
 
 		uint64_t selectedCellId = *selectedCellIds.begin();
@@ -232,6 +236,32 @@ void DataEditController::receivedExternalNotifications(set<Receiver> const& targ
     CATCH;
 }
 
+bool DataEditController::isEditorAffected(
+	DataChangeSet const& changes,
+	unordered_set<uint64_t> const& selectedCellIds,
+	unordered_set<uint64_t> const& selectedParticleIds) const
+{
+    TRY;
+	//notifications without recorded changes (e.g. from the symbol tab) always lead to a refresh
+	if (changes.isEmpty() || changes.hasField(DataChangeSet::Selection)) {
+		return true;
+	}
+	if (selectedCellIds.size() == 1 && selectedParticleIds.empty()) {
+		auto const& cluster = _repository->getClusterDescRef(*selectedCellIds.begin());
+		return changes.isClusterAffected(cluster.id);
+	}
+	if (selectedCellIds.empty() && selectedParticleIds.size() == 1) {
+		return changes.isParticleAffected(*selectedParticleIds.begin());
+	}
+	if (selectedCellIds.size() + selectedParticleIds.size() > 1) {
+
+		//selection editor only shows the number of selected entities
+		return !changes.removedCellIds.empty() || !changes.removedParticleIds.empty();
+	}
+	return true;
+    CATCH;
+}
+
 void DataEditController::switchToCellEditor(CellDescription const& cell, UpdateDescription update)
 {
     TRY;
@@ -30,6 +30,10 @@ private:
 	Q_SLOT void onRefresh();
 	Q_SLOT void receivedExternalNotifications(set<Receiver> const& targets, UpdateDescription update);
 
+	bool isEditorAffected(
+		DataChangeSet const& changes,
+		unordered_set<uint64_t> const& selectedCellIds,
+		unordered_set<uint64_t> const& selectedParticleIds) const;
 	void switchToCellEditor(CellDescription const& cell, UpdateDescription update = UpdateDescription::All);
 
 	list<QMetaObject::Connection> _connections;
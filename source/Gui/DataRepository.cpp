@@ -1,10 +1,16 @@
 #include "DataRepository.h"
 
+#include <atomic>
+#include <cmath>
+
 #include <QMatrix4x4>
 
 #include "Base/DebugMacros.h"
 #include "Base/NumberGenerator.h"
+#include "Base/Parallel.h"
+#include "EngineInterface/ChangeDescriptions.h"
 #include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Physics.h"
 #include "EngineInterface/SimulationAccess.h"
 #include "EngineInterface/SimulationContext.h"
 #include "EngineInterface/SimulationParameters.h"
@@ -30,7 +36,14 @@ void DataRepository::init(
     _selectedCellIds.clear();
     _selectedClusterIds.clear();
     _selectedParticleIds.clear();
+    invalidateSelectionIndices();
     _selectedTokenIndex.reset();
+    _navi.update(_data);
+    updateUnchangedDataIndices();
+    _changesByReceivers = {
+        {Receiver::Simulation, DataChangeSet()},
+        {Receiver::VisualEditor, DataChangeSet::createAll()},
+        {Receiver::DataEditor, DataChangeSet::createAll()}};
 
     for (auto const& connection : _connections) {
         disconnect(connection);
@@ -46,25 +59,46 @@ void DataRepository::init(
         connect(_notifier, &Notifier::notifyDataRepositoryChanged, this, &DataRepository::sendDataChangesToSimulation));
 }
 
-DataDescription& DataRepository::getDataRef()
+template <typename Func>
+void DataRepository::recordChanges(Func const& func, bool dataChanged)
+{
+    //large change sets are not cheaper to process than a complete update
+    auto const maxNumChanges = std::max(10000, static_cast<int>(_navi.cellIds.size() + _navi.particleIds.size()));
+    for (auto& changesByReceiver : _changesByReceivers) {
+        auto& changes = changesByReceiver.second;
+        if (changes.all || (!dataChanged && Receiver::Simulation == changesByReceiver.first)) {
+            continue;
+        }
+        func(changes);
+        if (changes.getNumChanges() > maxNumChanges) {
+            changes.setAll();
+        }
+    }
+}
+
+DataDescription const& DataRepository::getDataRef() const
 {
     return _data;
 }
 
-CellDescription& DataRepository::getCellDescRef(uint64_t cellId)
+CellDescription const& DataRepository::getCellDescRef(uint64_t cellId) const
 {
     TRY;
-    ClusterDescription& clusterDesc = getClusterDescRef(cellId);
+    ClusterDescription const& clusterDesc = getClusterDescRef(cellId);
     int cellIndex = _navi.cellIndicesByCellIds.at(cellId);
     return clusterDesc.cells->at(cellIndex);
     CATCH;
 }
 
-ClusterDescription& DataRepository::getClusterDescRef(uint64_t cellId)
+CellDescription& DataRepository::getCellDescRefForModification(uint64_t cellId, int fields)
 {
     TRY;
     int clusterIndex = _navi.clusterIndicesByCellIds.at(cellId);
-    return _data.clusters->at(clusterIndex);
+    int cellIndex = _navi.cellIndicesByCellIds.at(cellId);
+    auto& clusterDesc = _data.clusters->at(clusterIndex);
+    auto& cellDesc = clusterDesc.cells->at(cellIndex);
+    recordModifiedCell(cellId, clusterDesc.id, fields);
+    return cellDesc;
     CATCH;
 }
 
@@ -76,14 +110,6 @@ ClusterDescription const& DataRepository::getClusterDescRef(uint64_t cellId) con
     CATCH;
 }
 
-ParticleDescription& DataRepository::getParticleDescRef(uint64_t particleId)
-{
-    TRY;
-    int particleIndex = _navi.particleIndicesByParticleIds.at(particleId);
-    return _data.particles->at(particleIndex);
-    CATCH;
-}
-
 ParticleDescription const& DataRepository::getParticleDescRef(uint64_t particleId) const
 {
     TRY;
@@ -125,11 +151,15 @@ void DataRepository::addAndSelectCell(QVector2D const& posDelta)
                                                      .setType(Enums::CellFunction::COMPUTER)
                                                      .setVolatileData(QByteArray(memorySize, 0))));
     _descHelper->makeValid(desc);
+    recordSelectedEntities();
+    recordAddedCluster(desc);
     _data.addCluster(desc);
     _selectedCellIds = {desc.cells->front().id};
     _selectedClusterIds = {desc.id};
     _selectedParticleIds = {};
+    invalidateSelectionIndices();
     _navi.update(_data);
+    recordSelectedEntities();
     CATCH;
 }
 
@@ -139,11 +169,15 @@ void DataRepository::addAndSelectParticle(QVector2D const& posDelta)
     QVector2D pos = _rect.center().toQVector2D() + posDelta;
     auto desc = ParticleDescription().setPos(pos).setVel({}).setEnergy(_parameters.cellMinEnergy / 2.0);
     _descHelper->makeValid(desc);
+    recordSelectedEntities();
+    recordParticle(desc.id, &DataChangeSet::addedParticleIds, DataChangeSet::AllFields);
     _data.addParticle(desc);
     _selectedCellIds = {};
     _selectedClusterIds = {};
     _selectedParticleIds = {desc.id};
+    invalidateSelectionIndices();
     _navi.update(_data);
+    recordSelectedEntities();
     CATCH;
 }
 
@@ -168,38 +202,46 @@ void DataRepository::addAndSelectData(DataDescription data, QVector2D const& pos
     QVector2D delta = targetCenter - centerOfData;
     data.shift(delta);
 
+    recordSelectedEntities();
     _selectedCellIds = {};
     _selectedClusterIds = {};
     _selectedParticleIds = {};
+    invalidateSelectionIndices();
     if (data.clusters) {
         for (auto& cluster : *data.clusters) {
             cluster.id = 0;
             _descHelper->makeValid(cluster);
-            _data.addCluster(cluster);
             _selectedClusterIds.insert(cluster.id);
             if (cluster.cells) {
+                _selectedCellIds.reserve(_selectedCellIds.size() + cluster.cells->size());
                 std::transform(
                     cluster.cells->begin(),
                     cluster.cells->end(),
                     std::inserter(_selectedCellIds, _selectedCellIds.begin()),
                     [](auto const& cell) { return cell.id; });
             }
+            recordAddedCluster(cluster);
+            _data.addCluster(std::move(cluster));
         }
     }
     if (data.particles) {
         for (auto& particle : *data.particles) {
             particle.id = 0;
             _descHelper->makeValid(particle);
+            recordParticle(particle.id, &DataChangeSet::addedParticleIds, DataChangeSet::AllFields);
             _data.addParticle(particle);
             _selectedParticleIds.insert(particle.id);
         }
     }
     _navi.update(_data);
+    recordSelectedEntities();
     CATCH;
 }
 
 namespace
 {
+    int const ClustersPerChunk = 64;
+
     QVector2D calcCenter(
         int numCluster,
         int numParticles,
@@ -280,6 +322,7 @@ void DataRepository::addDataAtFixedPosition(vector<DataAndAngle> dataAndAngles)
             for (auto& cluster : *data.clusters) {
                 cluster.id = 0;
                 _descHelper->makeValid(cluster);
+                recordAddedCluster(cluster);
                 _data.addCluster(cluster);
             }
         }
@@ -287,6 +330,7 @@ void DataRepository::addDataAtFixedPosition(vector<DataAndAngle> dataAndAngles)
             for (auto& particle : *data.particles) {
                 particle.id = 0;
                 _descHelper->makeValid(particle);
+                recordParticle(particle.id, &DataChangeSet::addedParticleIds, DataChangeSet::AllFields);
                 _data.addParticle(particle);
             }
         }
@@ -295,22 +339,103 @@ void DataRepository::addDataAtFixedPosition(vector<DataAndAngle> dataAndAngles)
     CATCH;
 }
 
+void DataRepository::addInstances(
+    DataDescription const& prototype,
+    vector<DescriptionInstancer::Transform> const& transforms)
+{
+    TRY;
+    auto const numIds = DescriptionInstancer::getNumIdsPerInstance(prototype) * static_cast<uint32_t>(transforms.size());
+    if (0 == numIds) {
+        return;
+    }
+    auto instances = DescriptionInstancer::createInstances(prototype, transforms, _numberGenerator->getIds(numIds));
+    auto const numClusters = static_cast<int>(instances.clusters->size());
+    auto const numParticles = static_cast<int>(instances.particles->size());
+
+    //the instances only consist of new entities => the delta can be built directly without comparing with the
+    //unchanged data
+    vector<ClusterChangeDescription> clusterChanges(numClusters);
+    vector<ParticleChangeDescription> particleChanges(numParticles);
+    Parallel::forEach(0, numClusters, [&](int index) {
+        clusterChanges[index] = ClusterChangeDescription(instances.clusters->at(index));
+    });
+    Parallel::forEach(0, numParticles, [&](int index) {
+        particleChanges[index] = ParticleChangeDescription(instances.particles->at(index));
+    });
+    DataChangeDescription delta;
+    delta.clusters.reserve(numClusters);
+    for (auto const& change : clusterChanges) {
+        delta.addNewCluster(change);
+    }
+    delta.particles.reserve(numParticles);
+    for (auto const& change : particleChanges) {
+        delta.addNewParticle(change);
+    }
+    _access->updateData(delta);
+
+    auto const firstClusterIndex = _data.clusters ? static_cast<int>(_data.clusters->size()) : 0;
+    auto const firstParticleIndex = _data.particles ? static_cast<int>(_data.particles->size()) : 0;
+    for (auto const& cluster : *instances.clusters) {
+        _unchangedClusterIndicesByIds.insert_or_assign(
+            cluster.id, _unchangedData.clusters ? static_cast<int>(_unchangedData.clusters->size()) : 0);
+        _unchangedData.addCluster(cluster);
+        _data.addCluster(cluster);
+    }
+    for (auto const& particle : *instances.particles) {
+        _unchangedParticleIndicesByIds.insert_or_assign(
+            particle.id, _unchangedData.particles ? static_cast<int>(_unchangedData.particles->size()) : 0);
+        _unchangedData.addParticle(particle);
+        _data.addParticle(particle);
+    }
+    _navi.updateAppended(_data, firstClusterIndex, firstParticleIndex);
+
+    //the simulation already knows the instances
+    recordChanges(
+        [&](DataChangeSet& changes) {
+            for (auto const& cluster : *instances.clusters) {
+                changes.addedClusterIds.insert(cluster.id);
+                if (cluster.cells) {
+                    for (auto const& cell : *cluster.cells) {
+                        changes.addedCellIds.insert(cell.id);
+                    }
+                }
+            }
+            for (auto const& particle : *instances.particles) {
+                changes.addedParticleIds.insert(particle.id);
+            }
+            changes.fields = DataChangeSet::AllFields;
+        },
+        false);
+    CATCH;
+}
+
 void DataRepository::addRandomParticles(double totalEnergy, double maxEnergyPerParticle)
 {
     TRY;
+    //random values are generated in batches since the number of particles is not known in advance
+    int const batchSize = 1024;
+    vector<double> energies(batchSize);
+    vector<double> posX(batchSize);
+    vector<double> posY(batchSize);
+    vector<double> velX(batchSize);
+    vector<double> velY(batchSize);
+
     DataDescription data;
     double remainingEnergy = totalEnergy;
-    while (remainingEnergy > FLOATINGPOINT_MEDIUM_PRECISION) {
-        double particleEnergy = _numberGenerator->getRandomReal(maxEnergyPerParticle / 100.0, maxEnergyPerParticle);
-        particleEnergy = std::min(particleEnergy, remainingEnergy);
-        data.addParticle(
-            ParticleDescription()
-                .setPos(QVector2D(
-                    _numberGenerator->getRandomReal(0.0, _universeSize.x),
-                    _numberGenerator->getRandomReal(0.0, _universeSize.y)))
-                .setVel(QVector2D(
-                    _numberGenerator->getRandomReal() * 2.0 - 1.0, _numberGenerator->getRandomReal() * 2.0 - 1.0))
-                .setEnergy(particleEnergy));
+    for (int index = batchSize; remainingEnergy > FLOATINGPOINT_MEDIUM_PRECISION; ++index) {
+        if (index == batchSize) {
+            _numberGenerator->fillRandomReals(energies, maxEnergyPerParticle / 100.0, maxEnergyPerParticle);
+            _numberGenerator->fillRandomReals(posX, 0.0, _universeSize.x);
+            _numberGenerator->fillRandomReals(posY, 0.0, _universeSize.y);
+            _numberGenerator->fillRandomReals(velX, -1.0, 1.0);
+            _numberGenerator->fillRandomReals(velY, -1.0, 1.0);
+            index = 0;
+        }
+        double particleEnergy = std::min(energies[index], remainingEnergy);
+        data.addParticle(ParticleDescription()
+                             .setPos(QVector2D(posX[index], posY[index]))
+                             .setVel(QVector2D(velX[index], velY[index]))
+                             .setEnergy(particleEnergy));
         remainingEnergy -= particleEnergy;
     }
 
@@ -346,6 +471,13 @@ namespace
 void DataRepository::deleteSelection()
 {
     TRY;
+    recordSelectedEntities();
+    auto const clusterIdsBefore = getClusterIds();
+    recordChanges([&](DataChangeSet& changes) {
+        changes.removedCellIds.insert(_selectedCellIds.begin(), _selectedCellIds.end());
+        changes.removedParticleIds.insert(_selectedParticleIds.begin(), _selectedParticleIds.end());
+        changes.fields = DataChangeSet::AllFields;
+    });
     if (_data.clusters) {
         unordered_set<uint64_t> modifiedClusterIds;
         vector<ClusterDescription> newClusters;
@@ -382,9 +514,11 @@ void DataRepository::deleteSelection()
         }
         _data.particles = newParticles;
     }
+    recordReplacedClusters(clusterIdsBefore, DataChangeSet::Connections);
     _selectedCellIds = {};
     _selectedClusterIds = {};
     _selectedParticleIds = {};
+    invalidateSelectionIndices();
     _navi.update(_data);
     CATCH;
 }
@@ -392,6 +526,24 @@ void DataRepository::deleteSelection()
 void DataRepository::deleteExtendedSelection()
 {
     TRY;
+    recordSelectedEntities();
+    recordChanges([&](DataChangeSet& changes) {
+        if (_data.clusters) {
+            for (auto const& cluster : *_data.clusters) {
+                if (_selectedClusterIds.find(cluster.id) == _selectedClusterIds.end()) {
+                    continue;
+                }
+                changes.removedClusterIds.insert(cluster.id);
+                if (cluster.cells) {
+                    for (auto const& cell : *cluster.cells) {
+                        changes.removedCellIds.insert(cell.id);
+                    }
+                }
+            }
+        }
+        changes.removedParticleIds.insert(_selectedParticleIds.begin(), _selectedParticleIds.end());
+        changes.fields = DataChangeSet::AllFields;
+    });
     if (_data.clusters) {
         vector<ClusterDescription> newClusters;
         for (auto const& cluster : *_data.clusters) {
@@ -413,6 +565,7 @@ void DataRepository::deleteExtendedSelection()
     _selectedCellIds = {};
     _selectedClusterIds = {};
     _selectedParticleIds = {};
+    invalidateSelectionIndices();
     _navi.update(_data);
     CATCH;
 }
@@ -428,12 +581,13 @@ void DataRepository::addToken(TokenDescription const& token)
 {
     TRY;
     CHECK(_selectedCellIds.size() == 1);
-    auto& cell = getCellDescRef(*_selectedCellIds.begin());
+    auto const cellId = *_selectedCellIds.begin();
+    auto const& cell = getCellDescRef(cellId);
 
     int numToken = cell.tokens ? cell.tokens->size() : 0;
     if (numToken < _parameters.cellMaxToken) {
         uint pos = _selectedTokenIndex ? *_selectedTokenIndex : numToken;
-        cell.addToken(pos, token);
+        getCellDescRefForModification(cellId, DataChangeSet::Tokens).addToken(pos, token);
     }
     CATCH;
 }
@@ -444,7 +598,7 @@ void DataRepository::deleteToken()
     CHECK(_selectedCellIds.size() == 1);
     CHECK(_selectedTokenIndex);
 
-    auto& cell = getCellDescRef(*_selectedCellIds.begin());
+    auto& cell = getCellDescRefForModification(*_selectedCellIds.begin(), DataChangeSet::Tokens);
     cell.delToken(*_selectedTokenIndex);
     CATCH;
 }
@@ -475,15 +629,161 @@ void DataRepository::sendDataChangesToSimulation(set<Receiver> const& targets)
     if (targets.find(Receiver::Simulation) == targets.end()) {
         return;
     }
+    auto const changes = takeChanges(Receiver::Simulation);
+    if (changes.all) {
+        sendAllDataChangesToSimulation();
+    } else {
+        sendIncrementalDataChangesToSimulation(changes);
+    }
+    CATCH;
+}
+
+void DataRepository::sendAllDataChangesToSimulation()
+{
+    TRY;
     DataChangeDescription delta(_unchangedData, _data);
     _access->updateData(delta);
     _unchangedData = _data;
+    updateUnchangedDataIndices();
+    CATCH;
+}
+
+void DataRepository::sendIncrementalDataChangesToSimulation(DataChangeSet const& changes)
+{
+    TRY;
+    DataChangeDescription delta;
+
+    //deleted and modified entities first, then the added ones (same order as in the complete diff)
+    vector<ClusterDescription const*> addedClusters;
+    auto processCluster = [&](uint64_t clusterId) {
+        auto unchangedIt = _unchangedClusterIndicesByIds.find(clusterId);
+        auto currentIt = _navi.clusterIndicesByClusterIds.find(clusterId);
+        auto const isUnchangedPresent = unchangedIt != _unchangedClusterIndicesByIds.end();
+        auto const isCurrentPresent = currentIt != _navi.clusterIndicesByClusterIds.end();
+        if (isUnchangedPresent && isCurrentPresent) {
+            auto& clusterBefore = _unchangedData.clusters->at(unchangedIt->second);
+            auto const& clusterAfter = _data.clusters->at(currentIt->second);
+            ClusterChangeDescription change(clusterBefore, clusterAfter);
+            if (!change.isEmpty()) {
+                delta.addModifiedCluster(change);
+                clusterBefore = clusterAfter;
+            }
+        } else if (isUnchangedPresent) {
+            auto const& clusterBefore = _unchangedData.clusters->at(unchangedIt->second);
+            delta.addDeletedCluster(ClusterChangeDescription().setId(clusterId).setPos(*clusterBefore.pos));
+            removeUnchangedCluster(unchangedIt->second);
+        } else if (isCurrentPresent) {
+            addedClusters.emplace_back(&_data.clusters->at(currentIt->second));
+        }
+    };
+    unordered_set<uint64_t> processedClusterIds;
+    for (auto const* clusterIds : {&changes.removedClusterIds, &changes.modifiedClusterIds, &changes.addedClusterIds}) {
+        for (auto const& clusterId : *clusterIds) {
+            if (processedClusterIds.insert(clusterId).second) {
+                processCluster(clusterId);
+            }
+        }
+    }
+
+    vector<ParticleDescription const*> addedParticles;
+    auto processParticle = [&](uint64_t particleId) {
+        auto unchangedIt = _unchangedParticleIndicesByIds.find(particleId);
+        auto currentIt = _navi.particleIndicesByParticleIds.find(particleId);
+        auto const isUnchangedPresent = unchangedIt != _unchangedParticleIndicesByIds.end();
+        auto const isCurrentPresent = currentIt != _navi.particleIndicesByParticleIds.end();
+        if (isUnchangedPresent && isCurrentPresent) {
+            auto& particleBefore = _unchangedData.particles->at(unchangedIt->second);
+            auto const& particleAfter = _data.particles->at(currentIt->second);
+            ParticleChangeDescription change(particleBefore, particleAfter);
+            if (!change.isEmpty()) {
+                delta.addModifiedParticle(change);
+                particleBefore = particleAfter;
+            }
+        } else if (isUnchangedPresent) {
+            auto const& particleBefore = _unchangedData.particles->at(unchangedIt->second);
+            delta.addDeletedParticle(ParticleChangeDescription().setId(particleId).setPos(*particleBefore.pos));
+            removeUnchangedParticle(unchangedIt->second);
+        } else if (isCurrentPresent) {
+            addedParticles.emplace_back(&_data.particles->at(currentIt->second));
+        }
+    };
+    unordered_set<uint64_t> processedParticleIds;
+    for (auto const* particleIds :
+         {&changes.removedParticleIds, &changes.modifiedParticleIds, &changes.addedParticleIds}) {
+        for (auto const& particleId : *particleIds) {
+            if (processedParticleIds.insert(particleId).second) {
+                processParticle(particleId);
+            }
+        }
+    }
+
+    for (auto const& cluster : addedClusters) {
+        delta.addNewCluster(ClusterChangeDescription(*cluster));
+        _unchangedClusterIndicesByIds.insert_or_assign(
+            cluster->id, _unchangedData.clusters ? static_cast<int>(_unchangedData.clusters->size()) : 0);
+        _unchangedData.addCluster(*cluster);
+    }
+    for (auto const& particle : addedParticles) {
+        delta.addNewParticle(ParticleChangeDescription(*particle));
+        _unchangedParticleIndicesByIds.insert_or_assign(
+            particle->id, _unchangedData.particles ? static_cast<int>(_unchangedData.particles->size()) : 0);
+        _unchangedData.addParticle(*particle);
+    }
+
+    _access->updateData(delta);
+    CATCH;
+}
+
+void DataRepository::updateUnchangedDataIndices()
+{
+    TRY;
+    _unchangedClusterIndicesByIds.clear();
+    _unchangedParticleIndicesByIds.clear();
+    if (_unchangedData.clusters) {
+        _unchangedClusterIndicesByIds.reserve(_unchangedData.clusters->size());
+        for (int index = 0; index < _unchangedData.clusters->size(); ++index) {
+            _unchangedClusterIndicesByIds.insert_or_assign(_unchangedData.clusters->at(index).id, index);
+        }
+    }
+    if (_unchangedData.particles) {
+        _unchangedParticleIndicesByIds.reserve(_unchangedData.particles->size());
+        for (int index = 0; index < _unchangedData.particles->size(); ++index) {
+            _unchangedParticleIndicesByIds.insert_or_assign(_unchangedData.particles->at(index).id, index);
+        }
+    }
+    CATCH;
+}
+
+void DataRepository::removeUnchangedCluster(int clusterIndex)
+{
+    TRY;
+    auto& clusters = *_unchangedData.clusters;
+    _unchangedClusterIndicesByIds.erase(clusters.at(clusterIndex).id);
+    if (clusterIndex != clusters.size() - 1) {
+        clusters[clusterIndex] = std::move(clusters.back());
+        _unchangedClusterIndicesByIds.insert_or_assign(clusters[clusterIndex].id, clusterIndex);
+    }
+    clusters.pop_back();
+    CATCH;
+}
+
+void DataRepository::removeUnchangedParticle(int particleIndex)
+{
+    TRY;
+    auto& particles = *_unchangedData.particles;
+    _unchangedParticleIndicesByIds.erase(particles.at(particleIndex).id);
+    if (particleIndex != particles.size() - 1) {
+        particles[particleIndex] = std::move(particles.back());
+        _unchangedParticleIndicesByIds.insert_or_assign(particles[particleIndex].id, particleIndex);
+    }
+    particles.pop_back();
     CATCH;
 }
 
 void DataRepository::setSelection(list<uint64_t> const& cellIds, list<uint64_t> const& particleIds)
 {
     TRY;
+    recordSelectedEntities();
     _selectedCellIds.clear();
     for (uint64_t particleId : cellIds) {
         if (_navi.cellIds.find(particleId) != _navi.cellIds.end()) {
@@ -505,6 +805,8 @@ void DataRepository::setSelection(list<uint64_t> const& cellIds, list<uint64_t>
             _selectedClusterIds.insert(clusterIdByCellIdIter->second);
         }
     }
+    invalidateSelectionIndices();
+    recordSelectedEntities();
     CATCH;
 }
 
@@ -601,93 +903,130 @@ DataDescription DataRepository::getExtendedSelection() const
 void DataRepository::moveSelection(QVector2D const& delta)
 {
     TRY;
-    for (uint64_t cellId : _selectedCellIds) {
-        if (isCellPresent(cellId)) {
-            int clusterIndex = _navi.clusterIndicesByCellIds.at(cellId);
-            int cellIndex = _navi.cellIndicesByCellIds.at(cellId);
-            CellDescription& cellDesc = getCellDescRef(cellId);
-            cellDesc.pos = *cellDesc.pos + delta;
-        }
-    }
-
-    for (uint64_t particleId : _selectedParticleIds) {
-        if (isParticlePresent(particleId)) {
-            ParticleDescription& particleDesc = getParticleDescRef(particleId);
-            particleDesc.pos = *particleDesc.pos + delta;
-        }
-    }
+    auto const& indices = getSelectionIndices();
+    Parallel::forEach(0, static_cast<int>(indices.cells.size()), [&](int index) {
+        auto const& entry = indices.cells[index];
+        *_data.clusters->at(entry.index).cells->at(entry.cellIndex).pos += delta;
+    });
+    Parallel::forEach(0, static_cast<int>(indices.particles.size()), [&](int index) {
+        *_data.particles->at(indices.particles[index].index).pos += delta;
+    });
+    recordModifiedSelection(indices, false, DataChangeSet::Position);
     CATCH;
 }
 
 void DataRepository::moveExtendedSelection(QVector2D const& delta)
 {
     TRY;
-    for (uint64_t selectedClusterId : _selectedClusterIds) {
-        auto selectedClusterIndex = _navi.clusterIndicesByClusterIds.at(selectedClusterId);
-        ClusterDescription& clusterDesc = _data.clusters->at(selectedClusterIndex);
-        clusterDesc.pos = *clusterDesc.pos + delta;
-    }
-
-    list<uint64_t> extSelectedCellIds;
-    for (auto clusterIdByCellId : _navi.clusterIdsByCellIds) {
-        uint64_t cellId = clusterIdByCellId.first;
-        uint64_t clusterId = clusterIdByCellId.second;
-        if (_selectedClusterIds.find(clusterId) != _selectedClusterIds.end()) {
-            extSelectedCellIds.push_back(cellId);
-        }
-    }
-
-    for (uint64_t cellId : extSelectedCellIds) {
-        if (isCellPresent(cellId)) {
-            int clusterIndex = _navi.clusterIndicesByCellIds.at(cellId);
-            int cellIndex = _navi.cellIndicesByCellIds.at(cellId);
-            CellDescription& cellDesc = getCellDescRef(cellId);
-            cellDesc.pos = *cellDesc.pos + delta;
-        }
-    }
-
-    for (uint64_t particleId : _selectedParticleIds) {
-        if (isParticlePresent(particleId)) {
-            ParticleDescription& particleDesc = getParticleDescRef(particleId);
-            particleDesc.pos = *particleDesc.pos + delta;
-        }
-    }
+    auto const& indices = getSelectionIndices();
+    Parallel::forEach(
+        0,
+        static_cast<int>(indices.clusters.size()),
+        [&](int index) {
+            auto& cluster = _data.clusters->at(indices.clusters[index].index);
+            *cluster.pos += delta;
+            if (cluster.cells) {
+                for (auto& cell : *cluster.cells) {
+                    *cell.pos += delta;
+                }
+            }
+        },
+        ClustersPerChunk);
+    Parallel::forEach(0, static_cast<int>(indices.particles.size()), [&](int index) {
+        *_data.particles->at(indices.particles[index].index).pos += delta;
+    });
+    recordModifiedSelection(indices, true, DataChangeSet::Position);
     CATCH;
 }
 
 void DataRepository::reconnectSelectedCells()
 {
     TRY;
-    _descHelper->reconnect(getDataRef(), _unchangedData, getSelectedCellIds());
+    auto const clusterIdsBefore = getClusterIds();
+    _descHelper->reconnect(_data, _unchangedData, getSelectedCellIds());
     updateAfterCellReconnections();
+    recordReplacedClusters(clusterIdsBefore, DataChangeSet::Connections);
     CATCH;
 }
 
 void DataRepository::rotateSelection(double angle)
 {
     TRY;
-    vector<uint64_t> selectedClusterIds(_selectedClusterIds.begin(), _selectedClusterIds.end());
-    vector<uint64_t> selectedParticleIds(_selectedParticleIds.begin(), _selectedParticleIds.end());
-    auto clusterResolver = [&selectedClusterIds, this](int index) -> ClusterDescription& {
-        return _data.clusters->at(_navi.clusterIndicesByClusterIds.at(selectedClusterIds.at(index)));
-    };
-    auto particleResolver = [&selectedParticleIds, this](int index) -> ParticleDescription& {
-        return getParticleDescRef(selectedParticleIds.at(index));
+    auto const& indices = getSelectionIndices();
+
+    //center of the extended selection, summed up per chunk to keep the result independent of the thread scheduling
+    auto const numClusterChunks = Parallel::getNumChunks(static_cast<int>(indices.clusters.size()), ClustersPerChunk);
+    auto const numParticleChunks = Parallel::getNumChunks(static_cast<int>(indices.particles.size()));
+    vector<QVector2D> chunkSums(numClusterChunks + numParticleChunks);
+    vector<int> chunkCounts(numClusterChunks + numParticleChunks, 0);
+    Parallel::forEachChunk(
+        0,
+        static_cast<int>(indices.clusters.size()),
+        [&](int chunkIndex, int begin, int end) {
+            for (int index = begin; index < end; ++index) {
+                auto const& cluster = _data.clusters->at(indices.clusters[index].index);
+                if (cluster.cells) {
+                    for (auto const& cell : *cluster.cells) {
+                        chunkSums[chunkIndex] += *cell.pos;
+                        ++chunkCounts[chunkIndex];
+                    }
+                }
+            }
+        },
+        ClustersPerChunk);
+    Parallel::forEachChunk(0, static_cast<int>(indices.particles.size()), [&](int chunkIndex, int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            chunkSums[numClusterChunks + chunkIndex] += *_data.particles->at(indices.particles[index].index).pos;
+            ++chunkCounts[numClusterChunks + chunkIndex];
+        }
+    });
+    QVector2D center;
+    int numEntities = 0;
+    for (int chunkIndex = 0; chunkIndex < static_cast<int>(chunkSums.size()); ++chunkIndex) {
+        center += chunkSums[chunkIndex];
+        numEntities += chunkCounts[chunkIndex];
+    }
+    if (numEntities > 0) {
+        center /= numEntities;
+    }
+
+    auto const cosAngle = static_cast<float>(std::cos(angle * degToRad));
+    auto const sinAngle = static_cast<float>(std::sin(angle * degToRad));
+    auto rotatePos = [&](QVector2D& pos) {
+        auto const relPos = pos - center;
+        pos = center + QVector2D(cosAngle * relPos.x() - sinAngle * relPos.y(), sinAngle * relPos.x() + cosAngle * relPos.y());
     };
-    rotate(angle, _selectedClusterIds.size(), _selectedParticleIds.size(), clusterResolver, particleResolver);
+    Parallel::forEach(
+        0,
+        static_cast<int>(indices.clusters.size()),
+        [&](int index) {
+            auto& cluster = _data.clusters->at(indices.clusters[index].index);
+            if (!cluster.cells) {
+                return;
+            }
+            for (auto& cell : *cluster.cells) {
+                rotatePos(*cell.pos);
+            }
+            *cluster.angle += angle;
+            rotatePos(*cluster.pos);
+        },
+        ClustersPerChunk);
+    Parallel::forEach(0, static_cast<int>(indices.particles.size()), [&](int index) {
+        rotatePos(*_data.particles->at(indices.particles[index].index).pos);
+    });
+    recordModifiedSelection(indices, true, DataChangeSet::Position);
     CATCH;
 }
 
 void DataRepository::colorizeSelection(int colorCode)
 {
     TRY;
-    for (uint64_t cellId : _selectedCellIds) {
-        if (isCellPresent(cellId)) {
-            int cellIndex = _navi.cellIndicesByCellIds.at(cellId);
-            CellDescription& cellDesc = getCellDescRef(cellId);
-            cellDesc.metadata->color = colorCode;
-        }
-    }
+    auto const& indices = getSelectionIndices();
+    Parallel::forEach(0, static_cast<int>(indices.cells.size()), [&](int index) {
+        auto const& entry = indices.cells[index];
+        _data.clusters->at(entry.index).cells->at(entry.cellIndex).metadata->color = colorCode;
+    });
+    recordModifiedSelection(indices, false, DataChangeSet::Metadata);
     CATCH;
 }
 
@@ -695,6 +1034,7 @@ void DataRepository::updateCluster(ClusterDescription const& cluster)
 {
     TRY;
     int clusterIndex = _navi.clusterIndicesByClusterIds.at(cluster.id);
+    recordModifiedCluster(_data.clusters->at(clusterIndex), cluster);
     _data.clusters->at(clusterIndex) = cluster;
 
     _navi.update(_data);
@@ -706,6 +1046,7 @@ void DataRepository::updateParticle(ParticleDescription const& particle)
     TRY;
     int particleIndex = _navi.particleIndicesByParticleIds.at(particle.id);
     _data.particles->at(particleIndex) = particle;
+    recordParticle(particle.id, &DataChangeSet::modifiedParticleIds, DataChangeSet::AllFields);
 
     _navi.update(_data);
     CATCH;
@@ -754,6 +1095,7 @@ void DataRepository::updateAfterCellReconnections()
     _navi.update(_data);
 
     _selectedClusterIds.clear();
+    invalidateSelectionIndices();
     for (uint64_t selectedCellId : _selectedCellIds) {
         if (_navi.clusterIdsByCellIds.find(selectedCellId) != _navi.clusterIdsByCellIds.end()) {
             _selectedClusterIds.insert(_navi.clusterIdsByCellIds.at(selectedCellId));
@@ -769,6 +1111,15 @@ void DataRepository::updateInternals(DataDescription const& data)
     _unchangedData = _data;
 
     _navi.update(data);
+    updateUnchangedDataIndices();
+    for (auto& changesByReceiver : _changesByReceivers) {
+        auto& changes = changesByReceiver.second;
+        if (Receiver::Simulation == changesByReceiver.first) {
+            changes = DataChangeSet();
+        } else {
+            changes.setAll();
+        }
+    }
 
     unordered_set<uint64_t> newSelectedCells;
     std::copy_if(
@@ -795,5 +1146,242 @@ void DataRepository::updateInternals(DataDescription const& data)
         std::inserter(newSelectedParticles, newSelectedParticles.begin()),
         [this](uint64_t particleId) { return _navi.particleIds.find(particleId) != _navi.particleIds.end(); });
     _selectedParticleIds = newSelectedParticles;
+    invalidateSelectionIndices();
+    CATCH;
+}
+
+auto DataRepository::getSelectionIndices() -> SelectionIndices const&
+{
+    TRY;
+    if (_selectionIndices && isUpToDate(*_selectionIndices)) {
+        return *_selectionIndices;
+    }
+    SelectionIndices result;
+    result.cells.reserve(_selectedCellIds.size());
+    for (auto const& cellId : _selectedCellIds) {
+        auto const clusterIndexIt = _navi.clusterIndicesByCellIds.find(cellId);
+        if (clusterIndexIt != _navi.clusterIndicesByCellIds.end()) {
+            result.cells.push_back({cellId, clusterIndexIt->second, _navi.cellIndicesByCellIds.at(cellId)});
+        }
+    }
+    result.clusters.reserve(_selectedClusterIds.size());
+    for (auto const& clusterId : _selectedClusterIds) {
+        auto const clusterIndexIt = _navi.clusterIndicesByClusterIds.find(clusterId);
+        if (clusterIndexIt != _navi.clusterIndicesByClusterIds.end()) {
+            result.clusters.push_back({clusterId, clusterIndexIt->second});
+        }
+    }
+    result.particles.reserve(_selectedParticleIds.size());
+    for (auto const& particleId : _selectedParticleIds) {
+        auto const particleIndexIt = _navi.particleIndicesByParticleIds.find(particleId);
+        if (particleIndexIt != _navi.particleIndicesByParticleIds.end()) {
+            result.particles.push_back({particleId, particleIndexIt->second});
+        }
+    }
+
+    auto lessByPosition = [](SelectionIndices::Entry const& lhs, SelectionIndices::Entry const& rhs) {
+        return lhs.index < rhs.index || (lhs.index == rhs.index && lhs.cellIndex < rhs.cellIndex);
+    };
+    std::sort(result.cells.begin(), result.cells.end(), lessByPosition);
+    std::sort(result.clusters.begin(), result.clusters.end(), lessByPosition);
+    std::sort(result.particles.begin(), result.particles.end(), lessByPosition);
+    _selectionIndices = std::move(result);
+    return *_selectionIndices;
+    CATCH;
+}
+
+bool DataRepository::isUpToDate(SelectionIndices const& indices) const
+{
+    //entities may have been added or removed by mutators which keep the indices, hence the positions are verified
+    std::atomic<bool> result(true);
+    auto const numClusters = _data.clusters ? static_cast<int>(_data.clusters->size()) : 0;
+    auto const numParticles = _data.particles ? static_cast<int>(_data.particles->size()) : 0;
+    Parallel::forEach(0, static_cast<int>(indices.cells.size()), [&](int index) {
+        auto const& entry = indices.cells[index];
+        if (entry.index >= numClusters) {
+            result = false;
+            return;
+        }
+        auto const& cells = _data.clusters->at(entry.index).cells;
+        if (!cells || entry.cellIndex >= static_cast<int>(cells->size()) || cells->at(entry.cellIndex).id != entry.id) {
+            result = false;
+        }
+    });
+    for (auto const& entry : indices.clusters) {
+        if (entry.index >= numClusters || _data.clusters->at(entry.index).id != entry.id) {
+            return false;
+        }
+    }
+    for (auto const& entry : indices.particles) {
+        if (entry.index >= numParticles || _data.particles->at(entry.index).id != entry.id) {
+            return false;
+        }
+    }
+    return result;
+}
+
+void DataRepository::invalidateSelectionIndices()
+{
+    _selectionIndices.reset();
+}
+
+void DataRepository::recordModifiedSelection(SelectionIndices const& indices, bool extended, int fields)
+{
+    //one record for the whole selection instead of one per entity
+    recordChanges([&](DataChangeSet& changes) {
+        if (extended) {
+            for (auto const& entry : indices.clusters) {
+                auto const& cluster = _data.clusters->at(entry.index);
+                changes.modifiedClusterIds.insert(cluster.id);
+                if (cluster.cells) {
+                    for (auto const& cell : *cluster.cells) {
+                        changes.modifiedCellIds.insert(cell.id);
+                    }
+                }
+            }
+        } else {
+            for (auto const& entry : indices.cells) {
+                changes.modifiedCellIds.insert(entry.id);
+                changes.modifiedClusterIds.insert(_data.clusters->at(entry.index).id);
+            }
+        }
+        for (auto const& entry : indices.particles) {
+            changes.modifiedParticleIds.insert(entry.id);
+        }
+        changes.fields |= fields;
+    });
+}
+
+DataChangeSet DataRepository::takeChanges(Receiver receiver)
+{
+    TRY;
+    auto changesIt = _changesByReceivers.find(receiver);
+    if (changesIt == _changesByReceivers.end()) {
+        return DataChangeSet::createAll();
+    }
+    DataChangeSet result;
+    std::swap(result, changesIt->second);
+    return result;
+    CATCH;
+}
+
+void DataRepository::recordAddedCluster(ClusterDescription const& cluster)
+{
+    recordChanges([&](DataChangeSet& changes) {
+        changes.addedClusterIds.insert(cluster.id);
+        if (cluster.cells) {
+            for (auto const& cell : *cluster.cells) {
+                changes.addedCellIds.insert(cell.id);
+            }
+        }
+        changes.fields = DataChangeSet::AllFields;
+    });
+}
+
+void DataRepository::recordModifiedCluster(
+    ClusterDescription const& clusterBefore,
+    ClusterDescription const& clusterAfter)
+{
+    unordered_set<uint64_t> cellIdsAfter;
+    if (clusterAfter.cells) {
+        for (auto const& cell : *clusterAfter.cells) {
+            cellIdsAfter.insert(cell.id);
+        }
+    }
+    recordChanges([&](DataChangeSet& changes) {
+        changes.modifiedClusterIds.insert(clusterAfter.id);
+        if (clusterBefore.cells) {
+            for (auto const& cell : *clusterBefore.cells) {
+                if (cellIdsAfter.find(cell.id) == cellIdsAfter.end()) {
+                    changes.removedCellIds.insert(cell.id);
+                }
+            }
+        }
+        for (auto const& cellId : cellIdsAfter) {
+            changes.modifiedCellIds.insert(cellId);
+        }
+        changes.fields = DataChangeSet::AllFields;
+    });
+}
+
+void DataRepository::recordModifiedCell(uint64_t cellId, uint64_t clusterId, int fields)
+{
+    recordChanges([&](DataChangeSet& changes) {
+        changes.modifiedCellIds.insert(cellId);
+        changes.modifiedClusterIds.insert(clusterId);
+        changes.fields |= fields;
+    });
+}
+
+void DataRepository::recordParticle(uint64_t particleId, unordered_set<uint64_t> DataChangeSet::*ids, int fields)
+{
+    recordChanges([&](DataChangeSet& changes) {
+        (changes.*ids).insert(particleId);
+        changes.fields |= fields;
+    });
+}
+
+void DataRepository::recordReplacedClusters(unordered_set<uint64_t> const& clusterIdsBefore, int fields)
+{
+    TRY;
+    auto const clusterIdsAfter = getClusterIds();
+    recordChanges([&](DataChangeSet& changes) {
+        if (_data.clusters) {
+            for (auto const& cluster : *_data.clusters) {
+                if (clusterIdsBefore.find(cluster.id) == clusterIdsBefore.end()) {
+                    changes.addedClusterIds.insert(cluster.id);
+                    if (cluster.cells) {
+                        for (auto const& cell : *cluster.cells) {
+                            changes.modifiedCellIds.insert(cell.id);
+                        }
+                    }
+                    changes.fields |= fields;
+                }
+            }
+        }
+        for (auto const& clusterId : clusterIdsBefore) {
+            if (clusterIdsAfter.find(clusterId) == clusterIdsAfter.end()) {
+                changes.removedClusterIds.insert(clusterId);
+            }
+        }
+    });
+    CATCH;
+}
+
+void DataRepository::recordSelectedEntities()
+{
+    TRY;
+    recordChanges(
+        [&](DataChangeSet& changes) {
+            for (auto const& clusterId : _selectedClusterIds) {
+                auto clusterIndexIt = _navi.clusterIndicesByClusterIds.find(clusterId);
+                if (clusterIndexIt == _navi.clusterIndicesByClusterIds.end()) {
+                    continue;
+                }
+                auto const& cluster = _data.clusters->at(clusterIndexIt->second);
+                if (cluster.cells) {
+                    for (auto const& cell : *cluster.cells) {
+                        changes.modifiedCellIds.insert(cell.id);
+                    }
+                }
+            }
+            for (auto const& particleId : _selectedParticleIds) {
+                changes.modifiedParticleIds.insert(particleId);
+            }
+            changes.fields |= DataChangeSet::Selection;
+        },
+        false);
     CATCH;
 }
+
+unordered_set<uint64_t> DataRepository::getClusterIds() const
+{
+    unordered_set<uint64_t> result;
+    if (_data.clusters) {
+        result.reserve(_data.clusters->size());
+        for (auto const& cluster : *_data.clusters) {
+            result.insert(cluster.id);
+        }
+    }
+    return result;
+}
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "EngineInterface/DescriptionInstancer.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/SimulationAccess.h"
 
 #include "Definitions.h"
+#include "DataChangeSet.h"
 
 class DataRepository : public QObject
 {
@@ -17,13 +19,15 @@ public:
     virtual void
     init(Notifier* notifier, SimulationAccess* access, DescriptionHelper* connector, SimulationContext* context);
 
-    virtual DataDescription& getDataRef();
-    virtual CellDescription& getCellDescRef(uint64_t cellId);
-    virtual ClusterDescription& getClusterDescRef(uint64_t cellId);
+    //read-only access, data is changed by the methods below such that the changes are recorded for the receivers
+    virtual DataDescription const& getDataRef() const;
+    virtual CellDescription const& getCellDescRef(uint64_t cellId) const;
     virtual ClusterDescription const& getClusterDescRef(uint64_t cellId) const;
-    virtual ParticleDescription& getParticleDescRef(uint64_t particleId);
     virtual ParticleDescription const& getParticleDescRef(uint64_t particleId) const;
 
+    //records the cell as modified in the given fields (see DataChangeSet::Field) before it is handed out
+    virtual CellDescription& getCellDescRefForModification(uint64_t cellId, int fields);
+
     virtual void setSelectedTokenIndex(boost::optional<uint> const& value);
     virtual boost::optional<uint> getSelectedTokenIndex() const;
 
@@ -41,6 +45,9 @@ public:
         boost::optional<double> angle;
     };
     virtual void addDataAtFixedPosition(vector<DataAndAngle> dataAndAngles);
+
+    //adds one transformed copy of the prototype per transform, the copies are sent to the simulation immediately
+    virtual void addInstances(DataDescription const& prototype, vector<DescriptionInstancer::Transform> const& transforms);
     virtual void addRandomParticles(double totalEnergy, double maxEnergyPerParticle);
     virtual void deleteSelection();
     virtual void deleteExtendedSelection();
@@ -67,6 +74,7 @@ public:
     virtual unordered_set<uint64_t> getSelectedParticleIds() const;
     virtual DataDescription getExtendedSelection() const;
     virtual bool isCellPresent(uint64_t cellId);
+    virtual bool isParticlePresent(uint64_t particleId);
 
     virtual void requireDataUpdateFromSimulation(IntRect const& rect);
     virtual void requirePixelImageFromSimulation(IntRect const& rect, QImagePtr const& target);
@@ -77,6 +85,9 @@ public:
         IntVector2D const& imageSize);
     virtual std::mutex& getImageMutex();
 
+    //returns the changes since the last call for the given receiver
+    virtual DataChangeSet takeChanges(Receiver receiver);
+
     Q_SIGNAL void imageReady();
 
 
@@ -86,7 +97,41 @@ private:
 
     void updateAfterCellReconnections();
     void updateInternals(DataDescription const& data);
-    bool isParticlePresent(uint64_t particleId);
+
+    void sendAllDataChangesToSimulation();
+    void sendIncrementalDataChangesToSimulation(DataChangeSet const& changes);
+    void updateUnchangedDataIndices();
+    void removeUnchangedCluster(int clusterIndex);
+    void removeUnchangedParticle(int particleIndex);
+
+    template <typename Func>
+    void recordChanges(Func const& func, bool dataChanged = true);
+    void recordAddedCluster(ClusterDescription const& cluster);
+    void recordModifiedCluster(ClusterDescription const& clusterBefore, ClusterDescription const& clusterAfter);
+    void recordModifiedCell(uint64_t cellId, uint64_t clusterId, int fields);
+    void recordParticle(uint64_t particleId, unordered_set<uint64_t> DataChangeSet::*ids, int fields);
+    void recordReplacedClusters(unordered_set<uint64_t> const& clusterIdsBefore, int fields);
+    void recordSelectedEntities();
+    unordered_set<uint64_t> getClusterIds() const;
+
+    //selection resolved to positions in _data, sorted by position
+    struct SelectionIndices
+    {
+        struct Entry
+        {
+            uint64_t id = 0;
+            int index = 0;      //cluster or particle index
+            int cellIndex = 0;  //only used for cells
+        };
+        vector<Entry> cells;
+        vector<Entry> clusters;     //clusters with selected cells
+        vector<Entry> particles;
+    };
+    //resolves the selection again if it or the layout of _data has changed since the last call
+    SelectionIndices const& getSelectionIndices();
+    bool isUpToDate(SelectionIndices const& indices) const;
+    void invalidateSelectionIndices();
+    void recordModifiedSelection(SelectionIndices const& indices, bool extended, int fields);
 
     list<QMetaObject::Connection> _connections;
 
@@ -102,8 +147,12 @@ private:
     unordered_set<uint64_t> _selectedCellIds;
     unordered_set<uint64_t> _selectedClusterIds;
     unordered_set<uint64_t> _selectedParticleIds;
+    boost::optional<SelectionIndices> _selectionIndices;
 
     DescriptionNavigator _navi;
+    unordered_map<uint64_t, int> _unchangedClusterIndicesByIds;
+    unordered_map<uint64_t, int> _unchangedParticleIndicesByIds;
+    map<Receiver, DataChangeSet> _changesByReceivers;
     RealRect _rect;
     IntVector2D _universeSize;
     std::mutex _mutex;
@@ -20,6 +20,7 @@ class QGraphicsSimpleTextItem;
 class CellItem;
 class ParticleItem;
 class CellConnectionItem;
+class ClusterItem;
 class ItemConfig;
 class MonitorView;
 class MetadataManager;
@@ -71,6 +72,7 @@ class SimulationViewController;
 class ProgressBar;
 
 struct MonitorData;
+struct DataChangeSet;
 using MonitorDataSP = boost::shared_ptr<MonitorData>;
 
 enum class ActiveView {
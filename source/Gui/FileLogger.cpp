@@ -25,5 +25,10 @@ FileLogger::~FileLogger()
 
 void FileLogger::newLogMessage(Priority priority, std::string const& message)
 {
-    _outfile << message << std::endl;
+    _outfile << message << '\n';
+}
+
+void FileLogger::flush()
+{
+    _outfile.flush();
 }
@@ -19,9 +19,13 @@ GuiLogger::~GuiLogger()
     loggingService->unregisterCallBack(this);
 }
 
+//called from the logging thread
 void GuiLogger::newLogMessage(Priority priority, std::string const& message)
 {
-    if (Priority::Important == priority) {
-        _view->setNewLogMessage(message);
-    }
+    QMetaObject::invokeMethod(this, [this, message] { _view->setNewLogMessage(message); }, Qt::QueuedConnection);
+}
+
+Priority GuiLogger::getMinPriority() const
+{
+    return Priority::Important;
 }
@@ -15,6 +15,7 @@ public:
     virtual ~GuiLogger();
 
     void newLogMessage(Priority priority, std::string const& message) override;
+    Priority getMinPriority() const override;
 
 private:
     LoggingView* _view = nullptr;
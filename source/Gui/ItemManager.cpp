@@ -4,6 +4,7 @@
 
 #include "EngineInterface/ChangeDescriptions.h"
 #include "Gui/Settings.h"
+#include "Gui/DataChangeSet.h"
 #include "Gui/DataRepository.h"
 #include "Gui/ViewportInterface.h"
 
@@ -11,6 +12,7 @@
 #include "CellItem.h"
 #include "ParticleItem.h"
 #include "CellConnectionItem.h"
+#include "ClusterItem.h"
 #include "CoordinateSystem.h"
 #include "MarkerItem.h"
 
@@ -29,149 +31,425 @@ void ItemManager::init(QGraphicsScene * scene, ViewportInterface* viewport, Simu
 void ItemManager::activate(IntVector2D size)
 {
     TRY;
+    //scene deletes all items including the pooled ones
     _scene->clear();
 	_scene->setSceneRect(0, 0, CoordinateSystem::modelToScene(size.x), CoordinateSystem::modelToScene(size.y));
 	_cellsByIds.clear();
 	_particlesByIds.clear();
+	_clustersByIds.clear();
 	_connectionsByIds.clear();
+	_cellItemPool.clear();
+	_particleItemPool.clear();
+	_clusterItemPool.clear();
+	_completeUpdateRequired = true;
     CATCH;
 }
 
-void ItemManager::updateCells(DataRepository* dataController)
+void ItemManager::updateCells(DataRepository* repository)
 {
     TRY;
-	auto const &data = dataController->getDataRef();
+	auto const &data = repository->getDataRef();
 
-	map<uint64_t, CellItem*> newCellsByIds;
 	if (data.clusters) {
 		for (auto const &cluster : *data.clusters) {
 			for (auto const &cell : *cluster.cells) {
-				auto it = _cellsByIds.find(cell.id);
+				if (!isWithinViewport(*cell.pos)) {
+					continue;
+				}
 				CellItem* item;
+				auto it = _cellsByIds.find(cell.id);
 				if (it != _cellsByIds.end()) {
 					item = it->second;
 					item->update(cell);
-					newCellsByIds.insert_or_assign(cell.id, item);
-					_cellsByIds.erase(it);
-				}
-				else {
-					item = new CellItem(_config, cell);
-					_scene->addItem(item);
-					newCellsByIds[cell.id] = item;
-				}
-				if (dataController->isInSelection(cell.id)) {
-					item->setFocusState(CellItem::FOCUS_CELL);
-				}
-				else if (dataController->isInExtendedSelection(cell.id)) {
-					item->setFocusState(CellItem::FOCUS_CLUSTER);
 				}
 				else {
-					item->setFocusState(CellItem::NO_FOCUS);
+					if (!isItemCreationAllowed()) {
+						continue;
+					}
+					item = acquireItem(_cellItemPool, cell, [&] { return new CellItem(_config, cell); });
+					_cellsByIds.emplace(cell.id, item);
 				}
+				item->setUpdateNumber(_updateNumber);
+				updateFocusState(item, repository);
 			}
 		}
 	}
-	for (auto const& cellById : _cellsByIds) {
-		delete cellById.second;
-	}
-	_cellsByIds = newCellsByIds;
+	releaseUntouchedItems(_cellItemPool, _cellsByIds);
     CATCH;
 }
 
-void ItemManager::updateParticles(DataRepository* manipulator)
+void ItemManager::updateParticles(DataRepository* repository)
 {
     TRY;
-    auto const& data = manipulator->getDataRef();
+    auto const& data = repository->getDataRef();
 
-	map<uint64_t, ParticleItem*> newParticlesByIds;
 	if (data.particles) {
 		for (auto const &particle : *data.particles) {
-			auto it = _particlesByIds.find(particle.id);
+			if (!isWithinViewport(*particle.pos)) {
+				continue;
+			}
 			ParticleItem* item;
+			auto it = _particlesByIds.find(particle.id);
 			if (it != _particlesByIds.end()) {
 				item = it->second;
 				item->update(particle);
-				newParticlesByIds.insert_or_assign(particle.id, item);
-				_particlesByIds.erase(it);
 			}
 			else {
-				item = new ParticleItem(_config, particle);
-				_scene->addItem(item);
-				newParticlesByIds.insert_or_assign(particle.id, item);
+				if (!isItemCreationAllowed()) {
+					continue;
+				}
+				item = acquireItem(_particleItemPool, particle, [&] { return new ParticleItem(_config, particle); });
+				_particlesByIds.emplace(particle.id, item);
 			}
-			if (manipulator->isInSelection(particle.id)) {
-				item->setFocusState(ParticleItem::FOCUS);
+			item->setUpdateNumber(_updateNumber);
+			updateFocusState(item, repository);
+		}
+	}
+	releaseUntouchedItems(_particleItemPool, _particlesByIds);
+    CATCH;
+}
+
+void ItemManager::updateConnections(DataRepository* repository)
+{
+    TRY;
+	deleteAllConnections();
+
+	//connections are needed if at least one of their cells is represented by an item
+	for (auto const& cellById : _cellsByIds) {
+		auto const& cell = repository->getCellDescRef(cellById.first);
+		if (!cell.connectingCells) {
+			continue;
+		}
+		for (uint64_t connectingCellId : *cell.connectingCells) {
+			if (repository->isCellPresent(connectingCellId)) {
+				addConnection(cell, repository->getCellDescRef(connectingCellId));
+			}
+		}
+	}
+    CATCH;
+}
+
+void ItemManager::updateClusters(DataRepository* repository)
+{
+    TRY;
+	auto const &data = repository->getDataRef();
+
+	if (data.clusters) {
+		for (auto const &cluster : *data.clusters) {
+			if (!cluster.cells || cluster.cells->empty()) {
+				continue;
+			}
+			if (!isWithinViewport(cluster.pos ? *cluster.pos : *cluster.cells->front().pos)) {
+				continue;
+			}
+			ClusterItem* item;
+			auto it = _clustersByIds.find(cluster.id);
+			if (it != _clustersByIds.end()) {
+				item = it->second;
+				item->update(cluster);
 			}
 			else {
-				item->setFocusState(ParticleItem::NO_FOCUS);
+				if (!isItemCreationAllowed()) {
+					continue;
+				}
+				item = acquireItem(_clusterItemPool, cluster, [&] { return new ClusterItem(cluster); });
+				_clustersByIds.emplace(cluster.id, item);
 			}
+			item->setUpdateNumber(_updateNumber);
+			updateFocusState(item, repository);
 		}
 	}
-	for (auto const& particleById : _particlesByIds) {
-		delete particleById.second;
-	}
-	_particlesByIds = newParticlesByIds;
+	releaseUntouchedItems(_clusterItemPool, _clustersByIds);
     CATCH;
 }
 
-void ItemManager::updateConnections(DataRepository* repository)
+void ItemManager::updateCellsIncrementally(DataRepository* repository, DataChangeSet const& changes)
 {
     TRY;
-    auto const& data = repository->getDataRef();
-	if (!data.clusters) {
-		return;
+	for (auto const& cellId : changes.removedCellIds) {
+		auto it = _cellsByIds.find(cellId);
+		if (it != _cellsByIds.end()) {
+			releaseItem(_cellItemPool, it->second);
+			_cellsByIds.erase(it);
+		}
 	}
+	for (auto const* cellIds : { &changes.addedCellIds, &changes.modifiedCellIds }) {
+		for (auto const& cellId : *cellIds) {
+			auto it = _cellsByIds.find(cellId);
+			if (!repository->isCellPresent(cellId) || !isWithinViewport(*repository->getCellDescRef(cellId).pos)) {
+				if (it != _cellsByIds.end()) {
+					releaseItem(_cellItemPool, it->second);
+					_cellsByIds.erase(it);
+				}
+				continue;
+			}
+			auto const& cell = repository->getCellDescRef(cellId);
+			CellItem* item;
+			if (it != _cellsByIds.end()) {
+				item = it->second;
+				item->update(cell);
+			}
+			else {
+				if (!isItemCreationAllowed()) {
+					continue;
+				}
+				item = acquireItem(_cellItemPool, cell, [&] { return new CellItem(_config, cell); });
+				_cellsByIds.emplace(cellId, item);
+			}
+			updateFocusState(item, repository);
+		}
+	}
+    CATCH;
+}
 
-	map<set<uint64_t>, CellConnectionItem*> newConnectionsByIds;
-	for (auto const &cluster : *data.clusters) {
-		for (auto const &cell : *cluster.cells) {
+void ItemManager::updateConnectionsIncrementally(DataRepository* repository, DataChangeSet const& changes)
+{
+    TRY;
+	//connections of all affected cells are recreated
+	for (auto const* cellIds : { &changes.removedCellIds, &changes.addedCellIds, &changes.modifiedCellIds }) {
+		for (auto const& cellId : *cellIds) {
+			deleteConnections(cellId);
+		}
+	}
+	for (auto const* cellIds : { &changes.addedCellIds, &changes.modifiedCellIds }) {
+		for (auto const& cellId : *cellIds) {
+			if (!repository->isCellPresent(cellId)) {
+				continue;
+			}
+			auto const& cell = repository->getCellDescRef(cellId);
 			if (!cell.connectingCells) {
 				continue;
 			}
+			auto const hasItem = _cellsByIds.find(cellId) != _cellsByIds.end();
 			for (uint64_t connectingCellId : *cell.connectingCells) {
-				if (!repository->isCellPresent(connectingCellId)) {
+				if (!hasItem && _cellsByIds.find(connectingCellId) == _cellsByIds.end()) {
 					continue;
 				}
-				auto &connectingCellD = repository->getCellDescRef(connectingCellId);
-				set<uint64_t> connectionId;
-				connectionId.insert(cell.id);
-				connectionId.insert(connectingCellId);
-				if (newConnectionsByIds.find(connectionId) != newConnectionsByIds.end()) {
-					continue;
+				if (repository->isCellPresent(connectingCellId)) {
+					addConnection(cell, repository->getCellDescRef(connectingCellId));
 				}
-				//update may lead to exception in rare cases (Qt bug?)
-/*
-				auto connectionIt = _connectionsByIds.find(connectionId);
-				if (connectionIt != _connectionsByIds.end()) {
-					CellConnectionItem* connection = connectionIt->second;
-					connection->update(cell, connectingCellD);
-					newConnectionsByIds[connectionId] = connection;
-					_connectionsByIds.erase(connectionIt);
+			}
+		}
+	}
+    CATCH;
+}
+
+void ItemManager::updateParticlesIncrementally(DataRepository* repository, DataChangeSet const& changes)
+{
+    TRY;
+	for (auto const& particleId : changes.removedParticleIds) {
+		auto it = _particlesByIds.find(particleId);
+		if (it != _particlesByIds.end()) {
+			releaseItem(_particleItemPool, it->second);
+			_particlesByIds.erase(it);
+		}
+	}
+	for (auto const* particleIds : { &changes.addedParticleIds, &changes.modifiedParticleIds }) {
+		for (auto const& particleId : *particleIds) {
+			auto it = _particlesByIds.find(particleId);
+			if (!repository->isParticlePresent(particleId)
+				|| !isWithinViewport(*repository->getParticleDescRef(particleId).pos)) {
+				if (it != _particlesByIds.end()) {
+					releaseItem(_particleItemPool, it->second);
+					_particlesByIds.erase(it);
 				}
-				else {
-*/
-					CellConnectionItem* newConnection = new CellConnectionItem(_config, cell, connectingCellD);
-					_scene->addItem(newConnection);
-					newConnectionsByIds[connectionId] = newConnection;
-/*
+				continue;
+			}
+			auto const& particle = repository->getParticleDescRef(particleId);
+			ParticleItem* item;
+			if (it != _particlesByIds.end()) {
+				item = it->second;
+				item->update(particle);
+			}
+			else {
+				if (!isItemCreationAllowed()) {
+					continue;
 				}
-*/
+				item = acquireItem(_particleItemPool, particle, [&] { return new ParticleItem(_config, particle); });
+				_particlesByIds.emplace(particleId, item);
 			}
+			updateFocusState(item, repository);
 		}
 	}
+    CATCH;
+}
+
+void ItemManager::updateFocusState(CellItem* item, DataRepository* repository) const
+{
+	auto const cellId = item->getId();
+	if (repository->isInSelection(cellId)) {
+		item->setFocusState(CellItem::FOCUS_CELL);
+	}
+	else if (repository->isInExtendedSelection(cellId)) {
+		item->setFocusState(CellItem::FOCUS_CLUSTER);
+	}
+	else {
+		item->setFocusState(CellItem::NO_FOCUS);
+	}
+}
+
+void ItemManager::updateFocusState(ParticleItem* item, DataRepository* repository) const
+{
+	if (repository->isInSelection(item->getId())) {
+		item->setFocusState(ParticleItem::FOCUS);
+	}
+	else {
+		item->setFocusState(ParticleItem::NO_FOCUS);
+	}
+}
+
+void ItemManager::updateFocusState(ClusterItem* item, DataRepository* repository) const
+{
+	auto const& cellIds = item->getCellIds();
+	if (!cellIds.empty() && repository->isInExtendedSelection(cellIds.front())) {
+		item->setFocusState(ClusterItem::FOCUS);
+	}
+	else {
+		item->setFocusState(ClusterItem::NO_FOCUS);
+	}
+}
+
+void ItemManager::addConnection(CellDescription const& cell1, CellDescription const& cell2)
+{
+	auto const connectionId = std::make_pair(cell1.id, cell2.id);
+	if (_connectionsByIds.find(connectionId) != _connectionsByIds.end()) {
+		return;
+	}
+	//update may lead to exception in rare cases (Qt bug?), thus connections are always recreated
+	auto connection = new CellConnectionItem(_config, cell1, cell2);
+	_scene->addItem(connection);
+	_connectionsByIds.insert_or_assign(connectionId, connection);
+	_connectionsByIds.insert_or_assign(std::make_pair(cell2.id, cell1.id), connection);
+}
+
+void ItemManager::deleteConnections(uint64_t cellId)
+{
+	auto it = _connectionsByIds.lower_bound(std::make_pair(cellId, uint64_t(0)));
+	while (it != _connectionsByIds.end() && it->first.first == cellId) {
+		delete it->second;
+		_connectionsByIds.erase(std::make_pair(it->first.second, cellId));
+		it = _connectionsByIds.erase(it);
+	}
+}
+
+void ItemManager::deleteAllConnections()
+{
 	for (auto const& connectionById : _connectionsByIds) {
-		delete connectionById.second;
+		if (connectionById.first.first < connectionById.first.second) {
+			delete connectionById.second;
+		}
+	}
+	_connectionsByIds.clear();
+}
+
+bool ItemManager::isWithinViewport(QVector2D const& pos) const
+{
+	return _viewportRect.contains(pos.x(), pos.y());
+}
+
+bool ItemManager::isItemCreationAllowed()
+{
+	if (_remainingItemCreations > 0) {
+		--_remainingItemCreations;
+		return true;
+	}
+	_updatePending = true;
+	_completeUpdateRequired = true;
+	return false;
+}
+
+template<typename Item, typename Description, typename CreateItemFunc>
+Item* ItemManager::acquireItem(vector<Item*>& pool, Description const& desc, CreateItemFunc const& createItem)
+{
+	if (!pool.empty()) {
+		auto item = pool.back();
+		pool.pop_back();
+		item->update(desc);
+		item->show();
+		return item;
+	}
+	auto item = createItem();
+	_scene->addItem(item);
+	return item;
+}
+
+template<typename Item>
+void ItemManager::releaseItem(vector<Item*>& pool, Item* item)
+{
+	if (static_cast<int>(pool.size()) < Const::MaxPooledItems) {
+		item->hide();
+		pool.push_back(item);
+	}
+	else {
+		delete item;
 	}
-	_connectionsByIds = newConnectionsByIds;
-    CATCH;
 }
 
-void ItemManager::update(DataRepository* repository)
+template<typename Item>
+void ItemManager::releaseAllItems(vector<Item*>& pool, unordered_map<uint64_t, Item*>& itemsByIds)
+{
+	for (auto const& itemById : itemsByIds) {
+		releaseItem(pool, itemById.second);
+	}
+	itemsByIds.clear();
+}
+
+template<typename Item>
+void ItemManager::releaseUntouchedItems(vector<Item*>& pool, unordered_map<uint64_t, Item*>& itemsByIds)
+{
+	for (auto it = itemsByIds.begin(); it != itemsByIds.end();) {
+		if (it->second->getUpdateNumber() != _updateNumber) {
+			releaseItem(pool, it->second);
+			it = itemsByIds.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+void ItemManager::update(DataRepository* repository, DataChangeSet const& changes)
 {
     TRY;
-    updateCells(repository);
-	updateConnections(repository);
-	updateParticles(repository);
+	auto const margin = Const::ItemViewportMargin;
+	_viewportRect = _viewport->getRect().adjusted(-margin, -margin, margin, margin);
+	_remainingItemCreations = Const::MaxItemCreationsPerUpdate;
+	_updatePending = false;
+
+	auto const completeUpdate = changes.all || _completeUpdateRequired;
+	_completeUpdateRequired = false;
+	if (completeUpdate || _showClusterItems) {
+		++_updateNumber;
+	}
+
+	if (_showClusterItems) {
+		if (!_cellsByIds.empty() || !_connectionsByIds.empty()) {
+			deleteAllConnections();
+			releaseAllItems(_cellItemPool, _cellsByIds);
+		}
+
+		//cluster items are few in number, thus they are always updated completely
+		updateClusters(repository);
+	}
+	else {
+		if (!_clustersByIds.empty()) {
+			releaseAllItems(_clusterItemPool, _clustersByIds);
+		}
+		if (completeUpdate) {
+			updateCells(repository);
+			updateConnections(repository);
+		}
+		else {
+			updateCellsIncrementally(repository, changes);
+			updateConnectionsIncrementally(repository, changes);
+		}
+	}
+	if (completeUpdate) {
+		updateParticles(repository);
+	}
+	else {
+		updateParticlesIncrementally(repository, changes);
+	}
     CATCH;
 }
 
@@ -220,7 +498,31 @@ bool ItemManager::isMarkerActive() const
 QList<QGraphicsItem*> ItemManager::getItemsWithinMarker() const
 {
     TRY;
-    return _marker->collidingItems();
+    QList<QGraphicsItem*> result;
+    for (auto const& item : _marker->collidingItems()) {
+        if (item->isVisible()) {
+            result.push_back(item);
+        }
+    }
+    return result;
+    CATCH;
+}
+
+void ItemManager::setZoomFactor(double zoomFactor)
+{
+    TRY;
+    auto const showClusterItems = zoomFactor < Const::ZoomLevelForClusterItems;
+    if (showClusterItems != _showClusterItems) {
+        _showClusterItems = showClusterItems;
+        _completeUpdateRequired = true;
+    }
+    CATCH;
+}
+
+bool ItemManager::isUpdatePending() const
+{
+    TRY;
+    return _updatePending;
     CATCH;
 }
 
@@ -16,7 +16,7 @@ public:
 	virtual void init(QGraphicsScene* scene, ViewportInterface* viewport, SimulationParameters const& parameters);
 
 	virtual void activate(IntVector2D size);
-	virtual void update(DataRepository* visualDesc);
+	virtual void update(DataRepository* repository, DataChangeSet const& changes);
 
 	virtual void setMarkerItem(QPointF const &upperLeft, QPointF const &lowerRight);
 	virtual void setMarkerLowerRight(QPointF const &lowerRight);
@@ -26,19 +26,63 @@ public:
 
 	virtual void toggleCellInfo(bool showInfo);
 
+	//clusters are represented by single items below Const::ZoomLevelForClusterItems
+	virtual void setZoomFactor(double zoomFactor);
+
+	//true if not all items within the viewport could be created due to the per-update budget
+	virtual bool isUpdatePending() const;
+
 private:
 	void updateCells(DataRepository* visualDesc);
 	void updateConnections(DataRepository* visualDesc);
 	void updateParticles(DataRepository* visualDesc);
+
+	void updateCellsIncrementally(DataRepository* repository, DataChangeSet const& changes);
+	void updateConnectionsIncrementally(DataRepository* repository, DataChangeSet const& changes);
+	void updateParticlesIncrementally(DataRepository* repository, DataChangeSet const& changes);
+
+	void updateClusters(DataRepository* repository);
+
+	void updateFocusState(CellItem* item, DataRepository* repository) const;
+	void updateFocusState(ParticleItem* item, DataRepository* repository) const;
+	void updateFocusState(ClusterItem* item, DataRepository* repository) const;
+	void addConnection(CellDescription const& cell1, CellDescription const& cell2);
+	void deleteConnections(uint64_t cellId);
+	void deleteAllConnections();
+
+	bool isWithinViewport(QVector2D const& pos) const;
+	bool isItemCreationAllowed();
+
+	template<typename Item, typename Description, typename CreateItemFunc>
+	Item* acquireItem(vector<Item*>& pool, Description const& desc, CreateItemFunc const& createItem);
+	template<typename Item>
+	void releaseItem(vector<Item*>& pool, Item* item);
+	template<typename Item>
+	void releaseAllItems(vector<Item*>& pool, unordered_map<uint64_t, Item*>& itemsByIds);
+	template<typename Item>
+	void releaseUntouchedItems(vector<Item*>& pool, unordered_map<uint64_t, Item*>& itemsByIds);
 		
 	QGraphicsScene* _scene = nullptr;
 	ViewportInterface* _viewport = nullptr;
 	SimulationParameters _parameters;
 	ItemConfig* _config = nullptr;
 
-	map<uint64_t, CellItem*> _cellsByIds;
-	map<uint64_t, ParticleItem*> _particlesByIds;
-	map<set<uint64_t>, CellConnectionItem*> _connectionsByIds;
+	unordered_map<uint64_t, CellItem*> _cellsByIds;
+	unordered_map<uint64_t, ParticleItem*> _particlesByIds;
+	unordered_map<uint64_t, ClusterItem*> _clustersByIds;
+	map<pair<uint64_t, uint64_t>, CellConnectionItem*> _connectionsByIds;	//contains each connection in both directions
+
+	//hidden items which can be reused
+	vector<CellItem*> _cellItemPool;
+	vector<ParticleItem*> _particleItemPool;
+	vector<ClusterItem*> _clusterItemPool;
+
+	int _updateNumber = 0;	//items not stamped with the current number during a complete update are released
+	QRectF _viewportRect;
+	int _remainingItemCreations = 0;
+	bool _updatePending = false;
+	bool _showClusterItems = false;
+	bool _completeUpdateRequired = true;
 	MarkerItem* _marker = nullptr;
 };
 
@@ -5,6 +5,7 @@
 #include <QMatrix4x4>
 #include <QScrollBar>
 #include <QResizeEvent>
+#include <QTimer>
 
 #include "Base/ServiceLocator.h"
 #include "Base/Definitions.h"
@@ -22,6 +23,7 @@
 #include "ItemWorldController.h"
 #include "CellItem.h"
 #include "ParticleItem.h"
+#include "ClusterItem.h"
 #include "ItemManager.h"
 #include "CoordinateSystem.h"
 #include "ItemViewport.h"
@@ -130,6 +132,7 @@ void ItemWorldController::setZoomFactor(double zoomFactor)
 {
     TRY;
     _zoomFactor = zoomFactor;
+    _itemManager->setZoomFactor(zoomFactor);
     auto graphicsView = _simulationViewWidget->getGraphicsView();
     graphicsView->resetTransform();
     graphicsView->scale(CoordinateSystem::sceneToModel(_zoomFactor), CoordinateSystem::sceneToModel(_zoomFactor));
@@ -221,7 +224,8 @@ namespace
     bool clickedOnSpace(QList<QGraphicsItem*> const& items)
     {
         for (auto item : items) {
-            if (qgraphicsitem_cast<CellItem*>(item) || qgraphicsitem_cast<ParticleItem*>(item)) {
+            if (qgraphicsitem_cast<CellItem*>(item) || qgraphicsitem_cast<ParticleItem*>(item)
+                || qgraphicsitem_cast<ClusterItem*>(item)) {
                 return false;
             }
         }
@@ -323,13 +327,29 @@ void ItemWorldController::centerSelectionIfEnabled()
 }
 
 void ItemWorldController::updateItems()
+{
+    TRY;
+    updateItems(_repository->takeChanges(Receiver::VisualEditor));
+    CATCH;
+}
+
+void ItemWorldController::updateItems(DataChangeSet const& changes)
 {
     TRY;
     auto graphicsView = _simulationViewWidget->getGraphicsView();
     graphicsView->setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
-    _itemManager->update(_repository);
+    _itemManager->update(_repository, changes);
     graphicsView->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
     _scene->update();
+
+    //remaining items are created in the next event loop cycles in order to keep the GUI responsive
+    if (_itemManager->isUpdatePending() && !_itemUpdateScheduled) {
+        _itemUpdateScheduled = true;
+        QTimer::singleShot(0, this, [this] {
+            _itemUpdateScheduled = false;
+            updateItems();
+        });
+    }
     CATCH;
 }
 
@@ -351,7 +371,10 @@ void ItemWorldController::cellInfoToggled(bool showInfo)
     TRY;
     _itemManager->toggleCellInfo(showInfo);
 	if (!_connections.empty()) {
-        updateItems();
+
+        //appearance of all items changes
+        _repository->takeChanges(Receiver::VisualEditor);
+        updateItems(DataChangeSet::createAll());
 	}
     CATCH;
 }
@@ -380,9 +403,16 @@ ItemWorldController::Selection ItemWorldController::getSelectionFromItems(QList<
     TRY;
     ItemWorldController::Selection result;
 	for (auto item : items) {
+		if (!item->isVisible()) {
+			continue;
+		}
 		if (auto cellItem = qgraphicsitem_cast<CellItem*>(item)) {
 			result.cellIds.push_back(cellItem->getId());
 		}
+		if (auto clusterItem = qgraphicsitem_cast<ClusterItem*>(item)) {
+			auto const& cellIds = clusterItem->getCellIds();
+			result.cellIds.insert(result.cellIds.end(), cellIds.begin(), cellIds.end());
+		}
 		if (auto particleItem = qgraphicsitem_cast<ParticleItem*>(item)) {
 			result.particleIds.push_back(particleItem->getId());
 		}
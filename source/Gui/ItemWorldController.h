@@ -59,6 +59,7 @@ private:
 	boost::optional<QVector2D> getCenterPosOfSelection() const;
 	void centerSelectionIfEnabled();
     void updateItems();
+    void updateItems(DataChangeSet const& changes);
 
 	Q_SLOT void receivedNotifications(set<Receiver> const& targets);
 	Q_SLOT void cellInfoToggled(bool showInfo);
@@ -92,4 +93,5 @@ private:
 	bool _mouseButtonPressed = true;
 	bool _centerSelection = false;
     bool _dataRequested = false;
+    bool _itemUpdateScheduled = false;
 };
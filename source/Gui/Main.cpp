@@ -9,6 +9,7 @@
 #include "Base/GlobalFactory.h"
 #include "Base/NumberGenerator.h"
 #include "Base/BaseServices.h"
+#include "Base/EventLog.h"
 #include "Base/Exceptions.h"
 #include "EngineInterface/SimulationAccess.h"
 #include "EngineInterface/EngineInterfaceBuilderFacade.h"
@@ -40,6 +41,19 @@ int main(int argc, char* argv[])
     FileLogger fileLogger;
     BugReportLogger bugReportLogger;
 
+    auto const eventLogFilename =
+        GuiSettings::getSettingsValue(Const::EventLogFilenameKey, Const::EventLogFilenameDefault);
+    if (!eventLogFilename.empty()) {
+        EventLog::Config config;
+        config.baseFilename = eventLogFilename;
+        config.numSegments =
+            GuiSettings::getSettingsValue(Const::EventLogNumSegmentsKey, Const::EventLogNumSegmentsDefault);
+        if (!ServiceLocator::getInstance().getService<EventLog>()->open(config)) {
+            auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+            loggingService->logMessage(Priority::Important, "Event log could not be created: " + eventLogFilename);
+        }
+    }
+
     MainController controller;
 
     try {
@@ -30,6 +30,7 @@
 #include "EngineGpu/EngineGpuBuilderFacade.h"
 #include "EngineGpu/EngineGpuData.h"
 #include "EngineGpu/SimulationMonitorGpu.h"
+#include "EngineGpu/SpatialStatisticsRecorderGpu.h"
 
 #include "Web/WebAccess.h"
 #include "Web/WebBuilderFacade.h"
@@ -293,6 +294,8 @@ void MainController::initSimulation(SymbolTable* symbolTable, SimulationParamete
 
 	auto simMonitor = _monitorBuildFunc(_simController);
 	SET_CHILD(_simMonitor, simMonitor);
+    initSpatialStatisticsRecorder();
+    initSpeciesCensus();
 
     auto webSimMonitor = _monitorBuildFunc(_simController);
     auto space = context->getSpaceProperties();
@@ -316,6 +319,51 @@ void MainController::initSimulation(SymbolTable* symbolTable, SimulationParamete
 	_view->initSimulation(_simController, _accessBuildFunc(_simController));
 }
 
+void MainController::initSpatialStatisticsRecorder()
+{
+    if (_spatialStatisticsRecorder) {
+        _spatialStatisticsRecorder->deleteLater();
+        _spatialStatisticsRecorder = nullptr;
+    }
+
+    auto const filename =
+        GuiSettings::getSettingsValue(Const::SpatialStatisticsFilenameKey, Const::SpatialStatisticsFilenameDefault);
+    auto controllerGpu = dynamic_cast<SimulationControllerGpu*>(_simController);
+    if (filename.empty() || !controllerGpu) {
+        return;
+    }
+    SpatialStatisticsRecorderGpu::Config config;
+    config.gridSize = {
+        GuiSettings::getSettingsValue(Const::SpatialStatisticsGridSizeXKey, Const::SpatialStatisticsGridSizeXDefault),
+        GuiSettings::getSettingsValue(Const::SpatialStatisticsGridSizeYKey, Const::SpatialStatisticsGridSizeYDefault)};
+    config.interval =
+        GuiSettings::getSettingsValue(Const::SpatialStatisticsIntervalKey, Const::SpatialStatisticsIntervalDefault);
+    config.filename = filename;
+
+    auto facade = ServiceLocator::getInstance().getService<EngineGpuBuilderFacade>();
+    _spatialStatisticsRecorder = facade->buildSpatialStatisticsRecorder();
+    _spatialStatisticsRecorder->setParent(this);
+    _spatialStatisticsRecorder->init(controllerGpu, config);
+}
+
+void MainController::initSpeciesCensus()
+{
+    auto const filename =
+        GuiSettings::getSettingsValue(Const::SpeciesCensusFilenameKey, Const::SpeciesCensusFilenameDefault);
+    if (filename.empty()) {
+        _dataAnalyzer->stopCensus();
+        return;
+    }
+    DataAnalyzer::CensusConfig config;
+    config.interval =
+        GuiSettings::getSettingsValue(Const::SpeciesCensusIntervalKey, Const::SpeciesCensusIntervalDefault);
+    config.census.minNumCells =
+        GuiSettings::getSettingsValue(Const::SpeciesCensusMinNumCellsKey, Const::SpeciesCensusMinNumCellsDefault);
+    config.census.speciesTableFilename = filename + ".species.csv";
+    config.census.countsFilename = filename + ".counts.csv";
+    _dataAnalyzer->startCensus(_simController, _accessBuildFunc(_simController), config);
+}
+
 void MainController::recreateSimulation(SerializedSimulation const & serializedSimulation)
 {
     auto ptr = _simController;
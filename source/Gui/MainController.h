@@ -3,6 +3,7 @@
 
 #include "EngineInterface/Definitions.h"
 
+#include "EngineGpu/Definitions.h"
 #include "Web/Definitions.h"
 
 #include "Jobs.h"
@@ -45,6 +46,8 @@ public:
 private:
     void logStart();
 	void initSimulation(SymbolTable* symbolTable, SimulationParameters const& parameters);
+    void initSpatialStatisticsRecorder();
+    void initSpeciesCensus();
     void recreateSimulation(SerializedSimulation const& serializedSimulation);
 	void connectSimController() const;
 	void addRandomEnergy(double amount);
@@ -62,6 +65,7 @@ private:
 
 	SimulationController* _simController = nullptr;
 	SimulationMonitor* _simMonitor = nullptr;
+    SpatialStatisticsRecorderGpu* _spatialStatisticsRecorder = nullptr;
 
     SimulationChanger* _simChanger = nullptr;
     list<QMetaObject::Connection> _simChangerConnections;
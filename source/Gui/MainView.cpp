@@ -238,6 +238,7 @@ void MainView::setupMenuAndToolbar()
     ui->menuView->addAction(actions->actionZoomIn);
     ui->menuView->addAction(actions->actionZoomOut);
     ui->menuView->addAction(actions->actionDisplayLink);
+    ui->menuView->addAction(actions->actionMinimap);
     ui->menuView->addSeparator();
     auto visualEffects = new QMenu("Visual effects", this);
     visualEffects->addAction(actions->actionGlowEffect);
@@ -0,0 +1,88 @@
+#include "MinimapWidget.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+
+#include "Settings.h"
+
+MinimapWidget::MinimapWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setCursor(Qt::PointingHandCursor);
+}
+
+void MinimapWidget::setUniverseSize(IntVector2D const& universeSize)
+{
+    _universeSize = universeSize;
+    if (universeSize.x <= 0 || universeSize.y <= 0) {
+        return;
+    }
+    if (universeSize.x >= universeSize.y) {
+        setFixedSize(Const::MinimapSize, std::max(1, Const::MinimapSize * universeSize.y / universeSize.x));
+    } else {
+        setFixedSize(std::max(1, Const::MinimapSize * universeSize.x / universeSize.y), Const::MinimapSize);
+    }
+}
+
+void MinimapWidget::setImage(QImage const& image)
+{
+    _image = image;
+    update();
+}
+
+void MinimapWidget::setViewRect(RealRect const& worldRect)
+{
+    _viewRect = worldRect;
+    update();
+}
+
+void MinimapWidget::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Const::BackgroundColor);
+    if (!_image.isNull()) {
+        painter.drawImage(QPoint(0, 0), _image);
+    }
+
+    auto const scale = getScale();
+    QRectF viewRect(
+        _viewRect.p1.x * scale,
+        _viewRect.p1.y * scale,
+        (_viewRect.p2.x - _viewRect.p1.x) * scale,
+        (_viewRect.p2.y - _viewRect.p1.y) * scale);
+    painter.setPen(Const::MinimapViewRectColor);
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(viewRect.intersected(QRectF(rect()).adjusted(0, 0, -1, -1)));
+    painter.drawRect(QRectF(rect()).adjusted(0, 0, -1, -1));
+}
+
+void MinimapWidget::mousePressEvent(QMouseEvent* event)
+{
+    if (event->buttons() == Qt::LeftButton) {
+        Q_EMIT centerRequested(mapWidgetToWorldPosition(event->pos()));
+    }
+}
+
+void MinimapWidget::mouseMoveEvent(QMouseEvent* event)
+{
+    if (event->buttons() == Qt::LeftButton) {
+        Q_EMIT centerRequested(mapWidgetToWorldPosition(event->pos()));
+    }
+}
+
+float MinimapWidget::getScale() const
+{
+    if (_universeSize.x <= 0 || _universeSize.y <= 0) {
+        return 1.0f;
+    }
+    return std::min(toFloat(width()) / toFloat(_universeSize.x), toFloat(height()) / toFloat(_universeSize.y));
+}
+
+QVector2D MinimapWidget::mapWidgetToWorldPosition(QPoint const& pos) const
+{
+    auto const scale = getScale();
+    QVector2D result(toFloat(pos.x()) / scale, toFloat(pos.y()) / scale);
+    result.setX(std::max(0.0f, std::min(result.x(), toFloat(_universeSize.x))));
+    result.setY(std::max(0.0f, std::min(result.y(), toFloat(_universeSize.y))));
+    return result;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QImage>
+#include <QVector2D>
+#include <QWidget>
+
+#include "EngineInterface/Definitions.h"
+#include "Definitions.h"
+
+/**
+ * Overview of the whole world with the currently visible region. Clicking or dragging requests to center the view
+ * at the corresponding world position.
+ */
+class MinimapWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    MinimapWidget(QWidget* parent = nullptr);
+    virtual ~MinimapWidget() = default;
+
+    void setUniverseSize(IntVector2D const& universeSize);  //adapts the widget size to the aspect ratio
+    void setImage(QImage const& image);
+    void setViewRect(RealRect const& worldRect);
+
+    Q_SIGNAL void centerRequested(QVector2D const& worldPos);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+
+private:
+    float getScale() const;
+    QVector2D mapWidgetToWorldPosition(QPoint const& pos) const;
+
+    IntVector2D _universeSize;
+    QImage _image;
+    RealRect _viewRect;
+};
@@ -22,6 +22,7 @@
 #include "EngineInterface/SimulationController.h"
 #include "EngineInterface/SpaceProperties.h"
 
+#include "MinimapWidget.h"
 #include "Notifier.h"
 #include "Settings.h"
 #include "OpenGLWorldScene.h"
@@ -41,6 +42,11 @@ OpenGLWorldController::OpenGLWorldController(SimulationViewWidget* simulationVie
 */
 
     connect(&_updateViewTimer, &QTimer::timeout, this, &OpenGLWorldController::updateViewTimeout);
+    connect(&_densityUpdateTimer, &QTimer::timeout, this, &OpenGLWorldController::updateDensityMap);
+
+    _minimap = new MinimapWidget(graphicsView);
+    _minimap->hide();
+    connect(_minimap, &MinimapWidget::centerRequested, this, &OpenGLWorldController::minimapCenterRequested);
 }
 
 void OpenGLWorldController::init(
@@ -62,6 +68,15 @@ void OpenGLWorldController::init(
     }
     _scene->init(access, repository->getImageMutex());
     _scene->update();
+
+    auto const universeSize = _controller->getContext()->getSpaceProperties()->getSize();
+    _densityPyramid.init(universeSize, Const::DensityMapBinSize);
+    _densityUpdateRegion = 0;
+    _requestedDensityRect = boost::none;
+    _isDensityMapSuspended = false;
+    _minimap->setUniverseSize(universeSize);
+    _minimap->setImage(QImage());
+
     _scene->installEventFilter(this);
     _simulationViewWidget->getGraphicsView()->installEventFilter(this);
 }
@@ -70,6 +85,9 @@ void OpenGLWorldController::setSettings(SimulationViewSettings const& settings)
 {
     _settings = settings;
     _scene->setSettings(settings);
+    if (!_connections.empty()) {
+        _minimap->setVisible(settings.minimap);
+    }
 }
 
 void OpenGLWorldController::connectView()
@@ -85,9 +103,16 @@ void OpenGLWorldController::connectView()
         _simulationViewWidget, &SimulationViewWidget::scrolledX, this, &OpenGLWorldController::scrolledX));
     _connections.push_back(QObject::connect(
         _simulationViewWidget, &SimulationViewWidget::scrolledY, this, &OpenGLWorldController::scrolledY));
+    _connections.push_back(
+        connect(_access, &SimulationAccess::dataReadyToRetrieve, this, &OpenGLWorldController::densityDataReceived));
 
     auto graphicsView = _simulationViewWidget->getGraphicsView();
     _scene->resize({graphicsView->width(), graphicsView->height()});
+
+    _requestedDensityRect = boost::none;
+    _densityUpdateTimer.start(Const::DensityMapUpdateInterval);
+    updateMinimapGeometry();
+    _minimap->setVisible(_settings.minimap);
 }
 
 void OpenGLWorldController::disconnectView()
@@ -96,6 +121,9 @@ void OpenGLWorldController::disconnectView()
         disconnect(connection);
     }
     _connections.clear();
+
+    _densityUpdateTimer.stop();
+    _minimap->hide();
 }
 
 void OpenGLWorldController::refresh()
@@ -285,6 +313,7 @@ void OpenGLWorldController::resize(QResizeEvent* event)
     auto size = event->size();
     _scene->resize({size.width(), size.height()});
     updateScrollbars();
+    updateMinimapGeometry();
 }
 
 void OpenGLWorldController::receivedNotifications(set<Receiver> const& targets)
@@ -299,16 +328,22 @@ void OpenGLWorldController::receivedNotifications(set<Receiver> const& targets)
 void OpenGLWorldController::requestImage()
 {
     if (!_connections.empty()) {
-        auto graphicsView = _simulationViewWidget->getGraphicsView();
-        auto topLeft = mapViewToWorldPosition(QVector2D(0, 0));
-        auto bottomRight = mapViewToWorldPosition(QVector2D(graphicsView->width() - 1, graphicsView->height() - 1));
-        RealRect worldRect{RealVector2D(topLeft), RealVector2D(bottomRight)};
+        auto const worldRect = getVisibleWorldRect();
         auto sceneRect = _scene->sceneRect();
+        IntVector2D const imageSize{
+            static_cast<int>(sceneRect.width() + 0.5), static_cast<int>(sceneRect.height() + 0.5)};
+        _minimap->setViewRect(worldRect);
+
+        //far zoomed out views are drawn from the density map instead of the entities
+        if (_zoomFactor < Const::ZoomLevelForDensityRendering && _densityPyramid.isComplete()) {
+            QImage image(imageSize.x, imageSize.y, QImage::Format_RGBA8888);
+            _densityPyramid.render(worldRect, static_cast<float>(_zoomFactor), image);
+            _scene->setImage(image);
+            imageReady();
+            return;
+        }
         _repository->requireVectorImageFromSimulation(
-            worldRect,
-            _zoomFactor,
-            _scene->getImageResource(),
-            {static_cast<int>(sceneRect.width() + 0.5), static_cast<int>(sceneRect.height() + 0.5)});
+            worldRect, _zoomFactor, _scene->getImageResource(), imageSize);
     }
 }
 
@@ -346,6 +381,83 @@ void OpenGLWorldController::updateViewTimeout()
     }
 }
 
+void OpenGLWorldController::updateDensityMap()
+{
+    if (_requestedDensityRect) {
+        return;
+    }
+    if (!isDensityMapNeeded()) {
+        if (!_isDensityMapSuspended) {
+            _densityPyramid.init(_densityPyramid.getUniverseSize(), Const::DensityMapBinSize);
+            _densityUpdateRegion = 0;
+            _isDensityMapSuspended = true;
+        }
+        return;
+    }
+    _isDensityMapSuspended = false;
+
+    auto const interval =
+        _controller->getRun() ? Const::DensityMapUpdateIntervalWhileRunning : Const::DensityMapUpdateInterval;
+    if (_densityUpdateTimer.intervalAsDuration() != interval) {
+        _densityUpdateTimer.setInterval(interval);
+    }
+
+    //the world is refreshed band by band, band boundaries are aligned to the bins of the density map
+    auto const universeSize = _densityPyramid.getUniverseSize();
+    auto const binSize = Const::DensityMapBinSize;
+    auto const numBins = (universeSize.y + binSize - 1) / binSize;
+    auto const binsPerRegion =
+        std::max(1, (numBins + Const::DensityMapUpdateRegions - 1) / Const::DensityMapUpdateRegions);
+    if (_densityUpdateRegion * binsPerRegion >= numBins) {
+        _densityUpdateRegion = 0;
+    }
+    auto const startY = _densityUpdateRegion * binsPerRegion * binSize;
+    auto const endY = std::min(startY + binsPerRegion * binSize, universeSize.y);
+
+    _requestedDensityRect = IntRect{{0, startY}, {universeSize.x, endY}};
+    _access->requireData(*_requestedDensityRect, ResolveDescription());
+}
+
+void OpenGLWorldController::densityDataReceived()
+{
+    if (!_requestedDensityRect) {
+        return;
+    }
+    _densityPyramid.update(_access->retrieveData(), *_requestedDensityRect);
+    _requestedDensityRect = boost::none;
+    ++_densityUpdateRegion;
+
+    _minimap->setImage(_densityPyramid.renderOverview({_minimap->width(), _minimap->height()}));
+    if (_zoomFactor < Const::ZoomLevelForDensityRendering && !_controller->getRun()) {
+        requestImage();
+    }
+}
+
+void OpenGLWorldController::minimapCenterRequested(QVector2D const& worldPos)
+{
+    centerTo(worldPos);
+    requestImage();
+}
+
+void OpenGLWorldController::updateMinimapGeometry()
+{
+    auto graphicsView = _simulationViewWidget->getGraphicsView();
+    _minimap->move(graphicsView->width() - _minimap->width() - Const::MinimapMargin, Const::MinimapMargin);
+}
+
+bool OpenGLWorldController::isDensityMapNeeded() const
+{
+    return _minimap->isVisible() || _zoomFactor < Const::ZoomLevelForDensityRendering;
+}
+
+RealRect OpenGLWorldController::getVisibleWorldRect() const
+{
+    auto graphicsView = _simulationViewWidget->getGraphicsView();
+    auto topLeft = mapViewToWorldPosition(QVector2D(0, 0));
+    auto bottomRight = mapViewToWorldPosition(QVector2D(graphicsView->width() - 1, graphicsView->height() - 1));
+    return RealRect{RealVector2D(topLeft), RealVector2D(bottomRight)};
+}
+
 QVector2D OpenGLWorldController::mapViewToWorldPosition(QVector2D const& viewPos) const
 {
     auto graphicsView = _simulationViewWidget->getGraphicsView();
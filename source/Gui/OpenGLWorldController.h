@@ -5,11 +5,13 @@
 #include <QTimer>
 
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/DensityPyramid.h"
 #include "EngineInterface/Descriptions.h"
 #include "AbstractWorldController.h"
 #include "Definitions.h"
 
 class OpenGLWorldScene;
+class MinimapWidget;
 class QResizeEvent;
 class QOpenGLWidget;
 
@@ -53,6 +55,9 @@ protected:
 private:
     void centerTo(QVector2D const& worldPosition, IntVector2D const& viewPos);
     void updateScrollbars();
+    void updateMinimapGeometry();
+    bool isDensityMapNeeded() const;
+    RealRect getVisibleWorldRect() const;
 
     Q_SLOT void receivedNotifications(set<Receiver> const& targets);
     Q_SLOT void requestImage();
@@ -60,6 +65,9 @@ private:
     Q_SLOT void scrolledX(float centerX);
     Q_SLOT void scrolledY(float centerY);
     Q_SLOT void updateViewTimeout();
+    Q_SLOT void updateDensityMap();
+    Q_SLOT void densityDataReceived();
+    Q_SLOT void minimapCenterRequested(QVector2D const& worldPos);
 
     QVector2D mapViewToWorldPosition(QVector2D const& viewPos) const;
     QVector2D mapDeltaViewToDeltaWorldPosition(QVector2D const& viewPos) const;
@@ -78,6 +86,14 @@ private:
     QTimer _updateViewTimer;
     int _scheduledViewUpdates = 0;
 
+    //density map for low zoom levels and the minimap
+    DensityPyramid _densityPyramid;
+    MinimapWidget* _minimap = nullptr;
+    QTimer _densityUpdateTimer;
+    int _densityUpdateRegion = 0;
+    boost::optional<IntRect> _requestedDensityRect;
+    bool _isDensityMapSuspended = false;    //density map is discarded while neither the minimap nor the view needs it
+
     double _zoomFactor = 0.0;
     QVector2D _center;
 
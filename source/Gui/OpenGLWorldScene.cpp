@@ -2,6 +2,7 @@
 
 #include <QOpenGLShader>
 #include <QFile>
+#include <QImage>
 #include <QOpenGLFramebufferObject>
 
 #include "Base/Exceptions.h"
@@ -108,6 +109,15 @@ ImageResource OpenGLWorldScene::getImageResource() const
     return _imageResource;
 }
 
+void OpenGLWorldScene::setImage(QImage const& image)
+{
+    std::lock_guard<std::mutex> lock(*_mutex);
+    _context->makeCurrent(_surface);
+    m_texture->bind();
+    m_texture->setData(QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, image.constBits());
+    m_texture->release();
+}
+
 void OpenGLWorldScene::resize(IntVector2D const& size)
 {
     setSceneRect(0, 0, size.x, size.y);
@@ -33,6 +33,9 @@ public:
 
     ImageResource getImageResource() const;
 
+    //uploads an image rendered on the host, it has to match the scene size and the pixel layout of the GPU engine
+    void setImage(QImage const& image);
+
     void resize(IntVector2D const& size);
 
     void drawBackground(QPainter* painter, const QRectF& rect) override;
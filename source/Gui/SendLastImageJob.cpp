@@ -10,6 +10,7 @@
 
 #include "EngineInterface/SimulationAccess.h"
 
+#include "Web/ImageEncoder.h"
 #include "Web/WebAccess.h"
 
 SendLastImageJob::SendLastImageJob(
@@ -17,6 +18,8 @@ SendLastImageJob::SendLastImageJob(
     string const& currentToken,
     IntVector2D const& pos,
     IntVector2D const& size,
+    IntVector2D const& universeSize,
+    bool softwareRendering,
     SimulationAccess* simAccess,
     WebAccess* webAccess,
     QObject* parent)
@@ -25,10 +28,16 @@ SendLastImageJob::SendLastImageJob(
     , _currentToken(currentToken)
     , _pos(pos)
     , _size(size)
+    , _universeSize(universeSize)
+    , _softwareRendering(softwareRendering)
     , _simAccess(simAccess)
     , _webAccess(webAccess)
 {
-    connect(_simAccess, &SimulationAccess::imageReady, this, &SendLastImageJob::imageFromGpuReceived);
+    if (_softwareRendering) {
+        connect(_simAccess, &SimulationAccess::dataReadyToRetrieve, this, &SendLastImageJob::dataFromSimulationReceived);
+    } else {
+        connect(_simAccess, &SimulationAccess::imageReady, this, &SendLastImageJob::imageFromGpuReceived);
+    }
     connect(_webAccess, &WebAccess::sendLastImageReceived, this, &SendLastImageJob::serverReceivedImage);
 }
 
@@ -44,6 +53,9 @@ void SendLastImageJob::process()
         requestImage();
         break;
     case State::ImageFromGpuRequested:
+        encodeImage();
+        break;
+    case State::ImageEncoded:
         sendImageToServer();
         break;
     case State::ImageToServerSent:
@@ -59,9 +71,10 @@ bool SendLastImageJob::isFinished() const
     return State::Finished == _state;
 }
 
-bool SendLastImageJob::isBlocking() const
+string SendLastImageJob::getConflictKey() const
 {
-    return true;
+    //image requests are answered by signals of the simulation access without reference to the requester
+    return "SimulationAccess";
 }
 
 void SendLastImageJob::requestImage()
@@ -74,19 +87,38 @@ void SendLastImageJob::requestImage()
 
     _image = boost::make_shared<QImage>(_size.x, _size.y, QImage::Format_RGB32);
     auto const rect = IntRect{ _pos, IntVector2D{ _pos.x + _size.x, _pos.y + _size.y } };
-    _simAccess->requirePixelImage(rect, _image, _mutex);
+    if (_softwareRendering) {
+        _simAccess->requireData(rect, ResolveDescription());
+    } else {
+        _simAccess->requirePixelImage(rect, _image, _mutex);
+    }
 
     _state = State::ImageFromGpuRequested;
     _isReady = false;
 }
 
+void SendLastImageJob::encodeImage()
+{
+    runConcurrently([this] {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_renderInput) {
+            RealRect const worldRect{
+                RealVector2D{toFloat(_pos.x), toFloat(_pos.y)},
+                RealVector2D{toFloat(_pos.x + _size.x), toFloat(_pos.y + _size.y)}};
+            SoftwareRenderer::render(*_renderInput, _universeSize, worldRect, 1.0f, *_image);
+            _renderInput = boost::none;
+        }
+        _encodedImageData = ImageEncoder::encode(*_image, ImageEncoder::Format::Png);
+    });
+
+    _state = State::ImageEncoded;
+}
+
 void SendLastImageJob::sendImageToServer()
 {
     delete _buffer;
     _buffer = new QBuffer(&_encodedImageData);
-    _buffer->open(QIODevice::ReadWrite);
-    _image->save(_buffer, "PNG");
-    _buffer->seek(0);
+    _buffer->open(QIODevice::ReadOnly);
 
     auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
 
@@ -119,6 +151,19 @@ void SendLastImageJob::imageFromGpuReceived()
     }
 
     _isReady = true;
+    wakeUp();
+}
+
+void SendLastImageJob::dataFromSimulationReceived()
+{
+    if (State::ImageFromGpuRequested != _state) {
+        return;
+    }
+
+    //renders on the CPU such that no CUDA device or OpenGL context is needed for the image, see encodeImage()
+    _renderInput = SoftwareRenderer::createInput(_simAccess->retrieveData());
+    _isReady = true;
+    wakeUp();
 }
 
 void SendLastImageJob::serverReceivedImage()
@@ -132,4 +177,5 @@ void SendLastImageJob::serverReceivedImage()
 
     delete _buffer;
     _buffer = nullptr;
+    wakeUp();
 }
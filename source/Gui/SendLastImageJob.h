@@ -2,6 +2,8 @@
 
 #include "Base/Job.h"
 
+#include "EngineInterface/SoftwareRenderer.h"
+
 #include "Web/Definitions.h"
 
 #include "Definitions.h"
@@ -16,26 +18,31 @@ public:
         string const& currentToken,
         IntVector2D const& pos,
         IntVector2D const& size,
+        IntVector2D const& universeSize,
+        bool softwareRendering,
         SimulationAccess* simAccess,
         WebAccess* webAccess,
         QObject* parent);
 
     void process() override;
     bool isFinished() const override;
-    bool isBlocking() const override;
+    string getConflictKey() const override;
 
 private:
     void requestImage();
+    void encodeImage();
     void sendImageToServer();
     void finish();
 
     Q_SLOT void imageFromGpuReceived();
+    Q_SLOT void dataFromSimulationReceived();
     Q_SLOT void serverReceivedImage();
 
     enum class State
     {
         Init,
         ImageFromGpuRequested,
+        ImageEncoded,
         ImageToServerSent,
         Finished
     };
@@ -45,10 +52,13 @@ private:
 
     IntVector2D _pos;
     IntVector2D _size;
+    IntVector2D _universeSize;
+    bool _softwareRendering = false;
     string _currentSimulationId;
     string _currentToken;
 
     QImagePtr _image;
+    boost::optional<SoftwareRenderer::Input> _renderInput;
     QBuffer* _buffer = nullptr;
     QByteArray _encodedImageData;
 
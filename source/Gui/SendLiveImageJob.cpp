@@ -18,6 +18,10 @@ SendLiveImageJob::SendLiveImageJob(
     string const& taskId,
     IntVector2D const& pos,
     IntVector2D const& size,
+    IntVector2D const& universeSize,
+    bool softwareRendering,
+    ImageEncoder::Format format,
+    ImageDeltaEncoderPtr const& deltaEncoder,
     SimulationAccess* simAccess,
     WebAccess* webAccess,
     QObject* parent)
@@ -26,10 +30,18 @@ SendLiveImageJob::SendLiveImageJob(
     , _currentToken(currentToken)
     , _pos(pos)
     , _size(size)
+    , _universeSize(universeSize)
+    , _softwareRendering(softwareRendering)
+    , _format(format)
+    , _deltaEncoder(deltaEncoder)
     , _simAccess(simAccess)
     , _webAccess(webAccess)
 {
-    connect(_simAccess, &SimulationAccess::imageReady, this, &SendLiveImageJob::imageFromGpuReceived);
+    if (_softwareRendering) {
+        connect(_simAccess, &SimulationAccess::dataReadyToRetrieve, this, &SendLiveImageJob::dataFromSimulationReceived);
+    } else {
+        connect(_simAccess, &SimulationAccess::imageReady, this, &SendLiveImageJob::imageFromGpuReceived);
+    }
     connect(_webAccess, &WebAccess::sendProcessedTaskReceived, this, &SendLiveImageJob::serverReceivedImage);
 }
 
@@ -45,6 +57,9 @@ void SendLiveImageJob::process()
         requestImage();
         break;
     case State::ImageFromGpuRequested:
+        encodeImage();
+        break;
+    case State::ImageEncoded:
         sendImageToServer();
         break;
     case State::ImageToServerSent:
@@ -60,9 +75,10 @@ bool SendLiveImageJob::isFinished() const
     return State::Finished == _state;
 }
 
-bool SendLiveImageJob::isBlocking() const
+string SendLiveImageJob::getConflictKey() const
 {
-    return true;
+    //image requests are answered by signals of the simulation access without reference to the requester
+    return "SimulationAccess";
 }
 
 void SendLiveImageJob::requestImage()
@@ -76,21 +92,48 @@ void SendLiveImageJob::requestImage()
     stream << "Web: processing task " << getId() << ": request image with size " << _size.x << " x " << _size.y;
     loggingService->logMessage(Priority::Important, stream.str());
 
-    _simAccess->requirePixelImage(rect, _image, _mutex);
+    if (_softwareRendering) {
+        _simAccess->requireData(rect, ResolveDescription());
+    } else {
+        _simAccess->requirePixelImage(rect, _image, _mutex);
+    }
 
     _state = State::ImageFromGpuRequested;
     _isReady = false;
 }
 
-void SendLiveImageJob::sendImageToServer()
+void SendLiveImageJob::encodeImage()
 {
-    delete _buffer;
-    _buffer = new QBuffer(&_encodedImageData);
-    _buffer->open(QIODevice::ReadWrite);
-    _image->save(_buffer, "PNG");
-    _buffer->seek(0);
+    runConcurrently([this] {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_renderInput) {
+            RealRect const worldRect{
+                RealVector2D{toFloat(_pos.x), toFloat(_pos.y)},
+                RealVector2D{toFloat(_pos.x + _size.x), toFloat(_pos.y + _size.y)}};
+            SoftwareRenderer::render(*_renderInput, _universeSize, worldRect, 1.0f, *_image);
+            _renderInput = boost::none;
+        }
+        if (_deltaEncoder) {
+            _delta = _deltaEncoder->encode(*_image);
+        } else {
+            _encodedImageData = ImageEncoder::encode(*_image, _format);
+        }
+    });
+
+    _state = State::ImageEncoded;
+}
 
-    _webAccess->sendProcessedTask(_currentSimulationId, _currentToken, getId(), _buffer);
+void SendLiveImageJob::sendImageToServer()
+{
+    auto const mimeType = ImageEncoder::getMimeType(_format);
+    if (_deltaEncoder) {
+        _webAccess->sendProcessedTaskDelta(_currentSimulationId, _currentToken, getId(), _delta, mimeType);
+    } else {
+        delete _buffer;
+        _buffer = new QBuffer(&_encodedImageData);
+        _buffer->open(QIODevice::ReadOnly);
+        _webAccess->sendProcessedTask(_currentSimulationId, _currentToken, getId(), _buffer, mimeType);
+    }
 
     _state = State::ImageToServerSent;
     _isReady = false;
@@ -108,6 +151,19 @@ void SendLiveImageJob::imageFromGpuReceived()
         return;
     }
     _isReady = true;
+    wakeUp();
+}
+
+void SendLiveImageJob::dataFromSimulationReceived()
+{
+    if (State::ImageFromGpuRequested != _state) {
+        return;
+    }
+
+    //renders on the CPU such that no CUDA device or OpenGL context is needed for the image, see encodeImage()
+    _renderInput = SoftwareRenderer::createInput(_simAccess->retrieveData());
+    _isReady = true;
+    wakeUp();
 }
 
 void SendLiveImageJob::serverReceivedImage(string taskId)
@@ -120,9 +176,16 @@ void SendLiveImageJob::serverReceivedImage(string taskId)
 
     std::stringstream stream;
     stream << "Web: task " << getId() << " processed";
+    if (_deltaEncoder) {
+        stream << " (" << _delta.tiles.size() << " of " << _delta.tileHashes.size() << " tiles sent)";
+    }
     loggingService->logMessage(Priority::Important, stream.str());
 
+    if (_deltaEncoder) {
+        _deltaEncoder->acknowledge(_delta);
+    }
     _isReady = true;
     delete _buffer;
     _buffer = nullptr;
+    wakeUp();
 }
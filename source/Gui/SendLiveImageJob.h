@@ -2,7 +2,10 @@
 
 #include "Base/Job.h"
 
+#include "EngineInterface/SoftwareRenderer.h"
+
 #include "Web/Definitions.h"
+#include "Web/ImageDeltaEncoder.h"
 
 #include "Definitions.h"
 
@@ -17,26 +20,33 @@ public:
         string const& taskId,
         IntVector2D const& pos,
         IntVector2D const& size,
+        IntVector2D const& universeSize,
+        bool softwareRendering,
+        ImageEncoder::Format format,
+        ImageDeltaEncoderPtr const& deltaEncoder,   //nullptr: complete images are sent
         SimulationAccess* simAccess,
         WebAccess* webAccess,
         QObject* parent);
 
     void process() override;
     bool isFinished() const override;
-    bool isBlocking() const override;
+    string getConflictKey() const override;
 
 private:
     void requestImage();
+    void encodeImage();
     void sendImageToServer();
     void finish();
 
     Q_SLOT void imageFromGpuReceived();
+    Q_SLOT void dataFromSimulationReceived();
     Q_SLOT void serverReceivedImage(string taskId);
 
     enum class State
     {
         Init,
         ImageFromGpuRequested,
+        ImageEncoded,
         ImageToServerSent,
         Finished
     };
@@ -46,10 +56,16 @@ private:
 
     IntVector2D _pos;
     IntVector2D _size;
+    IntVector2D _universeSize;
+    bool _softwareRendering = false;
+    ImageEncoder::Format _format = ImageEncoder::Format::Png;
+    ImageDeltaEncoderPtr _deltaEncoder;
+    ImageDelta _delta;
     string _currentSimulationId;
     string _currentToken;
 
     QImagePtr _image;
+    boost::optional<SoftwareRenderer::Input> _renderInput;
     QBuffer* _buffer = nullptr;
     QByteArray _encodedImageData;
 
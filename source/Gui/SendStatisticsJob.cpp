@@ -17,7 +17,7 @@ SendStatisticsJob::SendStatisticsJob(
     WebAccess* webAccess,
     SimulationConfig const& config,
     QObject* parent)
-    : Job("SendStatisticsJob", parent)
+    : Job(Id, parent)
     , _currentSimulationId(currentSimulationId)
     , _currentToken(currentToken)
     , _simMonitor(simMonitor)
@@ -39,6 +39,9 @@ void SendStatisticsJob::process()
         requestStatistics();
         break;
     case State::StatisticsFromGpuRequested:
+        formatStatistics();
+        break;
+    case State::StatisticsFormatted:
         sendStatisticsToServer();
         break;
     default:
@@ -51,9 +54,9 @@ bool SendStatisticsJob::isFinished() const
     return State::Finished == _state;
 }
 
-bool SendStatisticsJob::isBlocking() const
+string SendStatisticsJob::getConflictKey() const
 {
-    return true;
+    return "SimulationMonitor";
 }
 
 void SendStatisticsJob::requestStatistics()
@@ -64,23 +67,33 @@ void SendStatisticsJob::requestStatistics()
     _isReady = false;
 }
 
-void SendStatisticsJob::sendStatisticsToServer()
+void SendStatisticsJob::formatStatistics()
 {
-    auto monitorData = _simMonitor->retrieveData();
-
-    _webAccess->sendStatistics(_currentSimulationId, _currentToken, {
-        { "timestep", std::to_string(monitorData.timeStep) },
-        { "numCells", std::to_string(monitorData.numCells) },
-        { "numParticles", std::to_string(monitorData.numParticles) },
-        { "numClusters", std::to_string(monitorData.numClusters) },
-        { "numActiveClusters", std::to_string(monitorData.numClustersWithTokens) },
-        { "numTokens", std::to_string(monitorData.numTokens) },
-        { "sizeX", std::to_string(_config->universeSize.x) },
-        { "sizeY", std::to_string(_config->universeSize.y) },
-        { "numBlocks", std::to_string(_config->cudaConstants.NUM_BLOCKS) },
-        { "numThreadsPerBlock", std::to_string(_config->cudaConstants.NUM_THREADS_PER_BLOCK) },
+    auto const monitorData = _simMonitor->retrieveData();
+    auto const universeSize = _config->universeSize;
+    auto const cudaConstants = _config->cudaConstants;
+    runConcurrently([this, monitorData, universeSize, cudaConstants] {
+        _statistics = {
+            { "timestep", std::to_string(monitorData.timeStep) },
+            { "numCells", std::to_string(monitorData.numCells) },
+            { "numParticles", std::to_string(monitorData.numParticles) },
+            { "numClusters", std::to_string(monitorData.numClusters) },
+            { "numActiveClusters", std::to_string(monitorData.numClustersWithTokens) },
+            { "numTokens", std::to_string(monitorData.numTokens) },
+            { "sizeX", std::to_string(universeSize.x) },
+            { "sizeY", std::to_string(universeSize.y) },
+            { "numBlocks", std::to_string(cudaConstants.NUM_BLOCKS) },
+            { "numThreadsPerBlock", std::to_string(cudaConstants.NUM_THREADS_PER_BLOCK) },
+        };
     });
 
+    _state = State::StatisticsFormatted;
+}
+
+void SendStatisticsJob::sendStatisticsToServer()
+{
+    _webAccess->sendStatistics(_currentSimulationId, _currentToken, _statistics);
+
     _state = State::Finished;
     _isReady = false;
 }
@@ -91,4 +104,5 @@ void SendStatisticsJob::statisticsFromGpuReceived()
         return;
     }
     _isReady = true;
+    wakeUp();
 }
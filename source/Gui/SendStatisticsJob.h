@@ -11,6 +11,8 @@ class SendStatisticsJob
 {
     Q_OBJECT
 public:
+    static auto constexpr Id = "SendStatisticsJob";
+
     SendStatisticsJob(
         string const& currentSimulationId,
         string const& currentToken,
@@ -21,10 +23,11 @@ public:
 
     void process() override;
     bool isFinished() const override;
-    bool isBlocking() const override;
+    string getConflictKey() const override;
 
 private:
     void requestStatistics();
+    void formatStatistics();
     void sendStatisticsToServer();
 
     Q_SLOT void statisticsFromGpuReceived();
@@ -33,6 +36,7 @@ private:
     {
         Init,
         StatisticsFromGpuRequested,
+        StatisticsFormatted,
         Finished
     };
 
@@ -41,6 +45,7 @@ private:
 
     string _currentSimulationId;
     string _currentToken;
+    map<string, string> _statistics;
 
     SimulationMonitor* _simMonitor = nullptr;
     WebAccess* _webAccess = nullptr;
@@ -91,6 +91,14 @@ bool GuiSettings::getSettingsValue(std::string const & key, bool defaultValue)
 	return settings.value(QString::fromStdString(key), QVariant(defaultValue)).toBool();
 }
 
+std::string GuiSettings::getSettingsValue(std::string const& key, std::string const& defaultValue)
+{
+    QSettings settings;
+    return settings.value(QString::fromStdString(key), QVariant(QString::fromStdString(defaultValue)))
+        .toString()
+        .toStdString();
+}
+
 void GuiSettings::setSettingsValue(std::string const & key, int value)
 {
 	QSettings settings;
@@ -114,3 +122,9 @@ void GuiSettings::setSettingsValue(std::string const & key, bool value)
 	QSettings settings;
 	settings.setValue(QString::fromStdString(key), QVariant(value));
 }
+
+void GuiSettings::setSettingsValue(std::string const& key, std::string const& value)
+{
+    QSettings settings;
+    settings.setValue(QString::fromStdString(key), QVariant(QString::fromStdString(value)));
+}
@@ -12,6 +12,22 @@ namespace Const
     auto const OpenGLViewUpdateInterval = std::chrono::milliseconds(20);
     auto const ViewUpdates = 6;
 
+    //item view
+    auto const ItemViewportMargin = 10.0;                  //in model units, entities outside are not represented by items
+    auto const MaxItemCreationsPerUpdate = 5000;           //remaining items are created in subsequent updates
+    auto const MaxPooledItems = 20000;                     //unused items kept for recycling per item type
+    auto const ZoomLevelForClusterItems = 8.0;             //below this zoom level clusters are drawn as single items
+
+    //density map and minimap
+    auto const DensityMapBinSize = 8;                      //in model units
+    auto const DensityMapUpdateInterval = std::chrono::milliseconds(250);
+    auto const DensityMapUpdateIntervalWhileRunning = std::chrono::milliseconds(1000);  //fetching data delays the simulation
+    auto const DensityMapUpdateRegions = 8;                //number of horizontal bands refreshed one after another
+    auto const ZoomLevelForDensityRendering = 0.5;         //below this zoom level the view is drawn from the density map
+    auto const MinimapSize = 200;                          //in pixels
+    auto const MinimapMargin = 10;                         //in pixels
+    const QColor MinimapViewRectColor(0xB0, 0xB0, 0xFF, 0xC0);
+
     //startup
     const QColor StartupTextColor(0x99, 0xa0, 0xdd);
     const QColor StartupNewVersionTextColor(0xB0, 0xb0, 0xff);
@@ -201,6 +217,34 @@ namespace Const
     const std::string ExtrapolateContentKey = "computation/extrapolateContent";
     const bool ExtrapolateContentDefault = false;
 
+    const std::string WebSoftwareRenderingKey = "web/softwareRendering";
+    const bool WebSoftwareRenderingDefault = false;
+    const std::string WebImageFormatKey = "web/imageFormat";
+    const int WebImageFormatDefault = 0;    //see ImageEncoder::Format
+    const std::string WebDeltaImagesKey = "web/deltaImages";
+    const bool WebDeltaImagesDefault = false;   //requires server support for sendprocessedtaskdelta
+
+    const std::string SpatialStatisticsFilenameKey = "statistics/spatial/filename";
+    const std::string SpatialStatisticsFilenameDefault = "";   //recording is disabled for an empty filename
+    const std::string SpatialStatisticsGridSizeXKey = "statistics/spatial/gridSize/x";
+    const int SpatialStatisticsGridSizeXDefault = 64;
+    const std::string SpatialStatisticsGridSizeYKey = "statistics/spatial/gridSize/y";
+    const int SpatialStatisticsGridSizeYDefault = 64;
+    const std::string SpatialStatisticsIntervalKey = "statistics/spatial/interval";
+    const int SpatialStatisticsIntervalDefault = 1000;
+
+    const std::string SpeciesCensusFilenameKey = "statistics/census/filename";
+    const std::string SpeciesCensusFilenameDefault = "";    //census is disabled for an empty filename
+    const std::string SpeciesCensusIntervalKey = "statistics/census/interval";
+    const int SpeciesCensusIntervalDefault = 1000;
+    const std::string SpeciesCensusMinNumCellsKey = "statistics/census/minNumCells";
+    const int SpeciesCensusMinNumCellsDefault = 2;
+
+    const std::string EventLogFilenameKey = "statistics/eventLog/filename";
+    const std::string EventLogFilenameDefault = "";    //base filename of the segment files, disabled if empty
+    const std::string EventLogNumSegmentsKey = "statistics/eventLog/numSegments";
+    const int EventLogNumSegmentsDefault = 16;
+
 	const std::string ColorizeColorCodeKey = "colorize/colorCode";
     const int ColorizeColorCodeDefault = 0;
 
@@ -233,9 +277,11 @@ public:
     static uint getSettingsValue(std::string const& key, uint defaultValue);
     static double getSettingsValue(std::string const& key, double defaultValue);
 	static bool getSettingsValue(std::string const& key, bool defaultValue);
+    static std::string getSettingsValue(std::string const& key, std::string const& defaultValue);
 
 	static void setSettingsValue(std::string const& key, int value);
     static void setSettingsValue(std::string const& key, uint value);
     static void setSettingsValue(std::string const& key, double value);
 	static void setSettingsValue(std::string const& key, bool value);
+    static void setSettingsValue(std::string const& key, std::string const& value);
 };
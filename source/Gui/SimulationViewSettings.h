@@ -4,6 +4,7 @@ struct SimulationViewSettings
 {
     bool glowEffect = true;
     bool motionEffect = true;
+    bool minimap = true;
 
     enum class Mode
     {
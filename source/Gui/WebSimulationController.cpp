@@ -15,6 +15,7 @@
 #include "EngineInterface/SimulationMonitor.h"
 #include "EngineInterface/SimulationAccess.h"
 #include "EngineInterface/SpaceProperties.h"
+#include "Web/ImageDeltaEncoder.h"
 #include "Web/WebAccess.h"
 
 #include "SendLiveImageJob.h"
@@ -26,21 +27,16 @@
 
 namespace
 {
-    auto const POLLING_INTERVAL = 300;
-    auto const PROCESS_JOBS_INTERVAL = 50;
     auto const UPDATE_STATISTICS_INTERVAL = 1000;
+    auto const MAX_DELTA_ENCODERS = 16;
 }
 
 WebSimulationController::WebSimulationController(WebAccess * webAccess, QWidget* parent /*= nullptr*/)
     : QObject(parent)
     , _webAccess(webAccess)
     , _parent(parent)
-    , _pollingTimer(new QTimer(this))
-    , _processJobsTimer(new QTimer(this))
     , _updateStatisticsTimer(new QTimer(this))
 {
-    connect(_pollingTimer, &QTimer::timeout, this, &WebSimulationController::requestUnprocessedTasks);
-    connect(_processJobsTimer, &QTimer::timeout, this, &WebSimulationController::processJobs);
     connect(_updateStatisticsTimer, &QTimer::timeout, this, &WebSimulationController::sendStatistics);
     connect(_webAccess, &WebAccess::unprocessedTasksReceived, this, &WebSimulationController::unprocessedTasksReceived);
     connect(_webAccess, &WebAccess::error, [&](auto const& message) {
@@ -64,8 +60,7 @@ void WebSimulationController::init(
     SET_CHILD(_monitor, monitor);
 
     _worker = boost::make_shared<_Worker>();
-    _processJobsTimer->stop();
-    _processJobsTimer->start(PROCESS_JOBS_INTERVAL);
+    _deltaEncoderByRegion.clear();
 }
 
 bool WebSimulationController::onConnectToSimulation()
@@ -107,10 +102,11 @@ bool WebSimulationController::onConnectToSimulation()
     }
 
     if (_currentToken) {
+        _deltaEncoderByRegion.clear();
         QMessageBox msgBox(QMessageBox::Information, "Connection successful",
             QString(Const::InfoConnectedTo).arg(QString::fromStdString(simulationInfo.simulationName)));
         msgBox.exec();
-        _pollingTimer->start(POLLING_INTERVAL);
+        _webAccess->startTaskPolling(*_currentSimulationId, *_currentToken);
         _updateStatisticsTimer->start(UPDATE_STATISTICS_INTERVAL);
 
         auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
@@ -127,7 +123,7 @@ bool WebSimulationController::onConnectToSimulation()
 
 bool WebSimulationController::onDisconnectToSimulation(string const& simulationId, string const & token)
 {
-    _pollingTimer->stop();
+    _webAccess->stopTaskPolling();
     _updateStatisticsTimer->stop();
 
     auto newJob = new SendLastImageJob(
@@ -135,9 +131,14 @@ bool WebSimulationController::onDisconnectToSimulation(string const& simulationI
         *_currentToken, 
         IntVector2D{ 0, 0 }, 
         _config->universeSize, 
+        _config->universeSize,
+        isSoftwareRenderingEnabled(),
         _simAccess, 
         _webAccess, 
         this);
+
+    //the last statistics should reach the server before the disconnection at the end of the job
+    newJob->addDependency(SendStatisticsJob::Id);
     _worker->add(newJob);
 
     return true;
@@ -153,11 +154,6 @@ boost::optional<string> WebSimulationController::getCurrentToken() const
     return _currentToken;
 }
 
-void WebSimulationController::requestUnprocessedTasks() const
-{
-    _webAccess->requestUnprocessedTasks(*_currentSimulationId, *_currentToken);
-}
-
 void WebSimulationController::unprocessedTasksReceived(vector<Task> tasks)
 {
     if (tasks.empty() || !_currentSimulationId) {
@@ -180,7 +176,18 @@ void WebSimulationController::unprocessedTasksReceived(vector<Task> tasks)
                 taskSize.y = worldSize.y - task.pos.y;
             }
             auto newJob = new SendLiveImageJob(
-                *_currentSimulationId, *_currentToken, task.id, task.pos, taskSize, _simAccess, _webAccess, this);
+                *_currentSimulationId,
+                *_currentToken,
+                task.id,
+                task.pos,
+                taskSize,
+                worldSize,
+                isSoftwareRenderingEnabled(),
+                getImageFormat(),
+                getDeltaEncoder(task.pos, taskSize),
+                _simAccess,
+                _webAccess,
+                this);
             _worker->add(newJob);
 
             ++numNewJobs;
@@ -195,14 +202,44 @@ void WebSimulationController::unprocessedTasksReceived(vector<Task> tasks)
     }
 }
 
-void WebSimulationController::processJobs()
+bool WebSimulationController::isSoftwareRenderingEnabled() const
+{
+    return GuiSettings::getSettingsValue(Const::WebSoftwareRenderingKey, Const::WebSoftwareRenderingDefault);
+}
+
+ImageEncoder::Format WebSimulationController::getImageFormat() const
 {
-    _worker->process();
+    auto const format = GuiSettings::getSettingsValue(Const::WebImageFormatKey, Const::WebImageFormatDefault);
+    auto const maxFormat = static_cast<int>(ImageEncoder::Format::Qoi);
+    return static_cast<ImageEncoder::Format>(std::max(0, std::min(format, maxFormat)));
+}
+
+ImageDeltaEncoderPtr WebSimulationController::getDeltaEncoder(IntVector2D const& pos, IntVector2D const& size)
+{
+    if (!GuiSettings::getSettingsValue(Const::WebDeltaImagesKey, Const::WebDeltaImagesDefault)) {
+        return nullptr;
+    }
+
+    //the server keeps the last image for each requested region
+    auto const format = getImageFormat();
+    std::stringstream stream;
+    stream << pos.x << "," << pos.y << "," << size.x << "," << size.y << "," << static_cast<int>(format);
+    auto const region = stream.str();
+    auto findResult = _deltaEncoderByRegion.find(region);
+    if (findResult != _deltaEncoderByRegion.end()) {
+        return findResult->second;
+    }
+    if (_deltaEncoderByRegion.size() >= MAX_DELTA_ENCODERS) {
+        _deltaEncoderByRegion.clear();
+    }
+    auto const result = boost::make_shared<ImageDeltaEncoder>(format);
+    _deltaEncoderByRegion.emplace(region, result);
+    return result;
 }
 
 void WebSimulationController::sendStatistics()
 {
-    if (!_currentSimulationId) {
+    if (!_currentSimulationId || _worker->contains(SendStatisticsJob::Id)) {
         return;
     }
 
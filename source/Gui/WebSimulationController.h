@@ -6,6 +6,7 @@
 #include "Base/Definitions.h"
 #include "EngineInterface/Definitions.h"
 #include "Web/Definitions.h"
+#include "Web/ImageEncoder.h"
 #include "Web/Task.h"
 
 #include "Definitions.h"
@@ -26,16 +27,19 @@ public:
     boost::optional<string> getCurrentToken() const;
 
 private:
-    Q_SLOT void requestUnprocessedTasks() const;
+    bool isSoftwareRenderingEnabled() const;
+    ImageEncoder::Format getImageFormat() const;
+    ImageDeltaEncoderPtr getDeltaEncoder(IntVector2D const& pos, IntVector2D const& size);
+
     Q_SLOT void unprocessedTasksReceived(vector<Task> tasks);
 
-    void processJobs();
     Q_SLOT void sendStatistics();
 
     boost::optional<string> _currentSimulationId;
     boost::optional<string> _currentToken;
 
     Worker _worker;
+    unordered_map<string, ImageDeltaEncoderPtr> _deltaEncoderByRegion;
 
     QByteArray _encodedImageData;
     QBuffer* _buffer = nullptr;
@@ -45,8 +49,6 @@ private:
     SimulationConfig _config;
     QWidget* _parent = nullptr;
     WebAccess* _webAccess = nullptr;
-    QTimer* _pollingTimer = nullptr;
-    QTimer* _processJobsTimer = nullptr;
     QTimer* _updateStatisticsTimer = nullptr;
 
     list<QMetaObject::Connection> _connections;
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/CellComputerCompilerImpl.h"
+#include "EngineInterface/CompilerHelper.h"
+#include "EngineInterface/SymbolTable.h"
+
+class CellComputerCompilerTest : public ::testing::Test
+{
+public:
+    CellComputerCompilerTest();
+    virtual ~CellComputerCompilerTest() = default;
+
+protected:
+    InstructionCoded getInstruction(QByteArray const& code, int index) const;
+
+    SimulationParameters _parameters;
+    SymbolTable _symbols;
+    CellComputerCompilerImpl _compiler;
+};
+
+CellComputerCompilerTest::CellComputerCompilerTest()
+{
+    _parameters.tokenMemorySize = 256;
+    _parameters.cellFunctionComputerCellMemorySize = 8;
+    _parameters.cellFunctionComputerMaxInstructions = 15;
+    _symbols.addEntry("COUNTER", "[0x10]");
+    _symbols.addEntry("POINTER", "[2]");
+    _symbols.addEntry("LIMIT", "7");
+    _compiler.init(&_symbols, _parameters);
+}
+
+InstructionCoded CellComputerCompilerTest::getInstruction(QByteArray const& code, int index) const
+{
+    InstructionCoded result;
+    int instructionPointer = index * 3;
+    CompilerHelper::readInstruction(code, instructionPointer, result);
+    return result;
+}
+
+TEST_F(CellComputerCompilerTest, testKeywordsAndOperands)
+{
+    auto const result = _compiler.compileSourceCode(
+        "MOV (3), [[4]]\n"
+        "If [1] => 0x2A\n"
+        "  xor [5], (1)\n"
+        "ElSe\n"
+        "  sub [5], -1\n"
+        "ENDIF");
+    ASSERT_TRUE(result.compilationOk);
+    ASSERT_EQ(6 * 3, result.compilation.size());
+
+    auto const mov = getInstruction(result.compilation, 0);
+    EXPECT_EQ(Enums::ComputerOperation::MOV, mov.operation);
+    EXPECT_EQ(Enums::ComputerOptype::CMEM, mov.opType1);
+    EXPECT_EQ(Enums::ComputerOptype::MEMMEM, mov.opType2);
+    EXPECT_EQ(3, mov.operand1);
+    EXPECT_EQ(4, mov.operand2);
+
+    auto const condition = getInstruction(result.compilation, 1);
+    EXPECT_EQ(Enums::ComputerOperation::IFGE, condition.operation);
+    EXPECT_EQ(Enums::ComputerOptype::CONSTANT, condition.opType2);
+    EXPECT_EQ(0x2a, condition.operand2);
+
+    EXPECT_EQ(Enums::ComputerOperation::ELSE, getInstruction(result.compilation, 3).operation);
+    EXPECT_EQ(255, getInstruction(result.compilation, 4).operand2);
+    EXPECT_EQ(Enums::ComputerOperation::ENDIF, getInstruction(result.compilation, 5).operation);
+}
+
+TEST_F(CellComputerCompilerTest, testSymbols)
+{
+    auto const result = _compiler.compileSourceCode("mov COUNTER, LIMIT\nadd [POINTER], COUNTER");
+    ASSERT_TRUE(result.compilationOk);
+
+    auto const mov = getInstruction(result.compilation, 0);
+    EXPECT_EQ(Enums::ComputerOptype::MEM, mov.opType1);
+    EXPECT_EQ(0x10, mov.operand1);
+    EXPECT_EQ(7, mov.operand2);
+
+    auto const add = getInstruction(result.compilation, 1);
+    EXPECT_EQ(Enums::ComputerOptype::MEMMEM, add.opType1);
+    EXPECT_EQ(2, add.operand1);
+    EXPECT_EQ(Enums::ComputerOptype::MEM, add.opType2);
+    EXPECT_EQ(0x10, add.operand2);
+}
+
+TEST_F(CellComputerCompilerTest, testErrors)
+{
+    auto result = _compiler.compileSourceCode("mov [1], 2\nmove [1], 2\n");
+    EXPECT_FALSE(result.compilationOk);
+    EXPECT_EQ(2, result.lineOfFirstError);
+
+    result = _compiler.compileSourceCode("mov [1], 2\nif [1] <> 2\n");
+    EXPECT_FALSE(result.compilationOk);
+    EXPECT_EQ(2, result.lineOfFirstError);
+
+    result = _compiler.compileSourceCode("mov 1, 2\n");
+    EXPECT_FALSE(result.compilationOk);
+    EXPECT_EQ(1, result.lineOfFirstError);
+
+    result = _compiler.compileSourceCode("mov [1], 0xg\n");
+    EXPECT_FALSE(result.compilationOk);
+}
+
+TEST_F(CellComputerCompilerTest, testCompileManyAndCache)
+{
+    std::vector<std::string> codes;
+    for (int i = 0; i < 1000; ++i) {
+        codes.emplace_back("mov [1], " + std::to_string(i % 100) + "\nadd COUNTER, [1]");
+    }
+    codes.emplace_back("mov [1]");
+    auto const results = _compiler.compileMany(codes);
+    ASSERT_EQ(codes.size(), results.size());
+    for (int i = 0; i < static_cast<int>(codes.size()); ++i) {
+        auto const expected = _compiler.compileSourceCode(codes[i]);
+        EXPECT_EQ(expected.compilationOk, results[i].compilationOk);
+        EXPECT_EQ(expected.compilation, results[i].compilation);
+    }
+    EXPECT_FALSE(results.back().compilationOk);
+
+    //cached compilations must not survive changes of the symbol table
+    _symbols.addEntry("COUNTER", "[0x20]");
+    auto const result = _compiler.compileSourceCode(codes.front());
+    ASSERT_TRUE(result.compilationOk);
+    EXPECT_EQ(0x20, getInstruction(result.compilation, 1).operand1);
+}
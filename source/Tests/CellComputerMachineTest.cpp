@@ -0,0 +1,243 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/CellComputerMachine.h"
+#include "EngineInterface/CompilerHelper.h"
+
+class CellComputerMachineTest : public ::testing::Test
+{
+public:
+    CellComputerMachineTest();
+    virtual ~CellComputerMachineTest() = default;
+
+protected:
+    //straightforward transcription of CellComputerFunction::processing
+    void executeReference(QByteArray const& code, QByteArray& tokenMemory, QByteArray& cellMemory) const;
+
+    QByteArray createRandomCode(int numInstructions);
+    QByteArray createRandomMemory(int size);
+
+    SimulationParameters _parameters;
+    std::mt19937 _engine;
+};
+
+CellComputerMachineTest::CellComputerMachineTest()
+{
+    _parameters.tokenMemorySize = 256;
+    _parameters.cellFunctionComputerCellMemorySize = 8;
+    _parameters.cellFunctionComputerMaxInstructions = 15;
+}
+
+void CellComputerMachineTest::executeReference(QByteArray const& code, QByteArray& tokenMemory, QByteArray& cellMemory)
+    const
+{
+    auto const tokenMemorySize = _parameters.tokenMemorySize;
+    auto const cellMemorySize = _parameters.cellFunctionComputerCellMemorySize;
+    auto getMemoryByte = [&](uint8_t pointer, bool cell) -> int8_t {
+        return cell ? cellMemory[pointer] : tokenMemory[pointer];
+    };
+    auto setMemoryByte = [&](uint8_t pointer, char value, bool cell) {
+        if (cell) {
+            cellMemory[pointer] = value;
+        } else {
+            tokenMemory[pointer] = value;
+        }
+    };
+
+    auto staticData = code;
+    staticData.append(QByteArray(3, 0));
+    bool condTable[CellComputerMachine::MaxInstructions + 1];
+    int condPointer = 0;
+    auto const numStaticBytes = std::min(static_cast<int>(code.size()), _parameters.cellFunctionComputerMaxInstructions * 3);
+    for (int instructionPointer = 0; instructionPointer < numStaticBytes;) {
+        InstructionCoded instruction;
+        CompilerHelper::readInstruction(staticData, instructionPointer, instruction);
+
+        uint8_t opPointer1 = 0;
+        bool cell = false;
+        if (instruction.opType1 == Enums::ComputerOptype::MEM) {
+            opPointer1 = CompilerHelper::convertToAddress(instruction.operand1, tokenMemorySize);
+        }
+        if (instruction.opType1 == Enums::ComputerOptype::MEMMEM) {
+            instruction.operand1 = tokenMemory[CompilerHelper::convertToAddress(instruction.operand1, tokenMemorySize)];
+            opPointer1 = CompilerHelper::convertToAddress(instruction.operand1, tokenMemorySize);
+        }
+        if (instruction.opType1 == Enums::ComputerOptype::CMEM) {
+            opPointer1 = CompilerHelper::convertToAddress(instruction.operand1, cellMemorySize);
+            cell = true;
+        }
+
+        if (instruction.opType2 == Enums::ComputerOptype::MEM) {
+            instruction.operand2 = tokenMemory[CompilerHelper::convertToAddress(instruction.operand2, tokenMemorySize)];
+        }
+        if (instruction.opType2 == Enums::ComputerOptype::MEMMEM) {
+            instruction.operand2 = tokenMemory[CompilerHelper::convertToAddress(instruction.operand2, tokenMemorySize)];
+            instruction.operand2 = tokenMemory[CompilerHelper::convertToAddress(instruction.operand2, tokenMemorySize)];
+        }
+        if (instruction.opType2 == Enums::ComputerOptype::CMEM) {
+            instruction.operand2 = cellMemory[CompilerHelper::convertToAddress(instruction.operand2, cellMemorySize)];
+        }
+
+        bool execute = true;
+        for (int k = 0; k < condPointer; ++k) {
+            if (!condTable[k]) {
+                execute = false;
+            }
+        }
+        if (execute) {
+            auto const value = getMemoryByte(opPointer1, cell);
+            switch (instruction.operation) {
+            case Enums::ComputerOperation::MOV:
+                setMemoryByte(opPointer1, instruction.operand2, cell);
+                break;
+            case Enums::ComputerOperation::ADD:
+                setMemoryByte(opPointer1, value + instruction.operand2, cell);
+                break;
+            case Enums::ComputerOperation::SUB:
+                setMemoryByte(opPointer1, value - instruction.operand2, cell);
+                break;
+            case Enums::ComputerOperation::MUL:
+                setMemoryByte(opPointer1, value * instruction.operand2, cell);
+                break;
+            case Enums::ComputerOperation::DIV:
+                setMemoryByte(opPointer1, instruction.operand2 > 0 ? value / instruction.operand2 : 0, cell);
+                break;
+            case Enums::ComputerOperation::XOR:
+                setMemoryByte(opPointer1, value ^ instruction.operand2, cell);
+                break;
+            case Enums::ComputerOperation::OR:
+                setMemoryByte(opPointer1, value | instruction.operand2, cell);
+                break;
+            case Enums::ComputerOperation::AND:
+                setMemoryByte(opPointer1, value & instruction.operand2, cell);
+                break;
+            default:
+                break;
+            }
+        }
+
+        instruction.operand1 = getMemoryByte(opPointer1, cell);
+        switch (instruction.operation) {
+        case Enums::ComputerOperation::IFG:
+            condTable[condPointer++] = instruction.operand1 > instruction.operand2;
+            break;
+        case Enums::ComputerOperation::IFGE:
+            condTable[condPointer++] = instruction.operand1 >= instruction.operand2;
+            break;
+        case Enums::ComputerOperation::IFE:
+            condTable[condPointer++] = instruction.operand1 == instruction.operand2;
+            break;
+        case Enums::ComputerOperation::IFNE:
+            condTable[condPointer++] = instruction.operand1 != instruction.operand2;
+            break;
+        case Enums::ComputerOperation::IFLE:
+            condTable[condPointer++] = instruction.operand1 <= instruction.operand2;
+            break;
+        case Enums::ComputerOperation::IFL:
+            condTable[condPointer++] = instruction.operand1 < instruction.operand2;
+            break;
+        case Enums::ComputerOperation::ELSE:
+            if (condPointer > 0) {
+                condTable[condPointer - 1] = !condTable[condPointer - 1];
+            }
+            break;
+        case Enums::ComputerOperation::ENDIF:
+            if (condPointer > 0) {
+                --condPointer;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+QByteArray CellComputerMachineTest::createRandomCode(int numInstructions)
+{
+    //small operands such that memory operands hit the few bytes which are initialized with small values
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+    std::uniform_int_distribution<int> smallDistribution(-4, 12);
+    QByteArray result;
+    for (int i = 0; i < numInstructions; ++i) {
+        result.push_back(static_cast<char>(byteDistribution(_engine)));
+        result.push_back(static_cast<char>(smallDistribution(_engine)));
+        result.push_back(static_cast<char>(smallDistribution(_engine)));
+    }
+    return result;
+}
+
+QByteArray CellComputerMachineTest::createRandomMemory(int size)
+{
+    std::uniform_int_distribution<int> distribution(-8, 16);
+    QByteArray result;
+    for (int i = 0; i < size; ++i) {
+        result.push_back(static_cast<char>(distribution(_engine)));
+    }
+    return result;
+}
+
+TEST_F(CellComputerMachineTest, testConditionalBlocks)
+{
+    //if token[0] > 5: token[1] = 1 else: token[1] = 2, then cell[0] += token[1]
+    QByteArray code;
+    auto write = [&code](
+                     Enums::ComputerOperation::Type operation,
+                     Enums::ComputerOptype::Type opType1,
+                     Enums::ComputerOptype::Type opType2,
+                     int operand1,
+                     int operand2) {
+        CompilerHelper::writeInstruction(
+            code,
+            {operation, opType1, opType2, static_cast<uint8_t>(operand1), static_cast<uint8_t>(operand2)});
+    };
+    write(Enums::ComputerOperation::IFG, Enums::ComputerOptype::MEM, Enums::ComputerOptype::CONSTANT, 0, 5);
+    write(Enums::ComputerOperation::MOV, Enums::ComputerOptype::MEM, Enums::ComputerOptype::CONSTANT, 1, 1);
+    write(Enums::ComputerOperation::ELSE, Enums::ComputerOptype::MEM, Enums::ComputerOptype::MEM, 0, 0);
+    write(Enums::ComputerOperation::MOV, Enums::ComputerOptype::MEM, Enums::ComputerOptype::CONSTANT, 1, 2);
+    write(Enums::ComputerOperation::ENDIF, Enums::ComputerOptype::MEM, Enums::ComputerOptype::MEM, 0, 0);
+    write(Enums::ComputerOperation::ADD, Enums::ComputerOptype::CMEM, Enums::ComputerOptype::MEM, 0, 1);
+
+    CellComputerMachine machine(_parameters);
+    auto const program = machine.decode(code);
+    EXPECT_EQ(6, program.getNumInstructions());
+
+    auto batch = machine.createBatch(1000);
+    for (int i = 0; i < 1000; ++i) {
+        batch.setTokenMemory(i, QByteArray(1, static_cast<char>(i % 10)));
+        batch.setCellMemory(i, QByteArray(1, 10));
+    }
+    machine.execute(program, batch);
+    for (int i = 0; i < 1000; ++i) {
+        auto const expected = i % 10 > 5 ? 1 : 2;
+        EXPECT_EQ(expected, batch.getTokenMemory(i)[1]);
+        EXPECT_EQ(10 + expected, batch.getCellMemory(i)[0]);
+    }
+}
+
+TEST_F(CellComputerMachineTest, testRandomProgramsAgreeWithReference)
+{
+    CellComputerMachine machine(_parameters);
+    int const numTokens = 300;  //more than one block
+    for (int run = 0; run < 200; ++run) {
+        auto const code = createRandomCode(1 + run % 20);
+        auto const program = machine.decode(code);
+
+        vector<QByteArray> tokenMemories;
+        vector<QByteArray> cellMemories;
+        auto batch = machine.createBatch(numTokens);
+        for (int i = 0; i < numTokens; ++i) {
+            tokenMemories.emplace_back(createRandomMemory(_parameters.tokenMemorySize));
+            cellMemories.emplace_back(createRandomMemory(_parameters.cellFunctionComputerCellMemorySize));
+            batch.setTokenMemory(i, tokenMemories.back());
+            batch.setCellMemory(i, cellMemories.back());
+        }
+        machine.execute(program, batch);
+
+        for (int i = 0; i < numTokens; ++i) {
+            executeReference(code, tokenMemories[i], cellMemories[i]);
+            ASSERT_EQ(tokenMemories[i], batch.getTokenMemory(i)) << "run " << run << ", token " << i;
+            ASSERT_EQ(cellMemories[i], batch.getCellMemory(i)) << "run " << run << ", token " << i;
+        }
+    }
+}
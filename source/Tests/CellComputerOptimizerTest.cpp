@@ -0,0 +1,165 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/CellComputerCompilerImpl.h"
+#include "EngineInterface/CellComputerMachine.h"
+#include "EngineInterface/CellComputerOptimizer.h"
+#include "EngineInterface/CompilerHelper.h"
+#include "EngineInterface/SymbolTable.h"
+
+class CellComputerOptimizerTest : public ::testing::Test
+{
+public:
+    CellComputerOptimizerTest();
+    virtual ~CellComputerOptimizerTest() = default;
+
+protected:
+    QByteArray createRandomCode(int numInstructions);
+
+    //runs both programs over the same random memories and compares the results
+    void checkSameEffect(QByteArray const& code, QByteArray const& otherCode);
+
+    SimulationParameters _parameters;
+    SymbolTable _symbols;
+    CellComputerCompilerImpl _compiler;
+    std::mt19937 _engine;
+};
+
+CellComputerOptimizerTest::CellComputerOptimizerTest()
+{
+    _parameters.tokenMemorySize = 256;
+    _parameters.cellFunctionComputerCellMemorySize = 8;
+    _parameters.cellFunctionComputerMaxInstructions = 15;
+    _compiler.init(&_symbols, _parameters);
+}
+
+QByteArray CellComputerOptimizerTest::createRandomCode(int numInstructions)
+{
+    //few operations, operand types and addresses such that instructions often interact
+    std::uniform_int_distribution<int> operationDistribution(0, Enums::ComputerOperation::ENDIF);
+    std::uniform_int_distribution<int> opTypeDistribution(0, 9);
+    std::uniform_int_distribution<int> addressDistribution(0, 3);
+    std::uniform_int_distribution<int> constantDistribution(-2, 3);
+    auto getOpType = [&] {
+        auto const value = opTypeDistribution(_engine);
+        return value < 5 ? Enums::ComputerOptype::MEM : static_cast<Enums::ComputerOptype::Type>(value % 4);
+    };
+
+    QByteArray result;
+    for (int i = 0; i < numInstructions; ++i) {
+        InstructionCoded instruction;
+        instruction.operation = static_cast<Enums::ComputerOperation::Type>(operationDistribution(_engine));
+        instruction.opType1 = static_cast<Enums::ComputerOptype::Type>(getOpType() % 3);
+        instruction.opType2 = getOpType();
+        instruction.operand1 = static_cast<uint8_t>(addressDistribution(_engine));
+        instruction.operand2 = static_cast<uint8_t>(
+            instruction.opType2 == Enums::ComputerOptype::CONSTANT ? constantDistribution(_engine)
+                                                                   : addressDistribution(_engine));
+        CompilerHelper::writeInstruction(result, instruction);
+    }
+    return result;
+}
+
+void CellComputerOptimizerTest::checkSameEffect(QByteArray const& code, QByteArray const& otherCode)
+{
+    int const numTokens = 200;
+    std::uniform_int_distribution<int> distribution(-3, 5);
+    CellComputerMachine machine(_parameters);
+    auto batch = machine.createBatch(numTokens);
+    for (int i = 0; i < numTokens; ++i) {
+        QByteArray tokenMemory;
+        for (int address = 0; address < 8; ++address) {
+            tokenMemory.push_back(static_cast<char>(distribution(_engine)));
+        }
+        QByteArray cellMemory;
+        for (int address = 0; address < 8; ++address) {
+            cellMemory.push_back(static_cast<char>(distribution(_engine)));
+        }
+        batch.setTokenMemory(i, tokenMemory);
+        batch.setCellMemory(i, cellMemory);
+    }
+    auto otherBatch = batch;
+    machine.execute(machine.decode(code), batch);
+    machine.execute(machine.decode(otherCode), otherBatch);
+    ASSERT_EQ(batch.getTokenMemoryRef(), otherBatch.getTokenMemoryRef());
+    ASSERT_EQ(batch.getCellMemoryRef(), otherBatch.getCellMemoryRef());
+}
+
+TEST_F(CellComputerOptimizerTest, testFoldingAndDeadStores)
+{
+    auto const result = _compiler.compileOptimized(
+        "mov [1], 3\n"
+        "add [1], 2\n"
+        "mul [1], 2\n"
+        "mov [2], [3]\n"
+        "add (1), 5\n"
+        "sub (1), 7\n"
+        "mov [2], 4\n"
+        "or [4], 0\n"
+        "mov [5], [5]\n");
+    ASSERT_TRUE(result.compilationOk);
+    EXPECT_EQ(
+        "mov [0x1], 0xa\n"
+        "add (0x1), 0xfe\n"
+        "mov [0x2], 0x4",
+        _compiler.decompileSourceCode(result.compilation));
+}
+
+TEST_F(CellComputerOptimizerTest, testEmptyBlocks)
+{
+    auto const result = _compiler.compileOptimized(
+        "if [1] > 2\n"
+        "  if [2] = 0\n"
+        "  else\n"
+        "  endif\n"
+        "  mov [3], 1\n"
+        "else\n"
+        "endif\n"
+        "if [4] < 1\n"
+        "else\n");
+    ASSERT_TRUE(result.compilationOk);
+    EXPECT_EQ(
+        "if [0x1] > 0x2\n"
+        "  mov [0x3], 0x1\n"
+        "endif",
+        _compiler.decompileSourceCode(result.compilation));
+}
+
+TEST_F(CellComputerOptimizerTest, testCompileSourceCodeDoesNotOptimize)
+{
+    auto const result = _compiler.compileSourceCode("mov [1], 3\nmov [1], 3\n");
+    ASSERT_TRUE(result.compilationOk);
+    EXPECT_EQ(
+        "mov [0x1], 0x3\n"
+        "mov [0x1], 0x3",
+        _compiler.decompileSourceCode(result.compilation));
+}
+
+TEST_F(CellComputerOptimizerTest, testProgramsAboveInstructionLimitAreUnchanged)
+{
+    QByteArray code;
+    for (int i = 0; i < _parameters.cellFunctionComputerMaxInstructions + 1; ++i) {
+        CompilerHelper::writeInstruction(
+            code, {Enums::ComputerOperation::ADD, Enums::ComputerOptype::MEM, Enums::ComputerOptype::CONSTANT, 0, 0});
+    }
+    EXPECT_EQ(code, CellComputerOptimizer::optimize(code, _parameters));
+}
+
+TEST_F(CellComputerOptimizerTest, testRandomProgramsKeepSemantics)
+{
+    for (int run = 0; run < 500; ++run) {
+        auto const code = createRandomCode(1 + run % _parameters.cellFunctionComputerMaxInstructions);
+        auto const optimizedCode = CellComputerOptimizer::optimize(code, _parameters);
+        EXPECT_LE(optimizedCode.size(), code.size());
+        checkSameEffect(code, optimizedCode);
+
+        //decompiled optimized code compiles to a program with the same effect
+        auto const recompilation = _compiler.compileSourceCode(_compiler.decompileSourceCode(optimizedCode));
+        ASSERT_TRUE(recompilation.compilationOk) << "run " << run;
+        checkSameEffect(code, recompilation.compilation);
+        if (HasFatalFailure()) {
+            FAIL() << "run " << run;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/ClusterFingerprint.h"
+#include "EngineInterface/Descriptions.h"
+
+class ClusterFingerprintTest : public ::testing::Test
+{
+public:
+    virtual ~ClusterFingerprintTest() = default;
+
+protected:
+    //creates a chain of connected cells with the given cell functions, cell ids start at firstId
+    ClusterDescription createChain(vector<Enums::CellFunction::Type> const& cellFunctions, uint64_t firstId) const;
+};
+
+ClusterDescription ClusterFingerprintTest::createChain(
+    vector<Enums::CellFunction::Type> const& cellFunctions,
+    uint64_t firstId) const
+{
+    list<CellDescription> cells;
+    for (int i = 0; i < static_cast<int>(cellFunctions.size()); ++i) {
+        auto const id = firstId + i;
+        auto cell = CellDescription()
+                        .setId(id)
+                        .setPos({static_cast<float>(i), 0})
+                        .setMaxConnections(2)
+                        .setFlagTokenBlocked(false)
+                        .setTokenBranchNumber(i % 6)
+                        .setCellFeature(CellFeatureDescription().setType(cellFunctions[i]));
+        if (i > 0) {
+            cell.addConnection(id - 1);
+        }
+        if (i + 1 < static_cast<int>(cellFunctions.size())) {
+            cell.addConnection(id + 1);
+        }
+        cells.emplace_back(cell);
+    }
+    return ClusterDescription().setId(firstId + 1000).addCells(cells);
+}
+
+TEST_F(ClusterFingerprintTest, testIndependentOfCellOrderAndIds)
+{
+    auto const cluster = createChain(
+        {Enums::CellFunction::COMPUTER,
+         Enums::CellFunction::SCANNER,
+         Enums::CellFunction::WEAPON,
+         Enums::CellFunction::COMPUTER,
+         Enums::CellFunction::CONSTRUCTOR},
+        1);
+
+    auto permutedCluster = createChain(
+        {Enums::CellFunction::COMPUTER,
+         Enums::CellFunction::SCANNER,
+         Enums::CellFunction::WEAPON,
+         Enums::CellFunction::COMPUTER,
+         Enums::CellFunction::CONSTRUCTOR},
+        100);
+    std::reverse(permutedCluster.cells->begin(), permutedCluster.cells->end());
+    std::swap(permutedCluster.cells->at(1), permutedCluster.cells->at(3));
+
+    EXPECT_EQ(ClusterFingerprint::calc(cluster), ClusterFingerprint::calc(permutedCluster));
+}
+
+TEST_F(ClusterFingerprintTest, testDifferentStructure)
+{
+    //both chains consist of the same cells and have the same cell functions at their ends
+    auto const cluster1 = createChain(
+        {Enums::CellFunction::COMPUTER,
+         Enums::CellFunction::COMPUTER,
+         Enums::CellFunction::SCANNER,
+         Enums::CellFunction::SCANNER},
+        1);
+    auto const cluster2 = createChain(
+        {Enums::CellFunction::COMPUTER,
+         Enums::CellFunction::SCANNER,
+         Enums::CellFunction::COMPUTER,
+         Enums::CellFunction::SCANNER},
+        1);
+    EXPECT_NE(ClusterFingerprint::calc(cluster1), ClusterFingerprint::calc(cluster2));
+}
+
+TEST_F(ClusterFingerprintTest, testDifferentFeatures)
+{
+    auto const cluster = createChain({Enums::CellFunction::COMPUTER, Enums::CellFunction::COMPUTER}, 1);
+
+    auto clusterWithData = cluster;
+    clusterWithData.cells->at(0).cellFeature->setConstData(QByteArray(1, 'a'));
+    EXPECT_NE(ClusterFingerprint::calc(cluster), ClusterFingerprint::calc(clusterWithData));
+
+    auto clusterWithToken = cluster;
+    clusterWithToken.cells->at(1).addToken(TokenDescription());
+    EXPECT_TRUE(ClusterFingerprint::hasToken(clusterWithToken));
+    EXPECT_NE(ClusterFingerprint::calc(cluster), ClusterFingerprint::calc(clusterWithToken));
+}
+
+TEST_F(ClusterFingerprintTest, testCalcForData)
+{
+    DataDescription data;
+    for (int i = 0; i < 300; ++i) {
+        auto const cellFunction = static_cast<Enums::CellFunction::Type>(i % Enums::CellFunction::_COUNTER);
+        data.addCluster(createChain({cellFunction, Enums::CellFunction::COMPUTER}, i * 10));
+    }
+
+    auto const fingerprints = ClusterFingerprint::calc(data);
+    ASSERT_EQ(300u, fingerprints.size());
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(ClusterFingerprint::calc(data.clusters->at(i)), fingerprints.at(i));
+        EXPECT_EQ(fingerprints.at(i % Enums::CellFunction::_COUNTER), fingerprints.at(i));
+    }
+    EXPECT_NE(fingerprints.at(0), fingerprints.at(1));
+}
@@ -428,6 +428,49 @@ TEST_F(DataDescriptionTransferGpuTests, regressionTestRepeatingPartialUpdateAndR
     }
 }
 
+/**
+* Situation:
+* 	- particles and clusters distributed over the universe
+* 	- data of a rect is requested and afterwards data of a shifted rect
+* Expected result: data of the shifted rect equals the data obtained by a newly created access
+*/
+TEST_F(DataDescriptionTransferGpuTests, testGetContentOfShiftedRect)
+{
+    DataDescription origData;
+    for (int i = 0; i < 100; ++i) {
+        origData.addParticle(createParticle(QVector2D{static_cast<float>(i * 6) + 0.5f, static_cast<float>(i * 3) + 0.5f}));
+    }
+    for (int i = 0; i < 20; ++i) {
+        origData.addCluster(createHorizontalCluster(
+            5, QVector2D{static_cast<float>(i * 30) + 0.5f, static_cast<float>(i * 15) + 0.5f}, QVector2D{}, 0));
+    }
+    IntegrationTestHelper::updateData(_access, _context, origData);
+
+    IntegrationTestHelper::getContent(_access, {{0, 0}, {300, 200}});
+    auto data = IntegrationTestHelper::getContent(_access, {{100, 50}, {400, 250}});
+
+    auto otherAccess = _gpuFacade->buildSimulationAccess();
+    otherAccess->init(_controller);
+    auto expectedData = IntegrationTestHelper::getContent(otherAccess, {{100, 50}, {400, 250}});
+
+    auto getIds = [](DataDescription const& data) {
+        std::multiset<uint64_t> result;
+        for (auto const& cluster : data.clusters.get_value_or({})) {
+            result.insert(cluster.id);
+            for (auto const& cell : *cluster.cells) {
+                result.insert(cell.id);
+            }
+        }
+        for (auto const& particle : data.particles.get_value_or({})) {
+            result.insert(particle.id);
+        }
+        return result;
+    };
+    EXPECT_FALSE(getIds(expectedData).empty());
+    EXPECT_EQ(getIds(expectedData), getIds(data));
+    delete otherAccess;
+}
+
 namespace
 {
     EngineGpuData getEngineGpuDataForMinClusterArraySizes()
@@ -0,0 +1,163 @@
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "EngineGpu/DataTileCache.h"
+#include "EngineInterface/SpaceProperties.h"
+
+class DataTileCacheTest : public ::testing::Test
+{
+public:
+    DataTileCacheTest();
+    virtual ~DataTileCacheTest() = default;
+
+protected:
+    //one particle in the middle of each tile of rect
+    DataDescription createData(IntRect const& rect) const;
+
+    set<uint64_t> getParticleIds() const;
+    uint64_t getParticleId(IntVector2D const& pos) const;
+
+    void checkRect(IntRect const& expected, boost::optional<IntRect> const& actual) const;
+
+    //world consists of 4 x 3 tiles, the last column and row are smaller
+    IntVector2D const _worldSize{100, 80};
+    int const _tileSize = 30;
+    SpaceProperties _space;
+    DataTileCache _cache;
+};
+
+DataTileCacheTest::DataTileCacheTest()
+{
+    _space.init(_worldSize);
+    _cache.init(&_space, _tileSize);
+}
+
+DataDescription DataTileCacheTest::createData(IntRect const& rect) const
+{
+    DataDescription result;
+    for (int y = rect.p1.y; y < rect.p2.y; y += _tileSize) {
+        for (int x = rect.p1.x; x < rect.p2.x; x += _tileSize) {
+            IntVector2D const pos{x + 5, y + 5};
+            result.addParticle(ParticleDescription().setId(getParticleId(pos)).setPos(QVector2D(pos.x, pos.y)));
+        }
+    }
+    return result;
+}
+
+set<uint64_t> DataTileCacheTest::getParticleIds() const
+{
+    set<uint64_t> result;
+    auto const& data = _cache.getData();
+    if (data.particles) {
+        for (auto const& particle : *data.particles) {
+            result.insert(particle.id);
+        }
+    }
+    return result;
+}
+
+uint64_t DataTileCacheTest::getParticleId(IntVector2D const& pos) const
+{
+    return pos.x + pos.y * 1000;
+}
+
+void DataTileCacheTest::checkRect(IntRect const& expected, boost::optional<IntRect> const& actual) const
+{
+    ASSERT_TRUE(actual);
+    EXPECT_EQ(expected.p1.x, actual->p1.x);
+    EXPECT_EQ(expected.p1.y, actual->p1.y);
+    EXPECT_EQ(expected.p2.x, actual->p2.x);
+    EXPECT_EQ(expected.p2.y, actual->p2.y);
+}
+
+TEST_F(DataTileCacheTest, testCoveringRectIsTileAligned)
+{
+    checkRect({{30, 0}, {90, 60}}, _cache.getCoveringRect({{35, 10}, {70, 45}}));
+
+    //tile-aligned rect does not reach into the adjacent tiles
+    checkRect({{30, 30}, {60, 60}}, _cache.getCoveringRect({{30, 30}, {60, 60}}));
+}
+
+TEST_F(DataTileCacheTest, testOnlyMissingTilesAreFetched)
+{
+    auto const coveringRect = _cache.getCoveringRect({{0, 0}, {60, 60}});
+    checkRect(coveringRect, _cache.getRectToFetch(coveringRect, 1));
+    EXPECT_FALSE(_cache.getDataVersion());
+
+    ASSERT_TRUE(_cache.update(createData(coveringRect), coveringRect, coveringRect, 1));
+    EXPECT_EQ(1, *_cache.getDataVersion());
+    EXPECT_EQ(4, getParticleIds().size());
+
+    //nothing is missing at the same version
+    EXPECT_FALSE(_cache.getRectToFetch(coveringRect, 1));
+    EXPECT_FALSE(_cache.getRectToFetch(_cache.getCoveringRect({{10, 10}, {20, 50}}), 1));
+}
+
+TEST_F(DataTileCacheTest, testVersionBumpInvalidatesTiles)
+{
+    auto const coveringRect = _cache.getCoveringRect({{0, 0}, {60, 60}});
+    ASSERT_TRUE(_cache.update(createData(coveringRect), coveringRect, coveringRect, 1));
+
+    checkRect(coveringRect, _cache.getRectToFetch(coveringRect, 2));
+
+    //fetching only a part at the new version is rejected since the remaining tiles are outdated
+    IntRect const partRect{{30, 0}, {60, 60}};
+    EXPECT_FALSE(_cache.update(createData(partRect), partRect, coveringRect, 2));
+    EXPECT_FALSE(_cache.getDataVersion());
+    EXPECT_TRUE(getParticleIds().empty());
+    checkRect(coveringRect, _cache.getRectToFetch(coveringRect, 1));
+}
+
+TEST_F(DataTileCacheTest, testPartlyOverlappingViewport)
+{
+    auto const coveringRect = _cache.getCoveringRect({{0, 0}, {60, 60}});
+    ASSERT_TRUE(_cache.update(createData(coveringRect), coveringRect, coveringRect, 1));
+
+    //viewport is shifted by one tile to the right, only the new column is missing
+    auto const shiftedCoveringRect = _cache.getCoveringRect({{35, 5}, {85, 55}});
+    checkRect({{30, 0}, {90, 60}}, shiftedCoveringRect);
+    auto const rectToFetch = _cache.getRectToFetch(shiftedCoveringRect, 1);
+    checkRect({{60, 0}, {90, 60}}, rectToFetch);
+
+    //data of the left column is dropped, data of the overlap is kept
+    ASSERT_TRUE(_cache.update(createData(*rectToFetch), *rectToFetch, shiftedCoveringRect, 1));
+    EXPECT_EQ(
+        (set<uint64_t>{
+            getParticleId({35, 5}), getParticleId({35, 35}), getParticleId({65, 5}), getParticleId({65, 35})}),
+        getParticleIds());
+    EXPECT_FALSE(_cache.getRectToFetch(shiftedCoveringRect, 1));
+
+    //tiles of the dropped column have to be fetched again
+    checkRect({{0, 0}, {30, 60}}, _cache.getRectToFetch(coveringRect, 1));
+}
+
+TEST_F(DataTileCacheTest, testRectCrossingWorldBorder)
+{
+    //covering rect is clipped at the world border including the smaller last tiles
+    auto const coveringRect = _cache.getCoveringRect({{80, 70}, {130, 95}});
+    checkRect({{60, 60}, {100, 80}}, coveringRect);
+    checkRect(coveringRect, _cache.getRectToFetch(coveringRect, 1));
+
+    //positions beyond the border are taken modulo the world size
+    DataDescription data;
+    data.addParticle(ParticleDescription().setId(1).setPos({-5, 65}));    //at (95, 65)
+    data.addParticle(ParticleDescription().setId(2).setPos({105, 65}));   //at (5, 65)
+    data.addParticle(ParticleDescription().setId(3).setPos({75, -10}));   //at (75, 70)
+    ASSERT_TRUE(_cache.update(std::move(data), coveringRect, coveringRect, 1));
+    _cache.restrictToRect(_cache.getCoveringRect({{90, 60}, {100, 80}}));
+    EXPECT_EQ(set<uint64_t>{1}, getParticleIds());
+}
+
+TEST_F(DataTileCacheTest, testCachedTilesAreOnlyReusedWhilePaused)
+{
+    EXPECT_FALSE(_cache.getReusableDataVersion(false));
+
+    auto const coveringRect = _cache.getCoveringRect({{0, 0}, {60, 60}});
+    ASSERT_TRUE(_cache.update(createData(coveringRect), coveringRect, coveringRect, 1));
+    EXPECT_EQ(1, *_cache.getReusableDataVersion(false));
+    EXPECT_FALSE(_cache.getReusableDataVersion(true));
+
+    _cache.invalidate();
+    EXPECT_FALSE(_cache.getReusableDataVersion(false));
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Colors.h"
+#include "EngineInterface/DensityPyramid.h"
+#include "EngineInterface/Descriptions.h"
+
+class DensityPyramidTest : public ::testing::Test
+{
+public:
+    DensityPyramidTest();
+    virtual ~DensityPyramidTest() = default;
+
+protected:
+    DataDescription createData() const;
+    int getTotalNumCells() const;
+
+    IntVector2D const _universeSize{100, 60};
+    IntRect const _universeRect{{0, 0}, {100, 60}};
+    int const _binSize = 8;
+
+    DensityPyramid _pyramid;
+};
+
+DensityPyramidTest::DensityPyramidTest()
+{
+    _pyramid.init(_universeSize, _binSize);
+}
+
+DataDescription DensityPyramidTest::createData() const
+{
+    DataDescription result;
+    uint64_t id = 0;
+    for (int i = 0; i < 10; ++i) {
+        auto cell = CellDescription()
+                        .setId(++id)
+                        .setPos({static_cast<float>(i * 10) + 0.5f, 5.0f})
+                        .setEnergy(100)
+                        .setMetadata(CellMetadata().setColor(i));
+        result.addCluster(ClusterDescription().setId(++id).addCell(cell));
+    }
+    result.addParticle(ParticleDescription().setId(++id).setPos({99.5f, 59.5f}).setEnergy(10));
+
+    //lies outside the universe and is mapped to position (2, 5)
+    auto cell = CellDescription().setId(++id).setPos({-98.0f, 5.0f}).setEnergy(100);
+    result.addCluster(ClusterDescription().setId(++id).addCell(cell));
+    return result;
+}
+
+int DensityPyramidTest::getTotalNumCells() const
+{
+    return _pyramid.getBin(_pyramid.getNumLevels() - 1, {0, 0}).numCells;
+}
+
+TEST_F(DensityPyramidTest, testLevels)
+{
+    ASSERT_EQ(5, _pyramid.getNumLevels());
+    EXPECT_EQ(13, _pyramid.getLevelSize(0).x);
+    EXPECT_EQ(8, _pyramid.getLevelSize(0).y);
+    EXPECT_EQ(1, _pyramid.getLevelSize(4).x);
+    EXPECT_EQ(1, _pyramid.getLevelSize(4).y);
+    EXPECT_EQ(0, _pyramid.getLevelForZoom(1.0f));
+    EXPECT_EQ(2, _pyramid.getLevelForZoom(1.0f / 30));
+    EXPECT_FALSE(_pyramid.isComplete());
+}
+
+TEST_F(DensityPyramidTest, testUpdateWholeUniverse)
+{
+    _pyramid.update(createData(), _universeRect);
+
+    EXPECT_TRUE(_pyramid.isComplete());
+    EXPECT_EQ(11, getTotalNumCells());
+    EXPECT_EQ(1, _pyramid.getBin(_pyramid.getNumLevels() - 1, {0, 0}).numParticles);
+
+    auto const& bin = _pyramid.getBin(0, {0, 0});
+    EXPECT_EQ(2, bin.numCells);
+    EXPECT_EQ(2, bin.numCellsByColor[0]);
+    EXPECT_FLOAT_EQ(200.0f, bin.cellEnergy);
+    EXPECT_EQ(1, _pyramid.getBin(0, {12, 7}).numParticles);
+}
+
+TEST_F(DensityPyramidTest, testUpdateRegion)
+{
+    _pyramid.update(createData(), _universeRect);
+
+    //only bins lying completely inside the region are replaced
+    _pyramid.update(DataDescription(), {{0, 0}, {23, 60}});
+
+    EXPECT_EQ(0, _pyramid.getBin(0, {0, 0}).numCells);
+    EXPECT_EQ(0, _pyramid.getBin(0, {1, 0}).numCells);
+    EXPECT_EQ(1, _pyramid.getBin(0, {2, 0}).numCells);
+    EXPECT_EQ(8, getTotalNumCells());
+}
+
+TEST_F(DensityPyramidTest, testRender)
+{
+    _pyramid.update(createData(), _universeRect);
+
+    QImage image(60, 40, QImage::Format_RGBA8888);
+    _pyramid.render(RealRect{{-10, -10}, {50, 30}}, 1.0f, image);
+
+    auto pixel = [&](int x, int y) { return reinterpret_cast<unsigned int const*>(image.constBits())[x + y * 60]; };
+    EXPECT_EQ(Const::NothingnessColor, pixel(5, 5));
+    EXPECT_EQ(Const::SpaceColor, pixel(20, 30));
+    EXPECT_NE(Const::SpaceColor, pixel(11, 15));
+}
+
+TEST_F(DensityPyramidTest, testRenderPixelsOfBin)
+{
+    _pyramid.update(createData(), _universeRect);
+
+    //at zoom 2 a bin of level 0 covers 16 x 16 pixels
+    QImage image(200, 120, QImage::Format_RGBA8888);
+    _pyramid.render(RealRect{{0, 0}, {100, 60}}, 2.0f, image);
+
+    auto pixel = [&](int x, int y) { return reinterpret_cast<unsigned int const*>(image.constBits())[x + y * 200]; };
+    auto const binPixel = pixel(0, 0);
+    EXPECT_NE(Const::SpaceColor, binPixel);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            ASSERT_EQ(binPixel, pixel(x, y));
+        }
+    }
+    EXPECT_NE(binPixel, pixel(16, 0));
+    EXPECT_EQ(Const::SpaceColor, pixel(0, 16));
+}
@@ -0,0 +1,344 @@
+#include <cmath>
+#include <queue>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "Base/Parallel.h"
+#include "Base/ServiceLocator.h"
+#include "EngineInterface/DescriptionFactory.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationParameters.h"
+
+class DescriptionFactoryTest : public ::testing::Test
+{
+public:
+    DescriptionFactoryTest();
+    virtual ~DescriptionFactoryTest();
+
+protected:
+    //cells are numbered 1, ..., n and two cells are connected if and only if they are lattice neighbors, i.e. their
+    //distance equals cellDistance
+    void checkLattice(ClusterDescription const& cluster, double cellDistance) const;
+
+    //positions and connections are equal for one and several threads
+    template <typename CreateFunc>
+    void checkIndependentOfThreadCount(CreateFunc const& createFunc) const;
+
+    //number of triangular lattice sites whose position satisfies the predicate
+    template <typename Predicate>
+    int countTriangularLatticeSites(double cellDistance, int maxRow, Predicate const& isInside) const;
+
+    //sequential breadth-first search over the connections, returns the distances to the nearest start cell by cell id
+    unordered_map<uint64_t, int> calcDistances(
+        ClusterDescription const& cluster,
+        std::unordered_set<uint64_t> const& startCellIds) const;
+
+    //branch numbers equal the distances modulo cellMaxTokenBranchNumber for one and several threads
+    void checkBranchNumbers(ClusterDescription const& cluster, std::unordered_set<uint64_t> const& startCellIds);
+
+    DescriptionFactory* _factory = nullptr;
+    SimulationParameters _parameters;
+};
+
+DescriptionFactoryTest::DescriptionFactoryTest()
+{
+    _factory = ServiceLocator::getInstance().getService<DescriptionFactory>();
+    _parameters.cellMaxTokenBranchNumber = 6;
+}
+
+DescriptionFactoryTest::~DescriptionFactoryTest()
+{
+    Parallel::setNumThreads(0);
+}
+
+void DescriptionFactoryTest::checkLattice(ClusterDescription const& cluster, double cellDistance) const
+{
+    ASSERT_TRUE(cluster.cells);
+    auto const& cells = *cluster.cells;
+    auto const numCells = static_cast<int>(cells.size());
+    for (int i = 0; i < numCells; ++i) {
+        ASSERT_EQ(i + 1, cells[i].id);
+    }
+
+    //brute force over all pairs
+    for (int i = 0; i < numCells; ++i) {
+        auto const& connectingCells = *cells[i].connectingCells;
+        std::set<uint64_t> const connectedIds(connectingCells.begin(), connectingCells.end());
+        ASSERT_EQ(connectingCells.size(), connectedIds.size());
+        for (int j = 0; j < numCells; ++j) {
+            auto const distance = (*cells[i].pos - *cells[j].pos).length();
+            auto const isNeighbor = i != j && std::abs(distance - cellDistance) < 0.01;
+            ASSERT_EQ(isNeighbor, connectedIds.count(cells[j].id) == 1) << "cells " << i + 1 << " and " << j + 1;
+        }
+    }
+}
+
+template <typename CreateFunc>
+void DescriptionFactoryTest::checkIndependentOfThreadCount(CreateFunc const& createFunc) const
+{
+    Parallel::setNumThreads(1);
+    auto const sequentialCluster = createFunc();
+    Parallel::setNumThreads(7);
+    auto const parallelCluster = createFunc();
+    Parallel::setNumThreads(0);
+
+    auto const& sequentialCells = *sequentialCluster.cells;
+    auto const& parallelCells = *parallelCluster.cells;
+    ASSERT_EQ(sequentialCells.size(), parallelCells.size());
+    for (int i = 0; i < sequentialCells.size(); ++i) {
+        ASSERT_EQ(sequentialCells[i].id, parallelCells[i].id);
+        ASSERT_EQ(*sequentialCells[i].pos, *parallelCells[i].pos);
+        ASSERT_EQ(*sequentialCells[i].connectingCells, *parallelCells[i].connectingCells);
+    }
+}
+
+template <typename Predicate>
+int DescriptionFactoryTest::countTriangularLatticeSites(double cellDistance, int maxRow, Predicate const& isInside)
+    const
+{
+    int result = 0;
+    for (int row = -maxRow; row <= maxRow; ++row) {
+        for (int column = -2 * maxRow; column <= 2 * maxRow; ++column) {
+            QVector2D const pos(
+                (column + row / 2.0) * cellDistance, row * std::sqrt(3.0) / 2.0 * cellDistance);
+            if (isInside(pos)) {
+                ++result;
+            }
+        }
+    }
+    return result;
+}
+
+unordered_map<uint64_t, int> DescriptionFactoryTest::calcDistances(
+    ClusterDescription const& cluster,
+    std::unordered_set<uint64_t> const& startCellIds) const
+{
+    unordered_map<uint64_t, CellDescription const*> cellsByIds;
+    for (auto const& cell : *cluster.cells) {
+        cellsByIds.emplace(cell.id, &cell);
+    }
+
+    unordered_map<uint64_t, int> result;
+    std::queue<uint64_t> cellIdQueue;
+    for (auto const& cellId : startCellIds) {
+        result.emplace(cellId, 0);
+        cellIdQueue.push(cellId);
+    }
+    while (!cellIdQueue.empty()) {
+        auto const cellId = cellIdQueue.front();
+        cellIdQueue.pop();
+        for (auto const& connectingCellId : *cellsByIds.at(cellId)->connectingCells) {
+            if (result.emplace(connectingCellId, result.at(cellId) + 1).second) {
+                cellIdQueue.push(connectingCellId);
+            }
+        }
+    }
+    return result;
+}
+
+void DescriptionFactoryTest::checkBranchNumbers(
+    ClusterDescription const& cluster,
+    std::unordered_set<uint64_t> const& startCellIds)
+{
+    auto const distances = calcDistances(cluster, startCellIds);
+    ASSERT_EQ(cluster.cells->size(), distances.size());
+
+    for (int numThreads : {1, 7}) {
+        Parallel::setNumThreads(numThreads);
+        DataDescription data;
+        data.addCluster(cluster);
+        _factory->generateBranchNumbers(_parameters, data, startCellIds);
+        for (auto const& cell : *data.clusters->front().cells) {
+            ASSERT_EQ(distances.at(cell.id) % _parameters.cellMaxTokenBranchNumber, *cell.tokenBranchNumber)
+                << "cell " << cell.id << " with " << numThreads << " threads";
+        }
+    }
+    Parallel::setNumThreads(0);
+}
+
+TEST_F(DescriptionFactoryTest, testRect)
+{
+    auto const cluster = _factory->createRect(
+        DescriptionFactory::CreateRectParameters().size({4, 3}).cellDistance(2.0).centerPosition({10, 20}));
+
+    ASSERT_EQ(12, cluster.cells->size());
+    EXPECT_EQ(QVector2D(10, 20), *cluster.pos);
+
+    //sites lie on a grid centered at the center position
+    std::set<std::pair<int, int>> positions;
+    for (auto const& cell : *cluster.cells) {
+        positions.emplace(toInt(std::round(cell.pos->x() - 10 + 3)), toInt(std::round(cell.pos->y() - 20 + 2)));
+    }
+    std::set<std::pair<int, int>> expectedPositions;
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 3; ++y) {
+            expectedPositions.emplace(x * 2, y * 2);
+        }
+    }
+    EXPECT_EQ(expectedPositions, positions);
+
+    checkLattice(cluster, 2.0);
+}
+
+TEST_F(DescriptionFactoryTest, testRing)
+{
+    auto const cluster = _factory->createRing(DescriptionFactory::CreateRingParameters()
+                                                  .outerRadius(5.0)
+                                                  .innerRadius(3.0)
+                                                  .cellDistance(1.0)
+                                                  .centerPosition({50, 40}));
+
+    //the lattice is symmetric to the origin, hence the center of the cells coincides with the lattice origin
+    auto const expectedNumCells = countTriangularLatticeSites(1.0, 10, [](QVector2D const& pos) {
+        return pos.length() >= 3.0 - 1e-6 && pos.length() <= 5.0 + 1e-6;
+    });
+    ASSERT_EQ(expectedNumCells, cluster.cells->size());
+    for (auto const& cell : *cluster.cells) {
+        auto const radius = (*cell.pos - QVector2D(50, 40)).length();
+        EXPECT_GE(radius, 3.0 - 0.01);
+        EXPECT_LE(radius, 5.0 + 0.01);
+    }
+
+    checkLattice(cluster, 1.0);
+}
+
+TEST_F(DescriptionFactoryTest, testFilledPolygon)
+{
+    //no lattice site lies on the boundary, which would make the even-odd rule ambiguous
+    vector<QVector2D> const vertices = {{-6.2f, -4}, {6.2f, -4}, {6.2f, 4}, {-6.2f, 4}};
+    auto const cluster = _factory->createFilledPolygon(
+        DescriptionFactory::CreatePolygonParameters().vertices(vertices).cellDistance(1.5).centerPosition({30, 30}));
+
+    auto const expectedNumCells = countTriangularLatticeSites(1.5, 10, [](QVector2D const& pos) {
+        return std::abs(pos.x()) < 6.2 && std::abs(pos.y()) < 4;
+    });
+    ASSERT_EQ(expectedNumCells, cluster.cells->size());
+
+    //the sites are symmetric to the lattice origin, hence their center coincides with the center position
+    QVector2D center;
+    for (auto const& cell : *cluster.cells) {
+        center += *cell.pos;
+    }
+    center /= static_cast<float>(cluster.cells->size());
+    EXPECT_NEAR(30, center.x(), 0.01);
+    EXPECT_NEAR(30, center.y(), 0.01);
+    for (auto const& cell : *cluster.cells) {
+        EXPECT_LT(std::abs(cell.pos->x() - 30), 6.2);
+        EXPECT_LT(std::abs(cell.pos->y() - 30), 4.0);
+    }
+
+    checkLattice(cluster, 1.5);
+}
+
+TEST_F(DescriptionFactoryTest, testFilledAsymmetricPolygon)
+{
+    //triangle with a vertex near the origin: cells must stay where the vertices are and must not be centered
+    vector<QVector2D> const vertices = {{-0.3f, -0.3f}, {10.2f, -0.3f}, {-0.3f, 8.1f}};
+    auto isInsideTriangle = [&vertices](QVector2D const& pos) {
+        for (int i = 0; i < 3; ++i) {
+            auto const& v1 = vertices[i];
+            auto const& v2 = vertices[(i + 1) % 3];
+            if ((v2.x() - v1.x()) * (pos.y() - v1.y()) - (v2.y() - v1.y()) * (pos.x() - v1.x()) < 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+    QVector2D const centerPosition(30, 30);
+    auto const cluster = _factory->createFilledPolygon(
+        DescriptionFactory::CreatePolygonParameters().vertices(vertices).centerPosition(centerPosition));
+
+    ASSERT_EQ(countTriangularLatticeSites(1.0, 20, isInsideTriangle), cluster.cells->size());
+    auto const rowDistance = std::sqrt(3.0) / 2.0;
+    for (auto const& cell : *cluster.cells) {
+        auto const relPos = *cell.pos - centerPosition;
+        EXPECT_TRUE(isInsideTriangle(relPos)) << "cell " << cell.id;
+
+        //cells lie on the lattice whose origin is the center position
+        auto const row = std::round(relPos.y() / rowDistance);
+        auto const column = relPos.x() - row / 2.0;
+        EXPECT_NEAR(row * rowDistance, relPos.y(), 0.001);
+        EXPECT_NEAR(std::round(column), column, 0.001);
+    }
+    auto const cellCenter = cluster.getClusterPosFromCells();
+    EXPECT_NEAR(cellCenter.x(), cluster.pos->x(), 0.001);
+    EXPECT_NEAR(cellCenter.y(), cluster.pos->y(), 0.001);
+
+    checkLattice(cluster, 1.0);
+}
+
+TEST_F(DescriptionFactoryTest, testIndependentOfThreadCount)
+{
+    //large enough that all loops are split into several chunks
+    checkIndependentOfThreadCount([&] {
+        return _factory->createRect(DescriptionFactory::CreateRectParameters().size({60, 50}));
+    });
+    checkIndependentOfThreadCount([&] {
+        return _factory->createRing(DescriptionFactory::CreateRingParameters().outerRadius(40).innerRadius(20));
+    });
+    checkIndependentOfThreadCount([&] {
+        return _factory->createFilledPolygon(
+            DescriptionFactory::CreatePolygonParameters().vertices({{-40, -30}, {40, -30}, {0, 30}}));
+    });
+}
+
+TEST_F(DescriptionFactoryTest, testBranchNumbersFromOneCell)
+{
+    auto const cluster =
+        _factory->createRing(DescriptionFactory::CreateRingParameters().outerRadius(20).innerRadius(8));
+    checkBranchNumbers(cluster, {1});
+}
+
+TEST_F(DescriptionFactoryTest, testBranchNumbersFromSeveralCells)
+{
+    //start from all boundary cells such that the frontiers are split into several chunks
+    int const size = 400;
+    auto const cluster = _factory->createRect(DescriptionFactory::CreateRectParameters().size({size, size}));
+    std::unordered_set<uint64_t> startCellIds;
+    for (auto const& cell : *cluster.cells) {
+        if (cell.connectingCells->size() < 4) {
+            startCellIds.insert(cell.id);
+        }
+    }
+    ASSERT_EQ(4 * (size - 1), startCellIds.size());
+    checkBranchNumbers(cluster, startCellIds);
+}
+
+TEST_F(DescriptionFactoryTest, testRandomizeCellFunctionsIsReproducible)
+{
+    auto const cluster = _factory->createRect(DescriptionFactory::CreateRectParameters().size({60, 50}));
+    std::unordered_set<uint64_t> cellIds;
+    for (auto const& cell : *cluster.cells) {
+        cellIds.insert(cell.id);
+    }
+    _parameters.cellFunctionComputerMaxInstructions = 15;
+    _parameters.cellFunctionComputerCellMemorySize = 8;
+    auto randomize = [&](uint64_t seed, int numThreads) {
+        Parallel::setNumThreads(numThreads);
+        DataDescription data;
+        data.addCluster(cluster);
+        _factory->randomizeCellFunctions(_parameters, data, cellIds, seed);
+        return data;
+    };
+
+    auto const data = randomize(42, 1);
+    auto const sameSeedData = randomize(42, 7);
+    auto const otherSeedData = randomize(43, 7);
+    auto const& cells = *data.clusters->front().cells;
+    auto const& sameSeedCells = *sameSeedData.clusters->front().cells;
+    auto const& otherSeedCells = *otherSeedData.clusters->front().cells;
+    int numDifferentCells = 0;
+    for (int i = 0; i < cells.size(); ++i) {
+        auto const& feature = *cells[i].cellFeature;
+        auto const& sameSeedFeature = *sameSeedCells[i].cellFeature;
+        auto const& otherSeedFeature = *otherSeedCells[i].cellFeature;
+        ASSERT_EQ(15 * 3, feature.volatileData.size());
+        ASSERT_EQ(8, feature.constData.size());
+        ASSERT_TRUE(feature == sameSeedFeature) << "cell " << cells[i].id;
+        if (feature.volatileData != otherSeedFeature.volatileData) {
+            ++numDifferentCells;
+        }
+    }
+    EXPECT_EQ(cells.size(), numDifferentCells);
+}
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionInstancer.h"
+#include "EngineInterface/Descriptions.h"
+
+class DescriptionInstancerTest : public ::testing::Test
+{
+public:
+    virtual ~DescriptionInstancerTest() = default;
+
+protected:
+    //two connected cells at (0, 0) and (2, 0) and a particle at (1, 3)
+    DataDescription createPrototype() const;
+};
+
+DataDescription DescriptionInstancerTest::createPrototype() const
+{
+    DataDescription result;
+    result.addCluster(ClusterDescription()
+                          .setId(10)
+                          .setPos({1, 0})
+                          .setVel({0, 0})
+                          .setAngle(0)
+                          .setAngularVel(0)
+                          .addCells({CellDescription().setId(11).setPos({0, 0}).setConnectingCells({12}),
+                                     CellDescription().setId(12).setPos({2, 0}).setConnectingCells({11})}));
+    result.addParticle(ParticleDescription().setId(20).setPos({1, 3}).setVel({0, 0}));
+    return result;
+}
+
+TEST_F(DescriptionInstancerTest, testIdsAreConsecutiveAndConnectionsRemapped)
+{
+    auto const prototype = createPrototype();
+    EXPECT_EQ(4, DescriptionInstancer::getNumIdsPerInstance(prototype));
+
+    vector<DescriptionInstancer::Transform> transforms(100);
+    auto const instances = DescriptionInstancer::createInstances(prototype, transforms, 1000);
+    ASSERT_EQ(100, instances.clusters->size());
+    ASSERT_EQ(100, instances.particles->size());
+
+    std::unordered_set<uint64_t> ids;
+    for (int i = 0; i < 100; ++i) {
+        auto const& cluster = instances.clusters->at(i);
+        auto const& cells = *cluster.cells;
+        ids.insert(cluster.id);
+        ids.insert(cells[0].id);
+        ids.insert(cells[1].id);
+        ids.insert(instances.particles->at(i).id);
+        EXPECT_EQ(list<uint64_t>{cells[1].id}, *cells[0].connectingCells);
+        EXPECT_EQ(list<uint64_t>{cells[0].id}, *cells[1].connectingCells);
+    }
+    EXPECT_EQ(400, ids.size());
+    EXPECT_EQ(1000, *std::min_element(ids.begin(), ids.end()));
+    EXPECT_EQ(1399, *std::max_element(ids.begin(), ids.end()));
+}
+
+TEST_F(DescriptionInstancerTest, testTransform)
+{
+    auto const prototype = createPrototype();   //center is (1, 1)
+
+    DescriptionInstancer::Transform transform;
+    transform.posDelta = {10, 20};
+    transform.angle = 90;
+    transform.velocityXDelta = 0.5;
+    transform.angularVelocityDelta = 2;
+    auto const instances = DescriptionInstancer::createInstances(prototype, {transform}, 1);
+
+    auto const& cluster = instances.clusters->front();
+    auto const& particle = instances.particles->front();
+    auto expectNear = [](QVector2D const& expected, QVector2D const& actual) {
+        EXPECT_NEAR(expected.x(), actual.x(), 1e-4);
+        EXPECT_NEAR(expected.y(), actual.y(), 1e-4);
+    };
+    expectNear({12, 21}, *cluster.pos);
+    expectNear({12, 20}, *cluster.cells->at(0).pos);
+    expectNear({12, 22}, *cluster.cells->at(1).pos);
+    expectNear({9, 21}, *particle.pos);
+    expectNear({0.5, 0}, *cluster.vel);
+    expectNear({0.5, 0}, *particle.vel);
+    EXPECT_NEAR(90, *cluster.angle, 1e-4);
+    EXPECT_NEAR(2, *cluster.angularVel, 1e-4);
+}
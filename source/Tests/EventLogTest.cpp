@@ -0,0 +1,202 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Base/EventLog.h"
+#include "Base/EventLogReader.h"
+
+class EventLogTest : public ::testing::Test
+{
+public:
+    EventLogTest();
+    virtual ~EventLogTest();
+
+protected:
+    void removeSegments();
+
+    EventLog::Config _config;
+};
+
+EventLogTest::EventLogTest()
+{
+    _config.baseFilename = "EventLogTest";
+    _config.segmentSize = sizeof(EventLog::SegmentHeader) + 100 * sizeof(EventLog::Record);
+    _config.numSegments = 3;
+    removeSegments();
+}
+
+EventLogTest::~EventLogTest()
+{
+    removeSegments();
+}
+
+void EventLogTest::removeSegments()
+{
+    for (auto const& filename : EventLog::getSegmentFilenames(_config.baseFilename)) {
+        std::remove(filename.c_str());
+    }
+}
+
+TEST_F(EventLogTest, testReadWrittenRecords)
+{
+    {
+        EventLog log;
+        ASSERT_TRUE(log.open(_config));
+        log.logTimestep(10, 2.5);
+        log.logCounter("numCells", 1000);
+        log.logParameter("cell.function.constructor.offspring.cell energy", 50);
+        log.logJobEvent(EventLog::JobEvent::Added, "job");
+        log.logJobEvent(EventLog::JobEvent::Finished, "job");
+        log.logTimestep(11, 2.0);
+        log.logCounter("numCells", 1001);
+    }
+
+    vector<EventLogReader::Entry> entries;
+    ASSERT_TRUE(EventLogReader::read(_config.baseFilename, entries));
+    ASSERT_EQ(7, entries.size());
+
+    EXPECT_EQ(EventLog::Type::Timestep, entries.at(0).type);
+    EXPECT_EQ(10, entries.at(0).timestep);
+    EXPECT_EQ(2.5, entries.at(0).value);
+    EXPECT_EQ(EventLog::Type::Counter, entries.at(1).type);
+    EXPECT_EQ("numCells", entries.at(1).name);
+    EXPECT_EQ(10, entries.at(1).timestep);
+    EXPECT_EQ(1000, entries.at(1).value);
+    EXPECT_EQ(EventLog::Type::Parameter, entries.at(2).type);
+    EXPECT_EQ("cell.function.constructor.offspring.cell energy", entries.at(2).name);
+    EXPECT_EQ("added", entries.at(3).name);
+    EXPECT_EQ("finished", entries.at(4).name);
+    EXPECT_EQ(entries.at(3).value, entries.at(4).value);
+    EXPECT_EQ(1001, entries.at(6).value);
+    EXPECT_EQ(11, entries.at(6).timestep);
+    EXPECT_LE(entries.front().time, entries.back().time);
+
+    std::stringstream csv;
+    EventLogReader::writeCsv(csv, entries);
+    string line;
+    std::getline(csv, line);
+    EXPECT_EQ("time,timestep,type,name,value", line);
+    std::getline(csv, line);
+    EXPECT_EQ(std::to_string(entries.at(0).time) + ",10,timestep,timestep,2.5", line);
+    std::getline(csv, line);
+    EXPECT_EQ(std::to_string(entries.at(1).time) + ",10,counter,numCells,1000", line);
+}
+
+TEST_F(EventLogTest, testRotation)
+{
+    EventLog log;
+    ASSERT_TRUE(log.open(_config));
+    for (int timestep = 0; timestep < 1000; ++timestep) {
+        log.logTimestep(timestep, 1.0);
+        log.logCounter("numParticles", timestep);
+
+        //avoid dropping records in the bounded buffer
+        if (timestep % 100 == 0) {
+            log.flush();
+        }
+    }
+    log.close();
+    EXPECT_EQ(0, log.getNumDroppedRecords());
+
+    auto const filenames = EventLog::getSegmentFilenames(_config.baseFilename);
+    ASSERT_EQ(_config.numSegments, filenames.size());
+
+    //each segment has its own name definitions
+    for (auto const& filename : filenames) {
+        vector<EventLogReader::Entry> entries;
+        ASSERT_TRUE(EventLogReader::readSegment(filename, entries));
+        ASSERT_FALSE(entries.empty());
+        for (auto const& entry : entries) {
+            if (entry.type == EventLog::Type::Counter) {
+                EXPECT_EQ("numParticles", entry.name);
+                EXPECT_EQ(entry.timestep, entry.value);
+            }
+        }
+    }
+
+    //the most recent records are kept
+    vector<EventLogReader::Entry> entries;
+    ASSERT_TRUE(EventLogReader::read(_config.baseFilename, entries));
+    EXPECT_EQ(999, entries.back().value);
+    EXPECT_EQ(999, entries.back().timestep);
+}
+
+TEST_F(EventLogTest, testTornTail)
+{
+    {
+        EventLog log;
+        ASSERT_TRUE(log.open(_config));
+        for (int timestep = 0; timestep < 10; ++timestep) {
+            log.logTimestep(timestep, 1.0);
+        }
+    }
+
+    //simulate a crash while writing the sixth record
+    auto const filenames = EventLog::getSegmentFilenames(_config.baseFilename);
+    ASSERT_EQ(1, filenames.size());
+    {
+        std::fstream stream(filenames.front(), std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+        stream.seekp(sizeof(EventLog::SegmentHeader) + 5 * sizeof(EventLog::Record));
+        stream.put('\xff');
+    }
+
+    vector<EventLogReader::Entry> entries;
+    ASSERT_TRUE(EventLogReader::readSegment(filenames.front(), entries));
+    ASSERT_EQ(5, entries.size());
+    EXPECT_EQ(4, entries.back().timestep);
+}
+
+TEST_F(EventLogTest, testReopenContinuesAfterExistingSegments)
+{
+    for (int run = 0; run < 2; ++run) {
+        EventLog log;
+        ASSERT_TRUE(log.open(_config));
+        log.logCounter("run", run);
+    }
+
+    auto const filenames = EventLog::getSegmentFilenames(_config.baseFilename);
+    ASSERT_EQ(2, filenames.size());
+    EXPECT_EQ(EventLog::getSegmentFilename(_config.baseFilename, 1), filenames.back());
+
+    vector<EventLogReader::Entry> entries;
+    ASSERT_TRUE(EventLogReader::read(_config.baseFilename, entries));
+    ASSERT_EQ(2, entries.size());
+    EXPECT_EQ(0, entries.at(0).value);
+    EXPECT_EQ(1, entries.at(1).value);
+}
+
+TEST_F(EventLogTest, testManyThreads)
+{
+    EventLog log;
+    _config.segmentSize = 1 << 20;
+    ASSERT_TRUE(log.open(_config));
+
+    vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&log, i] {
+            for (int j = 0; j < 1000; ++j) {
+                log.logCounter("thread" + std::to_string(i), j);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    log.close();
+
+    vector<EventLogReader::Entry> entries;
+    ASSERT_TRUE(EventLogReader::read(_config.baseFilename, entries));
+    EXPECT_EQ(4000, entries.size() + log.getNumDroppedRecords());
+    map<string, double> lastValues;
+    for (auto const& entry : entries) {
+        ASSERT_EQ("thread", entry.name.substr(0, 6));
+        auto findResult = lastValues.find(entry.name);
+        if (findResult != lastValues.end()) {
+            EXPECT_LT(findResult->second, entry.value);
+        }
+        lastValues[entry.name] = entry.value;
+    }
+}
@@ -109,3 +109,29 @@ TEST_F(GpuBenchmarkForClusterDecomposition, testClusterDecomposition)
     IntegrationTestHelper::runSimulation(1, _controller);
     std::cerr << "Time elapsed during simulation: " << timer.elapsed() << " ms" << std::endl;
 }
+
+TEST_F(GpuBenchmarkForClusterDecomposition, testReclusteringOnHost)
+{
+    IntVector2D const size{1000, 400};
+    auto cluster = createRectangularCluster(size, QVector2D{1000, 500}, QVector2D{});
+
+    //cut cluster vertically in two halves
+    auto const cutX = size.x / 2;
+    for (int y = 0; y < size.y; ++y) {
+        auto& leftCell = cluster.cells->at(cutX - 1 + y * size.x);
+        auto& rightCell = cluster.cells->at(cutX + y * size.x);
+        leftCell.connectingCells->remove(rightCell.id);
+        rightCell.connectingCells->remove(leftCell.id);
+    }
+    DataDescription data;
+    data.addCluster(cluster);
+
+    QElapsedTimer timer;
+    timer.start();
+    _descHelper->recluster(data, {cluster.id});
+    std::cerr << "Time elapsed during reclustering: " << timer.elapsed() << " ms" << std::endl;
+
+    ASSERT_EQ(2, data.clusters->size());
+    EXPECT_EQ(size.x * size.y / 2, data.clusters->at(0).cells->size());
+    EXPECT_EQ(size.x * size.y / 2, data.clusters->at(1).cells->size());
+}
@@ -0,0 +1,161 @@
+#include <random>
+
+#include <gtest/gtest.h>
+#include <QImage>
+
+#include "Web/ImageDeltaEncoder.h"
+#include "Web/ImageEncoder.h"
+
+class ImageEncoderTest : public ::testing::Test
+{
+public:
+    virtual ~ImageEncoderTest() = default;
+
+protected:
+    //image with smooth gradients, uniform areas and noise such that all QOI operations occur
+    QImage createImage(int width, int height, QImage::Format format);
+
+    void expectEqualImages(QImage const& expected, QImage const& actual) const;
+
+    std::mt19937 _engine;
+};
+
+QImage ImageEncoderTest::createImage(int width, int height, QImage::Format format)
+{
+    std::uniform_int_distribution<uint32_t> distribution;
+    QImage result(width, height, format);
+    for (int y = 0; y < height; ++y) {
+        auto const line = reinterpret_cast<uint32_t*>(result.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            uint32_t color;
+            if (y < height / 4) {
+                color = 0xff102030;
+            } else if (y < height / 2) {
+                color = 0xff000000 | (x % 256) << 16 | ((x + y) % 256) << 8 | (y * 3 % 256);
+            } else if (y < height * 3 / 4) {
+                color = 0xff000000 | (distribution(_engine) % 4 == 0 ? 0x404040 : 0x808080);
+            } else {
+                color = distribution(_engine);
+            }
+            if (QImage::Format_RGB32 == format) {
+                color |= 0xff000000;
+            }
+            line[x] = color;
+        }
+    }
+    return result;
+}
+
+void ImageEncoderTest::expectEqualImages(QImage const& expected, QImage const& actual) const
+{
+    ASSERT_EQ(expected.width(), actual.width());
+    ASSERT_EQ(expected.height(), actual.height());
+    for (int y = 0; y < expected.height(); ++y) {
+        auto const expectedLine = reinterpret_cast<uint32_t const*>(expected.constScanLine(y));
+        auto const actualLine = reinterpret_cast<uint32_t const*>(actual.constScanLine(y));
+        for (int x = 0; x < expected.width(); ++x) {
+            ASSERT_EQ(expectedLine[x], actualLine[x]) << "pixel " << x << ", " << y;
+        }
+    }
+}
+
+TEST_F(ImageEncoderTest, testQoiFormat)
+{
+    QImage image(4, 1, QImage::Format_RGB32);
+    auto const line = reinterpret_cast<uint32_t*>(image.scanLine(0));
+    line[0] = 0xff000000;
+    line[1] = 0xff000000;
+    line[2] = 0xff010203;
+    line[3] = 0xff000000;
+
+    auto const data = ImageEncoder::encodeQoi(image);
+    QByteArray expected("qoif\0\0\0\4\0\0\0\1\3\0", 14);
+    expected.append(static_cast<char>(0xc1));   //run of 2 on the initial black pixel
+    expected.append(static_cast<char>(0x80 + 32 + 2));   //luma: dg = 2
+    expected.append(static_cast<char>((-1 + 8) << 4 | (1 + 8)));
+    expected.append(static_cast<char>(0x80 + 32 - 2));   //luma: dg = -2, index is initialized with transparent black
+    expected.append(static_cast<char>((1 + 8) << 4 | (-1 + 8)));
+    expected.append(QByteArray("\0\0\0\0\0\0\0\1", 8));
+    EXPECT_EQ(expected, data);
+}
+
+TEST_F(ImageEncoderTest, testQoiRoundTrip)
+{
+    for (auto const format : {QImage::Format_RGB32, QImage::Format_ARGB32}) {
+        auto const image = createImage(301, 117, format);
+        auto const data = ImageEncoder::encodeQoi(image);
+        EXPECT_LT(data.size(), 301 * 117 * 4);
+
+        auto const decodedImage = ImageEncoder::decodeQoi(data);
+        ASSERT_FALSE(decodedImage.isNull());
+        expectEqualImages(image, decodedImage);
+    }
+}
+
+TEST_F(ImageEncoderTest, testQoiInvalidData)
+{
+    auto const data = ImageEncoder::encodeQoi(createImage(50, 50, QImage::Format_RGB32));
+    EXPECT_TRUE(ImageEncoder::decodeQoi(data.left(data.size() / 2)).isNull());
+    EXPECT_TRUE(ImageEncoder::decodeQoi(QByteArray("qoif")).isNull());
+
+    auto corruptedData = data;
+    corruptedData[4] = 0x7f;    //huge width
+    EXPECT_TRUE(ImageEncoder::decodeQoi(corruptedData).isNull());
+}
+
+TEST_F(ImageEncoderTest, testPngFormats)
+{
+    auto const image = createImage(200, 100, QImage::Format_RGB32);
+    for (auto const format : {ImageEncoder::Format::Png, ImageEncoder::Format::FastPng}) {
+        QImage decodedImage;
+        ASSERT_TRUE(decodedImage.loadFromData(ImageEncoder::encode(image, format), "PNG"));
+        expectEqualImages(image, decodedImage.convertToFormat(QImage::Format_RGB32));
+    }
+}
+
+TEST_F(ImageEncoderTest, testDeltaOnlyContainsChangedTiles)
+{
+    auto image = createImage(150, 100, QImage::Format_RGB32);
+    ImageDeltaEncoder encoder(ImageEncoder::Format::Qoi, 64, 3);
+
+    auto delta = encoder.encode(image);
+    EXPECT_TRUE(delta.keyFrame);
+    ASSERT_EQ(6, delta.tiles.size());
+    EXPECT_EQ(6, delta.tileHashes.size());
+
+    //border tiles are smaller
+    auto const lastTile = ImageEncoder::decodeQoi(delta.tiles.back().data);
+    EXPECT_EQ(128, delta.tiles.back().pos.x);
+    EXPECT_EQ(64, delta.tiles.back().pos.y);
+    EXPECT_EQ(22, lastTile.width());
+    EXPECT_EQ(36, lastTile.height());
+    expectEqualImages(image.copy(128, 64, 22, 36), lastTile);
+
+    //without acknowledgment the next delta is again a key frame
+    EXPECT_TRUE(encoder.encode(image).keyFrame);
+    encoder.acknowledge(delta);
+
+    delta = encoder.encode(image);
+    EXPECT_FALSE(delta.keyFrame);
+    EXPECT_TRUE(delta.tiles.empty());
+    encoder.acknowledge(delta);
+
+    reinterpret_cast<uint32_t*>(image.scanLine(70))[65] ^= 1;
+    delta = encoder.encode(image);
+    EXPECT_FALSE(delta.keyFrame);
+    ASSERT_EQ(1, delta.tiles.size());
+    EXPECT_EQ(64, delta.tiles.front().pos.x);
+    EXPECT_EQ(64, delta.tiles.front().pos.y);
+    encoder.acknowledge(delta);
+
+    //key frame interval reached
+    delta = encoder.encode(image);
+    EXPECT_TRUE(delta.keyFrame);
+    EXPECT_EQ(6, delta.tiles.size());
+    encoder.acknowledge(delta);
+
+    //changed image size
+    delta = encoder.encode(createImage(100, 100, QImage::Format_RGB32));
+    EXPECT_TRUE(delta.keyFrame);
+    EXPECT_EQ(4, delta.tiles.size());
+}
@@ -0,0 +1,200 @@
+#include "LocalHttpServer.h"
+
+#include <cstring>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTcpSocket>
+#include <QTimer>
+
+namespace
+{
+    auto const ApiPrefix = "/api/";
+}
+
+LocalHttpServer::LocalHttpServer(QObject* parent)
+    : QObject(parent)
+{
+    _timer.start();
+    _server.listen(QHostAddress::LocalHost);
+    connect(&_server, &QTcpServer::newConnection, this, &LocalHttpServer::newConnection);
+}
+
+string LocalHttpServer::getAddress() const
+{
+    return "http://127.0.0.1:" + std::to_string(_server.serverPort()) + ApiPrefix;
+}
+
+void LocalHttpServer::setResponse(string const& apiMethod, Response const& response)
+{
+    setResponse(apiMethod, [response](Request const&) { return response; });
+}
+
+void LocalHttpServer::setResponse(
+    string const& apiMethod,
+    std::function<Response(Request const&)> const& responseFunc)
+{
+    _responseFuncByApiMethod.insert_or_assign(apiMethod, responseFunc);
+}
+
+auto LocalHttpServer::getRequests() const -> vector<Request> const&
+{
+    return _requests;
+}
+
+auto LocalHttpServer::getRequests(string const& apiMethod) const -> vector<Request>
+{
+    vector<Request> result;
+    for (auto const& request : _requests) {
+        if (request.apiMethod == apiMethod) {
+            result.emplace_back(request);
+        }
+    }
+    return result;
+}
+
+int LocalHttpServer::getNumConnections() const
+{
+    return _numConnections;
+}
+
+bool LocalHttpServer::processEventsUntil(std::function<bool()> const& predicate, int timeout)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!predicate()) {
+        if (timer.elapsed() > timeout) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+map<string, QByteArray> LocalHttpServer::parseMultiPart(Request const& request)
+{
+    map<string, QByteArray> result;
+    auto const findResult = request.headers.find("content-type");
+    auto const contentType =
+        QByteArray::fromStdString(findResult != request.headers.end() ? findResult->second : string());
+    auto const boundaryPos = contentType.indexOf("boundary=");
+    if (boundaryPos < 0) {
+        return result;
+    }
+    auto boundary = contentType.mid(boundaryPos + 9);
+    if (boundary.startsWith('"')) {
+        boundary = boundary.mid(1, boundary.size() - 2);
+    }
+    auto const delimiter = "--" + boundary;
+
+    auto const& body = request.body;
+    auto partBegin = body.indexOf(delimiter);
+    while (partBegin >= 0) {
+        partBegin += delimiter.size();
+        if (body.mid(partBegin, 2) == "--") {
+            break;
+        }
+        auto const headerEnd = body.indexOf("\r\n\r\n", partBegin);
+        auto const partEnd = body.indexOf("\r\n" + delimiter, headerEnd);
+        if (headerEnd < 0 || partEnd < 0) {
+            break;
+        }
+        auto const header = body.mid(partBegin, headerEnd - partBegin);
+        auto const namePos = header.indexOf("name=\"");
+        if (namePos >= 0) {
+            auto const nameEnd = header.indexOf('"', namePos + 6);
+            auto const name = header.mid(namePos + 6, nameEnd - namePos - 6).toStdString();
+            result.insert_or_assign(name, body.mid(headerEnd + 4, partEnd - headerEnd - 4));
+        }
+        partBegin = partEnd + 2;
+    }
+    return result;
+}
+
+void LocalHttpServer::newConnection()
+{
+    while (auto socket = _server.nextPendingConnection()) {
+        auto const connectionId = ++_numConnections;
+        connect(socket, &QTcpSocket::readyRead, this, [=] { readFromSocket(socket, connectionId); });
+        connect(socket, &QTcpSocket::disconnected, this, [=] {
+            _bufferBySocket.erase(socket);
+            _pendingResponsesBySocket.erase(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void LocalHttpServer::readFromSocket(QTcpSocket* socket, int connectionId)
+{
+    auto& buffer = _bufferBySocket[socket];
+    buffer.append(socket->readAll());
+
+    //several requests can arrive on a kept-alive connection
+    while (true) {
+        auto const headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            return;
+        }
+        Request request;
+        request.connectionId = connectionId;
+        request.time = _timer.elapsed();
+        auto const lines = buffer.left(headerEnd).split('\n');
+        auto const requestLine = lines.first().trimmed().split(' ');
+        request.method = requestLine.value(0).toStdString();
+        auto const path = requestLine.value(1).toStdString();
+        request.apiMethod = path.rfind(ApiPrefix, 0) == 0 ? path.substr(strlen(ApiPrefix)) : path;
+        for (int i = 1; i < lines.size(); ++i) {
+            auto const separator = lines.at(i).indexOf(':');
+            if (separator > 0) {
+                request.headers.insert_or_assign(
+                    lines.at(i).left(separator).trimmed().toLower().toStdString(),
+                    lines.at(i).mid(separator + 1).trimmed().toStdString());
+            }
+        }
+        auto const contentLength =
+            request.headers.count("content-length") ? std::stoi(request.headers.at("content-length")) : 0;
+        if (buffer.size() < headerEnd + 4 + contentLength) {
+            return;
+        }
+        request.body = buffer.mid(headerEnd + 4, contentLength);
+        buffer.remove(0, headerEnd + 4 + contentLength);
+
+        _requests.emplace_back(request);
+        respond(socket, request);
+    }
+}
+
+void LocalHttpServer::respond(QTcpSocket* socket, Request const& request)
+{
+    Response response;
+    auto findResult = _responseFuncByApiMethod.find(request.apiMethod);
+    if (findResult != _responseFuncByApiMethod.end()) {
+        response = findResult->second(request);
+    }
+
+    QByteArray data = "HTTP/1.1 " + QByteArray::number(response.status) + (response.status == 200 ? " OK" : " Error")
+        + "\r\nContent-Length: " + QByteArray::number(response.body.size())
+        + "\r\nContent-Type: text/plain\r\nConnection: keep-alive\r\n\r\n" + response.body;
+    auto const index = _pendingResponsesBySocket[socket].numRequests++;
+    if (response.delay > 0) {
+        QTimer::singleShot(response.delay, socket, [=] {
+            _pendingResponsesBySocket[socket].dataByIndex.emplace(index, data);
+            writeResponses(socket);
+        });
+    } else {
+        _pendingResponsesBySocket[socket].dataByIndex.emplace(index, data);
+        writeResponses(socket);
+    }
+}
+
+void LocalHttpServer::writeResponses(QTcpSocket* socket)
+{
+    auto& pendingResponses = _pendingResponsesBySocket[socket];
+    auto& dataByIndex = pendingResponses.dataByIndex;
+    for (auto it = dataByIndex.find(pendingResponses.numWritten); it != dataByIndex.end();
+         it = dataByIndex.find(pendingResponses.numWritten)) {
+        socket->write(it->second);
+        dataByIndex.erase(it);
+        ++pendingResponses.numWritten;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <functional>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTcpServer>
+
+#include "Base/Definitions.h"
+
+class QTcpSocket;
+
+/**
+ * Minimal HTTP/1.1 server on the loopback interface standing in for the web server in tests. Requests are recorded
+ * and answered with the response which has been set for the api method. Connections are kept alive and responses to
+ * pipelined requests are sent in request order.
+ */
+class LocalHttpServer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Request
+    {
+        string method;
+        string apiMethod;   //path without the api prefix
+        map<string, string> headers;    //lower case header names
+        QByteArray body;
+        int connectionId = 0;
+        qint64 time = 0;    //milliseconds since construction of the server
+    };
+
+    struct Response
+    {
+        int status = 200;
+        QByteArray body;
+        int delay = 0;    //in milliseconds
+    };
+
+    LocalHttpServer(QObject* parent = nullptr);
+
+    //base url of the api, e.g. "http://127.0.0.1:12345/api/"
+    string getAddress() const;
+
+    void setResponse(string const& apiMethod, Response const& response);
+    void setResponse(string const& apiMethod, std::function<Response(Request const&)> const& responseFunc);
+
+    vector<Request> const& getRequests() const;
+    vector<Request> getRequests(string const& apiMethod) const;
+    int getNumConnections() const;
+
+    //processes events until the predicate is fulfilled, returns false on timeout
+    static bool processEventsUntil(std::function<bool()> const& predicate, int timeout = 5000);
+
+    //parts of a multipart/form-data body by name
+    static map<string, QByteArray> parseMultiPart(Request const& request);
+
+private:
+    Q_SLOT void newConnection();
+    void readFromSocket(QTcpSocket* socket, int connectionId);
+    void respond(QTcpSocket* socket, Request const& request);
+    void writeResponses(QTcpSocket* socket);
+
+    QTcpServer _server;
+    map<string, std::function<Response(Request const&)>> _responseFuncByApiMethod;
+    vector<Request> _requests;
+    map<QTcpSocket*, QByteArray> _bufferBySocket;
+    int _numConnections = 0;
+    QElapsedTimer _timer;
+
+    struct PendingResponses
+    {
+        int numRequests = 0;
+        int numWritten = 0;
+        map<int, QByteArray> dataByIndex;
+    };
+    map<QTcpSocket*, PendingResponses> _pendingResponsesBySocket;
+};
@@ -0,0 +1,98 @@
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Base/LoggingServiceImpl.h"
+
+namespace
+{
+    class TestCallBack : public LoggingCallBack
+    {
+    public:
+        TestCallBack(Priority minPriority)
+            : _minPriority(minPriority)
+        {}
+
+        void newLogMessage(Priority priority, std::string const& message) override
+        {
+            _messages.emplace_back(message);
+            EXPECT_GE(priority, _minPriority);
+        }
+
+        Priority getMinPriority() const override { return _minPriority; }
+
+        void flush() override { ++_numFlushes; }
+
+        std::vector<std::string> const& getMessages() const { return _messages; }
+        int getNumFlushes() const { return _numFlushes; }
+
+    private:
+        Priority _minPriority;
+        std::vector<std::string> _messages;
+        int _numFlushes = 0;
+    };
+}
+
+TEST(LoggingServiceTest, testMessagesFromManyThreads)
+{
+    LoggingServiceImpl loggingService;
+    TestCallBack allMessages(Priority::Unimportant);
+    TestCallBack importantMessages(Priority::Important);
+    loggingService.registerCallBack(&allMessages);
+    loggingService.registerCallBack(&importantMessages);
+
+    //more messages than the buffer holds
+    int const numThreads = 4;
+    int const numMessagesPerThread = 5000;
+    std::vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < numThreads; ++threadIndex) {
+        threads.emplace_back([&, threadIndex] {
+            for (int i = 0; i < numMessagesPerThread; ++i) {
+                auto const priority = 0 == i % 10 ? Priority::Important : Priority::Unimportant;
+                loggingService.logMessage(priority, std::to_string(threadIndex) + " " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    loggingService.flush();
+
+    ASSERT_EQ(numThreads * numMessagesPerThread, allMessages.getMessages().size());
+    EXPECT_EQ(numThreads * numMessagesPerThread / 10, importantMessages.getMessages().size());
+    EXPECT_GT(allMessages.getNumFlushes(), 0);
+
+    //messages of one thread keep their order
+    std::vector<int> lastIndices(numThreads, -1);
+    for (auto const& message : allMessages.getMessages()) {
+        auto const separator = message.find(": ");
+        ASSERT_NE(std::string::npos, separator);
+        std::istringstream stream(message.substr(separator + 2));
+        int threadIndex;
+        int index;
+        stream >> threadIndex >> index;
+        EXPECT_EQ(lastIndices[threadIndex] + 1, index);
+        lastIndices[threadIndex] = index;
+    }
+
+    loggingService.unregisterCallBack(&importantMessages);
+    loggingService.unregisterCallBack(&allMessages);
+}
+
+TEST(LoggingServiceTest, testUnregisterDeliversPendingMessages)
+{
+    LoggingServiceImpl loggingService;
+    TestCallBack callback(Priority::Unimportant);
+    loggingService.registerCallBack(&callback);
+    for (int i = 0; i < 100; ++i) {
+        loggingService.logMessage(Priority::Unimportant, "message");
+    }
+    loggingService.unregisterCallBack(&callback);
+    EXPECT_EQ(100, callback.getMessages().size());
+
+    //without callbacks messages are dropped
+    loggingService.logMessage(Priority::Important, "message");
+    loggingService.flush();
+    EXPECT_EQ(100, callback.getMessages().size());
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+#include "Base/ServiceLocator.h"
+#include "EngineGpuKernels/CudaConstants.h"
+#include "EngineGpuKernels/CudaSimulation.cuh"
+#include "EngineInterface/SimulationParameters.h"
+
+class NumberGeneratorGpuTests : public ::testing::Test
+{
+public:
+    NumberGeneratorGpuTests();
+    ~NumberGeneratorGpuTests();
+
+protected:
+    CudaConstants _cudaConstants;
+    NumberGenerator* _numberGen = nullptr;
+};
+
+NumberGeneratorGpuTests::NumberGeneratorGpuTests()
+{
+    _cudaConstants.NUM_THREADS_PER_BLOCK = 64;
+    _cudaConstants.NUM_BLOCKS = 64;
+    _cudaConstants.MAX_CLUSTERS = 1000;
+    _cudaConstants.MAX_CELLS = 1000;
+    _cudaConstants.MAX_PARTICLES = 1000;
+    _cudaConstants.MAX_TOKENS = 1000;
+    _cudaConstants.MAX_CELLPOINTERS = 1000 * 10;
+    _cudaConstants.MAX_CLUSTERPOINTERS = 1000 * 10;
+    _cudaConstants.MAX_PARTICLEPOINTERS = 1000 * 10;
+    _cudaConstants.MAX_TOKENPOINTERS = 1000 * 10;
+    _cudaConstants.DYNAMIC_MEMORY_SIZE = 1000000;
+    _cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE = 1000;
+
+    GlobalFactory* factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+    _numberGen = factory->buildRandomNumberGenerator();
+}
+
+NumberGeneratorGpuTests::~NumberGeneratorGpuTests()
+{
+    delete _numberGen;
+}
+
+/**
+* Situation: device generator is seeded with the seed of a host generator
+* Expected result: host generator for stream 0 replays the integers and reals drawn on the device
+*/
+TEST_F(NumberGeneratorGpuTests, testHostReplaysDeviceValues)
+{
+    uint64_t const seed = 0x0123456789abcdef;
+    CudaSimulation simulation({100, 100}, 0, SimulationParameters(), _cudaConstants, seed);
+
+    int const count = 1000;
+    int const maxValue = 250;
+    vector<int> intValues(count);
+    vector<float> realValues(count);
+    simulation.getRandomNumbers(count, maxValue, intValues.data(), realValues.data());
+
+    _numberGen->init(0, seed);
+    for (int i = 0; i < count; ++i) {
+        ASSERT_EQ(static_cast<int>(_numberGen->getRandomInt(0, maxValue)), intValues[i]) << "index " << i;
+        ASSERT_EQ(static_cast<float>(_numberGen->getRandomReal()), realValues[i]) << "index " << i;
+    }
+}
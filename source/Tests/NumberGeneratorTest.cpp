@@ -3,6 +3,7 @@
 #include "Base/ServiceLocator.h"
 #include "Base/GlobalFactory.h"
 #include "Base/NumberGenerator.h"
+#include "Base/Philox.h"
 
 class NumberGeneratorTest : public ::testing::Test
 {
@@ -28,7 +29,7 @@ NumberGeneratorTest::~NumberGeneratorTest()
 
 TEST_F(NumberGeneratorTest, testTags)
 {
-	_numberGen->init(123, 1);
+	_numberGen->init(1);
 	quint64 tag = _numberGen->getId();
 	EXPECT_EQ(1, tag >> 48);
 	EXPECT_EQ(1, tag & 0xffffffffffff);
@@ -39,7 +40,7 @@ TEST_F(NumberGeneratorTest, testTags)
 	EXPECT_EQ(1, tag >> 48);
 	EXPECT_EQ(3, tag & 0xffffffffffff);
 
-	_numberGen->init(123, 23);
+	_numberGen->init(23);
 	tag = _numberGen->getId();
 	EXPECT_EQ(23, tag >> 48);
 	EXPECT_EQ(1, tag & 0xffffffffffff);
@@ -48,3 +49,84 @@ TEST_F(NumberGeneratorTest, testTags)
 	EXPECT_EQ(2, tag & 0xffffffffffff);
 }
 
+
+TEST_F(NumberGeneratorTest, testPhiloxKnownAnswers)
+{
+	//test vectors of the Random123 reference implementation
+	auto block = Philox::generate({0, 0, 0, 0}, 0, 0);
+	EXPECT_EQ(0x6627e8d5u, block.values[0]);
+	EXPECT_EQ(0xe169c58du, block.values[1]);
+	EXPECT_EQ(0xbc57ac4cu, block.values[2]);
+	EXPECT_EQ(0x9b00dbd8u, block.values[3]);
+
+	block = Philox::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, 0xa4093822, 0x299f31d0);
+	EXPECT_EQ(0xd16cfe09u, block.values[0]);
+	EXPECT_EQ(0x94fdccebu, block.values[1]);
+	EXPECT_EQ(0x5001e420u, block.values[2]);
+	EXPECT_EQ(0x24126ea1u, block.values[3]);
+}
+
+TEST_F(NumberGeneratorTest, testReproducibleStreams)
+{
+	_numberGen->init(1, 42);
+	vector<uint32_t> numbers;
+	for (int i = 0; i < 10; ++i) {
+		numbers.emplace_back(_numberGen->getRandomInt());
+	}
+
+	_numberGen->init(1, 42);
+	for (int i = 0; i < 10; ++i) {
+		EXPECT_EQ(numbers[i], _numberGen->getRandomInt());
+	}
+
+	_numberGen->init(2, 42);
+	int numEqual = 0;
+	for (int i = 0; i < 10; ++i) {
+		if (numbers[i] == _numberGen->getRandomInt()) {
+			++numEqual;
+		}
+	}
+	EXPECT_EQ(0, numEqual);
+
+	//stream position i is value i % 4 of block i / 4
+	_numberGen->init(1, 42);
+	_numberGen->discard(7);
+	EXPECT_EQ(numbers[7], _numberGen->getRandomInt());
+	EXPECT_EQ(Philox::generate(42, 1, 2).values[0], _numberGen->getRandomInt());
+}
+
+TEST_F(NumberGeneratorTest, testBulkFill)
+{
+	int const size = 10000;	//large enough for parallel processing
+	_numberGen->init(0, 7);
+	_numberGen->discard(3);
+	vector<uint32_t> ints(size);
+	_numberGen->fillRandomInts(ints, 10, 20);
+	vector<double> reals(size);
+	_numberGen->fillRandomReals(reals, -1.0, 1.0);
+	auto const bytes = _numberGen->getRandomArray(size + 1);
+	auto const nextNumber = _numberGen->getRandomInt();
+
+	_numberGen->init(0, 7);
+	_numberGen->discard(3);
+	for (int i = 0; i < size; ++i) {
+		auto const number = _numberGen->getRandomInt(10, 20);
+		ASSERT_EQ(number, ints[i]);
+		ASSERT_GE(number, 10);
+		ASSERT_LE(number, 20);
+	}
+	for (int i = 0; i < size; ++i) {
+		auto const number = _numberGen->getRandomReal(-1.0, 1.0);
+		ASSERT_DOUBLE_EQ(number, reals[i]);
+		ASSERT_GE(number, -1.0);
+		ASSERT_LT(number, 1.0);
+	}
+	for (int i = 0; i < size + 1; i += 4) {
+		auto number = _numberGen->getRandomInt();
+		for (int byteIndex = i; byteIndex < std::min(size + 1, i + 4); ++byteIndex) {
+			ASSERT_EQ(static_cast<char>(number), bytes[byteIndex]);
+			number >>= 8;
+		}
+	}
+	EXPECT_EQ(nextNumber, _numberGen->getRandomInt());
+}
@@ -21,7 +21,7 @@ PhysicsTest::PhysicsTest()
 {
 	GlobalFactory* factory = ServiceLocator::getInstance().getService<GlobalFactory>();
 	_numberGen = factory->buildRandomNumberGenerator();
-	_numberGen->init(123123, 0);
+	_numberGen->init(0, 123123);
 }
 
 PhysicsTest::~PhysicsTest()
@@ -129,3 +129,57 @@ TEST_F(PhysicsTest, testClockwiseAngleFromFirstToSecondVector)
     }
 }
 
+
+TEST_F(PhysicsTest, testBatchCalculationsAgreeWithSingleCalculations)
+{
+    for (int size : {1, 2, 7, 100}) {
+        vector<QVector2D> positions;
+        vector<QVector2D> velocities;
+        for (int i = 0; i < size; ++i) {
+            positions.emplace_back(_numberGen->getRandomReal(-50.0, 50.0), _numberGen->getRandomReal(-50.0, 50.0));
+            velocities.emplace_back(_numberGen->getRandomReal(-1.0, 1.0), _numberGen->getRandomReal(-1.0, 1.0));
+        }
+        Physics::Velocities velocityOfCenter{
+            QVector2D(_numberGen->getRandomReal(-1.0, 1.0), _numberGen->getRandomReal(-1.0, 1.0)),
+            _numberGen->getRandomReal(-10.0, 10.0)};
+
+        double centerX = 0.0;
+        double centerY = 0.0;
+        for (auto const& position : positions) {
+            centerX += position.x();
+            centerY += position.y();
+        }
+        centerX /= size;
+        centerY /= size;
+        QVector2D center(centerX, centerY);
+
+        double angularMass = 0.0;
+        double angularMomentum = 0.0;
+        for (int i = 0; i < size; ++i) {
+            double rx = positions[i].x() - center.x();
+            double ry = positions[i].y() - center.y();
+            double vx = velocities[i].x() - velocityOfCenter.linear.x();
+            double vy = velocities[i].y() - velocityOfCenter.linear.y();
+            angularMass += rx * rx + ry * ry;
+            angularMomentum += rx * vy - ry * vx;
+        }
+
+        Physics::VectorArray positionArray(positions);
+        Physics::VectorArray velocityArray(velocities);
+        ASSERT_PRED_FORMAT2(predEqualVectorMediumPrecision, center, Physics::mean(positionArray));
+        ASSERT_PRED2(predEqual_relative, angularMass, Physics::angularMass(positionArray, center));
+        ASSERT_PRED2(
+            predEqual_relative,
+            angularMomentum,
+            Physics::angularMomentum(positionArray, center, velocityArray, velocityOfCenter.linear));
+
+        Physics::VectorArray tangentialVelocities;
+        Physics::tangentialVelocities(positionArray, velocityOfCenter, tangentialVelocities);
+        for (int i = 0; i < size; ++i) {
+            ASSERT_PRED_FORMAT2(
+                predEqualVectorMediumPrecision,
+                Physics::tangentialVelocity(positions[i], velocityOfCenter),
+                tangentialVelocities.get(i));
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Colors.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SoftwareRenderer.h"
+
+class SoftwareRendererTest : public ::testing::Test
+{
+public:
+    virtual ~SoftwareRendererTest() = default;
+
+protected:
+    DataDescription createClusterWithConnectedCells(QVector2D const& pos) const;
+    QRgb toQRgb(unsigned int gpuColor) const;
+
+    IntVector2D const _universeSize{200, 200};
+};
+
+DataDescription SoftwareRendererTest::createClusterWithConnectedCells(QVector2D const& pos) const
+{
+    auto cell1 = CellDescription().setId(1).setPos(pos).setEnergy(100).setMetadata(CellMetadata().setColor(2));
+    auto cell2 = CellDescription()
+                     .setId(2)
+                     .setPos(pos + QVector2D(1, 0))
+                     .setEnergy(100)
+                     .setMetadata(CellMetadata().setColor(2))
+                     .addToken(TokenDescription());
+    cell1.addConnection(2);
+    cell2.addConnection(1);
+    return DataDescription().addCluster(ClusterDescription().setId(3).addCells({cell1, cell2}));
+}
+
+QRgb SoftwareRendererTest::toQRgb(unsigned int gpuColor) const
+{
+    return (gpuColor & 0xff00ff00) | ((gpuColor & 0xff) << 16) | ((gpuColor >> 16) & 0xff);
+}
+
+TEST_F(SoftwareRendererTest, testBackgroundOutsideUniverse)
+{
+    auto const image = SoftwareRenderer::render(DataDescription(), _universeSize, RealRect{{-10, -10}, {90, 90}}, 2.0f);
+
+    ASSERT_EQ(200, image.width());
+    ASSERT_EQ(200, image.height());
+    EXPECT_EQ(toQRgb(Const::NothingnessColor), image.pixel(5, 5));
+    EXPECT_EQ(toQRgb(Const::NothingnessColor), image.pixel(100, 19));
+    EXPECT_EQ(toQRgb(Const::SpaceColor), image.pixel(20, 20));
+    EXPECT_EQ(toQRgb(Const::SpaceColor), image.pixel(199, 199));
+}
+
+TEST_F(SoftwareRendererTest, testRenderedCellsAreTranslationInvariant)
+{
+    //second cluster lies on the corner of adjacent image tiles
+    auto const zoom = 4.0f;
+    auto const image1 = SoftwareRenderer::render(
+        createClusterWithConnectedCells({10.3f, 10.6f}), _universeSize, RealRect{{0, 0}, {50, 50}}, zoom);
+    auto const image2 = SoftwareRenderer::render(
+        createClusterWithConnectedCells({15.3f, 15.6f}), _universeSize, RealRect{{0, 0}, {50, 50}}, zoom);
+
+    auto numDrawnPixels = 0;
+    for (int y = 20; y < 60; ++y) {
+        for (int x = 20; x < 60; ++x) {
+            EXPECT_EQ(image1.pixel(x, y), image2.pixel(x + 20, y + 20));
+            if (image1.pixel(x, y) != toQRgb(Const::SpaceColor)) {
+                ++numDrawnPixels;
+            }
+        }
+    }
+    EXPECT_LT(0, numDrawnPixels);
+}
+
+TEST_F(SoftwareRendererTest, testCellsOnUniverseBorder)
+{
+    auto const image = SoftwareRenderer::render(
+        createClusterWithConnectedCells({-0.5f, 100.5f}), _universeSize, RealRect{{150, 50}, {210, 150}}, 1.0f);
+
+    //cell positions are mapped into the universe before drawing
+    EXPECT_NE(toQRgb(Const::SpaceColor), image.pixel(49, 50));
+}
+
+TEST_F(SoftwareRendererTest, testPixelsOfSingleCell)
+{
+    //color code 2 gives IndividualCellColor3 = (0x70, 0xff, 0x50), scaled by (sqrt(100) * 5 + 20) / 100 * 0.75
+    //for energy 100 and by 2 * radius = 2 / 3 for zoom 1
+    auto const cell =
+        CellDescription().setId(1).setPos({20, 30}).setEnergy(100).setMetadata(CellMetadata().setColor(2));
+    auto const data = DataDescription().addCluster(ClusterDescription().setId(2).addCell(cell));
+    auto const image = SoftwareRenderer::render(data, _universeSize, RealRect{{0, 0}, {50, 50}}, 1.0f);
+
+    //adding colors clears the lowest bit of each channel, the background blue 0x1b becomes 0x1a
+    //center pixel: (0x70, 0xff, 0x50) * 0.35 = (39, 88, 27), lowest bits cleared and added to the background
+    EXPECT_EQ(qRgb(0x26, 0x58, 0x1a + 0x1a), image.pixel(20, 30));
+
+    //neighbor pixels get 30% of the center color: (11, 26, 8)
+    for (auto const& pos : vector<IntVector2D>{{19, 30}, {21, 30}, {20, 29}, {20, 31}}) {
+        EXPECT_EQ(qRgb(0x0a, 0x1a, 0x08 + 0x1a), image.pixel(pos.x, pos.y)) << pos.x << ", " << pos.y;
+    }
+
+    //all other pixels show the background
+    std::set<std::pair<int, int>> drawnPixels;
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            if ((image.pixel(x, y) & 0xfefefe) != (toQRgb(Const::SpaceColor) & 0xfefefe)) {
+                drawnPixels.emplace(x, y);
+            }
+        }
+    }
+    EXPECT_EQ((std::set<std::pair<int, int>>{{20, 30}, {19, 30}, {21, 30}, {20, 29}, {20, 31}}), drawnPixels);
+}
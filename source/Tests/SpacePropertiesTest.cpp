@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "Base/ServiceLocator.h"
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+#include "EngineInterface/SpaceProperties.h"
+
+class SpacePropertiesTest : public ::testing::Test
+{
+public:
+	SpacePropertiesTest();
+	~SpacePropertiesTest();
+
+protected:
+	vector<QVector2D> createRandomPositions(IntVector2D const& size, int count) const;
+
+	NumberGenerator* _numberGen = nullptr;
+};
+
+SpacePropertiesTest::SpacePropertiesTest()
+{
+	GlobalFactory* factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+	_numberGen = factory->buildRandomNumberGenerator();
+	_numberGen->init(0, 123123);
+}
+
+SpacePropertiesTest::~SpacePropertiesTest()
+{
+	delete _numberGen;
+}
+
+vector<QVector2D> SpacePropertiesTest::createRandomPositions(IntVector2D const& size, int count) const
+{
+	vector<QVector2D> result;
+	for (int i = 0; i < count; ++i) {
+		result.emplace_back(
+			_numberGen->getRandomReal(-3.0 * size.x, 3.0 * size.x), _numberGen->getRandomReal(-3.0 * size.y, 3.0 * size.y));
+	}
+	result.emplace_back(-1.0f, -0.5f);
+	result.emplace_back(static_cast<float>(size.x), static_cast<float>(size.y));
+	return result;
+}
+
+TEST_F(SpacePropertiesTest, testBatchCorrectionAgreesWithReference)
+{
+	for (auto const& size : vector<IntVector2D>{ {1024, 512}, {1000, 300} }) {
+		SpaceProperties space;
+		space.init(size);
+		auto positions = createRandomPositions(size, 1000);
+
+		auto correctedPositions = positions;
+		space.correctPositions(correctedPositions.data(), static_cast<int>(correctedPositions.size()));
+
+		vector<IntVector2D> intPositions(positions.size());
+		space.correctPositionsAndConvertToIntVectors(
+			positions.data(), intPositions.data(), static_cast<int>(positions.size()));
+
+		for (int i = 0; i < positions.size(); ++i) {
+			auto const& pos = positions[i];
+			auto const& correctedPos = correctedPositions[i];
+			EXPECT_GE(correctedPos.x(), 0);
+			EXPECT_LE(correctedPos.x(), size.x);
+			EXPECT_GE(correctedPos.y(), 0);
+			EXPECT_LE(correctedPos.y(), size.y);
+			EXPECT_NEAR(0, std::remainder(correctedPos.x() - pos.x(), static_cast<double>(size.x)), 0.01);
+			EXPECT_NEAR(0, std::remainder(correctedPos.y() - pos.y(), static_cast<double>(size.y)), 0.01);
+
+			//reference implementation with integer modulo
+			IntVector2D intPos{ static_cast<int>(pos.x()), static_cast<int>(pos.y()) };
+			intPos.x = intPos.x < 0 ? intPos.x - 1 : intPos.x;
+			intPos.y = intPos.y < 0 ? intPos.y - 1 : intPos.y;
+			intPos.x = ((intPos.x % size.x) + size.x) % size.x;
+			intPos.y = ((intPos.y % size.y) + size.y) % size.y;
+			EXPECT_EQ(intPos.x, intPositions[i].x);
+			EXPECT_EQ(intPos.y, intPositions[i].y);
+			EXPECT_TRUE(intPos == space.correctPositionAndConvertToIntVector(pos));
+		}
+	}
+}
@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "Base/NpyTimeSeriesWriter.h"
+#include "EngineGpu/SpatialStatistics.h"
+#include "EngineGpuKernels/AccessTOs.cuh"
+
+class SpatialStatisticsTest : public ::testing::Test
+{
+public:
+    SpatialStatisticsTest();
+    virtual ~SpatialStatisticsTest() = default;
+
+protected:
+    void addCluster(float2 const& pos, float2 const& vel, vector<float2> const& cellPositions, int cellFunction);
+    void addToken(int cellIndex, float energy);
+    void addParticle(float2 const& pos, float2 const& vel, float energy);
+
+    DataAccessTO getDataTO();
+
+    IntVector2D const _universeSize{100, 60};
+
+    int _numClusters = 0;
+    int _numCells = 0;
+    int _numParticles = 0;
+    int _numTokens = 0;
+    vector<ClusterAccessTO> _clusters;
+    vector<CellAccessTO> _cells;
+    vector<ParticleAccessTO> _particles;
+    vector<TokenAccessTO> _tokens;
+};
+
+SpatialStatisticsTest::SpatialStatisticsTest()
+{
+    _clusters.reserve(10);
+    _cells.reserve(10);
+    _particles.reserve(10);
+    _tokens.reserve(10);
+}
+
+void SpatialStatisticsTest::addCluster(
+    float2 const& pos,
+    float2 const& vel,
+    vector<float2> const& cellPositions,
+    int cellFunction)
+{
+    ClusterAccessTO cluster{};
+    cluster.pos = pos;
+    cluster.vel = vel;
+    cluster.numCells = static_cast<int>(cellPositions.size());
+    cluster.cellStartIndex = static_cast<int>(_cells.size());
+    cluster.tokenStartIndex = static_cast<int>(_tokens.size());
+    for (auto const& cellPos : cellPositions) {
+        CellAccessTO cell{};
+        cell.pos = cellPos;
+        cell.energy = 100;
+        cell.cellFunctionType = cellFunction;
+        _cells.emplace_back(cell);
+    }
+    _clusters.emplace_back(cluster);
+}
+
+void SpatialStatisticsTest::addToken(int cellIndex, float energy)
+{
+    TokenAccessTO token{};
+    token.cellIndex = cellIndex;
+    token.energy = energy;
+    _tokens.emplace_back(token);
+    ++_clusters.back().numTokens;
+}
+
+void SpatialStatisticsTest::addParticle(float2 const& pos, float2 const& vel, float energy)
+{
+    ParticleAccessTO particle{};
+    particle.pos = pos;
+    particle.vel = vel;
+    particle.energy = energy;
+    _particles.emplace_back(particle);
+}
+
+DataAccessTO SpatialStatisticsTest::getDataTO()
+{
+    _numClusters = static_cast<int>(_clusters.size());
+    _numCells = static_cast<int>(_cells.size());
+    _numParticles = static_cast<int>(_particles.size());
+    _numTokens = static_cast<int>(_tokens.size());
+
+    DataAccessTO result;
+    result.numClusters = &_numClusters;
+    result.clusters = _clusters.data();
+    result.numCells = &_numCells;
+    result.cells = _cells.data();
+    result.numParticles = &_numParticles;
+    result.particles = _particles.data();
+    result.numTokens = &_numTokens;
+    result.tokens = _tokens.data();
+    return result;
+}
+
+TEST_F(SpatialStatisticsTest, testCalcStatistics)
+{
+    addCluster({15, 15}, {1, 0}, {{14, 15}, {16, 15}}, Enums::CellFunction::SCANNER);
+    addToken(1, 50);
+    addParticle({18, 18}, {0, 4}, 20);
+
+    //lies outside the universe and is mapped to position (50, 45)
+    addCluster({-50, 45}, {0, 0}, {{-50, 45}}, Enums::CellFunction::WEAPON);
+
+    auto const statistics = SpatialStatisticsCalculator::calc(getDataTO(), _universeSize, {5, 3});
+    ASSERT_EQ(5, statistics.gridSize.x);
+    ASSERT_EQ(3, statistics.gridSize.y);
+    ASSERT_EQ(SpatialStatistics::NumChannels * 15, static_cast<int>(statistics.values.size()));
+
+    EXPECT_FLOAT_EQ(2.0f, statistics.get(SpatialStatistics::NumCells, {0, 0}));
+    EXPECT_FLOAT_EQ(1.0f, statistics.get(SpatialStatistics::NumTokens, {0, 0}));
+    EXPECT_FLOAT_EQ(1.0f, statistics.get(SpatialStatistics::NumParticles, {0, 0}));
+    EXPECT_FLOAT_EQ(270.0f / 400.0f, statistics.get(SpatialStatistics::EnergyDensity, {0, 0}));
+    EXPECT_FLOAT_EQ(2.0f / 3.0f, statistics.get(SpatialStatistics::MeanVelocityX, {0, 0}));
+    EXPECT_FLOAT_EQ(4.0f / 3.0f, statistics.get(SpatialStatistics::MeanVelocityY, {0, 0}));
+    EXPECT_FLOAT_EQ(
+        2.0f,
+        statistics.get(SpatialStatistics::NumCellsWithFunction + Enums::CellFunction::SCANNER, {0, 0}));
+
+    EXPECT_FLOAT_EQ(1.0f, statistics.get(SpatialStatistics::NumCells, {2, 2}));
+    EXPECT_FLOAT_EQ(
+        1.0f,
+        statistics.get(SpatialStatistics::NumCellsWithFunction + Enums::CellFunction::WEAPON, {2, 2}));
+    EXPECT_FLOAT_EQ(0.0f, statistics.get(SpatialStatistics::NumCells, {1, 1}));
+    EXPECT_FLOAT_EQ(0.0f, statistics.get(SpatialStatistics::MeanVelocityX, {1, 1}));
+}
+
+TEST_F(SpatialStatisticsTest, testRotatingCluster)
+{
+    addCluster({50, 30}, {0, 0}, {{48, 30}, {52, 30}}, Enums::CellFunction::COMPUTER);
+    _clusters.back().angularVel = 10;
+
+    //both cells lie in different bins and move in opposite directions
+    auto const statistics = SpatialStatisticsCalculator::calc(getDataTO(), _universeSize, {2, 1});
+    auto const velLeft = statistics.get(SpatialStatistics::MeanVelocityY, {0, 0});
+    auto const velRight = statistics.get(SpatialStatistics::MeanVelocityY, {1, 0});
+    EXPECT_NE(0.0f, velLeft);
+    EXPECT_FLOAT_EQ(-velLeft, velRight);
+}
+
+TEST_F(SpatialStatisticsTest, testNpyTimeSeries)
+{
+    auto const filename = "SpatialStatisticsTest.npy";
+    {
+        NpyTimeSeriesWriter writer;
+        ASSERT_TRUE(writer.open(filename, NpyTimeSeriesWriter::Type::Float32, {2, 3}));
+        for (int frame = 0; frame < 4; ++frame) {
+            vector<float> values(6, static_cast<float>(frame));
+            ASSERT_TRUE(writer.appendFrame(values.data()));
+        }
+        EXPECT_EQ(4, writer.getNumFrames());
+    }
+
+    std::ifstream stream(filename, std::ios_base::binary);
+    std::stringstream content;
+    content << stream.rdbuf();
+    stream.close();
+    std::remove(filename);
+
+    auto const data = content.str();
+    ASSERT_EQ(256u + 4 * 6 * 4, data.size());
+    EXPECT_EQ("\x93NUMPY", data.substr(0, 6));
+    auto const headerLength = static_cast<unsigned char>(data[8]) + (static_cast<unsigned char>(data[9]) << 8);
+    EXPECT_EQ(246, headerLength);
+    auto const header = data.substr(10, headerLength);
+    EXPECT_NE(string::npos, header.find("'descr': '<f4'"));
+    EXPECT_NE(string::npos, header.find("'shape': (4, 2, 3,)"));
+    EXPECT_EQ('\n', header.back());
+
+    float lastValue = 0;
+    std::memcpy(&lastValue, data.data() + data.size() - sizeof(float), sizeof(float));
+    EXPECT_FLOAT_EQ(3.0f, lastValue);
+}
@@ -0,0 +1,160 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SpeciesCensus.h"
+
+class SpeciesCensusTest : public ::testing::Test
+{
+public:
+    virtual ~SpeciesCensusTest() = default;
+
+protected:
+    ClusterDescription createCluster(int numCells, Enums::CellFunction::Type cellFunction);
+    string readFile(string const& filename) const;
+
+    uint64_t _id = 0;
+};
+
+ClusterDescription SpeciesCensusTest::createCluster(int numCells, Enums::CellFunction::Type cellFunction)
+{
+    auto const firstId = _id + 1;
+    list<CellDescription> cells;
+    for (int i = 0; i < numCells; ++i) {
+        auto const id = ++_id;
+        auto cell = CellDescription()
+                        .setId(id)
+                        .setPos({static_cast<float>(i), 0})
+                        .setMaxConnections(2)
+                        .setCellFeature(CellFeatureDescription().setType(cellFunction));
+        if (id > firstId) {
+            cell.addConnection(id - 1);
+        }
+        if (i + 1 < numCells) {
+            cell.addConnection(id + 1);
+        }
+        cells.emplace_back(cell);
+    }
+    return ClusterDescription().setId(++_id).addCells(cells);
+}
+
+string SpeciesCensusTest::readFile(string const& filename) const
+{
+    std::ifstream stream(filename);
+    std::stringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+
+TEST_F(SpeciesCensusTest, testAppearanceAndExtinction)
+{
+    SpeciesCensus census;
+    SpeciesCensus::Config config;
+    config.minNumCells = 2;
+    ASSERT_TRUE(census.init(config));
+
+    DataDescription sample1;
+    sample1.addCluster(createCluster(3, Enums::CellFunction::COMPUTER));
+    sample1.addCluster(createCluster(3, Enums::CellFunction::COMPUTER));
+    sample1.addCluster(createCluster(4, Enums::CellFunction::SCANNER));
+    sample1.addCluster(createCluster(1, Enums::CellFunction::SCANNER));    //too small
+    auto const result1 = census.addSample(100, sample1);
+
+    EXPECT_EQ(2, result1.numSpecies);
+    EXPECT_EQ(3, result1.numClusters);
+    EXPECT_EQ((vector<int>{0, 1}), result1.appearedSpecies);
+    EXPECT_TRUE(result1.extinctSpecies.empty());
+    ASSERT_EQ(2u, census.getSpecies().size());
+    EXPECT_EQ(2, census.getSpecies().at(0).count);
+    EXPECT_EQ(3, census.getSpecies().at(0).numCells);
+
+    DataDescription sample2;
+    sample2.addCluster(createCluster(3, Enums::CellFunction::COMPUTER));
+    sample2.addCluster(createCluster(5, Enums::CellFunction::WEAPON));
+    auto const result2 = census.addSample(200, sample2);
+
+    EXPECT_EQ((vector<int>{2}), result2.appearedSpecies);
+    EXPECT_EQ((vector<int>{1}), result2.extinctSpecies);
+    auto const& species = census.getSpecies();
+    EXPECT_EQ(1, species.at(0).count);
+    EXPECT_EQ(2, species.at(0).maxCount);
+    EXPECT_EQ(200, species.at(0).lastTimestep);
+    EXPECT_EQ(200, *species.at(1).extinctionTimestep);
+    EXPECT_EQ(100, species.at(1).lastTimestep);
+
+    //reappearance of an extinct species
+    DataDescription sample3;
+    sample3.addCluster(createCluster(4, Enums::CellFunction::SCANNER));
+    auto const result3 = census.addSample(300, sample3);
+    EXPECT_EQ((vector<int>{1}), result3.appearedSpecies);
+    EXPECT_EQ((vector<int>{0, 2}), result3.extinctSpecies);
+    EXPECT_FALSE(census.getSpecies().at(1).extinctionTimestep);
+    EXPECT_EQ(100, census.getSpecies().at(1).firstTimestep);
+}
+
+TEST_F(SpeciesCensusTest, testOutputFiles)
+{
+    SpeciesCensus census;
+    SpeciesCensus::Config config;
+    config.speciesTableFilename = "SpeciesCensusTest.species.csv";
+    config.countsFilename = "SpeciesCensusTest.counts.csv";
+    ASSERT_TRUE(census.init(config));
+
+    DataDescription sample1;
+    sample1.addCluster(createCluster(2, Enums::CellFunction::COMPUTER));
+    sample1.addCluster(createCluster(2, Enums::CellFunction::COMPUTER));
+    census.addSample(10, sample1);
+    census.addSample(20, DataDescription());
+    EXPECT_FALSE(census.hasWriteError());
+
+    auto const counts = readFile(config.countsFilename);
+    auto const speciesTable = readFile(config.speciesTableFilename);
+    std::remove(config.countsFilename.c_str());
+    std::remove(config.speciesTableFilename.c_str());
+
+    EXPECT_EQ("timestep,species,count\n10,0,2\n", counts);
+    std::stringstream tableStream(speciesTable);
+    string header, row, end;
+    std::getline(tableStream, header);
+    std::getline(tableStream, row);
+    EXPECT_FALSE(std::getline(tableStream, end));
+    EXPECT_EQ(0u, header.find("species,fingerprint,"));
+    EXPECT_EQ(0u, row.find("0,"));
+    EXPECT_NE(string::npos, row.find(",2,10,10,20,0,2"));
+}
+
+TEST_F(SpeciesCensusTest, testLineage)
+{
+    SpeciesCensus census;
+    ASSERT_TRUE(census.init(SpeciesCensus::Config()));
+
+    DataDescription sample1;
+    auto const cluster = createCluster(4, Enums::CellFunction::COMPUTER);
+    sample1.addCluster(cluster);
+    census.addSample(100, sample1);
+
+    //mutant built from the cells of the former cluster and an unrelated new species
+    auto mutant = cluster;
+    mutant.cells->front().setCellFeature(CellFeatureDescription().setType(Enums::CellFunction::SCANNER));
+    DataDescription sample2;
+    sample2.addCluster(mutant);
+    sample2.addCluster(createCluster(3, Enums::CellFunction::WEAPON));
+    auto const result2 = census.addSample(200, sample2);
+
+    ASSERT_EQ((vector<int>{1, 2}), result2.appearedSpecies);
+    auto const& species = census.getSpecies();
+    EXPECT_FALSE(species.at(0).parentId);
+    EXPECT_EQ(0, *species.at(1).parentId);
+    EXPECT_FALSE(species.at(2).parentId);
+
+    //offspring of the mutant after separation
+    auto offspring = mutant;
+    offspring.cells->back().setCellFeature(CellFeatureDescription().setType(Enums::CellFunction::CONSTRUCTOR));
+    DataDescription sample3;
+    sample3.addCluster(offspring);
+    census.addSample(300, sample3);
+    EXPECT_EQ(1, *census.getSpecies().at(3).parentId);
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/SymbolTable.h"
+#include "EngineInterface/SymbolTableIndex.h"
+
+TEST(SymbolTableIndexTest, testLookup)
+{
+    SymbolTable symbols;
+    symbols.addEntry("TOKEN_BRANCH", "[0]");
+    symbols.addEntry("SCANNER::SUCCESS", "1");
+
+    auto const index = symbols.getIndex();
+    EXPECT_EQ("[0]", index->getValue("TOKEN_BRANCH"));
+    EXPECT_EQ("1", index->getValue("SCANNER::SUCCESS"));
+    EXPECT_EQ("0x10", index->getValue("0x10"));
+    EXPECT_EQ("", index->getValue(""));
+}
+
+TEST(SymbolTableIndexTest, testIndexIsRebuiltAfterChanges)
+{
+    SymbolTable symbols;
+    symbols.addEntry("A", "[1]");
+    auto const index = symbols.getIndex();
+    EXPECT_EQ(index, symbols.getIndex());
+
+    symbols.addEntry("A", "[2]");
+    auto const changedIndex = symbols.getIndex();
+    EXPECT_NE(index, changedIndex);
+    EXPECT_EQ("[1]", index->getValue("A"));
+    EXPECT_EQ("[2]", changedIndex->getValue("A"));
+    EXPECT_NE(index->getHash(), changedIndex->getHash());
+
+    SymbolTable otherSymbols;
+    otherSymbols.addEntry("B", "3");
+    symbols.mergeEntries(otherSymbols);
+    EXPECT_EQ("3", symbols.getIndex()->getValue("B"));
+
+    symbols.delEntry("A");
+    EXPECT_EQ("A", symbols.getIndex()->getValue("A"));
+
+    otherSymbols.addEntry("A", "[2]");
+    otherSymbols.delEntry("A");
+    EXPECT_EQ(otherSymbols.getIndex()->getHash(), symbols.getIndex()->getHash());
+}
@@ -4,11 +4,13 @@
 #include "Base/BaseServices.h"
 #include "EngineInterface/EngineInterfaceServices.h"
 #include "EngineGpu/EngineGpuServices.h"
+#include "Web/WebServices.h"
 
 int main(int argc, char** argv) {
     BaseServices baseServices;
     EngineInterfaceServices _EngineInterfaceServices;
 	EngineGpuServices _EngineGpuServices;
+    WebServices _webServices;
 
     QApplication app(argc, argv);
 
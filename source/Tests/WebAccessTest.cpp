@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include <QBuffer>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "Base/ServiceLocator.h"
+#include "Web/ImageDeltaEncoder.h"
+#include "Web/WebAccess.h"
+#include "Web/WebBuilderFacade.h"
+
+#include "LocalHttpServer.h"
+
+class WebAccessTest : public ::testing::Test
+{
+public:
+    WebAccessTest();
+    virtual ~WebAccessTest();
+
+protected:
+    LocalHttpServer _server;
+    WebAccess* _webAccess = nullptr;
+    vector<string> _processedTaskIds;
+    vector<vector<Task>> _unprocessedTasks;
+    vector<string> _errors;
+};
+
+WebAccessTest::WebAccessTest()
+{
+    auto facade = ServiceLocator::getInstance().getService<WebBuilderFacade>();
+    _webAccess = facade->buildWebAccess(_server.getAddress());
+    QObject::connect(_webAccess, &WebAccess::sendProcessedTaskReceived, [this](string taskId) {
+        _processedTaskIds.emplace_back(taskId);
+    });
+    QObject::connect(_webAccess, &WebAccess::unprocessedTasksReceived, [this](vector<Task> tasks) {
+        _unprocessedTasks.emplace_back(tasks);
+    });
+    QObject::connect(_webAccess, &WebAccess::error, [this](string message) { _errors.emplace_back(message); });
+}
+
+WebAccessTest::~WebAccessTest()
+{
+    delete _webAccess;
+}
+
+TEST_F(WebAccessTest, testSendProcessedTask)
+{
+    QByteArray imageData("some image data");
+    QBuffer buffer(&imageData);
+    buffer.open(QIODevice::ReadOnly);
+    _webAccess->sendProcessedTask("simulation", "token", "task", &buffer, "image/qoi");
+
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil([&] { return !_processedTaskIds.empty(); }));
+    EXPECT_EQ("task", _processedTaskIds.front());
+
+    auto const requests = _server.getRequests("sendprocessedtask");
+    ASSERT_EQ(1, requests.size());
+    auto const parts = LocalHttpServer::parseMultiPart(requests.front());
+    EXPECT_EQ("task", parts.at("taskId"));
+    EXPECT_EQ(imageData, parts.at("image"));
+    EXPECT_NE(-1, requests.front().body.indexOf("Content-Type: image/qoi"));
+}
+
+TEST_F(WebAccessTest, testSendProcessedTaskDelta)
+{
+    QImage image(100, 70, QImage::Format_RGB32);
+    image.fill(0xff204060);
+    ImageDeltaEncoder encoder(ImageEncoder::Format::Qoi, 32);
+    encoder.acknowledge(encoder.encode(image));
+
+    image.setPixel(40, 50, 0xffffffff);
+    auto const delta = encoder.encode(image);
+    ASSERT_EQ(1, delta.tiles.size());
+    _webAccess->sendProcessedTaskDelta("simulation", "token", "task", delta, "image/qoi");
+
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil([&] { return !_processedTaskIds.empty(); }));
+    EXPECT_EQ("task", _processedTaskIds.front());
+
+    auto const requests = _server.getRequests("sendprocessedtaskdelta");
+    ASSERT_EQ(1, requests.size());
+    auto const parts = LocalHttpServer::parseMultiPart(requests.front());
+    EXPECT_EQ("100", parts.at("imageWidth"));
+    EXPECT_EQ("70", parts.at("imageHeight"));
+    EXPECT_EQ("32", parts.at("tileSize"));
+    EXPECT_EQ("0", parts.at("keyFrame"));
+    EXPECT_EQ("32,32", parts.at("tiles"));
+    EXPECT_EQ(delta.tiles.front().data, parts.at("tile0"));
+    EXPECT_EQ(0, parts.count("tile1"));
+
+    auto const tile = ImageEncoder::decodeQoi(parts.at("tile0"));
+    ASSERT_EQ(32, tile.width());
+    EXPECT_EQ(0xffffffff, tile.pixel(8, 18));
+}
+
+TEST_F(WebAccessTest, testFailedRequestCanBeRepeated)
+{
+    QByteArray imageData("some image data");
+    QBuffer buffer(&imageData);
+    buffer.open(QIODevice::ReadOnly);
+
+    _server.setResponse("sendprocessedtask", LocalHttpServer::Response{404});
+    _webAccess->sendProcessedTask("simulation", "token", "task1", &buffer, "image/png");
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil([&] { return !_errors.empty(); }));
+
+    _server.setResponse("sendprocessedtask", LocalHttpServer::Response());
+    buffer.seek(0);
+    _webAccess->sendProcessedTask("simulation", "token", "task2", &buffer, "image/png");
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil([&] { return !_processedTaskIds.empty(); }));
+    EXPECT_EQ("task2", _processedTaskIds.front());
+}
+
+TEST_F(WebAccessTest, testLongPolling)
+{
+    _server.setResponse(
+        "getunprocessedtasks",
+        LocalHttpServer::Response{200, R"({"tasks":[{"id":7,"pos":[10,20],"size":[30,40]}]})", 500});
+    _webAccess->startTaskPolling("simulation", "token");
+
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil([&] { return !_unprocessedTasks.empty(); }));
+    _webAccess->stopTaskPolling();
+
+    auto const& tasks = _unprocessedTasks.front();
+    ASSERT_EQ(1, tasks.size());
+    EXPECT_EQ("7", tasks.front().id);
+    EXPECT_EQ(10, tasks.front().pos.x);
+    EXPECT_EQ(20, tasks.front().pos.y);
+    EXPECT_EQ(30, tasks.front().size.x);
+    EXPECT_EQ(40, tasks.front().size.y);
+
+    //the server holds back the answer, hence there is no further request in the meantime
+    auto const requests = _server.getRequests("getunprocessedtasks");
+    EXPECT_LE(requests.size(), 2);
+    EXPECT_NE(-1, requests.front().body.indexOf("waitTime=20"));
+}
+
+TEST_F(WebAccessTest, testPollingWithoutWaitingServer)
+{
+    _server.setResponse("getunprocessedtasks", LocalHttpServer::Response{200, R"({"tasks":[]})"});
+    _webAccess->startTaskPolling("simulation", "token");
+
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil(
+        [&] { return _server.getRequests("getunprocessedtasks").size() >= 4; }));
+    _webAccess->stopTaskPolling();
+
+    //immediate answers must not result in busy polling
+    auto const requests = _server.getRequests("getunprocessedtasks");
+    for (int i = 1; i < 4; ++i) {
+        EXPECT_GE(requests.at(i).time - requests.at(i - 1).time, 250);
+    }
+    EXPECT_TRUE(_errors.empty());
+}
+
+TEST_F(WebAccessTest, testPollingBackoff)
+{
+    _server.setResponse("getunprocessedtasks", LocalHttpServer::Response{404});
+    _webAccess->startTaskPolling("simulation", "token");
+
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil(
+        [&] { return _server.getRequests("getunprocessedtasks").size() >= 4; }));
+
+    //intervals between failed polls grow exponentially
+    auto const requests = _server.getRequests("getunprocessedtasks");
+    auto const interval1 = requests.at(2).time - requests.at(1).time;
+    auto const interval2 = requests.at(3).time - requests.at(2).time;
+    EXPECT_GE(requests.at(1).time - requests.at(0).time, 250);
+    EXPECT_GE(interval1, 550);
+    EXPECT_GE(interval2, 1150);
+    EXPECT_TRUE(_errors.empty());
+
+    //backoff is reset after success
+    _server.setResponse("getunprocessedtasks", LocalHttpServer::Response{200, R"({"tasks":[]})"});
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil([&] { return _unprocessedTasks.size() >= 2; }, 10000));
+    _webAccess->stopTaskPolling();
+
+    auto const requestsAfterSuccess = _server.getRequests("getunprocessedtasks");
+    auto const numRequests = requestsAfterSuccess.size();
+    EXPECT_LT(
+        requestsAfterSuccess.at(numRequests - 1).time - requestsAfterSuccess.at(numRequests - 2).time, interval2);
+}
+
+TEST_F(WebAccessTest, testStatisticsBatches)
+{
+    for (int i = 0; i < 25; ++i) {
+        _webAccess->sendStatistics("simulation", "token", {{"timestep", std::to_string(i)}});
+    }
+    _webAccess->flushStatistics();
+
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil(
+        [&] { return _server.getRequests("sendstatisticsbatch").size() >= 3; }));
+    EXPECT_TRUE(_server.getRequests("sendstatistics").empty());
+
+    auto const requests = _server.getRequests("sendstatisticsbatch");
+    ASSERT_EQ(3, requests.size());
+
+    vector<int> batchSizes;
+    int timestep = 0;
+    for (auto const& request : requests) {
+        EXPECT_EQ("deflate", request.headers.at("content-encoding"));
+        EXPECT_EQ("application/json", request.headers.at("content-type"));
+        EXPECT_EQ(requests.front().connectionId, request.connectionId);
+
+        //qUncompress expects the zlib stream to be prefixed by a size hint
+        QByteArray compressed(4, 0);
+        compressed[2] = 1;
+        compressed.append(request.body);
+        auto const samples = QJsonDocument::fromJson(qUncompress(compressed)).array();
+        batchSizes.emplace_back(samples.size());
+        for (auto const& sample : samples) {
+            auto const sampleObject = sample.toObject();
+            EXPECT_EQ(std::to_string(timestep++), sampleObject.value("timestep").toString().toStdString());
+            EXPECT_EQ("simulation", sampleObject.value("simulationId").toString().toStdString());
+            EXPECT_TRUE(sampleObject.contains("time"));
+        }
+    }
+    EXPECT_EQ(vector<int>({10, 10, 5}), batchSizes);
+}
+
+TEST_F(WebAccessTest, testDisconnectAfterStatistics)
+{
+    _server.setResponse("sendstatisticsbatch", LocalHttpServer::Response{200, "", 200});
+    for (int i = 0; i < 25; ++i) {
+        _webAccess->sendStatistics("simulation", "token", {{"timestep", std::to_string(i)}});
+    }
+    _webAccess->requestDisconnect("simulation", "token");
+
+    ASSERT_TRUE(LocalHttpServer::processEventsUntil([&] { return !_server.getRequests("disconnect").empty(); }));
+
+    //all samples have been uploaded before the disconnect request
+    auto const& requests = _server.getRequests();
+    vector<string> apiMethods;
+    for (auto const& request : requests) {
+        apiMethods.emplace_back(request.apiMethod);
+    }
+    EXPECT_EQ(
+        vector<string>({"sendstatisticsbatch", "sendstatisticsbatch", "sendstatisticsbatch", "disconnect"}),
+        apiMethods);
+    EXPECT_GE(requests.back().time - requests.front().time, 550);
+}
@@ -0,0 +1,191 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include "Base/Job.h"
+#include "Base/Worker.h"
+
+namespace
+{
+    //job with a number of steps, each step has to be triggered by trigger() unless it is processed concurrently
+    class TestJob : public Job
+    {
+    public:
+        TestJob(string const& id, int numSteps, vector<string>& protocol, string const& conflictKey = string())
+            : Job(id, nullptr)
+            , _numSteps(numSteps)
+            , _protocol(protocol)
+            , _conflictKey(conflictKey)
+        {}
+
+        void process() override
+        {
+            if (!_isReady || isFinished()) {
+                return;
+            }
+            _protocol.emplace_back(getId() + ":" + std::to_string(_currentStep));
+            ++_currentStep;
+            if (_concurrentStage) {
+                runConcurrently(_concurrentStage);
+            } else {
+                _isReady = false;
+            }
+        }
+
+        bool isFinished() const override { return _currentStep == _numSteps; }
+
+        string getConflictKey() const override { return _conflictKey; }
+
+        void trigger()
+        {
+            _isReady = true;
+            wakeUp();
+        }
+
+        void setConcurrentStage(std::function<void()> const& stage) { _concurrentStage = stage; }
+
+    private:
+        bool _isReady = true;
+        int _currentStep = 0;
+        int _numSteps = 0;
+        vector<string>& _protocol;
+        string _conflictKey;
+        std::function<void()> _concurrentStage;
+    };
+}
+
+class WorkerTest : public ::testing::Test
+{
+public:
+    virtual ~WorkerTest() = default;
+
+protected:
+    //processes events until the predicate is fulfilled or the time limit is reached
+    void processEventsUntil(std::function<bool()> const& predicate)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (!predicate() && timer.elapsed() < 5000) {
+            QCoreApplication::processEvents();
+        }
+        QCoreApplication::processEvents();
+    }
+
+    vector<string> _protocol;
+    _Worker _worker;
+};
+
+TEST_F(WorkerTest, testJobsAreProcessedWithoutPolling)
+{
+    auto job = new TestJob("job", 2, _protocol);
+    EXPECT_TRUE(_worker.add(job));
+    TestJob duplicateJob("job", 1, _protocol);
+    EXPECT_FALSE(_worker.add(&duplicateJob));
+
+    QCoreApplication::processEvents();
+    EXPECT_EQ(vector<string>{"job:0"}, _protocol);
+
+    job->trigger();
+    QCoreApplication::processEvents();
+    EXPECT_EQ((vector<string>{"job:0", "job:1"}), _protocol);
+    EXPECT_FALSE(_worker.contains("job"));
+}
+
+TEST_F(WorkerTest, testConflictingJobsAreSerialized)
+{
+    auto first = new TestJob("first", 2, _protocol, "key");
+    auto second = new TestJob("second", 1, _protocol, "key");
+    auto independent = new TestJob("independent", 1, _protocol, "otherKey");
+    _worker.add(first);
+    _worker.add(second);
+    _worker.add(independent);
+
+    QCoreApplication::processEvents();
+    EXPECT_EQ((vector<string>{"first:0", "independent:0"}), _protocol);
+
+    first->trigger();
+    QCoreApplication::processEvents();
+    EXPECT_EQ((vector<string>{"first:0", "independent:0", "first:1", "second:0"}), _protocol);
+}
+
+TEST_F(WorkerTest, testConflictingJobsKeepOrderWhileWaitingForDependencies)
+{
+    auto dependency = new TestJob("dependency", 2, _protocol);
+    auto waiting = new TestJob("waiting", 1, _protocol, "key");
+    waiting->addDependency("dependency");
+    auto later = new TestJob("later", 1, _protocol, "key");
+    _worker.add(dependency);
+    _worker.add(waiting);
+    _worker.add(later);
+
+    QCoreApplication::processEvents();
+    EXPECT_EQ(vector<string>{"dependency:0"}, _protocol);
+
+    dependency->trigger();
+    QCoreApplication::processEvents();
+    EXPECT_EQ((vector<string>{"dependency:0", "dependency:1", "waiting:0", "later:0"}), _protocol);
+}
+
+TEST_F(WorkerTest, testDependenciesAndContinuations)
+{
+    auto first = new TestJob("first", 2, _protocol);
+    auto dependent = new TestJob("dependent", 1, _protocol);
+    dependent->addDependency("first");
+    first->addContinuation(new TestJob("continuation", 1, _protocol));
+    _worker.add(dependent);
+    _worker.add(first);
+
+    QCoreApplication::processEvents();
+    EXPECT_EQ(vector<string>{"first:0"}, _protocol);
+
+    first->trigger();
+    processEventsUntil([&] { return _protocol.size() == 4; });
+    ASSERT_EQ(4, _protocol.size());
+    EXPECT_EQ("first:1", _protocol.at(1));
+    EXPECT_EQ("dependent:0", _protocol.at(2));
+    EXPECT_EQ("continuation:0", _protocol.at(3));
+}
+
+TEST_F(WorkerTest, testConcurrentStages)
+{
+    auto const numJobs = 4;
+    std::atomic<int> numRunningStages{0};
+    std::atomic<int> maxRunningStages{0};
+    std::atomic<bool> stageOnMainThread{false};
+    auto const mainThreadId = std::this_thread::get_id();
+    for (int i = 0; i < numJobs; ++i) {
+        auto job = new TestJob("job" + std::to_string(i), 2, _protocol);
+        job->setConcurrentStage([&] {
+            if (std::this_thread::get_id() == mainThreadId) {
+                stageOnMainThread = true;
+            }
+            auto const running = ++numRunningStages;
+            for (auto max = maxRunningStages.load();
+                 running > max && !maxRunningStages.compare_exchange_weak(max, running);) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            --numRunningStages;
+        });
+        _worker.add(job);
+    }
+
+    auto areAllJobsFinished = [&] {
+        for (int i = 0; i < numJobs; ++i) {
+            if (_worker.contains("job" + std::to_string(i))) {
+                return false;
+            }
+        }
+        return true;
+    };
+    processEventsUntil(areAllJobsFinished);
+    EXPECT_TRUE(areAllJobsFinished());
+    EXPECT_EQ(numJobs * 2, _protocol.size());
+    EXPECT_FALSE(stageOnMainThread);
+    if (std::thread::hardware_concurrency() > 1) {
+        EXPECT_LT(1, maxRunningStages.load());
+    }
+}
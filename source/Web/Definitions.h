@@ -6,3 +6,5 @@
 
 class WebAccess;
 class HttpClient;
+class ImageDeltaEncoder;
+using ImageDeltaEncoderPtr = shared_ptr<ImageDeltaEncoder>;
@@ -1,3 +1,4 @@
+#include <QCoreApplication>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QHttpMultiPart>
@@ -10,60 +11,83 @@
 HttpClient::HttpClient(QObject* parent /*= nullptr*/)
     : QObject(parent)
 {
-    connect(&_networkManager, &QNetworkAccessManager::finished, this, &HttpClient::finished);
+}
+
+HttpClient::~HttpClient()
+{
+    //replies belong to the shared network manager
+    auto const handlerByReply = std::move(_handlerByReply);
+    _handlerByReply.clear();
+    for (auto const& [reply, handler] : handlerByReply) {
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
 }
 
 void HttpClient::get(QUrl const& url, string const& handler, bool omitErrorResponse)
 {
-    QNetworkRequest request(url);
-    request.setSslConfiguration(QSslConfiguration::defaultConfiguration());
-    request.setHeader(QNetworkRequest::UserAgentHeader, "alien");
+    RequestOptions options;
+    options.omitErrorResponse = omitErrorResponse;
+    auto request = createRequest(url, options);
 
-    auto reply = _networkManager.get(request);
-    _handlerByReply.insert_or_assign(reply, handler);
-    if (omitErrorResponse) {
-        _noErrorResponseWantedFor.insert(reply);
-    }
+    //replies to GET requests can be pipelined on a kept-alive connection
+    request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+
+    auto reply = getNetworkManager()->get(request);
+    registerReply(reply, handler, options);
 }
 
 void HttpClient::postText(QUrl const & url, string const& handler, QByteArray const & data)
 {
-    QNetworkRequest request(url);
-    request.setSslConfiguration(QSslConfiguration::defaultConfiguration());
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
-    request.setHeader(QNetworkRequest::UserAgentHeader, "alien");
+    postText(url, handler, data, RequestOptions());
+}
 
-    auto reply = _networkManager.post(request, data);
-    _handlerByReply.insert_or_assign(reply, handler);
+void HttpClient::postText(QUrl const& url, string const& handler, QByteArray const& data, RequestOptions const& options)
+{
+    auto request = createRequest(url, options);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QString::fromStdString(options.contentType));
+    if (options.compress) {
+        request.setRawHeader("Content-Encoding", "deflate");
+    }
+
+    auto reply = getNetworkManager()->post(request, options.compress ? compress(data) : data);
+    registerReply(reply, handler, options);
     _postDataByReply.insert_or_assign(reply, data);
 }
 
 void HttpClient::postBinary(QUrl const & url, string const& handler, QHttpMultiPart* data)
 {
-    QNetworkRequest request(url);
-    request.setSslConfiguration(QSslConfiguration::defaultConfiguration());
-    request.setHeader(QNetworkRequest::UserAgentHeader, "alien");
+    RequestOptions options;
+    auto request = createRequest(url, options);
 
-    auto reply = _networkManager.post(request, data);
+    auto reply = getNetworkManager()->post(request, data);
     data->setParent(reply);
-    _handlerByReply.insert_or_assign(reply, handler);
+    registerReply(reply, handler, options);
     _postDataByReply.insert_or_assign(reply, data);
 }
 
+QByteArray HttpClient::compress(QByteArray const& data)
+{
+    //qCompress prepends the uncompressed size to the zlib stream
+    return qCompress(data).mid(4);
+}
+
 void HttpClient::finished(QNetworkReply * reply)
 {
+    auto handler = _handlerByReply.at(reply);
+    auto const options = _optionsByReply.at(reply);
     auto cleanupOnExit = [&]() {
         reply->deleteLater();
         _handlerByReply.erase(reply);
         _postDataByReply.erase(reply);
-        _noErrorResponseWantedFor.erase(reply);
+        _optionsByReply.erase(reply);
     };
 
     auto errorCode = reply->error();
     if (QNetworkReply::NetworkError::NoError != errorCode) {
-        if (_noErrorResponseWantedFor.find(reply) == _noErrorResponseWantedFor.end()) {
-
-            auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+        auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+        if (!options.omitErrorResponse) {
             loggingService->logMessage(
                 Priority::Important,
                 QString("A network error occurred. Error code: %1.").arg(reply->error()).toStdString());
@@ -74,34 +98,64 @@ void HttpClient::finished(QNetworkReply * reply)
                 return;
             }
 
-            auto raw = reply->rawHeaderList();
             Q_EMIT error(QString("Could not read data from server.").toStdString());
+        } else {
+            loggingService->logMessage(
+                Priority::Unimportant,
+                QString("A network error occurred. Error code: %1.").arg(reply->error()).toStdString());
         }
 
-        reply->deleteLater();
         cleanupOnExit();
+        Q_EMIT failed(handler);
         return;
     }
     auto data = reply->readAll();
 
-    auto handler = _handlerByReply.at(reply);
+    cleanupOnExit();
     Q_EMIT dataReceived(handler, data);
+}
 
-    cleanupOnExit();
+QNetworkRequest HttpClient::createRequest(QUrl const& url, RequestOptions const& options) const
+{
+    QNetworkRequest request(url);
+    request.setSslConfiguration(QSslConfiguration::defaultConfiguration());
+    request.setHeader(QNetworkRequest::UserAgentHeader, "alien");
+    request.setRawHeader("Connection", "keep-alive");
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    if (options.timeout > 0) {
+        request.setTransferTimeout(options.timeout);
+    }
+    return request;
+}
+
+void HttpClient::registerReply(QNetworkReply* reply, string const& handler, RequestOptions const& options)
+{
+    _handlerByReply.insert_or_assign(reply, handler);
+    _optionsByReply.insert_or_assign(reply, options);
+    connect(reply, &QNetworkReply::finished, this, [this, reply] { finished(reply); });
 }
 
 void HttpClient::retry(QNetworkReply* reply)
 {
-    auto operation = reply->operation();
+    auto const handler = _handlerByReply.at(reply);
     if (QNetworkAccessManager::GetOperation == reply->operation()) {
-        get(reply->url(), _handlerByReply.at(reply));
+        get(reply->url(), handler, _optionsByReply.at(reply).omitErrorResponse);
     }
     if (QNetworkAccessManager::PostOperation == reply->operation()) {
         auto postData = _postDataByReply.at(reply);
         if (std::holds_alternative<QByteArray>(postData)) {
-            postText(reply->url(), _handlerByReply.at(reply), std::get<QByteArray>(postData));
+            postText(reply->url(), handler, std::get<QByteArray>(postData), _optionsByReply.at(reply));
         } else {
-            postBinary(reply->url(), _handlerByReply.at(reply), std::get<QHttpMultiPart*>(postData));
+            //multipart is owned by the failed reply
+            auto multiPart = std::get<QHttpMultiPart*>(postData);
+            multiPart->setParent(nullptr);
+            postBinary(reply->url(), handler, multiPart);
         }
     }
 }
+
+QNetworkAccessManager* HttpClient::getNetworkManager()
+{
+    static QNetworkAccessManager* result = new QNetworkAccessManager(QCoreApplication::instance());
+    return result;
+}
@@ -4,29 +4,50 @@
 #include <QNetworkAccessManager>
 #include "Definitions.h"
 
+/**
+ * All clients share one QNetworkAccessManager such that its pool of kept-alive connections (and HTTP/2 sessions) is
+ * reused by all requests to the server.
+ */
 class HttpClient : public QObject
 {
     Q_OBJECT
 public:
+    struct RequestOptions
+    {
+        bool omitErrorResponse = false;     //no error signal, failed() is emitted in any case
+        int timeout = 0;    //transfer timeout in milliseconds, 0 = default of Qt
+        string contentType = "application/x-www-form-urlencoded";
+        bool compress = false;      //body is sent with "Content-Encoding: deflate"
+    };
+
     HttpClient(QObject* parent = nullptr);
+    virtual ~HttpClient();
 
     void get(QUrl const& url, string const& handler, bool omitErrorResponse = false);
     void postText(QUrl const& url, string const& handler, QByteArray const& data);
+    void postText(QUrl const& url, string const& handler, QByteArray const& data, RequestOptions const& options);
     void postBinary(QUrl const& url, string const& handler, QHttpMultiPart* data);
 
+    static QByteArray compress(QByteArray const& data);
+
     Q_SIGNAL void dataReceived(string handler, QByteArray data);
+    Q_SIGNAL void failed(string handler);
 
     Q_SIGNAL void error(string message);
 
 private:
-    Q_SLOT void finished(QNetworkReply* reply);
+    void finished(QNetworkReply* reply);
+
+    QNetworkRequest createRequest(QUrl const& url, RequestOptions const& options) const;
+    void registerReply(QNetworkReply* reply, string const& handler, RequestOptions const& options);
 
     void retry(QNetworkReply* reply);
 
-    QNetworkAccessManager _networkManager;
+    static QNetworkAccessManager* getNetworkManager();
+
     std::unordered_map<QNetworkReply*, string> _handlerByReply;
-    std::unordered_set<QNetworkReply*> _noErrorResponseWantedFor;
+    std::unordered_map<QNetworkReply*, RequestOptions> _optionsByReply;
 
     using PostData = std::variant<QHttpMultiPart*, QByteArray>;
     std::unordered_map<QNetworkReply*, PostData> _postDataByReply;
-};
\ No newline at end of file
+};
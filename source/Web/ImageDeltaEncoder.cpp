@@ -0,0 +1,84 @@
+#include "ImageDeltaEncoder.h"
+
+#include <algorithm>
+
+#include "Base/Parallel.h"
+
+namespace
+{
+    //FNV-1a on 32 bit pixels instead of bytes
+    uint64_t const HashOffset = 0xcbf29ce484222325ull;
+    uint64_t const HashPrime = 0x100000001b3ull;
+
+    int const TileGrainSize = 8;
+}
+
+ImageDeltaEncoder::ImageDeltaEncoder(ImageEncoder::Format format, int tileSize, int keyFrameInterval)
+    : _format(format)
+    , _tileSize(std::max(1, tileSize))
+    , _keyFrameInterval(std::max(1, keyFrameInterval))
+{}
+
+ImageDelta ImageDeltaEncoder::encode(QImage const& image) const
+{
+    ImageDelta result;
+    result.imageSize = {image.width(), image.height()};
+    result.tileSize = _tileSize;
+    result.tileHashes = calcTileHashes(image, _tileSize);
+    result.keyFrame = !(result.imageSize == _imageSize) || _tileHashes.size() != result.tileHashes.size()
+        || _numDeltasSinceKeyFrame + 1 >= _keyFrameInterval;
+
+    auto const numTilesX = (image.width() + _tileSize - 1) / _tileSize;
+    vector<int> changedTiles;
+    for (int tile = 0; tile < static_cast<int>(result.tileHashes.size()); ++tile) {
+        if (result.keyFrame || result.tileHashes.at(tile) != _tileHashes.at(tile)) {
+            changedTiles.emplace_back(tile);
+        }
+    }
+
+    result.tiles.resize(changedTiles.size());
+    Parallel::forEach(
+        0,
+        static_cast<int>(changedTiles.size()),
+        [&](int index) {
+            auto const tile = changedTiles.at(index);
+            IntVector2D const pos{(tile % numTilesX) * _tileSize, (tile / numTilesX) * _tileSize};
+            auto const width = std::min(_tileSize, image.width() - pos.x);
+            auto const height = std::min(_tileSize, image.height() - pos.y);
+            result.tiles.at(index) = {pos, ImageEncoder::encode(image.copy(pos.x, pos.y, width, height), _format)};
+        },
+        TileGrainSize);
+    return result;
+}
+
+void ImageDeltaEncoder::acknowledge(ImageDelta const& delta)
+{
+    _imageSize = delta.imageSize;
+    _tileHashes = delta.tileHashes;
+    _numDeltasSinceKeyFrame = delta.keyFrame ? 0 : _numDeltasSinceKeyFrame + 1;
+}
+
+void ImageDeltaEncoder::reset()
+{
+    _imageSize = IntVector2D();
+    _tileHashes.clear();
+    _numDeltasSinceKeyFrame = 0;
+}
+
+vector<uint64_t> ImageDeltaEncoder::calcTileHashes(QImage const& image, int tileSize)
+{
+    auto const convertedImage = 32 == image.depth() ? image : image.convertToFormat(QImage::Format_ARGB32);
+    auto const numTilesX = (image.width() + tileSize - 1) / tileSize;
+    auto const numTilesY = (image.height() + tileSize - 1) / tileSize;
+
+    vector<uint64_t> result(numTilesX * numTilesY, HashOffset);
+    for (int y = 0; y < convertedImage.height(); ++y) {
+        auto const line = reinterpret_cast<uint32_t const*>(convertedImage.constScanLine(y));
+        auto const tileHashes = result.data() + (y / tileSize) * numTilesX;
+        for (int x = 0; x < convertedImage.width(); ++x) {
+            auto& hash = tileHashes[x / tileSize];
+            hash = (hash ^ line[x]) * HashPrime;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QImage>
+
+#include "Definitions.h"
+#include "ImageEncoder.h"
+
+struct ImageTile
+{
+    IntVector2D pos;    //upper left pixel of the tile in the image
+    QByteArray data;    //encoded tile
+};
+
+struct ImageDelta
+{
+    IntVector2D imageSize;
+    int tileSize = 0;
+    bool keyFrame = false;    //all tiles are contained and replace the previous image
+    vector<ImageTile> tiles;
+    vector<uint64_t> tileHashes;
+};
+
+/**
+ * Splits images into square tiles and encodes only the tiles which have changed since the last acknowledged image.
+ * Tiles at the right and bottom border are smaller if the image size is not a multiple of the tile size.
+ * Each instance describes the image of one region on the receiver side and must not be used by several threads at
+ * the same time.
+ */
+class WEB_EXPORT ImageDeltaEncoder
+{
+public:
+    static int const DefaultTileSize = 64;
+    static int const DefaultKeyFrameInterval = 50;
+
+    ImageDeltaEncoder(
+        ImageEncoder::Format format,
+        int tileSize = DefaultTileSize,
+        int keyFrameInterval = DefaultKeyFrameInterval);
+
+    ImageDelta encode(QImage const& image) const;
+
+    //has to be called after the receiver has successfully processed the delta
+    void acknowledge(ImageDelta const& delta);
+
+    //next delta will be a key frame
+    void reset();
+
+    static vector<uint64_t> calcTileHashes(QImage const& image, int tileSize);
+
+private:
+    ImageEncoder::Format _format;
+    int _tileSize = DefaultTileSize;
+    int _keyFrameInterval = DefaultKeyFrameInterval;
+
+    IntVector2D _imageSize;
+    vector<uint64_t> _tileHashes;
+    int _numDeltasSinceKeyFrame = 0;
+};
@@ -0,0 +1,232 @@
+#include "ImageEncoder.h"
+
+#include <array>
+
+#include <QBuffer>
+
+namespace
+{
+    //see https://qoiformat.org/qoi-specification.pdf
+    uint8_t const QoiOpIndex = 0x00;
+    uint8_t const QoiOpDiff = 0x40;
+    uint8_t const QoiOpLuma = 0x80;
+    uint8_t const QoiOpRun = 0xc0;
+    uint8_t const QoiOpRgb = 0xfe;
+    uint8_t const QoiOpRgba = 0xff;
+    uint8_t const QoiMask = 0xc0;
+    int const QoiMaxRun = 62;
+    int const QoiHeaderSize = 14;
+    char const QoiEndMarker[] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+    //PNG quality 80 is mapped to zlib compression level 1 by Qt
+    int const FastPngQuality = 80;
+
+    struct Pixel
+    {
+        uint8_t r = 0;
+        uint8_t g = 0;
+        uint8_t b = 0;
+        uint8_t a = 255;
+
+        bool operator==(Pixel const& other) const
+        {
+            return r == other.r && g == other.g && b == other.b && a == other.a;
+        }
+        bool operator!=(Pixel const& other) const { return !(*this == other); }
+
+        int getIndex() const { return (r * 3 + g * 5 + b * 7 + a * 11) % 64; }
+    };
+
+    //previously seen pixels, initialized with transparent black as required by the specification
+    std::array<Pixel, 64> createIndex()
+    {
+        std::array<Pixel, 64> result;
+        result.fill(Pixel{0, 0, 0, 0});
+        return result;
+    }
+
+    void writeUint32(QByteArray& data, uint32_t value)
+    {
+        data.append(static_cast<char>(value >> 24));
+        data.append(static_cast<char>(value >> 16));
+        data.append(static_cast<char>(value >> 8));
+        data.append(static_cast<char>(value));
+    }
+
+    uint32_t readUint32(uint8_t const* data)
+    {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+            | (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+    }
+}
+
+QByteArray ImageEncoder::encode(QImage const& image, Format format)
+{
+    if (Format::Qoi == format) {
+        return encodeQoi(image);
+    }
+    QByteArray result;
+    QBuffer buffer(&result);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG", Format::FastPng == format ? FastPngQuality : -1);
+    return result;
+}
+
+string ImageEncoder::getMimeType(Format format)
+{
+    return Format::Qoi == format ? "image/qoi" : "image/png";
+}
+
+QByteArray ImageEncoder::encodeQoi(QImage const& image)
+{
+    auto const channels = QImage::Format_RGB32 == image.format() ? 3 : 4;
+    auto const convertedImage =
+        3 == channels || QImage::Format_ARGB32 == image.format() ? image : image.convertToFormat(QImage::Format_ARGB32);
+    auto const width = convertedImage.width();
+    auto const height = convertedImage.height();
+
+    QByteArray result;
+    result.reserve(QoiHeaderSize + width * height * (channels + 1) + sizeof(QoiEndMarker));
+    result.append("qoif");
+    writeUint32(result, width);
+    writeUint32(result, height);
+    result.append(static_cast<char>(channels));
+    result.append(static_cast<char>(0));  //sRGB with linear alpha
+
+    auto index = createIndex();
+    Pixel previous;
+    int run = 0;
+    for (int y = 0; y < height; ++y) {
+        auto const line = reinterpret_cast<uint32_t const*>(convertedImage.constScanLine(y));
+        for (int x = 0; x < width; ++x) {
+            auto const argb = line[x];
+            Pixel pixel{
+                static_cast<uint8_t>(argb >> 16),
+                static_cast<uint8_t>(argb >> 8),
+                static_cast<uint8_t>(argb),
+                3 == channels ? static_cast<uint8_t>(255) : static_cast<uint8_t>(argb >> 24)};
+
+            if (pixel == previous) {
+                ++run;
+                if (run == QoiMaxRun) {
+                    result.append(static_cast<char>(QoiOpRun | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                result.append(static_cast<char>(QoiOpRun | (run - 1)));
+                run = 0;
+            }
+
+            auto const indexPosition = pixel.getIndex();
+            if (index[indexPosition] == pixel) {
+                result.append(static_cast<char>(QoiOpIndex | indexPosition));
+            } else {
+                index[indexPosition] = pixel;
+                if (pixel.a == previous.a) {
+                    auto const dr = static_cast<int8_t>(pixel.r - previous.r);
+                    auto const dg = static_cast<int8_t>(pixel.g - previous.g);
+                    auto const db = static_cast<int8_t>(pixel.b - previous.b);
+                    auto const dgr = dr - dg;
+                    auto const dgb = db - dg;
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                        result.append(static_cast<char>(QoiOpDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                    } else if (dgr >= -8 && dgr <= 7 && dg >= -32 && dg <= 31 && dgb >= -8 && dgb <= 7) {
+                        result.append(static_cast<char>(QoiOpLuma | (dg + 32)));
+                        result.append(static_cast<char>((dgr + 8) << 4 | (dgb + 8)));
+                    } else {
+                        result.append(static_cast<char>(QoiOpRgb));
+                        result.append(static_cast<char>(pixel.r));
+                        result.append(static_cast<char>(pixel.g));
+                        result.append(static_cast<char>(pixel.b));
+                    }
+                } else {
+                    result.append(static_cast<char>(QoiOpRgba));
+                    result.append(static_cast<char>(pixel.r));
+                    result.append(static_cast<char>(pixel.g));
+                    result.append(static_cast<char>(pixel.b));
+                    result.append(static_cast<char>(pixel.a));
+                }
+            }
+            previous = pixel;
+        }
+    }
+    if (run > 0) {
+        result.append(static_cast<char>(QoiOpRun | (run - 1)));
+    }
+    result.append(QoiEndMarker, sizeof(QoiEndMarker));
+    return result;
+}
+
+QImage ImageEncoder::decodeQoi(QByteArray const& data)
+{
+    auto const bytes = reinterpret_cast<uint8_t const*>(data.constData());
+    auto const size = data.size();
+    if (size < QoiHeaderSize + static_cast<int>(sizeof(QoiEndMarker)) || data.left(4) != "qoif") {
+        return QImage();
+    }
+    auto const width = static_cast<int>(readUint32(bytes + 4));
+    auto const height = static_cast<int>(readUint32(bytes + 8));
+    auto const channels = bytes[12];
+    if (width <= 0 || height <= 0 || (channels != 3 && channels != 4)
+        || static_cast<int64_t>(width) * height > (static_cast<int64_t>(size) - QoiHeaderSize) * QoiMaxRun) {
+        return QImage();
+    }
+
+    QImage result(width, height, 3 == channels ? QImage::Format_RGB32 : QImage::Format_ARGB32);
+    auto index = createIndex();
+    Pixel pixel;
+    int run = 0;
+    int position = QoiHeaderSize;
+    auto const end = size - static_cast<int>(sizeof(QoiEndMarker));
+    for (int y = 0; y < height; ++y) {
+        auto const line = reinterpret_cast<uint32_t*>(result.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            if (run > 0) {
+                --run;
+            } else if (position < end) {
+                auto const op = bytes[position++];
+                if (QoiOpRgb == op) {
+                    if (position + 3 > end) {
+                        return QImage();
+                    }
+                    pixel.r = bytes[position++];
+                    pixel.g = bytes[position++];
+                    pixel.b = bytes[position++];
+                } else if (QoiOpRgba == op) {
+                    if (position + 4 > end) {
+                        return QImage();
+                    }
+                    pixel.r = bytes[position++];
+                    pixel.g = bytes[position++];
+                    pixel.b = bytes[position++];
+                    pixel.a = bytes[position++];
+                } else if (QoiOpIndex == (op & QoiMask)) {
+                    pixel = index[op];
+                } else if (QoiOpDiff == (op & QoiMask)) {
+                    pixel.r += ((op >> 4) & 0x03) - 2;
+                    pixel.g += ((op >> 2) & 0x03) - 2;
+                    pixel.b += (op & 0x03) - 2;
+                } else if (QoiOpLuma == (op & QoiMask)) {
+                    if (position + 1 > end) {
+                        return QImage();
+                    }
+                    auto const op2 = bytes[position++];
+                    auto const dg = (op & 0x3f) - 32;
+                    pixel.r += dg - 8 + ((op2 >> 4) & 0x0f);
+                    pixel.g += dg;
+                    pixel.b += dg - 8 + (op2 & 0x0f);
+                } else {
+                    run = op & 0x3f;
+                }
+                index[pixel.getIndex()] = pixel;
+            } else {
+                return QImage();
+            }
+            line[x] = (static_cast<uint32_t>(pixel.a) << 24) | (static_cast<uint32_t>(pixel.r) << 16)
+                | (static_cast<uint32_t>(pixel.g) << 8) | pixel.b;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QByteArray>
+#include <QImage>
+
+#include "Definitions.h"
+
+/**
+ * Encodes images for the transfer to the server.
+ * - Png: default zlib compression
+ * - FastPng: lowest zlib compression level, about 3-5 times faster at slightly larger output
+ * - Qoi: "Quite OK Image" format, lossless and encoded in a single pass without entropy coding
+ */
+class WEB_EXPORT ImageEncoder
+{
+public:
+    enum class Format
+    {
+        Png,
+        FastPng,
+        Qoi
+    };
+
+    static QByteArray encode(QImage const& image, Format format);
+    static string getMimeType(Format format);
+
+    static QByteArray encodeQoi(QImage const& image);
+
+    //returns a null image if the data is not valid
+    static QImage decodeQoi(QByteArray const& data);
+};
@@ -4,6 +4,7 @@
 
 #include "Definitions.h"
 
+#include "ImageDeltaEncoder.h"
 #include "SimulationInfo.h"
 #include "Task.h"
 
@@ -18,10 +19,29 @@ public:
     virtual void requestCurrentVersion() = 0;
     virtual void requestSimulationInfos() = 0;
     virtual void requestConnectToSimulation(string const& simulationId, string const& password) = 0;
-    virtual void requestUnprocessedTasks(string const& simulationId, string const& token) = 0;
-    virtual void sendProcessedTask(string const& simulationId, string const& token, string const& taskId, QBuffer* data) = 0;
+
+    //long-polls for unprocessed tasks until stopped, unprocessedTasksReceived is emitted for each answer
+    virtual void startTaskPolling(string const& simulationId, string const& token) = 0;
+    virtual void stopTaskPolling() = 0;
+
+    virtual void sendProcessedTask(
+        string const& simulationId,
+        string const& token,
+        string const& taskId,
+        QBuffer* data,
+        string const& mimeType) = 0;
+    virtual void sendProcessedTaskDelta(
+        string const& simulationId,
+        string const& token,
+        string const& taskId,
+        ImageDelta const& delta,
+        string const& mimeType) = 0;
     virtual void requestDisconnect(string const& simulationId, string const& token) = 0;
+
+    //samples are buffered and uploaded in compressed batches
     virtual void sendStatistics(string const& simulationId, string const& token, map<string, string> monitorData) = 0;
+    virtual void flushStatistics() = 0;
+
     virtual void sendLastImage(string const& simulationId, string const& token, QBuffer* data) = 0;
     virtual void sendBugReport(string const& protocol, string const& email, string const& userMessage) = 0;
 
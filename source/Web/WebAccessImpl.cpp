@@ -1,5 +1,16 @@
+#include <chrono>
+#include <sstream>
+
 #include <QUrlQuery>
 #include <QHttpMultiPart>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+
+#include "Base/Exceptions.h"
+#include "Base/LoggingService.h"
+#include "Base/ServiceLocator.h"
 
 #include "HttpClient.h"
 #include "Parser.h"
@@ -11,22 +22,35 @@ using namespace std::string_literals;
 
 namespace
 {
-    auto const ServerAddress = "https://alien-project.org/world-explorer/api/"s;
-//    auto const ServerAddress = "http://localhost/api/"s;
-
     auto const ApiGetSimulation = "getsimulationinfos"s;
     auto const ApiGetCurrentVersion = "getcurrentversion"s;
     auto const ApiConnect = "connect"s;
     auto const ApiDisconnect = "disconnect"s;
     auto const ApiGetUnprocessedTasks = "getunprocessedtasks"s;
     auto const ApiSendProcessedTask = "sendprocessedtask"s;
-    auto const ApiSendStatistics = "sendstatistics"s;
+    auto const ApiSendProcessedTaskDelta = "sendprocessedtaskdelta"s;
+    auto const ApiSendStatisticsBatch = "sendstatisticsbatch"s;
     auto const ApiSendLastImage = "sendlastimage"s;
     auto const ApiSendBugReport = "sendbugreport"s;
+
+    auto const LONG_POLL_WAIT = 20000;      //time the server may hold back an answer without tasks
+    auto const LONG_POLL_TIMEOUT = 30000;
+    auto const MIN_POLL_INTERVAL = 300;     //servers without long-polling answer immediately
+    auto const MAX_POLL_BACKOFF = 30000;
+
+    auto const MAX_STATISTICS_BATCH_SIZE = 10;
+    auto const MAX_STATISTICS_BATCH_DELAY = 10000;
 }
 
-WebAccessImpl::WebAccessImpl()
+WebAccessImpl::WebAccessImpl(string const& serverAddress)
+    : _serverAddress(serverAddress)
+    , _taskPollingTimer(new QTimer(this))
+    , _statisticsTimer(new QTimer(this))
 {
+    _taskPollingTimer->setSingleShot(true);
+    _statisticsTimer->setSingleShot(true);
+    connect(_taskPollingTimer, &QTimer::timeout, this, &WebAccessImpl::pollTasks);
+    connect(_statisticsTimer, &QTimer::timeout, this, &WebAccessImpl::uploadStatistics);
     init();
 }
 
@@ -39,8 +63,10 @@ void WebAccessImpl::init()
 
     delete _http;
     _http = new HttpClient(this);
+    _requesting.clear();
 
     _connections.emplace_back(connect(_http, &HttpClient::dataReceived, this, &WebAccessImpl::dataReceived));
+    _connections.emplace_back(connect(_http, &HttpClient::failed, this, &WebAccessImpl::requestFailed));
     _connections.emplace_back(connect(_http, &HttpClient::error, this, &WebAccess::error));
 }
 
@@ -59,28 +85,79 @@ void WebAccessImpl::requestConnectToSimulation(string const& simulationId, strin
     post(ApiConnect, RequestType::Connect, { { "simulationId", simulationId },{ "password", password } });
 }
 
-void WebAccessImpl::requestUnprocessedTasks(std::string const & simulationId, string const& token)
+void WebAccessImpl::startTaskPolling(string const& simulationId, string const& token)
+{
+    stopTaskPolling();
+
+    _taskPolling.active = true;
+    _taskPolling.simulationId = simulationId;
+    _taskPolling.token = token;
+    _taskPolling.backoff = 0;
+    pollTasks();
+}
+
+void WebAccessImpl::stopTaskPolling()
 {
-    post(ApiGetUnprocessedTasks, RequestType::UnprocessedTasks, { { "simulationId", simulationId }, {"token", token} });
+    _taskPolling.active = false;
+    ++_taskPolling.generation;
+    _taskPollingTimer->stop();
+    _requesting.erase(RequestType::UnprocessedTasks);
 }
 
 void WebAccessImpl::sendProcessedTask(
     string const & simulationId, 
     string const & token, 
     string const& taskId, 
-    QBuffer* data)
+    QBuffer* data,
+    string const& mimeType)
 {
     postImage(
         ApiSendProcessedTask, 
         RequestType::ProcessedTask,
         taskId,
         {{"simulationId", simulationId}, {"token", token}, {"taskId", taskId}}, 
-        data);
+        data,
+        mimeType);
+}
+
+void WebAccessImpl::sendProcessedTaskDelta(
+    string const& simulationId,
+    string const& token,
+    string const& taskId,
+    ImageDelta const& delta,
+    string const& mimeType)
+{
+    //tile positions are listed in the order of the image parts "tile0", "tile1", ...
+    std::stringstream tilePositions;
+    vector<QByteArray> images;
+    for (auto const& tile : delta.tiles) {
+        if (!images.empty()) {
+            tilePositions << ";";
+        }
+        tilePositions << tile.pos.x << "," << tile.pos.y;
+        images.emplace_back(tile.data);
+    }
+    postImages(
+        ApiSendProcessedTaskDelta,
+        RequestType::ProcessedTaskDelta,
+        taskId,
+        {{"simulationId", simulationId},
+         {"token", token},
+         {"taskId", taskId},
+         {"imageWidth", std::to_string(delta.imageSize.x)},
+         {"imageHeight", std::to_string(delta.imageSize.y)},
+         {"tileSize", std::to_string(delta.tileSize)},
+         {"keyFrame", delta.keyFrame ? "1" : "0"},
+         {"tiles", tilePositions.str()}},
+        images,
+        mimeType);
 }
 
 void WebAccessImpl::requestDisconnect(std::string const & simulationId, string const& token)
 {
-    post(ApiDisconnect, RequestType::Disconnect, {{"simulationId", simulationId}, {"token", token}});
+    _pendingDisconnect = DisconnectRequest{simulationId, token};
+    flushStatistics();
+    disconnectIfStatisticsUploaded();
 }
 
 void WebAccessImpl::sendStatistics(
@@ -88,9 +165,24 @@ void WebAccessImpl::sendStatistics(
     string const & token, 
     map<string, string> monitorData)
 {
+    auto const time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
     monitorData.emplace("simulationId", simulationId);
     monitorData.emplace("token", token);
-    post(ApiSendStatistics, RequestType::SendStatistics, monitorData);
+    monitorData.emplace("time", std::to_string(time));
+    _statisticsBatch.samples.emplace_back(monitorData);
+
+    if (static_cast<int>(_statisticsBatch.samples.size()) >= MAX_STATISTICS_BATCH_SIZE) {
+        uploadStatistics();
+    } else if (!_statisticsTimer->isActive()) {
+        _statisticsTimer->start(MAX_STATISTICS_BATCH_DELAY);
+    }
+}
+
+void WebAccessImpl::flushStatistics()
+{
+    _statisticsBatch.flushRequested = true;
+    uploadStatistics();
 }
 
 void WebAccessImpl::sendLastImage(string const & simulationId, string const & token, QBuffer * data)
@@ -100,7 +192,8 @@ void WebAccessImpl::sendLastImage(string const & simulationId, string const & to
         RequestType::LastImage,
         "",
         { { "simulationId", simulationId },{ "token", token } },
-        data);
+        data,
+        ImageEncoder::getMimeType(ImageEncoder::Format::Png));
 }
 
 void WebAccessImpl::sendBugReport(
@@ -121,6 +214,9 @@ void WebAccessImpl::dataReceived(string handler, QByteArray data)
     auto requestType = static_cast<RequestType>(handlerParts.first().toUInt());
     auto id = handlerParts.last().toStdString();
 
+    if (RequestType::UnprocessedTasks == requestType && !isCurrentTaskPolling(id)) {
+        return;
+    }
     _requesting.erase(requestType);
 
     switch (requestType) {
@@ -134,11 +230,20 @@ void WebAccessImpl::dataReceived(string handler, QByteArray data)
     }
     break;
     case RequestType::UnprocessedTasks: {
-        auto tasks = Parser::parseForUnprocessedTasks(data);
+        vector<Task> tasks;
+        try {
+            tasks = Parser::parseForUnprocessedTasks(data);
+        }
+        catch (ParseErrorException const&) {
+            scheduleTaskPolling(false);
+            break;
+        }
+        scheduleTaskPolling(true);
         Q_EMIT unprocessedTasksReceived(tasks);
     }
     break;
-    case RequestType::ProcessedTask: {
+    case RequestType::ProcessedTask:
+    case RequestType::ProcessedTaskDelta: {
         Q_EMIT sendProcessedTaskReceived(id);
     }
     break;
@@ -146,12 +251,35 @@ void WebAccessImpl::dataReceived(string handler, QByteArray data)
         Q_EMIT sendLastImageReceived();
     }
     break;
+    case RequestType::SendStatistics: {
+        statisticsUploadFinished();
+    }
+    break;
     case RequestType::SendBugReport: {
         Q_EMIT sendBugReportReceived();
     } break;
     }
 }
 
+void WebAccessImpl::requestFailed(string handler)
+{
+    QStringList const handlerParts = QString::fromStdString(handler).split(QChar(':'));
+    auto requestType = static_cast<RequestType>(handlerParts.first().toUInt());
+    auto id = handlerParts.last().toStdString();
+
+    if (RequestType::UnprocessedTasks == requestType && !isCurrentTaskPolling(id)) {
+        return;
+    }
+    _requesting.erase(requestType);
+
+    if (RequestType::UnprocessedTasks == requestType) {
+        scheduleTaskPolling(false);
+    }
+    if (RequestType::SendStatistics == requestType) {
+        statisticsUploadFinished();
+    }
+}
+
 void WebAccessImpl::get(string const& apiMethodName, RequestType requestType, bool omitErrorResponse)
 {
     if (_requesting.find(requestType) != _requesting.end()) {
@@ -160,10 +288,15 @@ void WebAccessImpl::get(string const& apiMethodName, RequestType requestType, bo
     _requesting.insert(requestType);
 
     auto const handler = std::to_string(static_cast<int>(requestType)) + ":";
-    _http->get(QUrl(QString::fromStdString(ServerAddress + apiMethodName)), handler, omitErrorResponse);
+    _http->get(QUrl(QString::fromStdString(_serverAddress + apiMethodName)), handler, omitErrorResponse);
 }
 
-void WebAccessImpl::post(string const & apiMethodName, RequestType requestType, std::map<string, string> const& keyValues)
+void WebAccessImpl::post(
+    string const& apiMethodName,
+    RequestType requestType,
+    std::map<string, string> const& keyValues,
+    string const& id,
+    HttpClient::RequestOptions const& options)
 {
     if (_requesting.find(requestType) != _requesting.end()) {
         return;
@@ -175,11 +308,12 @@ void WebAccessImpl::post(string const & apiMethodName, RequestType requestType,
         params.addQueryItem(QString::fromStdString(keyValue.first), QString::fromStdString(keyValue.second));
     }
 
-    auto const handler = std::to_string(static_cast<int>(requestType)) + ":";
+    auto const handler = std::to_string(static_cast<int>(requestType)) + ":" + id;
     _http->postText(
-        QUrl(QString::fromStdString(ServerAddress + apiMethodName)),
+        QUrl(QString::fromStdString(_serverAddress + apiMethodName)),
         handler,
-        params.query().toUtf8());
+        params.query().toUtf8(),
+        options);
 }
 
 void WebAccessImpl::postImage(
@@ -187,14 +321,55 @@ void WebAccessImpl::postImage(
     RequestType requestType, 
     string const& id,
     std::map<string, string> const& keyValues, 
-    QBuffer* data)
+    QBuffer* data,
+    string const& mimeType)
 {
     if (_requesting.find(requestType) != _requesting.end()) {
         return;
     }
     _requesting.insert(requestType);
 
+    auto multiPart = createMultiPart(keyValues);
+
+    QHttpPart imagePart;
+    imagePart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QString::fromStdString(mimeType)));
+    imagePart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"image\""));
+    imagePart.setBodyDevice(data);
+
+    multiPart->append(imagePart);
+
+    postMultiPart(apiMethodName, requestType, id, multiPart);
+}
+
+void WebAccessImpl::postImages(
+    string const& apiMethodName,
+    RequestType requestType,
+    string const& id,
+    std::map<string, string> const& keyValues,
+    vector<QByteArray> const& images,
+    string const& mimeType)
+{
+    if (_requesting.find(requestType) != _requesting.end()) {
+        return;
+    }
+    _requesting.insert(requestType);
 
+    auto multiPart = createMultiPart(keyValues);
+
+    for (int i = 0; i < static_cast<int>(images.size()); ++i) {
+        QHttpPart imagePart;
+        imagePart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QString::fromStdString(mimeType)));
+        imagePart.setHeader(
+            QNetworkRequest::ContentDispositionHeader, QVariant(QString("form-data; name=\"tile%1\"").arg(i)));
+        imagePart.setBody(images.at(i));
+        multiPart->append(imagePart);
+    }
+
+    postMultiPart(apiMethodName, requestType, id, multiPart);
+}
+
+QHttpMultiPart* WebAccessImpl::createMultiPart(std::map<string, string> const& keyValues) const
+{
     QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
 
     for (auto const& keyValue : keyValues) {
@@ -204,17 +379,129 @@ void WebAccessImpl::postImage(
         textPart.setBody(QByteArray::fromStdString(keyValue.second));
         multiPart->append(textPart);
     }
+    return multiPart;
+}
 
-    QHttpPart imagePart;
-    imagePart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("image/png"));
-    imagePart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"image\""));
-    imagePart.setBodyDevice(data);
-
-    multiPart->append(imagePart);
-
+void WebAccessImpl::postMultiPart(
+    string const& apiMethodName,
+    RequestType requestType,
+    string const& id,
+    QHttpMultiPart* multiPart)
+{
     auto const handler = std::to_string(static_cast<int>(requestType)) + ":" + id;
     _http->postBinary(
-        QUrl(QString::fromStdString(ServerAddress + apiMethodName)),
+        QUrl(QString::fromStdString(_serverAddress + apiMethodName)),
         handler,
         multiPart);
 }
+
+void WebAccessImpl::pollTasks()
+{
+    if (!_taskPolling.active) {
+        return;
+    }
+    _taskPolling.sinceLastPoll.start();
+
+    HttpClient::RequestOptions options;
+    options.omitErrorResponse = true;   //server is polled again after backoff
+    options.timeout = LONG_POLL_TIMEOUT;
+    post(
+        ApiGetUnprocessedTasks,
+        RequestType::UnprocessedTasks,
+        {{"simulationId", _taskPolling.simulationId},
+         {"token", _taskPolling.token},
+         {"waitTime", std::to_string(LONG_POLL_WAIT / 1000)}},
+        std::to_string(_taskPolling.generation),
+        options);
+}
+
+void WebAccessImpl::scheduleTaskPolling(bool success)
+{
+    if (!_taskPolling.active) {
+        return;
+    }
+    if (success) {
+        _taskPolling.backoff = 0;
+        auto const elapsed = static_cast<int>(_taskPolling.sinceLastPoll.elapsed());
+        _taskPollingTimer->start(std::max(0, MIN_POLL_INTERVAL - elapsed));
+        return;
+    }
+
+    _taskPolling.backoff =
+        _taskPolling.backoff == 0 ? MIN_POLL_INTERVAL : std::min(_taskPolling.backoff * 2, MAX_POLL_BACKOFF);
+    _taskPollingTimer->start(_taskPolling.backoff);
+
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+    loggingService->logMessage(
+        Priority::Unimportant,
+        "Web: polling tasks failed, retry in " + std::to_string(_taskPolling.backoff) + " ms");
+}
+
+bool WebAccessImpl::isCurrentTaskPolling(string const& id) const
+{
+    return _taskPolling.active && std::to_string(_taskPolling.generation) == id;
+}
+
+void WebAccessImpl::uploadStatistics()
+{
+    auto& samples = _statisticsBatch.samples;
+    if (samples.empty()) {
+        _statisticsBatch.flushRequested = false;
+        _statisticsTimer->stop();
+        return;
+    }
+
+    //further samples are sent after the upload in progress
+    if (_requesting.find(RequestType::SendStatistics) != _requesting.end()) {
+        return;
+    }
+    _requesting.insert(RequestType::SendStatistics);
+    _statisticsTimer->stop();
+
+    auto const batchSize = std::min(samples.size(), static_cast<size_t>(MAX_STATISTICS_BATCH_SIZE));
+    QJsonArray jsonSamples;
+    for (auto it = samples.begin(); it != samples.begin() + batchSize; ++it) {
+        QJsonObject jsonSample;
+        for (auto const& [key, value] : *it) {
+            jsonSample.insert(QString::fromStdString(key), QString::fromStdString(value));
+        }
+        jsonSamples.append(jsonSample);
+    }
+    samples.erase(samples.begin(), samples.begin() + batchSize);
+
+    HttpClient::RequestOptions options;
+    options.omitErrorResponse = true;   //statistics are not essential
+    options.contentType = "application/json";
+    options.compress = true;
+    auto const handler = std::to_string(static_cast<int>(RequestType::SendStatistics)) + ":";
+    _http->postText(
+        QUrl(QString::fromStdString(_serverAddress + ApiSendStatisticsBatch)),
+        handler,
+        QJsonDocument(jsonSamples).toJson(QJsonDocument::Compact),
+        options);
+}
+
+void WebAccessImpl::statisticsUploadFinished()
+{
+    if (static_cast<int>(_statisticsBatch.samples.size()) >= MAX_STATISTICS_BATCH_SIZE
+        || _statisticsBatch.flushRequested) {
+        uploadStatistics();
+    } else if (!_statisticsBatch.samples.empty() && !_statisticsTimer->isActive()) {
+        _statisticsTimer->start(MAX_STATISTICS_BATCH_DELAY);
+    }
+    disconnectIfStatisticsUploaded();
+}
+
+void WebAccessImpl::disconnectIfStatisticsUploaded()
+{
+    if (!_pendingDisconnect || !_statisticsBatch.samples.empty()
+        || _requesting.find(RequestType::SendStatistics) != _requesting.end()) {
+        return;
+    }
+    auto const disconnect = *_pendingDisconnect;
+    _pendingDisconnect.reset();
+    post(
+        ApiDisconnect,
+        RequestType::Disconnect,
+        {{"simulationId", disconnect.simulationId}, {"token", disconnect.token}});
+}
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <QElapsedTimer>
+
 #include "WebAccess.h"
+#include "HttpClient.h"
+
+class QHttpMultiPart;
+class QTimer;
 
 class WebAccessImpl : public WebAccess
 {
 public:
-    WebAccessImpl();
+    WebAccessImpl(string const& serverAddress);
     virtual ~WebAccessImpl() = default;
 
     void init() override;
@@ -13,15 +19,29 @@ public:
     void requestCurrentVersion() override;
     void requestSimulationInfos() override;
     void requestConnectToSimulation(string const& simulationId, string const& password) override;
-    void requestUnprocessedTasks(string const& simulationId, string const& token) override;
-    void sendProcessedTask(string const& simulationId, string const& token, string const& taskId, QBuffer* data) override;
+    void startTaskPolling(string const& simulationId, string const& token) override;
+    void stopTaskPolling() override;
+    void sendProcessedTask(
+        string const& simulationId,
+        string const& token,
+        string const& taskId,
+        QBuffer* data,
+        string const& mimeType) override;
+    void sendProcessedTaskDelta(
+        string const& simulationId,
+        string const& token,
+        string const& taskId,
+        ImageDelta const& delta,
+        string const& mimeType) override;
     void requestDisconnect(string const& simulationId, string const& token) override;
     void sendStatistics(string const& simulationId, string const& token, map<string, string> monitorData) override;
+    void flushStatistics() override;
     void sendLastImage(string const& simulationId, string const& token, QBuffer* data) override;
     void sendBugReport(string const& protocol, string const& email, string const& userMessage) override;
 
 private:
     Q_SLOT void dataReceived(string handler, QByteArray data);
+    Q_SLOT void requestFailed(string handler);
 
     enum class RequestType {
         CurrentVersion,
@@ -30,20 +50,66 @@ private:
         Disconnect,
         UnprocessedTasks,
         ProcessedTask,
+        ProcessedTaskDelta,
         SendStatistics,
         LastImage,
         SendBugReport
     };
 
     void get(string const& apiMethodName, RequestType requestType, bool omitErrorResponse = false);
-    void post(string const& apiMethodName, RequestType requestType, std::map<string, string> const& keyValues);
+    void post(
+        string const& apiMethodName,
+        RequestType requestType,
+        std::map<string, string> const& keyValues,
+        string const& id = "",
+        HttpClient::RequestOptions const& options = HttpClient::RequestOptions());
     void postImage(string const& apiMethodName, RequestType requestType, string const& id, 
-        std::map<string, string> const& keyValues, QBuffer* data);
+        std::map<string, string> const& keyValues, QBuffer* data, string const& mimeType);
+    void postImages(string const& apiMethodName, RequestType requestType, string const& id,
+        std::map<string, string> const& keyValues, vector<QByteArray> const& images, string const& mimeType);
+    QHttpMultiPart* createMultiPart(std::map<string, string> const& keyValues) const;
+    void postMultiPart(string const& apiMethodName, RequestType requestType, string const& id, QHttpMultiPart* multiPart);
+
+    Q_SLOT void pollTasks();
+    void scheduleTaskPolling(bool success);
+    bool isCurrentTaskPolling(string const& id) const;
+
+    Q_SLOT void uploadStatistics();
+    void statisticsUploadFinished();
+    void disconnectIfStatisticsUploaded();
 
 private:
 
+    string _serverAddress;
     HttpClient* _http = nullptr;
 
     set<RequestType> _requesting;
     std::vector<QMetaObject::Connection> _connections;
+
+    struct TaskPolling
+    {
+        bool active = false;
+        int generation = 0;     //replies of former pollings are ignored
+        string simulationId;
+        string token;
+        int backoff = 0;    //in milliseconds, 0 = last poll succeeded
+        QElapsedTimer sinceLastPoll;
+    };
+    TaskPolling _taskPolling;
+    QTimer* _taskPollingTimer = nullptr;
+
+    struct StatisticsBatch
+    {
+        vector<map<string, string>> samples;
+        bool flushRequested = false;
+    };
+    StatisticsBatch _statisticsBatch;
+    QTimer* _statisticsTimer = nullptr;
+
+    struct DisconnectRequest
+    {
+        string simulationId;
+        string token;
+    };
+    boost::optional<DisconnectRequest> _pendingDisconnect;    //sent after the buffered statistics have been uploaded
 };
\ No newline at end of file
@@ -8,5 +8,8 @@ public:
     virtual ~WebBuilderFacade() = default;
 
     virtual WebAccess* buildWebAccess() const = 0;
+
+    //serverAddress is the base url of the api, e.g. "http://localhost/api/"
+    virtual WebAccess* buildWebAccess(string const& serverAddress) const = 0;
 };
 
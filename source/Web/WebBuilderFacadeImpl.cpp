@@ -1,7 +1,17 @@
 #include "WebBuilderFacadeImpl.h"
 #include "WebAccessImpl.h"
 
+namespace
+{
+    auto const DefaultServerAddress = "https://alien-project.org/world-explorer/api/";
+}
+
 WebAccess * WebBuilderFacadeImpl::buildWebAccess() const
 {
-    return new WebAccessImpl();
+    return buildWebAccess(DefaultServerAddress);
+}
+
+WebAccess* WebBuilderFacadeImpl::buildWebAccess(string const& serverAddress) const
+{
+    return new WebAccessImpl(serverAddress);
 }